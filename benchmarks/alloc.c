@@ -0,0 +1,53 @@
+#include "bench_framework.h"
+
+#include <stdlib.h>
+
+#define ITERATIONS 10000000ull
+#define LIVE_OBJECTS 4096
+
+// Sizes of the objects the interpreter allocates most: refcounters, envs,
+// scopes and small darrays
+static const uint64_t churn_sizes[] = {40, 48, 24, 32, 64, 96, 16, 128};
+
+static void *live[LIVE_OBJECTS];
+
+int main(void) {
+    BENCH_BEGIN();
+
+    BENCH("snuk_alloc/free 48 B", ITERATIONS, {
+        void *ptr = snuk_alloc(48, 8);
+        snuk_bench_sink += (uint64_t)(uintptr_t)ptr;
+        snuk_free(ptr);
+    });
+    BENCH("malloc/free 48 B", ITERATIONS, {
+        void *ptr = malloc(48);
+        snuk_bench_sink += (uint64_t)(uintptr_t)ptr;
+        free(ptr);
+    });
+
+    // Replace objects in a scattered order, so free lists get shuffled the
+    // way a long running script shuffles them
+    for (uint64_t i = 0; i < LIVE_OBJECTS; ++i) live[i] = snuk_alloc(churn_sizes[i % 8], 8);
+    BENCH("snuk_alloc/free churn 16-128 B", ITERATIONS, {
+        uint64_t slot = (bench_i * 2654435761u) % LIVE_OBJECTS;
+        snuk_free(live[slot]);
+        live[slot] = snuk_alloc(churn_sizes[bench_i % 8], 8);
+    });
+    for (uint64_t i = 0; i < LIVE_OBJECTS; ++i) snuk_free(live[i]);
+
+    for (uint64_t i = 0; i < LIVE_OBJECTS; ++i) live[i] = malloc(churn_sizes[i % 8]);
+    BENCH("malloc/free churn 16-128 B", ITERATIONS, {
+        uint64_t slot = (bench_i * 2654435761u) % LIVE_OBJECTS;
+        free(live[slot]);
+        live[slot] = malloc(churn_sizes[bench_i % 8]);
+    });
+    for (uint64_t i = 0; i < LIVE_OBJECTS; ++i) free(live[i]);
+
+    BENCH("snuk_alloc/free 4 KiB (freelist)", ITERATIONS / 10, {
+        void *ptr = snuk_alloc(KIB(4), 8);
+        snuk_bench_sink += (uint64_t)(uintptr_t)ptr;
+        snuk_free(ptr);
+    });
+
+    BENCH_END();
+}
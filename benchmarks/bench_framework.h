@@ -0,0 +1,64 @@
+#pragma once
+
+#include <snuk/logger.h>
+#include <snuk/memory.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief Sink for benchmark results so the measured work is not optimized away.
+ */
+static volatile uint64_t snuk_bench_sink;
+
+static inline uint64_t snuk_bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline void snuk_bench_report(const char *name, uint64_t iterations, uint64_t elapsed_ns) {
+    printf("%-40s %12llu iters %12.2f ns/op\n", name, (unsigned long long)iterations,
+           (double)elapsed_ns / (double)iterations);
+}
+
+static inline void snuk_bench_report_bytes(const char *name, uint64_t iterations, uint64_t bytes,
+                                           uint64_t elapsed_ns) {
+    printf("%-40s %12llu iters %12.2f MiB/s\n", name, (unsigned long long)iterations,
+           (double)(bytes * iterations) / (1024.0 * 1024.0) / ((double)elapsed_ns / 1e9));
+}
+
+/**
+ * @brief Time `iterations` runs of body and print the average cost per run.
+ *
+ * body may use bench_i, the index of the current run.
+ */
+#define BENCH(name, iterations, body)                                                     \
+    do {                                                                                  \
+        uint64_t bench_start = snuk_bench_now_ns();                                       \
+        for (uint64_t bench_i = 0; bench_i < (uint64_t)(iterations); ++bench_i) { body; } \
+        snuk_bench_report(name, iterations, snuk_bench_now_ns() - bench_start);           \
+    } while (0)
+
+/**
+ * @brief Like BENCH, but report throughput for body processing `bytes` bytes.
+ */
+#define BENCH_BYTES(name, iterations, bytes, body)                                        \
+    do {                                                                                  \
+        uint64_t bench_start = snuk_bench_now_ns();                                       \
+        for (uint64_t bench_i = 0; bench_i < (uint64_t)(iterations); ++bench_i) { body; } \
+        snuk_bench_report_bytes(name, iterations, bytes, snuk_bench_now_ns() - bench_start); \
+    } while (0)
+
+#define BENCH_BEGIN()                                         \
+    do {                                                      \
+        snuk_logger_init();                                   \
+        if (!snuk_memory_init(GIB(1))) return -1;             \
+    } while (0)
+
+#define BENCH_END()                                           \
+    do {                                                      \
+        snuk_memory_deinit();                                 \
+        snuk_logger_deinit();                                 \
+        return 0;                                             \
+    } while (0)
@@ -0,0 +1,110 @@
+#include "bench_framework.h"
+
+#include <snuk/interpreter/snuk_bigint.h>
+
+#define SMALL_ITERATIONS 50000000ull
+
+static SnukValue make_int(int64_t value) {
+    return (SnukValue){.type = SNUK_VALUE_INT, .int_value = value};
+}
+
+static SnukValue op(SnukValue left, SnukValue right, SnukTokenType token) {
+    SnukValue res = snuk_bigint_binary_op(left, right, token);
+    snuk_value_free(left);
+    return res;
+}
+
+/**
+ * @brief Build a pseudo random integer of about `limbs` 32 bit limbs.
+ */
+static SnukValue make_big(uint64_t limbs, uint64_t seed) {
+    SnukValue res = make_int(1);
+    for (uint64_t i = 0; i < limbs; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        res = op(res, make_int(1ll << 32), SNUK_TOKEN_STAR);
+        res = op(res, make_int((int64_t)(seed >> 33)), SNUK_TOKEN_PLUS);
+    }
+    return res;
+}
+
+static void bench_small(void) {
+    // Baseline without overflow checks against the checked fast path
+    int64_t acc = 0;
+    BENCH("int add (unchecked)", SMALL_ITERATIONS, acc = (acc + (int64_t)bench_i) & 0xFFFFFFFF);
+    snuk_bench_sink = (uint64_t)acc;
+
+    acc = 0;
+    BENCH("int add (checked)", SMALL_ITERATIONS, {
+        int64_t res;
+        if (snuk_int_add_overflow(acc, (int64_t)bench_i, &res)) break;
+        acc = res & 0xFFFFFFFF;
+    });
+    snuk_bench_sink = (uint64_t)acc;
+
+    acc = 1;
+    BENCH("int mul (unchecked)", SMALL_ITERATIONS, acc = (acc * (int64_t)(bench_i | 1)) & 0xFFFFFFFF);
+    snuk_bench_sink = (uint64_t)acc;
+
+    acc = 1;
+    BENCH("int mul (checked)", SMALL_ITERATIONS, {
+        int64_t res;
+        if (snuk_int_mul_overflow(acc, (int64_t)(bench_i | 1), &res)) break;
+        acc = res & 0xFFFFFFFF;
+    });
+    snuk_bench_sink = (uint64_t)acc;
+
+    // Promotion: the first product past int64_t
+    BENCH("int mul promoting to bigint", SMALL_ITERATIONS / 100, {
+        SnukValue res = snuk_bigint_binary_op(make_int(INT64_MAX), make_int(3), SNUK_TOKEN_STAR);
+        snuk_bench_sink += res.type;
+        snuk_value_free(res);
+    });
+}
+
+static void bench_big(void) {
+    static const uint64_t sizes[] = {4, 16, 32, 64, 256, 1024, 4096};
+    char name[64];
+
+    for (uint64_t s = 0; s < SNUK_ARRAY_LENGTH(sizes); ++s) {
+        uint64_t limbs = sizes[s];
+        uint64_t iterations = 2000000 / (limbs * limbs) + 10;
+        SnukValue a = make_big(limbs, 1);
+        SnukValue b = make_big(limbs, 2);
+
+        snprintf(name, sizeof(name), "bigint add %llu limbs", (unsigned long long)limbs);
+        BENCH(name, iterations * limbs, {
+            SnukValue res = snuk_bigint_binary_op(a, b, SNUK_TOKEN_PLUS);
+            snuk_bench_sink += res.type;
+            snuk_value_free(res);
+        });
+
+        snprintf(name, sizeof(name), "bigint mul %llu limbs", (unsigned long long)limbs);
+        BENCH(name, iterations, {
+            SnukValue res = snuk_bigint_binary_op(a, b, SNUK_TOKEN_STAR);
+            snuk_bench_sink += res.type;
+            snuk_value_free(res);
+        });
+
+        SnukValue product = snuk_bigint_binary_op(a, b, SNUK_TOKEN_STAR);
+        snprintf(name, sizeof(name), "bigint div %llu/%llu limbs", (unsigned long long)(2 * limbs),
+                 (unsigned long long)limbs);
+        BENCH(name, iterations, {
+            SnukValue res = snuk_bigint_binary_op(product, b, SNUK_TOKEN_SLASH);
+            snuk_bench_sink += res.type;
+            snuk_value_free(res);
+        });
+
+        snuk_value_free(product);
+        snuk_value_free(b);
+        snuk_value_free(a);
+    }
+}
+
+int main(void) {
+    BENCH_BEGIN();
+
+    bench_small();
+    bench_big();
+
+    BENCH_END();
+}
@@ -0,0 +1,35 @@
+#include "bench_framework.h"
+
+#include <snuk/writer.h>
+
+#define ITERATIONS 10000000ull
+
+int main(void) {
+    BENCH_BEGIN();
+
+    char buf[64];
+
+    BENCH("int snprintf", ITERATIONS,
+          snuk_bench_sink += (uint64_t)snprintf(buf, sizeof(buf), "%" PRId64, (int64_t)(bench_i * 7919)));
+    BENCH("int snuk_format_int", ITERATIONS, snuk_bench_sink += snuk_format_int((int64_t)(bench_i * 7919), buf));
+
+    BENCH("float snprintf %lf", ITERATIONS,
+          snuk_bench_sink += (uint64_t)snprintf(buf, sizeof(buf), "%lf", (double)bench_i * 0.25));
+    BENCH("float snuk_format_float (integral)", ITERATIONS,
+          snuk_bench_sink += snuk_format_float((double)bench_i, buf));
+    BENCH("float snuk_format_float (fraction)", ITERATIONS,
+          snuk_bench_sink += snuk_format_float((double)bench_i * 0.25 + 0.1, buf));
+
+    // Rewind instead of flushing so nothing reaches stdout
+    SnukWriter writer;
+    snuk_writer_init(&writer, SNUK_WRITER_DEFAULT_CAPACITY, SNUK_FLUSH_ON_FULL);
+    BENCH("writer int and separator", ITERATIONS, {
+        if (writer.len > writer.capacity - 64) writer.len = 0;
+        snuk_writer_write_int(&writer, (int64_t)bench_i);
+        snuk_writer_write(&writer, " ", 1);
+    });
+    writer.len = 0;
+    snuk_writer_deinit(&writer);
+
+    BENCH_END();
+}
@@ -0,0 +1,197 @@
+#include "bench_framework.h"
+
+#include <snuk/arena.h>
+#include <snuk/interpreter/interpreter.h>
+#include <snuk/interpreter/native.h>
+#include <snuk/interpreter/snuk_call.h>
+#include <snuk/interpreter/snuk_pool.h>
+#include <snuk/interpreter/snuk_program.h>
+#include <snuk/parser/parser.h>
+#include <string.h>
+
+#define ITERATIONS 100000
+#define JOBS 10000
+#define POOL_THREADS 2
+#define PAYLOAD_SIZE MIB(1)
+#define PAYLOAD_RUNS 1000
+
+static const char job[] = "var total = 0\nfor var i = 0; i < 20; i += 1 { total += i * seed }\ntotal\n";
+static const char comparator[] = "fn less(a, b) { return a < b }\n";
+static const char inspect[] = "data.get(0, 64).count(\",\") + data.length()\n";
+
+/**
+ * @brief Set up and tear down an interpreter, optionally touching a builtin
+ * type the way a one-liner calling a method on a value would.
+ */
+static void init_deinit(const char *type) {
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+    if (type) {
+        SnukValue value = snuk_interpreter_get_env(&intpret, snuk_string_view_create(type));
+        snuk_bench_sink += value.type;
+        snuk_value_free(value);
+    }
+    snuk_interpreter_deinit(&intpret);
+}
+
+/**
+ * @brief Run the job the way a process per job would, in a cold interpreter.
+ */
+static void run_cold(int64_t seed) {
+    SnukArena arena;
+    snuk_arena_init(&arena, SNUK_ARENA_DEFAULT_CHUNK_SIZE);
+    SnukAllocator allocator = snuk_arena_allocator(&arena);
+
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+    snuk_interpreter_create_env(&intpret, snuk_string_view_create("seed"), &any_type,
+                                (SnukValue){.type = SNUK_VALUE_INT, .int_value = seed}, false);
+
+    SnukParser parser;
+    snuk_parser_init(&parser, job, &allocator, SNUK_LEXER_MODE_EXECUTE);
+    SnukItem *item;
+    while ((item = snuk_parser_next_item(&parser))) {
+        SnukValue value = snuk_interpreter_exec_item(&intpret, item);
+        snuk_bench_sink += value.int_value;
+        snuk_value_free(value);
+    }
+
+    snuk_parser_deinit(&parser);
+    snuk_interpreter_deinit(&intpret);
+    snuk_arena_deinit(&arena);
+}
+
+/**
+ * @brief Run the compiled job in a warm interpreter, resetting it after.
+ */
+static void run_program(const SnukProgram *program, SnukInterpreter *intpret, int64_t seed) {
+    SnukProgramInput input = {.name = "seed", .value = {.type = SNUK_VALUE_INT, .int_value = seed}};
+    SnukValue value = snuk_program_run(program, intpret, &input, 1);
+    snuk_bench_sink += value.int_value;
+    snuk_value_free(value);
+    snuk_interpreter_reset(intpret);
+}
+
+/**
+ * @brief Call a script comparator from the host, passing arguments by name.
+ */
+static void call_by_name(SnukInterpreter *intpret, SnukValue fn, int64_t i) {
+    SnukParameter params[] = {
+        {.name = "a", .value = {.type = SNUK_VALUE_INT, .int_value = i}},
+        {.name = "b", .value = {.type = SNUK_VALUE_INT, .int_value = i % 7}},
+    };
+    SnukValue value = snuk_native_call_function(intpret, fn, params, 2);
+    snuk_bench_sink += value.bool_value;
+    snuk_value_free(value);
+}
+
+/**
+ * @brief Call the same comparator through a prepared handle.
+ */
+static void call_handle(SnukCallHandle *handle, int64_t i) {
+    SnukValue args[] = {
+        {.type = SNUK_VALUE_INT, .int_value = i},
+        {.type = SNUK_VALUE_INT, .int_value = i % 7},
+    };
+    SnukValue value = snuk_call_handle_invoke(handle, args);
+    snuk_bench_sink += value.bool_value;
+    snuk_value_free(value);
+}
+
+/**
+ * @brief Inspect a host payload copied into a string first.
+ */
+static void inspect_copy(const SnukProgram *program, SnukInterpreter *intpret, const char *payload) {
+    char *str = snuk_alloc(PAYLOAD_SIZE + 2, alignof(char));
+    str[0] = '"';
+    memcpy(str + 1, payload, PAYLOAD_SIZE);
+    str[PAYLOAD_SIZE + 1] = '"';
+    SnukProgramInput input = {
+        .name = "data",
+        .value = {.type = SNUK_VALUE_STRING, .string_value = snuk_string_view_create_with_len(str, PAYLOAD_SIZE + 2)},
+    };
+    SnukValue value = snuk_program_run(program, intpret, &input, 1);
+    snuk_bench_sink += value.int_value;
+    snuk_value_free(value);
+    snuk_interpreter_reset(intpret);
+    snuk_free(str);
+}
+
+/**
+ * @brief Inspect the same payload in place as a buffer.
+ */
+static void inspect_buffer(const SnukProgram *program, SnukInterpreter *intpret, const char *payload) {
+    SnukProgramInput input = {
+        .name = "data",
+        .value = snuk_native_create_buffer(intpret, payload, PAYLOAD_SIZE, NULL, NULL, false),
+    };
+    SnukValue value = snuk_program_run(program, intpret, &input, 1);
+    snuk_bench_sink += value.int_value;
+    snuk_value_free(value);
+    snuk_value_free(input.value);
+    snuk_interpreter_reset(intpret);
+}
+
+/**
+ * @brief Submit every job to the pool, then wait for all of them.
+ */
+static void run_pool(SnukPool *pool, SnukFuture **futures) {
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukProgramInput input = {.name = "seed", .value = {.type = SNUK_VALUE_INT, .int_value = i}};
+        futures[i] = snuk_pool_submit(pool, job, &input, 1);
+    }
+    for (int64_t i = 0; i < JOBS; ++i) {
+        snuk_bench_sink += snuk_future_wait(futures[i]).int_value;
+        snuk_future_destroy(futures[i]);
+    }
+}
+
+int main(void) {
+    BENCH_BEGIN();
+
+    BENCH("interpreter init and deinit", ITERATIONS, init_deinit(NULL));
+    BENCH("interpreter init, use str", ITERATIONS, init_deinit("str"));
+
+
+    int64_t seed = 0;
+    BENCH("job in a cold interpreter", JOBS, run_cold(seed++));
+
+    SnukProgram program;
+    snuk_program_compile(&program, job, "job");
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+    BENCH("compiled job in a reset interpreter", JOBS, run_program(&program, &intpret, seed++));
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+
+    snuk_program_compile(&program, comparator, "comparator");
+    snuk_interpreter_init(&intpret);
+    snuk_program_run(&program, &intpret, NULL, 0);
+    SnukValue less = snuk_interpreter_get_env(&intpret, snuk_string_view_create("less"));
+    BENCH("comparator called by name", ITERATIONS, call_by_name(&intpret, less, seed++));
+    SnukCallHandle handle;
+    snuk_call_handle_prepare(&handle, &intpret, less, NULL, 2);
+    BENCH("comparator called through a handle", ITERATIONS, call_handle(&handle, seed++));
+    snuk_call_handle_destroy(&handle);
+    snuk_value_free(less);
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+
+    char *payload = snuk_alloc(PAYLOAD_SIZE, alignof(char));
+    for (uint64_t i = 0; i < PAYLOAD_SIZE; ++i) payload[i] = i % 8 ? 'a' : ',';
+    snuk_program_compile(&program, inspect, "inspect");
+    snuk_interpreter_init(&intpret);
+    BENCH("1 MiB payload copied into a string", PAYLOAD_RUNS, inspect_copy(&program, &intpret, payload));
+    BENCH("1 MiB payload passed as a buffer", PAYLOAD_RUNS, inspect_buffer(&program, &intpret, payload));
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    snuk_free(payload);
+
+    SnukPool *pool = snuk_pool_create(POOL_THREADS);
+    SnukFuture **futures = snuk_alloc(JOBS * sizeof(SnukFuture *), alignof(SnukFuture *));
+    BENCH("10000 jobs on a pool of 2 threads", 1, run_pool(pool, futures));
+    snuk_free(futures);
+    snuk_pool_destroy(pool);
+
+    BENCH_END();
+}
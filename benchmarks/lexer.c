@@ -0,0 +1,83 @@
+#include "bench_framework.h"
+
+#include <snuk/lexer.h>
+
+#define INPUT_SIZE MIB(4)
+#define ITERATIONS 10
+
+/**
+ * @brief A bit of everything the lexer sees in real scripts: keywords,
+ * identifiers, numbers, strings, operators and comments.
+ */
+static const char snippet[]
+    = "// running total of the squares\n"
+      "fn sum_squares(limit: int) -> int {\n"
+      "    var total: int = 0\n"
+      "    for (var i = 0; i < limit; i += 1) {\n"
+      "        if i % 2 == 0 and not (i > 1000) { total += i * i } else { continue }\n"
+      "    }\n"
+      "    return total\n"
+      "}\n"
+      "\n"
+      "type Point {\n"
+      "    var x: float = 0.5\n"
+      "    var y: float = 1.25e3\n"
+      "}\n"
+      "\n"
+      "/* block comment spanning\n"
+      "   two lines */\n"
+      "const message = \"hello, world\"\n"
+      "print sum_squares(0x40) + 0b1010, message.length(), null, true\n";
+
+/**
+ * @brief Generated code tends to carry long strings and documentation
+ * comments.
+ */
+static const char generated_snippet[]
+    = "/*\n"
+      " * Generated from the schema, do not edit. Every field below mirrors a column\n"
+      " * of the source table and keeps the column's documentation verbatim.\n"
+      " */\n"
+      "const query = \"select id, name, created_at, updated_at from records where deleted = false order by id\"\n"
+      "// the template is rendered once per record and printed without any escaping at all\n"
+      "const template = \"<tr><td class='id'></td><td class='name'></td><td class='date'></td></tr>\"\n";
+
+/**
+ * @brief Repeat text until size bytes, null terminated.
+ */
+static char *make_source(const char *text, uint64_t len, uint64_t size) {
+    char *src = snuk_alloc(size + 1, alignof(char));
+    uint64_t i = 0;
+    for (; i + len <= size; i += len) memcpy(src + i, text, len);
+    src[i] = '\0';
+    return src;
+}
+
+static uint64_t lex_all(const char *src, SnukLexerMode mode) {
+    SnukLexer lexer;
+    snuk_lexer_init(&lexer, src, mode);
+    uint64_t count = 0;
+    while (snuk_lexer_next_token(&lexer).type != SNUK_TOKEN_EOF) ++count;
+    snuk_lexer_deinit(&lexer);
+    return count;
+}
+
+int main(void) {
+    BENCH_BEGIN();
+
+    char *src = make_source(snippet, sizeof(snippet) - 1, INPUT_SIZE);
+    BENCH_BYTES("lex mixed source", ITERATIONS, strlen(src),
+                snuk_bench_sink += lex_all(src, SNUK_LEXER_MODE_COMMENTS));
+    BENCH_BYTES("lex mixed source, execute mode", ITERATIONS, strlen(src),
+                snuk_bench_sink += lex_all(src, SNUK_LEXER_MODE_EXECUTE));
+    snuk_free(src);
+
+    src = make_source(generated_snippet, sizeof(generated_snippet) - 1, INPUT_SIZE);
+    BENCH_BYTES("lex strings and comments", ITERATIONS, strlen(src),
+                snuk_bench_sink += lex_all(src, SNUK_LEXER_MODE_COMMENTS));
+    BENCH_BYTES("lex comments, execute mode", ITERATIONS, strlen(src),
+                snuk_bench_sink += lex_all(src, SNUK_LEXER_MODE_EXECUTE));
+    snuk_free(src);
+
+    BENCH_END();
+}
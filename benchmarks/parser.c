@@ -0,0 +1,92 @@
+#include "bench_framework.h"
+
+#include <snuk/arena.h>
+#include <snuk/parser/parser.h>
+#include <snuk/parser/snuk_image.h>
+#include <snuk/parser/snuk_item.h>
+
+#define INPUT_SIZE MIB(4)
+#define ITERATIONS 10
+#define IMAGE_PATH "bench_parser.snukc"
+
+/**
+ * @brief Declarations, control flow and expressions the way scripts mix them.
+ */
+static const char snippet[]
+    = "fn sum_squares(limit) {\n"
+      "    var total = 0\n"
+      "    var i = 0\n"
+      "    while i < limit { if i % 2 == 0 and not (i > 1000) { total += i * i }; i += 1 }\n"
+      "    return total\n"
+      "}\n"
+      "type Point {\n"
+      "    var x = 0.5\n"
+      "    var y = 1.25e3\n"
+      "}\n"
+      "const message = \"hello, world\"\n"
+      "print sum_squares(0x40) + 0b1010, [1, 2, 3], message, null, true\n";
+
+/**
+ * @brief Repeat text until size bytes, null terminated.
+ */
+static char *make_source(const char *text, uint64_t len, uint64_t size) {
+    char *src = snuk_alloc(size + 1, alignof(char));
+    uint64_t i = 0;
+    for (; i + len <= size; i += len) memcpy(src + i, text, len);
+    src[i] = '\0';
+    return src;
+}
+
+/**
+ * @brief Arena bytes the items of the last parse_all held, added up.
+ */
+static uint64_t parsed_bytes;
+
+/**
+ * @brief Parse every item, rewinding the arena after each like the runner.
+ */
+static uint64_t parse_all(const char *src, SnukArena *arena) {
+    SnukAllocator allocator = snuk_arena_allocator(arena);
+    SnukParser parser;
+    snuk_parser_init(&parser, src, &allocator, SNUK_LEXER_MODE_EXECUTE);
+
+    uint64_t count = 0;
+    parsed_bytes = 0;
+    while (true) {
+        SnukArenaMark mark = snuk_arena_mark(arena);
+        SnukItem *item = snuk_parser_next_item(&parser);
+        if (!item) break;
+        count += item->type == SNUK_ITEM_ERROR ? 1000000 : 1;
+        parsed_bytes += arena->used - mark.used;
+        snuk_arena_rewind(arena, mark);
+    }
+
+    snuk_parser_deinit(&parser);
+    return count;
+}
+
+int main(void) {
+    BENCH_BEGIN();
+
+    SnukArena arena;
+    snuk_arena_init(&arena, SNUK_ARENA_DEFAULT_CHUNK_SIZE);
+
+    char *src = make_source(snippet, sizeof(snippet) - 1, INPUT_SIZE);
+    BENCH_BYTES("parse mixed source", ITERATIONS, strlen(src), snuk_bench_sink += parse_all(src, &arena));
+    printf("%-40s %12.2f bytes per source byte\n", "parsed tree size", (double)parsed_bytes / (double)strlen(src));
+
+    // What a compiled image saves at startup, the source is not around to hash
+    if (snuk_image_compile(src, "", IMAGE_PATH)) {
+        SnukImage image;
+        BENCH_BYTES("load image of mixed source", ITERATIONS, strlen(src), {
+            snuk_image_load(&image, IMAGE_PATH);
+            snuk_bench_sink += image.item_count;
+            snuk_image_unload(&image);
+        });
+        remove(IMAGE_PATH);
+    }
+    snuk_free(src);
+
+    snuk_arena_deinit(&arena);
+    BENCH_END();
+}
@@ -0,0 +1,71 @@
+#include "bench_framework.h"
+
+#include <snuk/string_view.h>
+
+#define INPUT_SIZE MIB(8)
+#define ITERATIONS 20
+
+/**
+ * @brief Byte at a time search, the baseline the vector scans are measured
+ * against.
+ */
+static const char *naive_find(const char *haystack, uint64_t haystack_len, const char *needle, uint64_t needle_len) {
+    for (uint64_t i = 0; i + needle_len <= haystack_len; ++i)
+        if (memcmp(haystack + i, needle, needle_len) == 0) return haystack + i;
+    return NULL;
+}
+
+/**
+ * @brief Fill with lowercase words separated by spaces and a comma every few
+ * words, like ordinary text.
+ */
+static char *make_text(uint64_t size) {
+    char *text = snuk_alloc(size, alignof(char));
+    uint64_t seed = 1;
+    for (uint64_t i = 0; i < size; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t r = (seed >> 33) % 64;
+        text[i] = r < 8 ? ' ' : r == 8 ? ',' : (char)('a' + r % 26);
+    }
+    return text;
+}
+
+int main(void) {
+    BENCH_BEGIN();
+
+    char *text = make_text(INPUT_SIZE);
+    // Only at the very end, so every search scans the whole input
+    memcpy(text + INPUT_SIZE - 6, "needle", 6);
+    text[INPUT_SIZE - 7] = '#';
+
+    BENCH_BYTES("find byte (naive)", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += (uint64_t)naive_find(text, INPUT_SIZE, "#", 1));
+    BENCH_BYTES("find byte", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += (uint64_t)snuk_string_find_byte(text, INPUT_SIZE, '#'));
+
+    BENCH_BYTES("find substring (naive)", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += (uint64_t)naive_find(text, INPUT_SIZE, "needle", 6));
+    BENCH_BYTES("find substring", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += (uint64_t)snuk_string_find(text, INPUT_SIZE, "needle", 6));
+
+    BENCH_BYTES("count separators", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += snuk_string_count(text, INPUT_SIZE, ",", 1));
+    BENCH_BYTES("count words", ITERATIONS, INPUT_SIZE,
+                snuk_bench_sink += snuk_string_count(text, INPUT_SIZE, " a", 2));
+
+    // Walking the pieces the way str.split does
+    BENCH_BYTES("split on ','", ITERATIONS, INPUT_SIZE, {
+        SnukStringView rest = snuk_string_view_create_with_len(text, INPUT_SIZE);
+        SnukStringView sep = snuk_string_view_create_with_len(",", 1);
+        const char *match;
+        while ((match = snuk_string_view_find(rest, sep))) {
+            snuk_bench_sink += (uint64_t)(match - rest.str);
+            rest.len -= (uint64_t)(match - rest.str) + 1;
+            rest.str = match + 1;
+        }
+    });
+
+    snuk_free(text);
+
+    BENCH_END();
+}
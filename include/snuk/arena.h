@@ -0,0 +1,129 @@
+#pragma once
+
+#include "defines.h"
+#include "memory.h"
+
+/**
+ * @brief Default size of an arena chunk.
+ */
+#define SNUK_ARENA_DEFAULT_CHUNK_SIZE KIB(64)
+
+typedef struct SnukArenaChunk SnukArenaChunk;
+
+/**
+ * @brief Bump allocator over a list of chunks that grows on demand.
+ *
+ * Allocations are only given back all at once by snuk_arena_reset, except
+ * the most recent one, which snuk_arena_free and snuk_arena_realloc handle in
+ * place. Chunks come from snuk_alloc, so arenas can grow and be reset in any
+ * order.
+ */
+typedef struct SnukArena {
+    SnukArenaChunk *current;  // newest chunk, linked to the older ones
+    void *last;  // most recent allocation, NULL once it is freed
+    uint64_t chunk_size;
+    uint64_t used;  // bytes handed out since the last reset, padding included
+    uint64_t high_water;  // most bytes ever in use at once
+} SnukArena;
+
+/**
+ * @brief Position in an arena to rewind to, taken with snuk_arena_mark.
+ */
+typedef struct SnukArenaMark {
+    SnukArenaChunk *chunk;
+    uint8_t *top;
+    uint64_t used;
+} SnukArenaMark;
+
+/**
+ * @brief Initialize an arena with one chunk.
+ *
+ * @param arena Arena to initialize.
+ * @param chunk_size Size of each chunk, larger allocations get a chunk of
+ * their own.
+ */
+SNUK_API void snuk_arena_init(SnukArena *arena, uint64_t chunk_size);
+
+/**
+ * @brief Release every chunk.
+ *
+ * @param arena Arena to release.
+ */
+SNUK_API void snuk_arena_deinit(SnukArena *arena);
+
+/**
+ * @brief Allocate from the newest chunk, adding a chunk when it is full.
+ *
+ * @param arena Arena to allocate from.
+ * @param size Number of bytes.
+ * @param align Alignment, a power of two.
+ *
+ * @return The memory, never NULL.
+ */
+SNUK_API void *snuk_arena_alloc(SnukArena *arena, uint64_t size, uint64_t align);
+
+/**
+ * @brief Resize an allocation.
+ *
+ * The most recent allocation grows in place while its chunk has room.
+ * Anything else moves, copying no more than the old block can hold.
+ *
+ * @param arena Arena ptr came from.
+ * @param ptr Allocation to resize.
+ * @param new_size New size in bytes.
+ * @param align Alignment, a power of two.
+ *
+ * @return The resized memory.
+ */
+SNUK_API void *snuk_arena_realloc(SnukArena *arena, void *ptr, uint64_t new_size, uint64_t align);
+
+/**
+ * @brief Give back the most recent allocation, anything else waits for a reset.
+ *
+ * @param arena Arena ptr came from.
+ * @param ptr Allocation to free.
+ */
+SNUK_API void snuk_arena_free(SnukArena *arena, void *ptr);
+
+/**
+ * @brief Invalidate every allocation, keeping only the first chunk.
+ *
+ * @param arena Arena to reset.
+ */
+SNUK_API void snuk_arena_reset(SnukArena *arena);
+
+/**
+ * @brief Remember the current position of the arena.
+ *
+ * @param arena Arena to mark.
+ *
+ * @return Mark for snuk_arena_rewind.
+ */
+SNUK_API SnukArenaMark snuk_arena_mark(SnukArena *arena);
+
+/**
+ * @brief Invalidate every allocation made after mark, releasing the chunks
+ * added since.
+ *
+ * @param arena Arena the mark was taken from.
+ * @param mark Mark to rewind to, must not be older than the last reset.
+ */
+SNUK_API void snuk_arena_rewind(SnukArena *arena, SnukArenaMark mark);
+
+/**
+ * @brief Everything allocated so far as one block, for arenas that never
+ * needed a second chunk.
+ *
+ * @param arena Arena to look at.
+ * @param size Set to the bytes in use, padding included.
+ *
+ * @return Start of the first chunk's data, or NULL once the arena has grown.
+ */
+SNUK_API void *snuk_arena_contiguous(SnukArena *arena, uint64_t *size);
+
+/**
+ * @brief SnukAllocator that allocates from arena.
+ *
+ * @param arena Arena to wrap, must outlive the allocator.
+ */
+SNUK_API SnukAllocator snuk_arena_allocator(SnukArena *arena);
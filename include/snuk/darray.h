@@ -3,39 +3,82 @@
 #include "defines.h"
 #include "memory.h"
 
+#include <string.h>
+
 #define SNUK_DARRAY_DEFAULT_CAPACITY 5
 #define SNUK_DARRAY_RESIZE_FACTOR 2
 
-SNUK_STATIC_ASSERT(sizeof(uint64_t) == sizeof(void *), "size of pointer != size of uint64_t");
+/**
+ * @brief Header stored right before the first element of every darray.
+ *
+ * A darray is a pointer to its elements, so the header is always one
+ * SnukDArray back from it. offset locates the start of the allocation for
+ * element alignments above 16 bytes. Inline darrays keep their elements in
+ * storage provided by the caller until they outgrow it.
+ */
+typedef struct SnukDArray {
+    uint64_t capacity;
+    uint64_t length;
+    uint64_t stride;
+    uint64_t align;
+    SnukAllocator *allocator;
+    uint32_t offset;  // from the start of the allocation to the header
+    uint32_t is_inline;
+} SnukDArray;
+
+SNUK_STATIC_ASSERT(sizeof(SnukDArray) % 16 == 0, "elements after the header must stay 16 byte aligned");
 
-typedef enum SnukDArrayHeader {
-    SNUK_DARRAY_CAPACITY,
-    SNUK_DARRAY_SIZE,
-    SNUK_DARRAY_STRIDE,
-    SNUK_DARRAY_ALIGN,
-    SNUK_DARRAY_ALLOCATOR,
+#define SNUK_DARRAY_HEADER(arr) ((SnukDArray *)(arr) - 1)
 
-    SNUK_DARRAY_MAX_FIELDS,
-} SnukDArrayHeader;
+/**
+ * @brief Storage for a darray whose first capacity elements need no
+ * allocation.
+ *
+ * Declare it where the array lives, as a local or a struct member, and pass
+ * it to snuk_darray_create_inline. The storage must not move while the array
+ * is in use. Elements aligned to more than 16 bytes are not supported.
+ */
+#define SNUK_DARRAY_INLINE_STORAGE(type, capacity) \
+    struct {                                       \
+        SnukDArray header;                         \
+        type elements[capacity];                   \
+    }
+
+/**
+ * @brief Initializer for the header of SNUK_DARRAY_INLINE_STORAGE filled at
+ * compile time, for read only arrays in static storage.
+ *
+ * @param type Type of the elements
+ * @param length Number of elements the initializer fills
+ * @param capacity Capacity given to SNUK_DARRAY_INLINE_STORAGE
+ */
+#define SNUK_DARRAY_STATIC_HEADER(type, length_, capacity_)                                              \
+    {.capacity = (capacity_), .length = (length_), .stride = sizeof(type), .align = alignof(type),       \
+     .allocator = &snuk_global_allocator, .offset = 0, .is_inline = true}
 
 SNUK_API void *
     impl_snuk_darray_create(uint64_t capacity, uint64_t stride, uint64_t align, SnukAllocator *allocator);
 
+SNUK_API void *impl_snuk_darray_create_inline(
+    SnukDArray *header, void *elements, uint64_t capacity, uint64_t stride, uint64_t align, SnukAllocator *allocator);
+
 SNUK_API void impl_snuk_darray_destroy(void *arr);
 
 SNUK_API void impl_snuk_darray_resize(void **parr, uint64_t capacity);
 
-SNUK_API uint64_t impl_snuk_darray_header(void *arr, SnukDArrayHeader header);
-
-SNUK_API void impl_snuk_darray_push(void **parr, void *element);
+SNUK_API void impl_snuk_darray_grow(void **parr);
 
 SNUK_API void impl_snuk_darray_push_at(void **parr, uint64_t index, void *element);
 
-SNUK_API void impl_snuk_darray_pop(void **parr, void *element);
-
 SNUK_API void impl_snuk_darray_pop_at(void **parr, uint64_t index, void *element);
 
-SNUK_API void impl_snuk_darray_clear(void **parr);
+SNUK_INLINE void impl_snuk_darray_pop(void *arr, void *element) {
+    SnukDArray *header = SNUK_DARRAY_HEADER(arr);
+    if (header->length == 0) return;
+
+    --header->length;
+    if (element) memcpy(element, (uint8_t *)arr + header->length * header->stride, header->stride);
+}
 
 /**
  * @brief Create darray with given type and capacity.
@@ -60,6 +103,21 @@ SNUK_API void impl_snuk_darray_clear(void **parr);
 #define snuk_darray_create(type, allocator)                                         \
     snuk_darray_create_with_capacity(SNUK_DARRAY_DEFAULT_CAPACITY, type, allocator)
 
+/**
+ * @brief Create a darray in storage declared with SNUK_DARRAY_INLINE_STORAGE.
+ *
+ * @param storage Pointer to the storage
+ * @param type Type of the elements, as given to SNUK_DARRAY_INLINE_STORAGE
+ * @param allocator Allocator for when the array outgrows the storage (if NULL
+ * snuk_global allocator is used)
+ *
+ * @return The array.
+ */
+#define snuk_darray_create_inline(storage, type, allocator)                                            \
+    (type *)impl_snuk_darray_create_inline(&(storage)->header, (storage)->elements,                    \
+                                           SNUK_ARRAY_LENGTH((storage)->elements), sizeof(type), alignof(type), \
+                                           allocator)
+
 /**
  * @brief Destroy the darray.
  *
@@ -82,7 +140,7 @@ SNUK_API void impl_snuk_darray_clear(void **parr);
  *
  * @return The length of the array.
  */
-#define snuk_darray_get_length(arr) impl_snuk_darray_header(arr, SNUK_DARRAY_SIZE)
+#define snuk_darray_get_length(arr) (SNUK_DARRAY_HEADER(arr)->length)
 
 /**
  * @brief Get the current capacity of the darray.
@@ -93,7 +151,7 @@ SNUK_API void impl_snuk_darray_clear(void **parr);
  *
  * @return The capacity of the array.
  */
-#define snuk_darray_get_capacity(arr) impl_snuk_darray_header(arr, SNUK_DARRAY_CAPACITY)
+#define snuk_darray_get_capacity(arr) (SNUK_DARRAY_HEADER(arr)->capacity)
 
 /**
  * @brief Clear the darray.
@@ -103,17 +161,23 @@ SNUK_API void impl_snuk_darray_clear(void **parr);
  *
  * @param parr Pointer to the array
  */
-#define snuk_darray_clear(parr) impl_snuk_darray_clear((void **)parr)
+#define snuk_darray_clear(parr) ((void)(SNUK_DARRAY_HEADER(*(parr))->length = 0))
 
 /**
  * @brief Push the given element to the end of the array.
  *
+ * Stored by assignment, so element converts to the element type. parr is
+ * evaluated more than once.
+ *
  * @param parr Pointer to the array
  * @param element The element
- * @param res Result
  */
-#define snuk_darray_push(parr, element)                                    \
-    impl_snuk_darray_push((void **)parr, (__typeof__(element)[]){element})
+#define snuk_darray_push(parr, element)                                                        \
+    do {                                                                                       \
+        if (SNUK_DARRAY_HEADER(*(parr))->length == SNUK_DARRAY_HEADER(*(parr))->capacity)      \
+            impl_snuk_darray_grow((void **)(parr));                                            \
+        (*(parr))[SNUK_DARRAY_HEADER(*(parr))->length++] = (element);                          \
+    } while (0)
 
 /**
  * @brief Pop the element from the end of the array.
@@ -121,7 +185,7 @@ SNUK_API void impl_snuk_darray_clear(void **parr);
  * @param parr Pointer to the array
  * @param element Pointer to store poped element (can be NULL)
  */
-#define snuk_darray_pop(parr, element) impl_snuk_darray_pop((void **)parr, element)
+#define snuk_darray_pop(parr, element) impl_snuk_darray_pop(*(parr), element)
 
 /**
  * @brief Push the element to given index of the array.
@@ -47,6 +47,12 @@
     #define SNUK_FORCE_INLINE static inline __attribute__((always_inline))
 #endif
 
+#if defined(SNUK_COMPILER_MSVC)
+    #define SNUK_THREAD_LOCAL __declspec(thread)
+#else
+    #define SNUK_THREAD_LOCAL _Thread_local
+#endif
+
 #define SNUK_STRINGIFY(x) #x
 
 #define SNUK_SHOULD_NOT_REACH_HERE SNUK_ASSERT(false, "Should not reach here")
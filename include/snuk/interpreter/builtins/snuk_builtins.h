@@ -10,6 +10,7 @@ extern SnukType int_type;
 extern SnukType float_type;
 extern SnukType bool_type;
 extern SnukType str_type;
+extern SnukType generator_type;
 
 SnukValue builtin_null_get_member(SnukInterpreter *intpret, SnukStringView field);
 
@@ -17,10 +18,11 @@ static struct {
     const char *type;
     SnukValueType val_type;
 } builtin_types[] = {
-    {.type = "int",   .val_type = SNUK_VALUE_INT   },
-    {.type = "float", .val_type = SNUK_VALUE_FLOAT },
-    {.type = "bool",  .val_type = SNUK_VALUE_BOOL  },
-    {.type = "str",   .val_type = SNUK_VALUE_STRING},
+    {.type = "int",       .val_type = SNUK_VALUE_INT      },
+    {.type = "float",     .val_type = SNUK_VALUE_FLOAT    },
+    {.type = "bool",      .val_type = SNUK_VALUE_BOOL     },
+    {.type = "str",       .val_type = SNUK_VALUE_STRING   },
+    {.type = "generator", .val_type = SNUK_VALUE_GENERATOR},
 };
 
 SNUK_INLINE SnukValueType snuk_builtins_get_value_type(SnukStringView name) {
@@ -30,6 +32,16 @@ SNUK_INLINE SnukValueType snuk_builtins_get_value_type(SnukStringView name) {
     return SNUK_VALUE_UNKOWN;
 }
 
+/**
+ * @brief Check whether a value type is acceptable where a builtin type is
+ * expected, a bigint is an int that grew past int64_t and a buffer is a
+ * string in host memory.
+ */
+SNUK_INLINE bool snuk_builtins_value_type_matches(SnukValueType expected, SnukValueType actual) {
+    return actual == expected || (expected == SNUK_VALUE_INT && actual == SNUK_VALUE_BIGINT)
+        || (expected == SNUK_VALUE_STRING && actual == SNUK_VALUE_BUFFER);
+}
+
 SnukValue snuk_builtins_create_type(SnukInterpreter *intpret, SnukValueType type, bool weak_ref);
 
 bool snuk_builtins_create_builtin_types(SnukInterpreter *intpret, bool weak_ref);
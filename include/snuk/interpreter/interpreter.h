@@ -6,19 +6,23 @@
 #include "snuk/parser/snuk_item.h"
 #include "snuk/refcount.h"
 #include "snuk/string_view.h"
+#include "snuk/writer.h"
 #include "snuk_env.h"
 #include "snuk_signal.h"
 #include "snuk_value.h"
 
-#include <snmemory/linear.h>
-
 /**
  * @brief Mutable interpreter state shared across exec and eval calls.
  *
  * current is the active scope stack head; it changes as blocks, functions,
  * and for loops push and pop scopes. global is retained for the lifetime of
  * the interpreter so identifiers can fall through to the root. signal carries
- * the most recent control-flow signal raised during evaluation.
+ * the most recent control-flow signal raised during evaluation. output
+ * buffers everything written by print. ast is the refcounted region holding
+ * the AST of the code being run, set by the caller before each top-level item
+ * or NULL when the caller keeps the AST alive itself. Closures, global
+ * bindings and string literals retain the region they point into, so it is
+ * freed once nothing is left that does.
  */
 typedef struct SnukInterpreter {
     SnukRefCounter *current;
@@ -26,19 +30,21 @@ typedef struct SnukInterpreter {
     SnukRefCounter *instance;
     SnukValue *trash;
     SnukSignal signal;
-    void *mem;
-    SnukAllocator allocator;
-    snLinearAllocator la;
 
     bool panic_mode;
     SnukValue error;
+
+    SnukRefCounter *ast;  // borrowed, swapped for the closure's region on calls
+
+    SnukWriter output;  // print output, flushed on deinit
 } SnukInterpreter;
 
 /**
  * @brief Initialize an interpreter with a fresh global scope.
  *
  * Creates the global scope, sets the current scope to point at it, and
- * clears any pending signal.
+ * clears any pending signal. Output is fully buffered until changed with
+ * snuk_writer_set_policy.
  *
  * @param intpret Interpreter state to initialize.
  */
@@ -47,13 +53,24 @@ SNUK_API void snuk_interpreter_init(SnukInterpreter *intpret);
 /**
  * @brief Release the interpreter's scopes and reset the state.
  *
- * Releases the current scope (when distinct from global) and the global
- * scope, then zeroes the struct. Safe to call with a NULL pointer.
+ * Flushes pending output, releases the current scope (when distinct from
+ * global) and the global scope, then zeroes the struct. Safe to call with a
+ * NULL pointer.
  *
  * @param intpret Interpreter state to release, or NULL.
  */
 SNUK_API void snuk_interpreter_deinit(SnukInterpreter *intpret);
 
+/**
+ * @brief Drop every binding and start over with a fresh global scope.
+ *
+ * Flushes pending output and keeps the output and trash buffers, so a reused
+ * interpreter runs its next script without setting up again.
+ *
+ * @param intpret Interpreter state to reset.
+ */
+SNUK_API void snuk_interpreter_reset(SnukInterpreter *intpret);
+
 /**
  * @brief Execute a top-level parsed item.
  *
@@ -3,6 +3,8 @@
 #include "interpreter.h"
 #include "snuk/darray.h"
 #include "snuk/defines.h"
+#include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/stats.h"
 #include "snuk_scope.h"
 
 SNUK_INLINE SnukValue interpreter_error(SnukInterpreter *intpret, const char *err_msg) {
@@ -18,6 +20,27 @@ SNUK_INLINE SnukValue interpreter_error(SnukInterpreter *intpret, const char *er
 #define SNUK_INTERPRETER_CHECK(intpret, cond, err_msg)       \
     if (!(cond)) return interpreter_error(intpret, err_msg);
 
+/**
+ * @brief Build the value of a lazy binding, no-op for ordinary bindings.
+ *
+ * Lazy values are built in the global scope, which outlives every binding
+ * the value could be stored in.
+ */
+SNUK_INLINE SnukEnv *interpreter_resolve_env(SnukInterpreter *intpret, SnukEnv *env) {
+    if (!env || !env->build) return env;
+
+    SnukEnvBuildFn build = env->build;
+    env->build = NULL;
+
+    SnukRefCounter *current = snuk_ref_counter_move(&intpret->current);
+    intpret->current = snuk_ref_counter_retain(intpret->global);
+    env->value = build(intpret, true);
+    snuk_ref_counter_release(&intpret->current);
+    intpret->current = snuk_ref_counter_move(&current);
+
+    return env;
+}
+
 /**
  * @brief Walk the scope chain from current to global to resolve a name.
  */
@@ -28,7 +51,7 @@ SNUK_INLINE SnukEnv *interpreter_lookup(SnukInterpreter *intpret, SnukStringView
         if (!env) env = snuk_scope_lookup(intpret->instance, name);
     }
     if (!env) env = snuk_scope_lookup_recursive(intpret->current, name);
-    return env;
+    return interpreter_resolve_env(intpret, env);
 }
 
 /**
@@ -52,9 +75,15 @@ SNUK_INLINE void interpreter_pop_scope(SnukInterpreter *intpret) {
     intpret->current = snuk_ref_counter_move(&parent);
 }
 
+/**
+ * @brief Keep the AST being run alive for as long as the closure scope.
+ */
+SNUK_INLINE void interpreter_hold_ast(SnukInterpreter *intpret, SnukRefCounter *closure) {
+    if (intpret->ast) GET_SCOPE(closure)->ast = snuk_ref_counter_retain(intpret->ast);
+}
+
 SNUK_INLINE SnukEnv *
     interpreter_get_member_env(SnukInterpreter *intpret, SnukValue type_or_inst, SnukStringView field) {
-    SNUK_UNUSED(intpret);
     if (type_or_inst.type != SNUK_VALUE_TYPE && type_or_inst.type != SNUK_VALUE_TYPE_INST)
         return NULL;
 
@@ -62,7 +91,7 @@ SNUK_INLINE SnukEnv *
     SnukEnv *env = snuk_scope_lookup(type_or_inst.type_value.closure, field);
     if (!env && type_or_inst.type_value.type_scope)
         env = snuk_scope_lookup(type_or_inst.type_value.type_scope, field);
-    return env;
+    return interpreter_resolve_env(intpret, env);
 }
 
 SNUK_INLINE SnukValue interpreter_get_member(SnukInterpreter *intpret, SnukValue type_or_inst, SnukStringView field) {
@@ -97,6 +126,7 @@ SNUK_INLINE bool interpreter_set_member(
 
 SNUK_INLINE void interpreter_trash(SnukInterpreter *intpret, SnukValue value) {
     snuk_darray_push(&intpret->trash, value);
+    SNUK_STATS_MAX(trash_peak, snuk_darray_get_length(intpret->trash));
 }
 
 SNUK_INLINE void interpreter_clear_trash(SnukInterpreter *intpret) {
@@ -105,5 +135,42 @@ SNUK_INLINE void interpreter_clear_trash(SnukInterpreter *intpret) {
     snuk_darray_clear(&intpret->trash);
 }
 
+/**
+ * @brief Position of a parameter in the closure scope of a function.
+ *
+ * @return The index, or the parameter count if there is no such parameter.
+ */
+SNUK_INLINE uint64_t interpreter_param_index(SnukScope *fn_scope, SnukStringView name) {
+    uint64_t count = snuk_darray_get_length(fn_scope->vars);
+    for (uint64_t i = 0; i < count; ++i)
+        if (snuk_string_view_equal(fn_scope->vars[i]->name, name)) return i;
+    return count;
+}
+
+/**
+ * @brief Receiver of a fast native called through a function value, the
+ * value wrapped by the instance it was read from or null. Borrowed.
+ *
+ * A method kept after its instance is gone has no receiver left, it reads
+ * as unknown like the lookup of a missing name.
+ */
+SNUK_INLINE SnukValue interpreter_fast_receiver(SnukValue fn) {
+    if (!fn.native_fn.instance) return (SnukValue){.type = SNUK_VALUE_NULL};
+    if (!snuk_ref_counter_get(fn.native_fn.instance)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    SnukEnv *env = snuk_scope_lookup(fn.native_fn.instance, value_str);
+    return env ? env->value : (SnukValue){.type = SNUK_VALUE_UNKOWN};
+}
+
 SnukValue execute_block_expr(
     SnukInterpreter *intpret, SnukExpr *block, int capture_signals, int propogate_signals, bool weak_ref);
+
+/**
+ * @brief Run the items of a block in the current scope, stopping at a
+ * captured or propagated signal. execute_block_expr without the scope.
+ */
+SnukValue interpreter_run_block(SnukInterpreter *intpret, SnukExpr *block, int capture_signals, int propogate_signals);
+
+SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item, bool weak_ref);
+
+SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
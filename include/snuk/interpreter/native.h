@@ -4,6 +4,7 @@
 #include "snuk/defines.h"
 #include "snuk/parser/snuk_type.h"
 #include "snuk/string_view.h"
+#include "snuk_buffer.h"
 #include "snuk_scope.h"
 #include "snuk_value.h"
 
@@ -15,7 +16,8 @@ typedef struct SnukParameter {
     SnukValue value;  // if build_value is null this one is used
 } SnukParameter;
 
-typedef SnukValue (*native_function_t)(SnukInterpreter *intpret);
+// Parameters a native_fast_function_t can take, the arguments live on the stack
+#define SNUK_NATIVE_MAX_ARGS 8
 
 typedef struct SnukTypeMember {
     const char *name;
@@ -32,16 +34,58 @@ SNUK_INLINE bool snuk_native_add_value(
     return true;
 }
 
+/**
+ * @brief Add a binding whose value is built by build on first access.
+ *
+ * Nothing is allocated for the value until a script reads the name.
+ */
+SNUK_INLINE bool snuk_native_add_lazy_value(
+    SnukInterpreter *intpret, const char *name, SnukType *type, build_value_t build, bool is_const) {
+    // TODO: constant
+    SNUK_UNUSED(is_const);
+    SnukEnv *env = snuk_env_create_lazy(snuk_string_view_create(name), type, build);
+    return snuk_scope_add_env(intpret->current, env);
+}
+
 SNUK_API SnukValue snuk_native_lookup(SnukInterpreter *intpret, const char *name);
 
 SNUK_API SnukValue snuk_native_get_member(SnukInterpreter *intpret, SnukValue type_or_inst, const char *name);
 
+/**
+ * @brief Call a script or native function with arguments matched to its
+ * parameters by name. For repeated calls, see SnukCallHandle.
+ *
+ * @return Value of the function, or SNUK_VALUE_UNKOWN if the arguments do
+ * not fit the parameters.
+ */
+SNUK_API SnukValue snuk_native_call_function(SnukInterpreter *intpret, SnukValue fn, SnukParameter *params, uint64_t count);
+
 SNUK_API SnukValue snuk_native_create_type(
     SnukInterpreter *intpret, SnukTypeMember *members, uint64_t count, bool weak_ref);
 
+/**
+ * @brief Create a type like snuk_native_create_type, but members with a
+ * build_value are only built when first accessed.
+ */
+SNUK_API SnukValue snuk_native_create_lazy_type(
+    SnukInterpreter *intpret, SnukTypeMember *members, uint64_t count, bool weak_ref);
+
 SNUK_API SnukValue snuk_native_create_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
                                          SnukType *fn_type, native_function_t fn, bool weak_ref);
 
+/**
+ * @brief Create a function like snuk_native_create_fn that is called with
+ * positional arguments instead of a scope to look them up in.
+ *
+ * Calls skip creating the scope and its bindings, and methods on ints,
+ * floats, bools, strings and generators skip wrapping the receiver in an
+ * instance. Parameter names and defaults still apply to named arguments.
+ *
+ * @param count Number of parameters, at most SNUK_NATIVE_MAX_ARGS.
+ */
+SNUK_API SnukValue snuk_native_create_fast_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
+                                              SnukType *fn_type, native_fast_function_t fn, bool weak_ref);
+
 SNUK_API SnukValue snuk_native_create_inst(
     SnukInterpreter *intpret, SnukType *type, SnukTypeMember *members, uint64_t count, bool weak_ref);
 
@@ -53,6 +97,17 @@ SNUK_API SnukValue snuk_native_create_bool(SnukInterpreter *intpret, bool value,
 
 SNUK_API SnukValue snuk_native_create_string(SnukInterpreter *intpret, const char *str, bool weak_ref);
 
+/**
+ * @brief Create a string that reads host memory in place, see SnukBuffer.
+ *
+ * @param bytes Host memory, not copied and without quotes.
+ * @param len Number of bytes.
+ * @param release Called once no value references the bytes, or NULL.
+ * @param data Passed to release.
+ */
+SNUK_API SnukValue snuk_native_create_buffer(SnukInterpreter *intpret, const char *bytes, uint64_t len,
+                                             SnukBufferReleaseFn release, void *data, bool weak_ref);
+
 SNUK_API SnukValue snuk_native_create_null(SnukInterpreter *intpret, bool weak_ref);
 
 SNUK_API SnukValue snuk_native_create_interface(SnukInterpreter *intpret, SnukType *interface, bool weak_ref);
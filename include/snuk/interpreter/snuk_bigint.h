@@ -0,0 +1,130 @@
+#pragma once
+
+#include "snuk/defines.h"
+#include "snuk/lexer.h"
+#include "snuk/refcount.h"
+#include "snuk_value.h"
+
+#define GET_BIGINT(rc) ((SnukBigInt *)snuk_ref_counter_get(rc))
+
+/**
+ * @brief Number of limbs from which multiplication switches from schoolbook to
+ * Karatsuba.
+ */
+#define SNUK_BIGINT_KARATSUBA_THRESHOLD 32
+
+/**
+ * @brief Immutable arbitrary-precision integer.
+ *
+ * Stored as sign and magnitude, limbs are little endian base 2^32 with no
+ * leading zero limbs. A bigint value never holds a number that fits in
+ * int64_t, results that fit are demoted back to SNUK_VALUE_INT.
+ */
+typedef struct SnukBigInt {
+    uint64_t len;
+    bool negative;
+    uint32_t limbs[];
+} SnukBigInt;
+
+/**
+ * @brief Checked int64_t addition.
+ *
+ * @return True if the result overflowed, res is unspecified then.
+ */
+SNUK_INLINE bool snuk_int_add_overflow(int64_t a, int64_t b, int64_t *res) {
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_add_overflow(a, b, res);
+#else
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return true;
+    *res = a + b;
+    return false;
+#endif
+}
+
+/**
+ * @brief Checked int64_t subtraction.
+ *
+ * @return True if the result overflowed, res is unspecified then.
+ */
+SNUK_INLINE bool snuk_int_sub_overflow(int64_t a, int64_t b, int64_t *res) {
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_sub_overflow(a, b, res);
+#else
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b)) return true;
+    *res = a - b;
+    return false;
+#endif
+}
+
+/**
+ * @brief Checked int64_t multiplication.
+ *
+ * @return True if the result overflowed, res is unspecified then.
+ */
+SNUK_INLINE bool snuk_int_mul_overflow(int64_t a, int64_t b, int64_t *res) {
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_mul_overflow(a, b, res);
+#else
+    if (a > 0) {
+        if (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a) return true;
+    } else if (a < 0) {
+        if (b > 0 ? a < INT64_MIN / b : (b != 0 && a < INT64_MAX / b)) return true;
+    }
+    *res = a * b;
+    return false;
+#endif
+}
+
+/**
+ * @brief Perform a binary operator on integer operands of arbitrary size.
+ *
+ * Both operands must be SNUK_VALUE_INT or SNUK_VALUE_BIGINT. Supports the
+ * arithmetic operators (+ - * / %) and comparisons. Division truncates toward
+ * zero like int64_t division.
+ *
+ * @param left Left operand, not consumed.
+ * @param right Right operand, not consumed.
+ * @param op Operator token.
+ *
+ * @return The result, demoted to SNUK_VALUE_INT when it fits, or
+ * SNUK_VALUE_UNKOWN for unsupported operators and division by zero.
+ */
+SNUK_API SnukValue snuk_bigint_binary_op(SnukValue left, SnukValue right, SnukTokenType op);
+
+/**
+ * @brief Negate an integer, promoting INT64_MIN to a bigint.
+ *
+ * @param value SNUK_VALUE_INT or SNUK_VALUE_BIGINT, consumed.
+ *
+ * @return The negated value.
+ */
+SNUK_API SnukValue snuk_bigint_negate(SnukValue value);
+
+/**
+ * @brief Upper bound on the characters needed to write a bigint in decimal.
+ *
+ * @param bigint Refcounted bigint.
+ *
+ * @return Buffer size for snuk_bigint_to_chars, including the sign.
+ */
+SNUK_API uint64_t snuk_bigint_max_chars(SnukRefCounter *bigint);
+
+/**
+ * @brief Write a bigint in decimal.
+ *
+ * @param bigint Refcounted bigint.
+ * @param buf Buffer of at least snuk_bigint_max_chars bytes, not null
+ * terminated.
+ *
+ * @return Number of characters written.
+ */
+SNUK_API uint64_t snuk_bigint_to_chars(SnukRefCounter *bigint, char *buf);
+
+/**
+ * @brief Convert a bigint to the nearest double.
+ *
+ * @param bigint Refcounted bigint.
+ *
+ * @return The converted value, may be infinity.
+ */
+SNUK_API double snuk_bigint_to_double(SnukRefCounter *bigint);
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "snuk/defines.h"
+#include "snuk/lexer.h"
+#include "snuk/refcount.h"
+#include "snuk_value.h"
+
+#define GET_BUFFER(rc) ((SnukBuffer *)snuk_ref_counter_get(rc))
+
+/**
+ * @brief Called once the last value referencing a host buffer is freed.
+ *
+ * @param data User data given with the buffer.
+ * @param bytes Start of the buffer.
+ * @param len Length of the buffer.
+ */
+typedef void (*SnukBufferReleaseFn)(void *data, const char *bytes, uint64_t len);
+
+/**
+ * @brief Host owned bytes read by scripts without copying.
+ *
+ * Buffer values are strings to scripts. Each one holds a strong reference to
+ * the buffer and a view into it, slicing only makes a new view. The host
+ * must keep the bytes unchanged until release is called.
+ */
+typedef struct SnukBuffer {
+    const char *bytes;
+    uint64_t len;
+    SnukBufferReleaseFn release;  // NULL when the host outlives every value
+    void *data;
+} SnukBuffer;
+
+/**
+ * @brief Create a buffer value viewing all of bytes.
+ *
+ * @param bytes Start of the host memory, not copied.
+ * @param len Number of bytes.
+ * @param release Called when the buffer is no longer referenced, or NULL.
+ * @param data Passed to release.
+ *
+ * @return Buffer value owning the only reference to the new buffer.
+ */
+SNUK_API SnukValue snuk_buffer_create(const char *bytes, uint64_t len, SnukBufferReleaseFn release, void *data);
+
+/**
+ * @brief View part of a buffer value without copying.
+ *
+ * @param value Buffer value, not consumed.
+ * @param start Offset into the view of value.
+ * @param len Number of bytes, start + len must not pass the end of value.
+ *
+ * @return Buffer value sharing the buffer of value.
+ */
+SNUK_API SnukValue snuk_buffer_slice(SnukValue value, uint64_t start, uint64_t len);
+
+/**
+ * @brief Characters of a string or buffer value, without the quotes of a
+ * string.
+ *
+ * @return False if value is neither.
+ */
+SNUK_INLINE bool snuk_buffer_contents(SnukValue value, SnukStringView *out) {
+    if (value.type == SNUK_VALUE_BUFFER) {
+        *out = value.buffer.view;
+        return true;
+    }
+    if (value.type != SNUK_VALUE_STRING) return false;
+
+    *out = snuk_string_view_create_with_len(value.string_value.str + 1, value.string_value.len - 2);
+    return true;
+}
+
+/**
+ * @brief Perform a binary operator where a buffer stands in for a string.
+ *
+ * Both operands must be SNUK_VALUE_STRING or SNUK_VALUE_BUFFER. Supports ==,
+ * != comparing characters and + which creates a new string.
+ *
+ * @param left Left operand, not consumed.
+ * @param right Right operand, not consumed.
+ * @param op Operator token.
+ *
+ * @return The result, or SNUK_VALUE_UNKOWN for unsupported operators.
+ */
+SNUK_API SnukValue snuk_buffer_binary_op(SnukValue left, SnukValue right, SnukTokenType op);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "interpreter.h"
+#include "snuk/defines.h"
+
+/**
+ * @brief Function prepared once for being called many times from the host.
+ *
+ * Preparing resolves which parameter each argument fills and which take
+ * their default, so a call only binds values. Script functions get a scope
+ * for their parameters and one for their body that are reused by the next
+ * call, unless something made by the call, such as a closure or a
+ * generator, still holds them.
+ */
+typedef struct SnukCallHandle {
+    SnukInterpreter *intpret; /**< Interpreter the function belongs to. */
+    SnukValue fn; /**< The function, kept alive by the handle. */
+    SnukRefCounter *closure; /**< Parameters of the function with their defaults. */
+    uint64_t argc; /**< Number of arguments every call passes. */
+    uint64_t param_count; /**< Number of parameters of the function. */
+    uint64_t *slots; /**< Argument index of each parameter, argc for its default. */
+    SnukRefCounter *instance; /**< Instance of a native method, or NULL. */
+    SnukEnv *receiver; /**< value member of instance, the receiver of a fast native. */
+    SnukRefCounter *params; /**< Reused scope of the parameters, NULL until the next call needs one. */
+    SnukRefCounter *locals; /**< Reused scope of the body, child of params. */
+} SnukCallHandle;
+
+/**
+ * @brief Prepare a function for calls with a fixed list of arguments.
+ *
+ * @param handle Handle to prepare, destroy it whatever the result.
+ * @param intpret Interpreter the function was created in.
+ * @param fn Script or native function, copied.
+ * @param names Parameter filled by each argument, or NULL to fill the first
+ * argc parameters in order.
+ * @param argc Number of arguments.
+ *
+ * @return false if fn is not a function or no longer alive, a name is
+ * unknown or repeated, or a parameter without a default is left out.
+ */
+SNUK_API bool snuk_call_handle_prepare(
+    SnukCallHandle *handle, SnukInterpreter *intpret, SnukValue fn, const char *const *names, uint64_t argc);
+
+/**
+ * @brief Call the function.
+ *
+ * Arguments are checked against the parameter types like a call in a
+ * script would, and are borrowed.
+ *
+ * @param handle Prepared handle.
+ * @param args handle->argc arguments, in the order given to prepare.
+ *
+ * @return Value of the function, owned by the caller, or SNUK_VALUE_UNKOWN
+ * if an argument has the wrong type.
+ */
+SNUK_API SnukValue snuk_call_handle_invoke(SnukCallHandle *handle, const SnukValue *args);
+
+/**
+ * @brief Release the function and the reused scopes.
+ *
+ * @param handle Handle to destroy, safe on a zeroed handle.
+ */
+SNUK_API void snuk_call_handle_destroy(SnukCallHandle *handle);
@@ -3,18 +3,27 @@
 #include "snuk/darray.h"
 #include "snuk/defines.h"
 #include "snuk/parser/snuk_type.h"
+#include "snuk/stats.h"
 #include "snuk/string_view.h"
 #include "snuk_value.h"
 
 typedef struct SnukEnv SnukEnv;
 
+typedef SnukValue (*SnukEnvBuildFn)(SnukInterpreter *intpret, bool weak_ref);
+
 /**
  * @brief Single name-to-value binding inside a scope.
+ *
+ * A lazy binding has build set and value SNUK_VALUE_UNKOWN until it is first
+ * resolved through interpreter_resolve_env. ast holds the AST region name and
+ * type point into when the binding can outlive the code that created it.
  */
 struct SnukEnv {
     SnukStringView name;
     SnukType *type;
     SnukValue value;
+    SnukEnvBuildFn build;
+    SnukRefCounter *ast;
 };
 
 /**
@@ -26,19 +35,39 @@ SNUK_INLINE SnukEnv *snuk_env_create(SnukStringView name, SnukType *type, SnukVa
         .name = name,
         .type = type,
         .value = snuk_value_copy(value),
+        .build = NULL,
+    };
+    SNUK_STATS_INC(envs_created);
+    return env;
+}
+
+/**
+ * @brief Allocate a lazy SnukEnv whose value is built on first access.
+ */
+SNUK_INLINE SnukEnv *snuk_env_create_lazy(SnukStringView name, SnukType *type, SnukEnvBuildFn build) {
+    SnukEnv *env = (SnukEnv *)snuk_alloc(sizeof(SnukEnv), alignof(SnukEnv));
+    *env = (SnukEnv){
+        .name = name,
+        .type = type,
+        .value = {.type = SNUK_VALUE_UNKOWN},
+        .build = build,
     };
+    SNUK_STATS_INC(envs_created);
     return env;
 }
 
 SNUK_INLINE void snuk_env_assign_value(SnukEnv *env, SnukValue value) {
     snuk_value_free(env->value);
     env->value = snuk_value_copy(value);
+    env->build = NULL;
 }
 
 SNUK_INLINE void snuk_env_free(SnukEnv *env) {
     if (!env) return;
 
     snuk_value_free(env->value);
+    if (env->ast) snuk_ref_counter_release(&env->ast);
 
     snuk_free(env);
+    SNUK_STATS_INC(envs_destroyed);
 }
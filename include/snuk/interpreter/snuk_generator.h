@@ -0,0 +1,114 @@
+#pragma once
+
+#include "snuk/darray.h"
+#include "snuk/defines.h"
+#include "snuk/parser/snuk_expr.h"
+#include "snuk/refcount.h"
+#include "snuk_value.h"
+
+#define GET_GENERATOR(rc) ((SnukGenerator *)snuk_ref_counter_get(rc))
+
+/**
+ * @brief Lifecycle of a generator.
+ */
+typedef enum SnukGeneratorState {
+    SNUK_GENERATOR_SUSPENDED, /**< Waiting to be resumed. */
+    SNUK_GENERATOR_RUNNING, /**< Body is executing. */
+    SNUK_GENERATOR_DONE, /**< Body finished, no more values. */
+} SnukGeneratorState;
+
+/**
+ * @brief Resume point inside a generator body.
+ *
+ * expr is either a block or a loop expression. Block frames record the next
+ * item to execute and the signals they capture, loop frames record the phase
+ * the loop is in. A frame that owns a scope pops it when the frame is popped.
+ */
+typedef struct SnukGeneratorFrame {
+    SnukExpr *expr;
+    uint64_t index;
+    int capture_signals;
+    uint8_t phase;
+    bool owns_scope;
+    SnukValue iterable;  // generator consumed by a for-in frame
+} SnukGeneratorFrame;
+
+/**
+ * @brief Produces the values of a native generator.
+ *
+ * @param intpret Interpreter state.
+ * @param state State given to snuk_generator_create_native.
+ * @param value Receives the next value, owned by the caller.
+ *
+ * @return False once there are no more values.
+ */
+typedef bool (*SnukGeneratorNativeFn)(SnukInterpreter *intpret, void *state, SnukValue *value);
+
+/**
+ * @brief Suspended call of a generator function.
+ *
+ * The body runs over an explicit frame stack instead of the C stack, so a
+ * suspended generator is just its frames and the innermost scope of the body.
+ * instance is held weakly, like the instance of a method value.
+ */
+typedef struct SnukGenerator {
+    SnukGeneratorFrame *frames;  // darray
+    SnukRefCounter *scope;
+    SnukRefCounter *instance;
+    SnukValue pending;  // value fetched ahead by snuk_generator_done
+    SnukGeneratorState state;
+    SnukGeneratorNativeFn native;  // set for native generators, which have no frames
+    void *native_state;
+    SnukValue source;  // value the native state reads from, freed with the generator
+    SnukRefCounter *ast;  // AST region of the body, held until it finishes
+} SnukGenerator;
+
+/**
+ * @brief Create a generator for a call of a generator function.
+ *
+ * Must be called with the call scope (parameters bound) as the interpreter's
+ * current scope. The body does not run until the generator is resumed.
+ *
+ * @param intpret Interpreter state.
+ * @param body Body block of the generator function.
+ *
+ * @return Generator value owning the new generator.
+ */
+SNUK_API SnukValue snuk_generator_create(SnukInterpreter *intpret, SnukExpr *body);
+
+/**
+ * @brief Create a generator whose values come from a C function.
+ *
+ * @param intpret Interpreter state.
+ * @param next Called for every value.
+ * @param state Passed to next, allocated with snuk_alloc and freed with the
+ * generator.
+ *
+ * @return Generator value owning the new generator.
+ */
+SNUK_API SnukValue snuk_generator_create_native(SnukInterpreter *intpret, SnukGeneratorNativeFn next, void *state);
+
+/**
+ * @brief Resume the generator and fetch the next yielded value.
+ *
+ * @param intpret Interpreter state.
+ * @param generator Refcounted generator to resume.
+ * @param value Receives the yielded value, owned by the caller. An error
+ * raised inside the body is returned as SNUK_VALUE_ERROR.
+ *
+ * @return False once the generator is exhausted.
+ */
+SNUK_API bool snuk_generator_next(SnukInterpreter *intpret, SnukRefCounter *generator, SnukValue *value);
+
+/**
+ * @brief Check whether the generator is exhausted.
+ *
+ * Runs the body up to the next yield if needed; the fetched value is kept
+ * and returned by the following snuk_generator_next.
+ *
+ * @param intpret Interpreter state.
+ * @param generator Refcounted generator to check.
+ *
+ * @return True if the generator has no more values.
+ */
+SNUK_API bool snuk_generator_done(SnukInterpreter *intpret, SnukRefCounter *generator);
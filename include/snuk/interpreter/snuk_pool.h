@@ -0,0 +1,99 @@
+#pragma once
+
+#include "snuk/defines.h"
+#include "snuk_program.h"
+
+/**
+ * @brief Worker threads that run scripts, each in an interpreter of its own.
+ *
+ * Every worker keeps its interpreter and parser arena warm between jobs and
+ * owns a queue of jobs. Submissions are spread over the queues, and a worker
+ * whose queue runs dry steals the newest job of another.
+ */
+typedef struct SnukPool SnukPool;
+
+/**
+ * @brief Result of a submitted job, filled in by the worker that ran it.
+ */
+typedef struct SnukFuture SnukFuture;
+
+/**
+ * @brief Start a pool of worker threads.
+ *
+ * Turns on snuk_memory_set_shared until the pool is destroyed, so create it
+ * while a single thread is running and run one pool at a time.
+ *
+ * @param threads Number of workers, at least one.
+ *
+ * @return The pool, or NULL if no worker could be started.
+ */
+SNUK_API SnukPool *snuk_pool_create(uint32_t threads);
+
+/**
+ * @brief Run every job still queued, then stop the workers.
+ *
+ * Futures stay valid and have to be destroyed on their own.
+ *
+ * @param pool Pool to destroy, or NULL.
+ */
+SNUK_API void snuk_pool_destroy(SnukPool *pool);
+
+/**
+ * @brief Queue a script given as source.
+ *
+ * Only ints, floats, bools, null and strings cross threads, other inputs
+ * are bound as null. Names and strings are copied, buffers as strings.
+ *
+ * @param pool Pool to run it on.
+ * @param src Source text, null terminated, copied.
+ * @param inputs Globals to bind first, can be NULL when count is 0.
+ * @param count Number of inputs.
+ *
+ * @return Future of the value of the last item, or of the first error.
+ */
+SNUK_API SnukFuture *
+    snuk_pool_submit(SnukPool *pool, const char *src, const SnukProgramInput *inputs, uint64_t count);
+
+/**
+ * @brief Queue a compiled program, skipping the parse.
+ *
+ * Items are only read while running, so one program can be submitted any
+ * number of times. It has to stay alive until the futures are done.
+ *
+ * @return Future of the value of the last item, or of the first error.
+ */
+SNUK_API SnukFuture *snuk_pool_submit_program(
+    SnukPool *pool, const SnukProgram *program, const SnukProgramInput *inputs, uint64_t count);
+
+/**
+ * @brief Queue a program loaded with snuk_image_load, see
+ * snuk_pool_submit_program. The image has to stay loaded until the futures
+ * are done.
+ */
+SNUK_API SnukFuture *
+    snuk_pool_submit_image(SnukPool *pool, const SnukImage *image, const SnukProgramInput *inputs, uint64_t count);
+
+/**
+ * @brief Check whether the job finished, without waiting.
+ */
+SNUK_API bool snuk_future_done(SnukFuture *future);
+
+/**
+ * @brief Wait for the job to finish.
+ *
+ * Results that cannot leave the interpreter, such as functions and
+ * instances, come back as null. A string points into the future.
+ *
+ * @param future Future of the job.
+ *
+ * @return Value of the last item, or SNUK_VALUE_ERROR when an item failed
+ * or the source did not parse.
+ */
+SNUK_API SnukValue snuk_future_wait(SnukFuture *future);
+
+/**
+ * @brief Wait for the job and release the future and its result.
+ *
+ * @param future Future to destroy, or NULL.
+ */
+SNUK_API void snuk_future_destroy(SnukFuture *future);
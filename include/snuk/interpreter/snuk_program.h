@@ -0,0 +1,75 @@
+#pragma once
+
+#include "interpreter.h"
+#include "snuk/arena.h"
+#include "snuk/defines.h"
+#include "snuk/parser/snuk_image.h"
+
+/**
+ * @brief Value bound as a global of a program before it runs.
+ */
+typedef struct SnukProgramInput {
+    const char *name; /**< Name of the global, null terminated. */
+    SnukValue value; /**< Bound with the any type. */
+} SnukProgramInput;
+
+/**
+ * @brief Program parsed once and run any number of times.
+ *
+ * A compiled program owns a copy of its source and the flat trees of its
+ * items. Running only reads the items, so one program can run in several
+ * interpreters at once, on any thread.
+ */
+typedef struct SnukProgram {
+    SnukItem **items; /**< Top-level items in source order. */
+    uint64_t item_count; /**< Number of top-level items. */
+    SnukArena arena; /**< Holds source and trees, empty when borrowed from an image. */
+} SnukProgram;
+
+/**
+ * @brief Parse a whole program.
+ *
+ * Parse errors are reported on stderr like snuk_image_compile does.
+ *
+ * @param program Program to compile into, destroy it whatever the result.
+ * @param src Source text, null terminated, copied.
+ * @param source_path Name used in error messages.
+ *
+ * @return true if every item parsed.
+ */
+SNUK_API bool snuk_program_compile(SnukProgram *program, const char *src, const char *source_path);
+
+/**
+ * @brief Release the trees and the source of a compiled program.
+ *
+ * @param program Program to destroy, safe on a zeroed or borrowed program.
+ */
+SNUK_API void snuk_program_destroy(SnukProgram *program);
+
+/**
+ * @brief Borrow the items of a loaded image as a program.
+ *
+ * The image has to stay loaded while the program is in use.
+ */
+SNUK_INLINE SnukProgram snuk_program_from_image(const SnukImage *image) {
+    return (SnukProgram){.items = image->items, .item_count = image->item_count};
+}
+
+/**
+ * @brief Bind the inputs and run every item in the current scope.
+ *
+ * Bindings of earlier runs stay visible, call snuk_interpreter_reset in
+ * between for a fresh global scope. An input that is already bound in the
+ * current scope gets the new value. Functions and types created by the run
+ * point into the program, so it has to outlive them.
+ *
+ * @param program Program to run.
+ * @param intpret Interpreter to run it in.
+ * @param inputs Globals to bind first, can be NULL when count is 0.
+ * @param count Number of inputs.
+ *
+ * @return Value of the last item, or the first SNUK_VALUE_ERROR, owned by
+ * the caller.
+ */
+SNUK_API SnukValue snuk_program_run(
+    const SnukProgram *program, SnukInterpreter *intpret, const SnukProgramInput *inputs, uint64_t count);
@@ -2,6 +2,7 @@
 
 #include "snuk/defines.h"
 #include "snuk/refcount.h"
+#include "snuk/stats.h"
 #include "snuk_env.h"
 
 #define GET_SCOPE(rc) ((SnukScope *)snuk_ref_counter_get(rc))
@@ -12,13 +13,18 @@ typedef struct SnukScope SnukScope;
 /**
  * @brief Lexical scope holding variable bindings and a parent reference.
  *
- * vars is a darray of owned SnukEnv pointers. parent is a refcounted handle
- * to the enclosing scope, or NULL for the global scope.
+ * vars is a darray of owned SnukEnv pointers, starting out in vars_storage
+ * so that scopes with few bindings need no second allocation. parent is a
+ * refcounted handle to the enclosing scope, or NULL for the global scope.
+ * Scopes of functions, types and instances hold the AST region they were
+ * created from, so it lives as long as they can run or name it.
  */
 struct SnukScope {
     SnukEnv **vars;  // darray
+    SNUK_DARRAY_INLINE_STORAGE(SnukEnv *, 4) vars_storage;
     SnukRefCounter *parent;
     bool weak_ref;
+    SnukRefCounter *ast;  // AST region of the code a closure scope runs, or NULL
 };
 
 SNUK_INLINE void snuk_scope_destroy_envs(SnukScope *scope) {
@@ -51,7 +57,10 @@ SNUK_INLINE void snuk_scope_destroy(void *data, void *ptr) {
         else snuk_ref_counter_release(&scope->parent);
     }
 
+    if (scope->ast) snuk_ref_counter_release(&scope->ast);
+
     snuk_free(scope);
+    SNUK_STATS_INC(scopes_destroyed);
 }
 
 /**
@@ -65,11 +74,11 @@ SNUK_INLINE void snuk_scope_destroy(void *data, void *ptr) {
  */
 SNUK_INLINE SnukRefCounter *snuk_scope_create(SnukRefCounter *parent, bool weak_ref) {
     SnukScope *scope = (SnukScope *)snuk_alloc(sizeof(SnukScope), alignof(SnukScope));
-    *scope = (SnukScope){
-        .vars = snuk_darray_create(SnukEnv *, NULL),
-        .parent = snuk_ref_counter_move(&parent),
-        .weak_ref = weak_ref,
-    };
+    scope->vars = snuk_darray_create_inline(&scope->vars_storage, SnukEnv *, NULL);
+    scope->parent = snuk_ref_counter_move(&parent);
+    scope->weak_ref = weak_ref;
+    scope->ast = NULL;
+    SNUK_STATS_INC(scopes_created);
     return snuk_ref_counter_create(scope, NULL, snuk_scope_destroy);
 }
 
@@ -12,9 +12,21 @@ typedef struct SnukInterpreter SnukInterpreter;
 
 typedef SnukValue (*native_function_t)(SnukInterpreter *intpret);
 
+/**
+ * @brief Native function called with its arguments in parameter order.
+ *
+ * receiver is the value a method was read from, such as the string of
+ * "abc".length(), and null for plain functions. Missing arguments hold
+ * their default. Receiver and arguments are borrowed, copy what is kept or
+ * returned.
+ */
+typedef SnukValue (*native_fast_function_t)(
+    SnukInterpreter *intpret, SnukValue receiver, const SnukValue *args, uint64_t argc);
+
 typedef enum SnukValueType {
     SNUK_VALUE_UNKOWN,
     SNUK_VALUE_INT,
+    SNUK_VALUE_BIGINT,
     SNUK_VALUE_FLOAT,
     SNUK_VALUE_BOOL,
     SNUK_VALUE_STRING,
@@ -24,6 +36,8 @@ typedef enum SnukValueType {
     SNUK_VALUE_TYPE,
     SNUK_VALUE_TYPE_INST,
     SNUK_VALUE_INTERFACE,
+    SNUK_VALUE_GENERATOR,
+    SNUK_VALUE_BUFFER,
     SNUK_VALUE_ERROR,
 
     SNUK_VALUE_MAX,
@@ -39,7 +53,12 @@ typedef enum SnukValueType {
  *
  * @note A function value holds a refcounted reference to its closure scope,
  * which keeps the captured bindings alive for as long as the function value
- * is reachable.
+ * is reachable. A generator value holds a refcounted SnukGenerator, the
+ * suspended frame of a generator function call. A bigint value holds a
+ * refcounted immutable SnukBigInt, produced when int arithmetic overflows.
+ * A buffer value holds a refcounted host SnukBuffer and the part of it the
+ * value views, scripts see it as a string. A string literal's value views the
+ * AST and holds its region in string_owner.
  */
 struct SnukValue {
     SnukValueType type;
@@ -48,7 +67,10 @@ struct SnukValue {
         int64_t int_value;
         double float_value;
         bool bool_value;
-        SnukStringView string_value;
+        struct {
+            SnukStringView string_value;
+            SnukRefCounter *string_owner;  // memory holding the characters, NULL when nothing needs to keep it
+        };
 
         struct {
             SnukRefCounter *instance;
@@ -56,12 +78,14 @@ struct SnukValue {
             bool weak_ref;
             SnukExpr *body;
             SnukType *type;
+            bool is_generator;
         } fn_value;
 
         struct {
             SnukRefCounter *instance;
             SnukRefCounter *closure;
-            native_function_t fn;
+            native_function_t fn;  // NULL when fast is set
+            native_fast_function_t fast;
             SnukType *type;
         } native_fn;
 
@@ -76,6 +100,14 @@ struct SnukValue {
             SnukType *type;
         } interface;
 
+        SnukRefCounter *generator;
+        SnukRefCounter *bigint;
+
+        struct {
+            SnukRefCounter *ref;
+            SnukStringView view;
+        } buffer;
+
         const char *err_msg;
     };
 };
@@ -96,9 +128,13 @@ SNUK_INLINE bool snuk_value_is_true(SnukValue value) {
             return value.float_value != 0;
         case SNUK_VALUE_STRING:
             return value.string_value.len != 0;
+        case SNUK_VALUE_BUFFER:  // same as the string it reads as, which always has its quotes
+            return true;
 
+        case SNUK_VALUE_BIGINT:  // never zero, zero fits in an int
         case SNUK_VALUE_FN:
         case SNUK_VALUE_TYPE:
+        case SNUK_VALUE_GENERATOR:
             return true;
 
         case SNUK_VALUE_TYPE_INST:
@@ -8,10 +8,28 @@ SNUK_API char *snuk_read_line(char *buffer, uint64_t size);
 // reads entire file, caller should free
 SNUK_API char *snuk_read_file(const char *path);
 
+// creates or truncates the file and writes len bytes to it
+SNUK_API bool snuk_write_file(const char *path, const void *data, uint64_t len);
+
+// maps entire file copy on write, writes never reach the file, NULL on failure
+SNUK_API void *snuk_map_file(const char *path, uint64_t *size);
+
+// unmaps memory from snuk_map_file
+SNUK_API void snuk_unmap_file(void *data, uint64_t size);
+
+// absolute form of an existing path, caller should free, NULL on failure
+SNUK_API char *snuk_absolute_path(const char *path);
+
 SNUK_API void snuk_print(const char *fmt, ...);
 
 SNUK_API void snuk_println(const char *fmt, ...);
 
+// writes len bytes to stdout as is
+SNUK_API void snuk_write(const char *data, uint64_t len);
+
+// flushes stdout
+SNUK_API void snuk_flush(void);
+
 // stderr, for error output
 SNUK_API void snuk_eprint(const char *fmt, ...);
 
@@ -43,6 +43,7 @@ typedef enum SnukTokenType {
     SNUK_TOKEN_RETURN,
     SNUK_TOKEN_BREAK,
     SNUK_TOKEN_CONTINUE,
+    SNUK_TOKEN_YIELD,
     SNUK_TOKEN_FN,
     SNUK_TOKEN_TYPE,
     SNUK_TOKEN_INTERFACE,
@@ -117,56 +118,74 @@ typedef enum SnukTokenType {
     SNUK_TOKEN_MAX,
 } SnukTokenType;
 
+/**
+ * @brief Value of a token that is more than its source text.
+ *
+ * int_literal for SNUK_TOKEN_INTEGER, float_literal for SNUK_TOKEN_FLOAT and
+ * err_msg for SNUK_TOKEN_ERROR.
+ */
+typedef union SnukTokenLiteral {
+    int64_t int_literal;
+    double float_literal;
+    const char *err_msg;
+} SnukTokenLiteral;
+
 /**
  * @brief Lexical token produced from Snuk source text.
  *
- * The token type selects which union member is meaningful: string_literal for
- * textual tokens and error context, int_literal for integer literals, and
- * float_literal for floating-point literals. The line and column fields record
- * the token start using zero-based source coordinates.
+ * Tokens only locate their text in the source. Numbers and errors keep their
+ * value in the lexer's literal table at index literal, and the line and
+ * column are worked out on demand with snuk_lexer_token_position.
  *
- * @note String views point into the source buffer owned by the caller.
+ * For strings the text includes the quotes, for comments it excludes the
+ * markers and for errors it is empty, at the place the error was found.
  */
 typedef struct SnukToken {
     SnukTokenType type;
-
-    union {
-        SnukStringView string_literal;
-        int64_t int_literal;
-        double float_literal;
-    };
-
-    const char *err_msg;
-
-    SnukStringView leading_comment;
-    SnukStringView trailing_comment;
-
-    uint64_t line, col;
+    uint32_t offset;  // of the text from the start of the source
+    uint32_t len;
+    uint32_t literal;  // index into the lexer's literals
 } SnukToken;
 
+SNUK_STATIC_ASSERT(sizeof(SnukToken) == 16, "Expected SnukToken to stay 16 bytes.");
+
 typedef struct ScopeDepth ScopeDepth;
+typedef struct SnukTokenTrivia SnukTokenTrivia;
+
+/**
+ * @brief What the lexer does with comments.
+ */
+typedef enum SnukLexerMode {
+    /** Attach comments to tokens and emit standalone comment tokens, for tooling. */
+    SNUK_LEXER_MODE_COMMENTS,
+    /** Skip comments entirely, they never reach the parser. */
+    SNUK_LEXER_MODE_EXECUTE,
+} SnukLexerMode;
 
 /**
  * @brief Mutable scanner state for a null-terminated Snuk source string.
  *
- * Tracks the original source, the current cursor, the current token start, and
- * zero-based line and column positions for both cursor and token start.
+ * Tracks the original source, the current cursor and the current token
+ * start. Positions are not tracked while scanning, newlines is filled the
+ * first time one is asked for.
  *
  * @note The source buffer must remain valid for the lifetime of the lexer.
  */
 typedef struct SnukLexer {
     const char *src;
+    const char *end;  // null terminator of src
 
     const char *cur;
     const char *token_start;
-    uint64_t token_start_line;
-    uint64_t token_start_col;
-
-    uint64_t line;
-    uint64_t col;
 
     SnukTokenType previous_token_type;
     ScopeDepth *sd;  // darray
+
+    SnukLexerMode mode;
+
+    SnukTokenLiteral *literals;  // darray
+    SnukTokenTrivia *trivia;  // darray, comments of tokens in SNUK_LEXER_MODE_COMMENTS
+    uint32_t *newlines;  // darray of newline offsets, NULL until needed
 } SnukLexer;
 
 /**
@@ -174,11 +193,12 @@ typedef struct SnukLexer {
  *
  * @param lexer Lexer state to initialize.
  * @param src Null-terminated source buffer to scan.
+ * @param mode Whether comments are kept or skipped.
  *
  * @note The source buffer is borrowed and must outlive all tokens produced by
- * the lexer.
+ * the lexer. Sources are limited to 4 GiB so offsets fit in 32 bits.
  */
-SNUK_API void snuk_lexer_init(SnukLexer *lexer, const char *src);
+SNUK_API void snuk_lexer_init(SnukLexer *lexer, const char *src, SnukLexerMode mode);
 
 /**
  * @brief Reset a lexer to an empty state.
@@ -190,7 +210,9 @@ SNUK_API void snuk_lexer_deinit(SnukLexer *lexer);
 /**
  * @brief Scan and return the next token from the lexer.
  *
- * Advances the lexer past leading whitespace and the returned token.
+ * Advances the lexer past leading whitespace and the returned token. In
+ * SNUK_LEXER_MODE_EXECUTE comments are skipped like whitespace, except that
+ * newlines inside block comments never end an item.
  *
  * @param lexer Lexer state to scan from.
  *
@@ -198,6 +220,71 @@ SNUK_API void snuk_lexer_deinit(SnukLexer *lexer);
  */
 SNUK_API SnukToken snuk_lexer_next_token(SnukLexer *lexer);
 
+/**
+ * @brief Scan up to count tokens into tokens.
+ *
+ * Stops early after the end-of-file token.
+ *
+ * @param lexer Lexer state to scan from.
+ * @param tokens Where to store the tokens.
+ * @param count Room in tokens, at least 1.
+ *
+ * @return Number of tokens stored.
+ */
+SNUK_API uint64_t snuk_lexer_next_tokens(SnukLexer *lexer, SnukToken *tokens, uint64_t count);
+
+/**
+ * @brief Get the source text of a token.
+ *
+ * @param lexer Lexer that produced the token.
+ * @param token The token.
+ *
+ * @return View into the source.
+ */
+SNUK_INLINE SnukStringView snuk_lexer_token_text(const SnukLexer *lexer, SnukToken token) {
+    return snuk_string_view_create_with_len(lexer->src + token.offset, token.len);
+}
+
+/**
+ * @brief Get the value of a number or error token.
+ *
+ * @param lexer Lexer that produced the token.
+ * @param token Token of type SNUK_TOKEN_INTEGER, SNUK_TOKEN_FLOAT or
+ * SNUK_TOKEN_ERROR.
+ *
+ * @return The literal.
+ */
+SNUK_INLINE SnukTokenLiteral snuk_lexer_token_literal(const SnukLexer *lexer, SnukToken token) {
+    return lexer->literals[token.literal];
+}
+
+/**
+ * @brief Work out the zero-based line and column a token starts at.
+ *
+ * The first call scans the whole source for newlines, later ones are a
+ * binary search. Meant for error reporting, the lexer itself never needs it.
+ *
+ * @param lexer Lexer that produced the token.
+ * @param token The token.
+ * @param line Where to store the line.
+ * @param col Where to store the column.
+ */
+SNUK_API void snuk_lexer_token_position(SnukLexer *lexer, SnukToken token, uint64_t *line, uint64_t *col);
+
+/**
+ * @brief Get the comments attached to a token.
+ *
+ * Only SNUK_LEXER_MODE_COMMENTS attaches comments, in the other modes both
+ * views are always empty.
+ *
+ * @param lexer Lexer that produced the token.
+ * @param token The token.
+ * @param leading Where to store the comment before the token.
+ * @param trailing Where to store the comment after it on the same line.
+ */
+SNUK_API void snuk_lexer_token_comments(
+    const SnukLexer *lexer, SnukToken token, SnukStringView *leading, SnukStringView *trailing);
+
 /**
  * @brief Convert a token type to a readable string.
  *
@@ -210,6 +297,7 @@ SNUK_API const char *snuk_lexer_token_type_to_string(SnukTokenType type);
 /**
  * @brief Log a token for debugging.
  *
+ * @param lexer Lexer that produced the token.
  * @param token Token to log.
  */
-SNUK_API void snuk_lexer_log_token(SnukToken token);
+SNUK_API void snuk_lexer_log_token(SnukLexer *lexer, SnukToken token);
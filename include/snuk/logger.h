@@ -4,21 +4,66 @@
 
 #include <snlogger/log_level.h>
 
+// Preprocessor visible mirrors of snLogLevel
+#define SNUK_LOG_LEVEL_TRACE 0
+#define SNUK_LOG_LEVEL_DEBUG 1
+#define SNUK_LOG_LEVEL_INFO 2
+#define SNUK_LOG_LEVEL_WARN 3
+#define SNUK_LOG_LEVEL_ERROR 4
+#define SNUK_LOG_LEVEL_FATAL 5
+
+// Calls below this level are compiled out, set by the build or defaulted here
+#if !defined(SNUK_LOG_LEVEL_MIN)
+    #if defined(SNUK_DEBUG)
+        #define SNUK_LOG_LEVEL_MIN SNUK_LOG_LEVEL_TRACE
+    #else
+        #define SNUK_LOG_LEVEL_MIN SNUK_LOG_LEVEL_INFO
+    #endif
+#endif
+
 SNUK_API void snuk_logger_init(void);
 SNUK_API void snuk_logger_deinit(void);
 
 SNUK_API void snuk_log_msg(
     snLogLevel level, const char *file, const char *function, long line, const char *format_string, ...);
 
-#define log_trace(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_TRACE, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
-#define log_debug(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_DEBUG, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
-#define log_info(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_INFO, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
-#define log_warn(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_WARN, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
-#define log_error(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_ERROR, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
-#define log_fatal(msg, ...)                                                            \
-    snuk_log_msg(SN_LOG_LEVEL_FATAL, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
+#define SNUK_LOG(level, msg, ...) snuk_log_msg(level, __FILE__, __func__, __LINE__, msg, ##__VA_ARGS__)
+
+// Arguments stay type checked and referenced, but nothing is emitted
+#define SNUK_LOG_DISABLED(level, msg, ...)         \
+    do {                                           \
+        if (0) SNUK_LOG(level, msg, ##__VA_ARGS__); \
+    } while (0)
+
+#if SNUK_LOG_LEVEL_MIN <= SNUK_LOG_LEVEL_TRACE
+    #define log_trace(msg, ...) SNUK_LOG(SN_LOG_LEVEL_TRACE, msg, ##__VA_ARGS__)
+#else
+    #define log_trace(msg, ...) SNUK_LOG_DISABLED(SN_LOG_LEVEL_TRACE, msg, ##__VA_ARGS__)
+#endif
+
+#if SNUK_LOG_LEVEL_MIN <= SNUK_LOG_LEVEL_DEBUG
+    #define log_debug(msg, ...) SNUK_LOG(SN_LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
+#else
+    #define log_debug(msg, ...) SNUK_LOG_DISABLED(SN_LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
+#endif
+
+#if SNUK_LOG_LEVEL_MIN <= SNUK_LOG_LEVEL_INFO
+    #define log_info(msg, ...) SNUK_LOG(SN_LOG_LEVEL_INFO, msg, ##__VA_ARGS__)
+#else
+    #define log_info(msg, ...) SNUK_LOG_DISABLED(SN_LOG_LEVEL_INFO, msg, ##__VA_ARGS__)
+#endif
+
+#if SNUK_LOG_LEVEL_MIN <= SNUK_LOG_LEVEL_WARN
+    #define log_warn(msg, ...) SNUK_LOG(SN_LOG_LEVEL_WARN, msg, ##__VA_ARGS__)
+#else
+    #define log_warn(msg, ...) SNUK_LOG_DISABLED(SN_LOG_LEVEL_WARN, msg, ##__VA_ARGS__)
+#endif
+
+#if SNUK_LOG_LEVEL_MIN <= SNUK_LOG_LEVEL_ERROR
+    #define log_error(msg, ...) SNUK_LOG(SN_LOG_LEVEL_ERROR, msg, ##__VA_ARGS__)
+#else
+    #define log_error(msg, ...) SNUK_LOG_DISABLED(SN_LOG_LEVEL_ERROR, msg, ##__VA_ARGS__)
+#endif
+
+// Fatal messages are never compiled out
+#define log_fatal(msg, ...) SNUK_LOG(SN_LOG_LEVEL_FATAL, msg, ##__VA_ARGS__)
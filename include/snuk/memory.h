@@ -41,6 +41,27 @@ SNUK_API bool snuk_memory_init(uint64_t reserve_size);
  */
 SNUK_API void snuk_memory_deinit(void);
 
+/**
+ * @brief Make the allocation functions safe to call from several threads.
+ *
+ * Off by default. Small blocks always come from per thread slab classes
+ * without a lock; while on, larger blocks, pages and new slab chunks take a
+ * spin lock. Only switch it while a single thread is running, before starting
+ * the others and after joining them. Arenas are not covered, each must stay
+ * with one thread. SNUK_STATS counters take atomic adds while on.
+ *
+ * @param shared true while more than one thread allocates.
+ */
+SNUK_API void snuk_memory_set_shared(bool shared);
+
+/**
+ * @brief Hand the calling thread's cached slab blocks back for other threads.
+ *
+ * Threads started with snuk_thread_create call it when their function
+ * returns, other threads that allocated should call it before exiting.
+ */
+SNUK_API void snuk_memory_thread_exit(void);
+
 /**
  * @brief Allocates a number of memory pages.
  *
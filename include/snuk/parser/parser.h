@@ -19,18 +19,43 @@
  */
 
 typedef struct SnukItem SnukItem;
+typedef struct SnukExpr SnukExpr;
+
+// Power of two, the lexer refills all but previous and current at once
+#define SNUK_PARSER_TOKEN_BUFFER_SIZE 64
+
+/**
+ * @brief Nodes of one fn body, or of a top level item, while it is parsed.
+ *
+ * Nodes refer to their children by distance, so the array can grow and be
+ * copied out as is. Anything outside it holding a node pointer registers the
+ * slot as a fixup, to be pointed at the copy.
+ */
+typedef struct SnukParserNodes {
+    SnukExpr *nodes; /**< Darray of nodes. */
+    SnukExpr ***fixups; /**< Darray of slots holding a node id until the copy. */
+} SnukParserNodes;
 
 /**
  * @brief Parser state for a single source buffer.
  */
 typedef struct SnukParser {
     SnukLexer lexer; /**< Lexer used to produce tokens. */
-    SnukToken previous; /**< previously consumed tokens. */
-    SnukToken current; /**< Current token. */
-    SnukToken next; /**< Next token. */
+    SnukToken tokens[SNUK_PARSER_TOKEN_BUFFER_SIZE]; /**< Ring buffer of lexed tokens. */
+    uint64_t token_index; /**< Position of current in the token stream. */
+    uint64_t token_count; /**< Number of tokens lexed so far. */
+    SnukToken *previous; /**< previously consumed tokens. */
+    SnukToken *current; /**< Current token. */
+    SnukToken *next; /**< Next token. */
 
     SnukAllocator *allocator;
 
+    SnukParserNodes *nodes; /**< Darray of node arrays, reused across items. */
+    uint64_t nodes_depth; /**< Number of node arrays in use. */
+
+    uint64_t fn_depth; /**< Nesting depth of fn bodies being parsed. */
+    bool yielded; /**< Set when the innermost fn body contains a yield. */
+
     bool panic_mode; /**< Error and recovery state flags. */
     const char *err_msg;
     SnukToken err_token;
@@ -44,13 +69,14 @@ typedef struct SnukParser {
  *
  * @param parser Parser context to initialize.
  * @param src Null-terminated source text to parse.
- * @param alloc_data User data passed to alloc.
- * @param alloc Allocation callback used for parser nodes.
+ * @param allocator Allocator for parser nodes.
+ * @param mode SNUK_LEXER_MODE_EXECUTE drops comments before they become
+ * tokens or nodes, SNUK_LEXER_MODE_COMMENTS keeps them for tooling.
  *
  * @note The source text must remain valid for the lifetime of parsed nodes that
  * reference token text.
  */
-SNUK_API void snuk_parser_init(SnukParser *parser, const char *src, SnukAllocator *allocator);
+SNUK_API void snuk_parser_init(SnukParser *parser, const char *src, SnukAllocator *allocator, SnukLexerMode mode);
 
 /**
  * @brief Deinitialize a parser context.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "parser.h"
+#include "snuk/darray.h"
 #include "snuk/defines.h"
 #include "snuk/logger.h"
 
@@ -9,6 +10,106 @@ typedef struct SnukExpr SnukExpr;
 typedef struct SnukType SnukType;
 typedef struct SnukVar SnukVar;
 
+/**
+ * @brief Position of a node in the node array being parsed, counting from 1.
+ *
+ * 0 stands for no node.
+ */
+typedef uint32_t SnukExprId;
+
+/**
+ * @brief Distance from a node to a node of the same array, 0 for none.
+ */
+typedef int32_t SnukExprRef;
+
+#define SNUK_EXPR_NONE ((SnukExprId)0)
+
+/**
+ * @brief Lex the next batch of tokens into the ring buffer.
+ *
+ * @param parser Parser context to operate on.
+ *
+ * @note Overwrites every slot but previous and current.
+ */
+void parser_fill_tokens(SnukParser *parser);
+
+/**
+ * @brief Start a node array for a fn body or a top level item.
+ *
+ * @param parser Parser context to operate on.
+ */
+void parser_begin_nodes(SnukParser *parser);
+
+/**
+ * @brief Copy the innermost node array out to the parser allocator.
+ *
+ * Points every fixup registered since parser_begin_nodes at the copy.
+ *
+ * @param parser Parser context to operate on.
+ * @param id Node to return the copy of.
+ *
+ * @return The copy of id, or NULL for SNUK_EXPR_NONE.
+ */
+SnukExpr *parser_end_nodes(SnukParser *parser, SnukExprId id);
+
+/**
+ * @brief Stand in for a node pointer until the node array is copied out.
+ *
+ * @param id The node.
+ *
+ * @return Value to store in the slot, NULL for SNUK_EXPR_NONE.
+ */
+SNUK_INLINE SnukExpr *parser_expr_handle(SnukExprId id) {
+    return (SnukExpr *)(uintptr_t)id;
+}
+
+/**
+ * @brief Have a slot holding a node handle pointed at the node once the node
+ * array is copied out.
+ *
+ * @param parser Parser context to operate on.
+ * @param slot Slot that stays put until then.
+ */
+SNUK_INLINE void parser_fixup_expr(SnukParser *parser, SnukExpr **slot) {
+    if (*slot) snuk_darray_push(&parser->nodes[parser->nodes_depth - 1].fixups, slot);
+}
+
+/**
+ * @brief Store a node in a slot outside the node array.
+ *
+ * @param parser Parser context to operate on.
+ * @param slot Slot that stays put until the node array is copied out.
+ * @param id The node.
+ */
+SNUK_INLINE void parser_bind_expr(SnukParser *parser, SnukExpr **slot, SnukExprId id) {
+    *slot = parser_expr_handle(id);
+    parser_fixup_expr(parser, slot);
+}
+
+/**
+ * @brief Get the source text of a token.
+ *
+ * @param parser Parser context to operate on.
+ * @param token Token from the parser.
+ *
+ * @return View into the source.
+ */
+SNUK_INLINE SnukStringView parser_token_text(SnukParser *parser, const SnukToken *token) {
+    return snuk_lexer_token_text(&parser->lexer, *token);
+}
+
+/**
+ * @brief Get the value of a number token.
+ *
+ * @param parser Parser context to operate on.
+ * @param token Token from the parser.
+ *
+ * @return The literal.
+ */
+SNUK_INLINE SnukTokenLiteral parser_token_literal(SnukParser *parser, const SnukToken *token) {
+    return snuk_lexer_token_literal(&parser->lexer, *token);
+}
+
 /**
  * @brief Advance to the next token.
  *
@@ -17,8 +118,11 @@ typedef struct SnukVar SnukVar;
 SNUK_INLINE void parser_advance(SnukParser *parser) {
     parser->previous = parser->current;
     parser->current = parser->next;
-    if (parser->current.type == SNUK_TOKEN_ERROR) parser_error(parser, "lexer error");
-    parser->next = snuk_lexer_next_token(&parser->lexer);
+    if (parser->current->type == SNUK_TOKEN_ERROR) parser_error(parser, "lexer error");
+
+    uint64_t next = ++parser->token_index + 1;
+    if (next == parser->token_count) parser_fill_tokens(parser);
+    parser->next = &parser->tokens[next & (SNUK_PARSER_TOKEN_BUFFER_SIZE - 1)];
 }
 
 /**
@@ -31,7 +135,7 @@ SNUK_INLINE void parser_advance(SnukParser *parser) {
  */
 SNUK_INLINE bool parser_check(SnukParser *parser, SnukTokenType expected) {
     // Does not consume
-    return parser->current.type == expected;
+    return parser->current->type == expected;
 }
 
 /**
@@ -43,7 +147,7 @@ SNUK_INLINE bool parser_check(SnukParser *parser, SnukTokenType expected) {
  * @return True when the next token matches expected.
  */
 SNUK_INLINE bool parser_check_next(SnukParser *parser, SnukTokenType expected) {
-    return parser->next.type == expected;
+    return parser->next->type == expected;
 }
 
 /**
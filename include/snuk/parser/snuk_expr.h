@@ -28,6 +28,7 @@ typedef enum SnukExprType {
     SNUK_EXPR_WHILE, /**< while loop expression. */
     SNUK_EXPR_DO_WHILE, /**< do-while loop expression. */
     SNUK_EXPR_FOR, /**< for loop expression. */
+    SNUK_EXPR_FOR_IN, /**< for-in loop expression. */
 
     SNUK_EXPR_FN, /**< Funtion expression */
     SNUK_EXPR_TYPE, /**< Type expression */
@@ -47,8 +48,51 @@ typedef enum SnukExprType {
     SNUK_EXPR_MAX, /**< Sentinel value for expression kinds. */
 } SnukExprType;
 
+/**
+ * @brief Rarely read parts of a fn expression.
+ */
+typedef struct SnukFnExpr {
+    SnukVar **params; /**< Darray of parameters. */
+    SnukExpr *body; /**< Body of function, in the fn's own node array. */
+    SnukStringView name; /**< Name in case of syntax sugar */
+    SnukType *type; /**< Type of the function */
+    bool is_generator; /**< Body contains a yield */
+} SnukFnExpr;
+
+/**
+ * @brief Rarely read parts of a type expression.
+ */
+typedef struct SnukTypeExpr {
+    SnukItem **members; /**< Dynamic array of members items in the type */
+    SnukStringView name; /**< Name in case of syntax sugar */
+    SnukType *type; /**< Type of the type */
+} SnukTypeExpr;
+
+/**
+ * @brief Rarely read parts of a type instance expression.
+ */
+typedef struct SnukTypeInstExpr {
+    SnukType *type; /**< Name of the type */
+    SnukStringView name; /**< Name in case of syntax sugar. */
+    SnukExprRef *init; /**< Darray of assignments to members, from the instance node. */
+} SnukTypeInstExpr;
+
+/**
+ * @brief Parts of a for loop that do not fit in its node.
+ */
+typedef struct SnukForExpr {
+    SnukItem *init; /**< Optional initializer. */
+    SnukExprRef condition; /**< Optional loop condition, from the loop node. */
+    SnukExprRef update; /**< Optional loop update, from the loop node. */
+    SnukExprRef body; /**< Loop body block, from the loop node. */
+} SnukForExpr;
+
 /**
  * @brief Parsed expression node.
+ *
+ * Nodes of a fn body sit in one array and find their children with
+ * snuk_expr_child. Anything bigger than two pointers goes to a record on the
+ * side, so the array stays dense.
  */
 struct SnukExpr {
     SnukExprType type; /**< Discriminant selecting the active expression payload. */
@@ -63,108 +107,163 @@ struct SnukExpr {
 
         struct {
             SnukTokenType op; /**< Unary operator token. */
-            SnukExpr *operand; /**< Unary operand expression. */
+            SnukExprRef operand; /**< Unary operand expression. */
         } unary;
 
         struct {
             SnukTokenType op; /**< Binary operator token. */
-            SnukExpr *left; /**< Left-hand operand expression. */
-            SnukExpr *right; /**< Right-hand operand expression. */
+            SnukExprRef left; /**< Left-hand operand expression. */
+            SnukExprRef right; /**< Right-hand operand expression. */
         } binary;
 
         struct {
-            SnukExpr *identifier; /**< Assignment target identifier
-                                     expression. */
-            SnukExpr *value; /**< Assigned value expression. */
+            SnukExprRef identifier; /**< Assignment target identifier
+                                       expression. */
+            SnukExprRef value; /**< Assigned value expression. */
         } assign;
 
         struct {
             SnukTokenType op; /**< Compound assignment token */
-            SnukExpr *identifier; /**< Assignment target identifier
-                                     expression. */
-            SnukExpr *value; /**< Assigned value expression. */
+            SnukExprRef identifier; /**< Assignment target identifier
+                                       expression. */
+            SnukExprRef value; /**< Assigned value expression. */
         } compound_assign;
 
         struct {
-            SnukExpr *condition; /**< Condition expression. */
-            SnukExpr *then_block; /**< Block expression to execute
-                                     on true condition */
-            SnukExpr *else_block; /**< Block expression to execute
-                                     on false condition */
+            SnukExprRef condition; /**< Condition expression. */
+            SnukExprRef then_block; /**< Block expression to execute
+                                       on true condition */
+            SnukExprRef else_block; /**< Block expression to execute
+                                       on false condition */
         } if_else;
 
         struct {
-            SnukExpr *value; /**< Value expression being matched. */
+            SnukExprRef value; /**< Value expression being matched. */
             // TODO:
         } match;
 
         struct {
-            SnukExpr *condition; /**< Loop condition expression. */
-            SnukExpr *body; /**< Loop body block. */
+            SnukExprRef condition; /**< Loop condition expression. */
+            SnukExprRef body; /**< Loop body block. */
         } while_loop;  // while, do while
 
-        struct {
-            SnukItem *init; /**< Optional initializer. */
-            SnukExpr *condition; /**< Optional loop condition
-                                    expression. */
-            SnukExpr *update; /**< Optional loop update expression. */
-            SnukExpr *body; /**< Loop body block. */
-        } for_loop;
+        SnukForExpr *for_loop;
 
         struct {
-            SnukVar **params; /**< Darray of parameters. */
-            SnukExpr *body; /**< Body of function */
-            SnukStringView name; /**< Name in case of syntax sugar */
-            SnukType *type; /**< Type of the function */
-        } fn_expr;
+            SnukExprRef iterable; /**< Expression producing the
+                                     generator to consume. */
+            SnukExprRef body; /**< Loop body block. */
+            SnukStringView *name; /**< Loop variable name. */
+        } for_in;
 
-        struct {
-            SnukItem **members; /**< Dynamic array of members items
-                                   in the type */
-            SnukStringView name; /**< Name in case of syntax sugar */
-            SnukType *type; /**< Type of the type */
-        } type_expr;
+        SnukFnExpr *fn_expr;
 
-        struct {
-            SnukType *type; /**< Name of the type */
-            SnukStringView name; /**< Name in case of syntax sugar. */
-            SnukExpr **init; /**< initial values of members */
-        } type_inst_expr;
+        SnukTypeExpr *type_expr;
+
+        SnukTypeInstExpr *type_inst_expr;
 
         SnukItem **block_items; /**< Dynamic array of items in the block. */
 
         struct {
-            SnukExpr *fn; /**< Expression to call */
-            SnukExpr **params; /**< Darray of call argument expressions. */
+            SnukExprRef fn; /**< Expression to call */
+            SnukExprRef *params; /**< Darray of call argument expressions. */
         } call;
 
         struct {
-            SnukExpr *type; /**< Type from which to access the
-                               field/member */
-            SnukExpr *field; /**< The field/member */
+            SnukExprRef type; /**< Type from which to access the
+                                 field/member */
+            SnukExprRef field; /**< The field/member */
         } member_access;
 
         struct {
-            SnukExpr **elements; /**< Darray of list elements */
+            SnukExprRef *elements; /**< Darray of list elements */
         } list;
     };
 };
 
-extern SnukExpr null_expr;
-extern SnukExpr self_expr;
+SNUK_STATIC_ASSERT(sizeof(SnukExpr) == 24, "expression nodes should stay three words");
+
+/**
+ * @brief Get a child of a node.
+ *
+ * @param expr The node.
+ * @param ref Reference stored in the node or its side record.
+ *
+ * @return The child, or NULL if there is none.
+ */
+SNUK_FORCE_INLINE SnukExpr *snuk_expr_child(const SnukExpr *expr, SnukExprRef ref) {
+    return ref ? (SnukExpr *)expr + ref : NULL;
+}
+
+/**
+ * @brief Get a node of the innermost node array.
+ *
+ * Only valid until the next node is created.
+ *
+ * @param parser Parser context to operate on.
+ * @param id The node, not SNUK_EXPR_NONE.
+ *
+ * @return The node.
+ */
+SNUK_INLINE SnukExpr *parser_expr(SnukParser *parser, SnukExprId id) {
+    return &parser->nodes[parser->nodes_depth - 1].nodes[id - 1];
+}
+
+/**
+ * @brief Reference a node from another node of the same array.
+ *
+ * @param from Node storing the reference.
+ * @param to Node referenced, or SNUK_EXPR_NONE.
+ *
+ * @return The reference.
+ */
+SNUK_INLINE SnukExprRef parser_expr_ref(SnukExprId from, SnukExprId to) {
+    return to ? (SnukExprRef)to - (SnukExprRef)from : 0;
+}
+
+/**
+ * @brief Turn a darray of nodes into references from a node, in place.
+ *
+ * @param from Node storing the references.
+ * @param ids Darray of nodes.
+ *
+ * @return The same darray, holding references.
+ */
+SNUK_INLINE SnukExprRef *parser_expr_refs(SnukExprId from, SnukExprId *ids) {
+    SnukExprRef *refs = (SnukExprRef *)ids;
+    uint64_t count = snuk_darray_get_length(ids);
+    for (uint64_t i = 0; i < count; ++i) refs[i] = parser_expr_ref(from, ids[i]);
+    return refs;
+}
+
+/**
+ * @brief Append an expression node to the innermost node array.
+ *
+ * @param parser Parser context to operate on.
+ *
+ * @return The new node, zeroed.
+ */
+SNUK_INLINE SnukExprId parser_create_expr(SnukParser *parser) {
+    SnukExpr **nodes = &parser->nodes[parser->nodes_depth - 1].nodes;
+    snuk_darray_push(nodes, (SnukExpr){0});
+    uint64_t count = snuk_darray_get_length(*nodes);
+    SNUK_ASSERT(count <= INT32_MAX, "too many expressions in one function");
+    return (SnukExprId)count;
+}
 
 /**
- * @brief Allocate an expression node.
+ * @brief Allocate a side record for a node.
  *
  * @param parser Parser context to operate on.
+ * @param size Size of the record.
+ * @param align Alignment of the record.
  *
- * @return Newly allocated expression storage.
+ * @return Newly allocated record storage.
  */
-SNUK_INLINE SnukExpr *parser_create_expr(SnukParser *parser) {
-    SnukExpr *expr = (SnukExpr *)parser->allocator->alloc(
-        parser->allocator->data, sizeof(SnukExpr), alignof(SnukExpr));
-    SNUK_ASSERT(expr, "allocator is full, increase memory size!");
-    return expr;
+SNUK_INLINE void *parser_create_expr_record(SnukParser *parser, uint64_t size, uint64_t align) {
+    void *record = parser->allocator->alloc(parser->allocator->data, size, align);
+    SNUK_ASSERT(record, "allocator is full, increase memory size!");
+    return record;
 }
 
 /**
@@ -174,13 +273,13 @@ SNUK_INLINE SnukExpr *parser_create_expr(SnukParser *parser) {
  *
  * @return Newly allocated comment expressoin.
  */
-SNUK_INLINE SnukExpr *build_comment_expr(SnukParser *parser, SnukToken comment_token) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
-        .type = comment_token.type == SNUK_TOKEN_BLOCK_COMMENT ? SNUK_EXPR_BLOCK_COMMENT : SNUK_EXPR_LINE_COMMENT,
-        .comment = parser_copy_string_view(parser, comment_token.string_literal),
+SNUK_INLINE SnukExprId build_comment_expr(SnukParser *parser, const SnukToken *comment_token) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
+        .type = comment_token->type == SNUK_TOKEN_BLOCK_COMMENT ? SNUK_EXPR_BLOCK_COMMENT : SNUK_EXPR_LINE_COMMENT,
+        .comment = parser_copy_string_view(parser, parser_token_text(parser, comment_token)),
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -190,9 +289,10 @@ SNUK_INLINE SnukExpr *build_comment_expr(SnukParser *parser, SnukToken comment_t
  *
  * @return Newly allocated null expression node.
  */
-SNUK_INLINE SnukExpr *build_null_expr(SnukParser *parser) {
-    SNUK_UNUSED(parser);
-    return &null_expr;
+SNUK_INLINE SnukExprId build_null_expr(SnukParser *parser) {
+    SnukExprId id = parser_create_expr(parser);
+    parser_expr(parser, id)->type = SNUK_EXPR_NULL;
+    return id;
 }
 
 /**
@@ -202,13 +302,13 @@ SNUK_INLINE SnukExpr *build_null_expr(SnukParser *parser) {
  *
  * @return Newly allocated boolean expression node.
  */
-SNUK_INLINE SnukExpr *build_bool_expr(SnukParser *parser) {
-    SnukExpr *bool_expr = parser_create_expr(parser);
-    *bool_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_bool_expr(SnukParser *parser) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_BOOL,
-        .bool_literal = parser->previous.type == SNUK_TOKEN_TRUE,
+        .bool_literal = parser->previous->type == SNUK_TOKEN_TRUE,
     };
-    return bool_expr;
+    return id;
 }
 
 /**
@@ -218,13 +318,14 @@ SNUK_INLINE SnukExpr *build_bool_expr(SnukParser *parser) {
  *
  * @return Newly allocated string literal expression node.
  */
-SNUK_INLINE SnukExpr *build_string_literal_expr(SnukParser *parser) {
-    SnukExpr *string_expr = parser_create_expr(parser);
-    *string_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_string_literal_expr(SnukParser *parser) {
+    SnukStringView literal = parser_copy_string_view(parser, parser_token_text(parser, parser->previous));
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_STRING,
-        .string_literal = parser_copy_string_view(parser, parser->previous.string_literal),
+        .string_literal = literal,
     };
-    return string_expr;
+    return id;
 }
 
 /**
@@ -234,13 +335,14 @@ SNUK_INLINE SnukExpr *build_string_literal_expr(SnukParser *parser) {
  *
  * @return Newly allocated identifier expression node.
  */
-SNUK_INLINE SnukExpr *build_identifier_expr(SnukParser *parser) {
-    SnukExpr *identifier = parser_create_expr(parser);
-    *identifier = (SnukExpr){
+SNUK_INLINE SnukExprId build_identifier_expr(SnukParser *parser) {
+    SnukStringView identifier = parser_copy_string_view(parser, parser_token_text(parser, parser->previous));
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_IDENTIFIER,
-        .identifier = parser_copy_string_view(parser, parser->previous.string_literal),
+        .identifier = identifier,
     };
-    return identifier;
+    return id;
 }
 
 /**
@@ -250,13 +352,13 @@ SNUK_INLINE SnukExpr *build_identifier_expr(SnukParser *parser) {
  *
  * @return Newly allocated integer literal expression node.
  */
-SNUK_INLINE SnukExpr *build_int_literal_expr(SnukParser *parser) {
-    SnukExpr *int_expr = parser_create_expr(parser);
-    *int_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_int_literal_expr(SnukParser *parser) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_INT,
-        .int_literal = parser->previous.int_literal,
+        .int_literal = parser_token_literal(parser, parser->previous).int_literal,
     };
-    return int_expr;
+    return id;
 }
 
 /**
@@ -266,13 +368,13 @@ SNUK_INLINE SnukExpr *build_int_literal_expr(SnukParser *parser) {
  *
  * @return Newly allocated floating-point literal expression node.
  */
-SNUK_INLINE SnukExpr *build_float_literal_expr(SnukParser *parser) {
-    SnukExpr *float_expr = parser_create_expr(parser);
-    *float_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_float_literal_expr(SnukParser *parser) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_FLOAT,
-        .float_literal = parser->previous.float_literal,
+        .float_literal = parser_token_literal(parser, parser->previous).float_literal,
     };
-    return float_expr;
+    return id;
 }
 
 /**
@@ -284,13 +386,13 @@ SNUK_INLINE SnukExpr *build_float_literal_expr(SnukParser *parser) {
  *
  * @return Newly allocated unary expression node.
  */
-SNUK_INLINE SnukExpr *build_unary_expr(SnukParser *parser, SnukTokenType op, SnukExpr *operand) {
-    SnukExpr *unary_expr = parser_create_expr(parser);
-    *unary_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_unary_expr(SnukParser *parser, SnukTokenType op, SnukExprId operand) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_UNARY,
-        .unary = {.op = op, .operand = operand},
+        .unary = {.op = op, .operand = parser_expr_ref(id, operand)},
     };
-    return unary_expr;
+    return id;
 }
 
 /**
@@ -303,13 +405,13 @@ SNUK_INLINE SnukExpr *build_unary_expr(SnukParser *parser, SnukTokenType op, Snu
  *
  * @return Newly allocated binary expression node.
  */
-SNUK_INLINE SnukExpr *build_binary_expr(SnukParser *parser, SnukTokenType op, SnukExpr *left, SnukExpr *right) {
-    SnukExpr *binary_expr = parser_create_expr(parser);
-    *binary_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_binary_expr(SnukParser *parser, SnukTokenType op, SnukExprId left, SnukExprId right) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_BINARY,
-        .binary = {.op = op, .left = left, .right = right},
+        .binary = {.op = op, .left = parser_expr_ref(id, left), .right = parser_expr_ref(id, right)},
     };
-    return binary_expr;
+    return id;
 }
 
 /**
@@ -321,13 +423,13 @@ SNUK_INLINE SnukExpr *build_binary_expr(SnukParser *parser, SnukTokenType op, Sn
  *
  * @return Newly allocated assignment expression node.
  */
-SNUK_INLINE SnukExpr *build_assign_expr(SnukParser *parser, SnukExpr *identifier, SnukExpr *value) {
-    SnukExpr *assign_expr = parser_create_expr(parser);
-    *assign_expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_assign_expr(SnukParser *parser, SnukExprId identifier, SnukExprId value) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_ASSIGN,
-        .assign = {.identifier = identifier, .value = value},
+        .assign = {.identifier = parser_expr_ref(id, identifier), .value = parser_expr_ref(id, value)},
     };
-    return assign_expr;
+    return id;
 }
 
 /**
@@ -340,14 +442,18 @@ SNUK_INLINE SnukExpr *build_assign_expr(SnukParser *parser, SnukExpr *identifier
  *
  * @return Newly allocated assignment expression node.
  */
-SNUK_INLINE SnukExpr *build_compound_assign_expr(
-    SnukParser *parser, SnukTokenType op, SnukExpr *identifier, SnukExpr *value) {
-    SnukExpr *compound = parser_create_expr(parser);
-    *compound = (SnukExpr){
+SNUK_INLINE SnukExprId build_compound_assign_expr(
+    SnukParser *parser, SnukTokenType op, SnukExprId identifier, SnukExprId value) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_COMPOUND_ASSIGN,
-        .compound_assign = {.op = op, .identifier = identifier, .value = value},
+        .compound_assign = {
+            .op = op,
+            .identifier = parser_expr_ref(id, identifier),
+            .value = parser_expr_ref(id, value),
+        },
     };
-    return compound;
+    return id;
 }
 
 /**
@@ -360,14 +466,18 @@ SNUK_INLINE SnukExpr *build_compound_assign_expr(
  *
  * @return Newly allocated if expression node.
  */
-SNUK_INLINE SnukExpr *
-    build_if_expr(SnukParser *parser, SnukExpr *condition, SnukExpr *then_block, SnukExpr *else_block) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId
+    build_if_expr(SnukParser *parser, SnukExprId condition, SnukExprId then_block, SnukExprId else_block) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_IF,
-        .if_else = {.condition = condition, .then_block = then_block, .else_block = else_block},
+        .if_else = {
+            .condition = parser_expr_ref(id, condition),
+            .then_block = parser_expr_ref(id, then_block),
+            .else_block = parser_expr_ref(id, else_block),
+        },
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -378,13 +488,13 @@ SNUK_INLINE SnukExpr *
  *
  * @return Newly allocated match expression node.
  */
-SNUK_INLINE SnukExpr *build_match_expr(SnukParser *parser, SnukExpr *value) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_match_expr(SnukParser *parser, SnukExprId value) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_MATCH,
-        .match = {.value = value},
+        .match = {.value = parser_expr_ref(id, value)},
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -396,13 +506,14 @@ SNUK_INLINE SnukExpr *build_match_expr(SnukParser *parser, SnukExpr *value) {
  *
  * @return Newly allocated while or do while expression node.
  */
-SNUK_INLINE SnukExpr *build_while_expr(SnukParser *parser, SnukExpr *condition, SnukExpr *body, bool is_do_while) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId
+    build_while_expr(SnukParser *parser, SnukExprId condition, SnukExprId body, bool is_do_while) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = is_do_while ? SNUK_EXPR_DO_WHILE : SNUK_EXPR_WHILE,
-        .while_loop = {.condition = condition, .body = body},
+        .while_loop = {.condition = parser_expr_ref(id, condition), .body = parser_expr_ref(id, body)},
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -416,14 +527,47 @@ SNUK_INLINE SnukExpr *build_while_expr(SnukParser *parser, SnukExpr *condition,
  *
  * @return Newly allocated for expression node.
  */
-SNUK_INLINE SnukExpr *build_for_expr(
-    SnukParser *parser, SnukItem *init, SnukExpr *condition, SnukExpr *update, SnukExpr *body) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_for_expr(
+    SnukParser *parser, SnukItem *init, SnukExprId condition, SnukExprId update, SnukExprId body) {
+    SnukForExpr *loop = parser_create_expr_record(parser, sizeof(SnukForExpr), alignof(SnukForExpr));
+    SnukExprId id = parser_create_expr(parser);
+    *loop = (SnukForExpr){
+        .init = init,
+        .condition = parser_expr_ref(id, condition),
+        .update = parser_expr_ref(id, update),
+        .body = parser_expr_ref(id, body),
+    };
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_FOR,
-        .for_loop = {.init = init, .condition = condition, .update = update, .body = body},
+        .for_loop = loop,
+    };
+    return id;
+}
+
+/**
+ * @brief Build an for-in expression node.
+ *
+ * @param parser Parser context to operate on.
+ * @param name Loop variable name.
+ * @param iterable Expression producing the generator to consume.
+ * @param body Block expression to execute.
+ *
+ * @return Newly allocated for-in expression node.
+ */
+SNUK_INLINE SnukExprId
+    build_for_in_expr(SnukParser *parser, SnukStringView name, SnukExprId iterable, SnukExprId body) {
+    SnukStringView *loop_name = parser_create_expr_record(parser, sizeof(SnukStringView), alignof(SnukStringView));
+    *loop_name = parser_copy_string_view(parser, name);
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
+        .type = SNUK_EXPR_FOR_IN,
+        .for_in = {
+            .iterable = parser_expr_ref(id, iterable),
+            .body = parser_expr_ref(id, body),
+            .name = loop_name,
+        },
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -431,20 +575,30 @@ SNUK_INLINE SnukExpr *build_for_expr(
  *
  * @param parser Parser context to operate on.
  * @param params Parameters of the fn expression.
- * @param body Block expression to execute.
+ * @param body Block expression to execute, already copied out of its node
+ * array.
  * @param name Name of function in case of syntax sugar.
  * @param type The type of function.
+ * @param is_generator True when the body contains a yield.
  *
  * @return Newly allocated fn expression node.
  */
-SNUK_INLINE SnukExpr *build_fn_expr(
-    SnukParser *parser, SnukVar **params, SnukExpr *body, SnukStringView name, SnukType *type) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_fn_expr(
+    SnukParser *parser, SnukVar **params, SnukExpr *body, SnukStringView name, SnukType *type, bool is_generator) {
+    SnukFnExpr *fn = parser_create_expr_record(parser, sizeof(SnukFnExpr), alignof(SnukFnExpr));
+    *fn = (SnukFnExpr){
+        .params = params,
+        .body = body,
+        .name = parser_copy_string_view(parser, name),
+        .type = type,
+        .is_generator = is_generator,
+    };
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_FN,
-        .fn_expr = {.params = params, .body = body, .name = parser_copy_string_view(parser, name), .type = type},
+        .fn_expr = fn,
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -457,14 +611,15 @@ SNUK_INLINE SnukExpr *build_fn_expr(
  *
  * @return Newly allocated type expression node.
  */
-SNUK_INLINE SnukExpr *
-    build_type_expr(SnukParser *parser, SnukItem **members, SnukStringView name, SnukType *type) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_type_expr(SnukParser *parser, SnukItem **members, SnukStringView name, SnukType *type) {
+    SnukTypeExpr *type_expr = parser_create_expr_record(parser, sizeof(SnukTypeExpr), alignof(SnukTypeExpr));
+    *type_expr = (SnukTypeExpr){.members = members, .name = parser_copy_string_view(parser, name), .type = type};
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_TYPE,
-        .type_expr = {.members = members, .name = parser_copy_string_view(parser, name), .type = type},
+        .type_expr = type_expr,
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -472,40 +627,48 @@ SNUK_INLINE SnukExpr *
  *
  * @param parser Parser context to operate on.
  * @param type The type of instance.
- * @param init Initialization values.
+ * @param init Darray of member assignments.
  * @param name Name in case of syntax sugar.
  *
  * @return Newly allocated type expression node.
  */
-SNUK_INLINE SnukExpr *
-    build_type_inst_expr(SnukParser *parser, SnukType *type, SnukExpr **init, SnukStringView name) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_type_inst_expr(SnukParser *parser, SnukType *type, SnukExprId *init, SnukStringView name) {
+    SnukTypeInstExpr *inst
+        = parser_create_expr_record(parser, sizeof(SnukTypeInstExpr), alignof(SnukTypeInstExpr));
+    SnukExprId id = parser_create_expr(parser);
+    *inst = (SnukTypeInstExpr){
+        .type = type,
+        .name = parser_copy_string_view(parser, name),
+        .init = parser_expr_refs(id, init),
+    };
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_TYPE_INST,
-        .type_inst_expr = {.type = type, .init = init, .name = parser_copy_string_view(parser, name)},
+        .type_inst_expr = inst,
     };
-    return expr;
+    return id;
 }
 
 /**
  * @brief Build an block expression node.
  *
  * @param parser Parser context to operate on.
- * @param expr Existing block expression to append to, or NULL to create one.
+ * @param id Existing block expression to append to, or SNUK_EXPR_NONE to
+ * create one.
  * @param item The item to append.
  *
  * @return Newly allocated block expression node.
  */
-SNUK_INLINE SnukExpr *build_block_expr(SnukParser *parser, SnukExpr *expr, SnukItem *item) {
-    if (!expr) {
-        expr = parser_create_expr(parser);
-        *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_block_expr(SnukParser *parser, SnukExprId id, SnukItem *item) {
+    if (!id) {
+        SnukItem **items = snuk_darray_create(SnukItem *, parser->allocator);
+        id = parser_create_expr(parser);
+        *parser_expr(parser, id) = (SnukExpr){
             .type = SNUK_EXPR_BLOCK,
-            .block_items = snuk_darray_create(SnukItem *, parser->allocator),
+            .block_items = items,
         };
     }
-    if (item) snuk_darray_push(&expr->block_items, item);
-    return expr;
+    if (item) snuk_darray_push(&parser_expr(parser, id)->block_items, item);
+    return id;
 }
 
 /**
@@ -513,17 +676,17 @@ SNUK_INLINE SnukExpr *build_block_expr(SnukParser *parser, SnukExpr *expr, SnukI
  *
  * @param parser Parser context to operate on.
  * @param fn Expression to call.
- * @param params The parameters.
+ * @param params Darray of arguments.
  *
  * @return Newly allocated call expression node.
  */
-SNUK_INLINE SnukExpr *build_call_expr(SnukParser *parser, SnukExpr *fn, SnukExpr **params) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_call_expr(SnukParser *parser, SnukExprId fn, SnukExprId *params) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_CALL,
-        .call = {.fn = fn, .params = params},
+        .call = {.fn = parser_expr_ref(id, fn), .params = parser_expr_refs(id, params)},
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -535,13 +698,13 @@ SNUK_INLINE SnukExpr *build_call_expr(SnukParser *parser, SnukExpr *fn, SnukExpr
  *
  * @return Newly allocated member access expression node.
  */
-SNUK_INLINE SnukExpr *build_member_access_expr(SnukParser *parser, SnukExpr *type, SnukExpr *field) {
-    SnukExpr *e = parser_create_expr(parser);
-    *e = (SnukExpr){
+SNUK_INLINE SnukExprId build_member_access_expr(SnukParser *parser, SnukExprId type, SnukExprId field) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_MEMBER,
-        .member_access = {.type = type, .field = field},
+        .member_access = {.type = parser_expr_ref(id, type), .field = parser_expr_ref(id, field)},
     };
-    return e;
+    return id;
 }
 
 /**
@@ -551,9 +714,10 @@ SNUK_INLINE SnukExpr *build_member_access_expr(SnukParser *parser, SnukExpr *typ
  *
  * @return Newly allocated self expression node.
  */
-SNUK_INLINE SnukExpr *build_self_expr(SnukParser *parser) {
-    SNUK_UNUSED(parser);
-    return &self_expr;
+SNUK_INLINE SnukExprId build_self_expr(SnukParser *parser) {
+    SnukExprId id = parser_create_expr(parser);
+    parser_expr(parser, id)->type = SNUK_EXPR_SELF;
+    return id;
 }
 
 /**
@@ -564,13 +728,13 @@ SNUK_INLINE SnukExpr *build_self_expr(SnukParser *parser) {
  *
  * @return Newly allocated list expression node.
  */
-SNUK_INLINE SnukExpr *build_list_expr(SnukParser *parser, SnukExpr **elements) {
-    SnukExpr *expr = parser_create_expr(parser);
-    *expr = (SnukExpr){
+SNUK_INLINE SnukExprId build_list_expr(SnukParser *parser, SnukExprId *elements) {
+    SnukExprId id = parser_create_expr(parser);
+    *parser_expr(parser, id) = (SnukExpr){
         .type = SNUK_EXPR_LIST,
-        .list = {.elements = elements},
+        .list = {.elements = parser_expr_refs(id, elements)},
     };
-    return expr;
+    return id;
 }
 
 /**
@@ -578,9 +742,9 @@ SNUK_INLINE SnukExpr *build_list_expr(SnukParser *parser, SnukExpr **elements) {
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-SnukExpr *snuk_expr_parse(SnukParser *parser);
+SnukExprId snuk_expr_parse(SnukParser *parser);
 
 /**
  * @brief Get a string name for an expression type.
@@ -597,4 +761,3 @@ const char *snuk_expr_type_to_string(SnukExprType type);
  * @param expr Expression to log.
  */
 void snuk_expr_log(SnukExpr *expr);
-
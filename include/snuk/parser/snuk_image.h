@@ -0,0 +1,68 @@
+#pragma once
+
+#include "snuk/defines.h"
+#include "snuk_item.h"
+
+#define SNUK_IMAGE_EXTENSION ".snukc"
+
+/**
+ * @brief Outcome of loading a compiled image.
+ */
+typedef enum SnukImageStatus {
+    SNUK_IMAGE_OK, /**< Loaded and ready to run. */
+    SNUK_IMAGE_UNREADABLE, /**< The file could not be opened or mapped. */
+    SNUK_IMAGE_INVALID, /**< Not an image, or written by an incompatible build. */
+    SNUK_IMAGE_STALE, /**< The source changed after the image was compiled. */
+    SNUK_IMAGE_NO_SOURCE, /**< Loaded and ready to run, but the source was not found to check it. */
+} SnukImageStatus;
+
+/**
+ * @brief Program loaded from a compiled image.
+ *
+ * The file is mapped copy on write and its pointers are relocated in place,
+ * so items point straight into the mapping. It has to stay loaded while any
+ * value or binding from the program is alive.
+ */
+typedef struct SnukImage {
+    void *mapping; /**< The mapped file. */
+    uint64_t size; /**< Size of the mapping. */
+    const char *source_path; /**< Absolute path of the source, empty if compiled without one. */
+    SnukItem **items; /**< Top-level items in source order. */
+    uint64_t item_count; /**< Number of top-level items. */
+} SnukImage;
+
+/**
+ * @brief Parse a whole program and write it as an image.
+ *
+ * Parse errors are reported on stderr and leave no file behind.
+ *
+ * @param src Source text, null terminated.
+ * @param source_path Path of the source, stored absolute for the staleness
+ * check, or "" to skip it.
+ * @param path Path of the image to write.
+ *
+ * @return true if the image was written.
+ */
+SNUK_API bool snuk_image_compile(const char *src, const char *source_path, const char *path);
+
+/**
+ * @brief Map an image and relocate it for execution.
+ *
+ * The source the image was compiled from has to hash to the one stored at
+ * compile time. A missing source is not an error so images can ship without
+ * it, but it is reported as SNUK_IMAGE_NO_SOURCE since freshness is unknown.
+ *
+ * @param image Image to load into, unload it whatever the status.
+ * @param path Path of the image.
+ *
+ * @return SNUK_IMAGE_OK or SNUK_IMAGE_NO_SOURCE, or why the image cannot run.
+ * source_path is set for those and SNUK_IMAGE_STALE.
+ */
+SNUK_API SnukImageStatus snuk_image_load(SnukImage *image, const char *path);
+
+/**
+ * @brief Unmap an image. Safe to call on a zeroed image.
+ *
+ * @param image Image to unload.
+ */
+SNUK_API void snuk_image_unload(SnukImage *image);
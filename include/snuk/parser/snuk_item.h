@@ -25,6 +25,8 @@ typedef enum SnukItemType {
     SNUK_ITEM_BREAK, /**< Transfer control out of loop, may carray value with
                         them. */
     SNUK_ITEM_CONTINUE, /**< Transfer control to next iteration. */
+    SNUK_ITEM_YIELD, /**< Suspend the enclosing generator, may carry value
+                        with them. */
 
     SNUK_ITEM_EXTEND, /**< extend types */
     SNUK_ITEM_INTERFACE, /**< interface */
@@ -42,7 +44,7 @@ struct SnukItem {
 
     union {
         SnukExpr *expr; /**< expression item payload (also used for
-                           return and break). */
+                           return, break and yield). */
         SnukVar *var;
         SnukExpr **print_exprs; /**< Dynamic array of expressions to print. */
 
@@ -59,6 +61,7 @@ struct SnukItem {
         struct {
             const char *msg;
             SnukToken token;
+            uint64_t line, col;
         } error;
     };
 };
@@ -87,12 +90,12 @@ SNUK_INLINE SnukItem *parser_create_item(SnukParser *parser) {
  *
  * @return Newly allocated expression item.
  */
-SNUK_INLINE SnukItem *build_expr_item(SnukParser *parser, SnukExpr *expr) {
+SNUK_INLINE SnukItem *build_expr_item(SnukParser *parser, SnukExprId expr) {
     SnukItem *item = parser_create_item(parser);
     *item = (SnukItem){
         .type = SNUK_ITEM_EXPR,
-        .expr = expr,
     };
+    parser_bind_expr(parser, &item->expr, expr);
     return item;
 }
 
@@ -119,11 +122,11 @@ SNUK_INLINE SnukItem *build_decl_item(SnukParser *parser, SnukVar *var, SnukItem
  *
  * @param parser Parser context to operate on.
  * @param type Token type for the control-flow keyword.
- * @param value Optional return value expression.
+ * @param value Optional return, break or yield value expression.
  *
  * @return Newly allocated control-flow item.
  */
-SNUK_INLINE SnukItem *build_flow_item(SnukParser *parser, SnukTokenType type, SnukExpr *value) {
+SNUK_INLINE SnukItem *build_flow_item(SnukParser *parser, SnukTokenType type, SnukExprId value) {
     if (type == SNUK_TOKEN_CONTINUE) return &continue_item;
 
     SnukItem *item = parser_create_item(parser);
@@ -131,19 +134,23 @@ SNUK_INLINE SnukItem *build_flow_item(SnukParser *parser, SnukTokenType type, Sn
         case SNUK_TOKEN_RETURN:
             *item = (SnukItem){
                 .type = SNUK_ITEM_RETURN,
-                .expr = value,
             };
             break;
         case SNUK_TOKEN_BREAK:
             *item = (SnukItem){
                 .type = SNUK_ITEM_BREAK,
-                .expr = value,
+            };
+            break;
+        case SNUK_TOKEN_YIELD:
+            *item = (SnukItem){
+                .type = SNUK_ITEM_YIELD,
             };
             break;
         default:
             SNUK_SHOULD_NOT_REACH_HERE;
             break;
     }
+    parser_bind_expr(parser, &item->expr, value);
     return item;
 }
 
@@ -155,8 +162,10 @@ SNUK_INLINE SnukItem *build_flow_item(SnukParser *parser, SnukTokenType type, Sn
  * @param expr Expression to append.
  *
  * @return Print item.
+ *
+ * @note The expressions need parser_fixup_expr once the last is appended.
  */
-SNUK_INLINE SnukItem *build_print_item(SnukParser *parser, SnukItem *item, SnukExpr *expr) {
+SNUK_INLINE SnukItem *build_print_item(SnukParser *parser, SnukItem *item, SnukExprId expr) {
     if (!item) {
         item = parser_create_item(parser);
         *item = (SnukItem){
@@ -164,7 +173,7 @@ SNUK_INLINE SnukItem *build_print_item(SnukParser *parser, SnukItem *item, SnukE
             .print_exprs = snuk_darray_create(SnukExpr *, parser->allocator),
         };
     }
-    if (expr) snuk_darray_push(&item->print_exprs, expr);
+    if (expr) snuk_darray_push(&item->print_exprs, parser_expr_handle(expr));
     return item;
 }
 
@@ -176,7 +185,7 @@ SNUK_INLINE SnukItem *build_print_item(SnukParser *parser, SnukItem *item, SnukE
  *
  * @return Extend item.
  */
-SNUK_INLINE SnukItem *build_extend_item(SnukParser *parser, SnukItem *item, SnukExpr *type, SnukItem *member) {
+SNUK_INLINE SnukItem *build_extend_item(SnukParser *parser, SnukItem *item, SnukExprId type, SnukItem *member) {
     if (!item) {
         item = parser_create_item(parser);
         *item = (SnukItem){
@@ -186,7 +195,7 @@ SNUK_INLINE SnukItem *build_extend_item(SnukParser *parser, SnukItem *item, Snuk
             },
         };
     }
-    if (type) item->extend_item.type = type;
+    if (type) parser_bind_expr(parser, &item->extend_item.type, type);
     if (member) snuk_darray_push(&item->extend_item.members, member);
     return item;
 }
@@ -214,6 +223,8 @@ SNUK_INLINE SnukItem *build_interface_item(SnukParser *parser, SnukStringView na
 /*
  * @brief Build a error item.
  *
+ * Works out the position of the token, the only place the parser needs one.
+ *
  * @param parser Parser context to operate on.
  * @param msg The message
  * @param token The token
@@ -229,6 +240,7 @@ SNUK_INLINE SnukItem *build_error_item(SnukParser *parser, const char *msg, Snuk
             .token = token,
         },
     };
+    snuk_lexer_token_position(&parser->lexer, token, &item->error.line, &item->error.col);
     return item;
 }
 
@@ -31,8 +31,9 @@ struct SnukType {
     };
 };
 
-extern SnukType any_type;
-extern SnukType type_type;
+// Singletons every parser and interpreter points at, never written after startup
+SNUK_API extern SnukType any_type;
+SNUK_API extern SnukType type_type;
 
 bool snuk_type_equal(SnukType *type1, SnukType *type2);
 
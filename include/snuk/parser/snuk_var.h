@@ -27,13 +27,13 @@ SNUK_INLINE SnukVar *parser_create_var(SnukParser *parser) {
  *
  * @return Newly allocated var node.
  */
-SNUK_INLINE SnukVar *build_var(SnukParser *parser, SnukStringView name, SnukType *type, SnukExpr *value) {
+SNUK_INLINE SnukVar *build_var(SnukParser *parser, SnukStringView name, SnukType *type, SnukExprId value) {
     SnukVar *var = parser_create_var(parser);
     *var = (SnukVar){
         .name = parser_copy_string_view(parser, name),
         .type = type,
-        .value = value,
     };
+    parser_bind_expr(parser, &var->value, value);
     return var;
 }
 
@@ -3,6 +3,7 @@
 #include "defines.h"
 #include "logger.h"
 #include "memory.h"
+#include "stats.h"
 
 // free_fn must free `mem` and any owned resources.
 // It must NOT free the refcounter itself.
@@ -27,6 +28,7 @@ SNUK_INLINE SnukRefCounter *snuk_ref_counter_create(void *mem, void *data, SnukR
         .data = data,
         .free_fn = free_fn,
     };
+    SNUK_STATS_INC(refcounters_created);
     log_debug("created a ref counter", NULL);
     return rc;
 }
@@ -36,6 +38,12 @@ SNUK_INLINE void *snuk_ref_counter_get(SnukRefCounter *rc) {
     return rc->mem;
 }
 
+// Strong and weak references together, 1 when the caller holds the only one
+SNUK_INLINE uint64_t snuk_ref_counter_count(SnukRefCounter *rc) {
+    SNUK_ASSERT(rc, "SnukRefCounter is null");
+    return rc->strong_count + rc->weak_count;
+}
+
 SNUK_INLINE SnukRefCounter *snuk_ref_counter_retain(SnukRefCounter *rc) {
     SNUK_ASSERT(rc, "SnukRefCounter is null");
     if (!rc->strong_count) return NULL;
@@ -63,6 +71,7 @@ SNUK_INLINE void snuk_ref_counter_release(SnukRefCounter **rc) {
 
     if ((*rc)->strong_count + (*rc)->weak_count == 0) {
         snuk_free(*rc);
+        SNUK_STATS_INC(refcounters_destroyed);
         log_debug("a ref counter got destroyed", NULL);
     }
 
@@ -77,6 +86,7 @@ SNUK_INLINE void snuk_ref_counter_release_weak(SnukRefCounter **rc) {
 
     if ((*rc)->strong_count + (*rc)->weak_count == 0) {
         snuk_free(*rc);
+        SNUK_STATS_INC(refcounters_destroyed);
         log_debug("a ref counter got destroyed", NULL);
     }
 
@@ -114,3 +114,72 @@ SNUK_INLINE char *snuk_string_concat(const char *a, uint64_t alen, const char *b
 
     return new;
 }
+
+/**
+ * @brief Find the first occurrence of a byte.
+ *
+ * Scans 16 or 32 bytes at a time with SSE2 or AVX2 when the target has them,
+ * falls back to a scalar loop otherwise.
+ *
+ * @param s String to search, need not be null terminated.
+ * @param len Length of s.
+ * @param c Byte to find.
+ *
+ * @return Pointer to the first match or NULL.
+ */
+SNUK_API const char *snuk_string_find_byte(const char *s, uint64_t len, char c);
+
+/**
+ * @brief Find the last occurrence of a byte.
+ *
+ * Vectorized like snuk_string_find_byte, scanning from the end.
+ *
+ * @param s String to search, need not be null terminated.
+ * @param len Length of s.
+ * @param c Byte to find.
+ *
+ * @return Pointer to the last match or NULL.
+ */
+SNUK_API const char *snuk_string_find_last_byte(const char *s, uint64_t len, char c);
+
+/**
+ * @brief Count the occurrences of a byte.
+ *
+ * Vectorized like snuk_string_find_byte.
+ *
+ * @param s String to search, need not be null terminated.
+ * @param len Length of s.
+ * @param c Byte to count.
+ *
+ * @return Number of occurrences.
+ */
+SNUK_API uint64_t snuk_string_count_byte(const char *s, uint64_t len, char c);
+
+/**
+ * @brief Find the first occurrence of needle in haystack.
+ *
+ * Candidates are filtered on the first and last byte of needle a vector at a
+ * time and only the survivors are compared in full.
+ *
+ * @param haystack String to search, need not be null terminated.
+ * @param haystack_len Length of haystack.
+ * @param needle String to find.
+ * @param needle_len Length of needle, an empty needle matches at haystack.
+ *
+ * @return Pointer to the first match or NULL.
+ */
+SNUK_API const char *snuk_string_find(
+    const char *haystack, uint64_t haystack_len, const char *needle, uint64_t needle_len);
+
+/**
+ * @brief Count non-overlapping occurrences of needle in haystack.
+ *
+ * @param haystack String to search, need not be null terminated.
+ * @param haystack_len Length of haystack.
+ * @param needle String to count.
+ * @param needle_len Length of needle, an empty needle counts as 0.
+ *
+ * @return Number of occurrences.
+ */
+SNUK_API uint64_t snuk_string_count(
+    const char *haystack, uint64_t haystack_len, const char *needle, uint64_t needle_len);
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "defines.h"
+#include "thread.h"
+
+/**
+ * @brief Allocators whose traffic is counted separately.
+ */
+typedef enum SnukStatsAllocator {
+    SNUK_STATS_ALLOCATOR_SLAB, /**< snuk_alloc up to 256 bytes, size-class slabs. */
+    SNUK_STATS_ALLOCATOR_GLOBAL, /**< snuk_alloc, the freelist heap. */
+    SNUK_STATS_ALLOCATOR_PAGES, /**< snuk_allocate_pages, backing the arenas. */
+    SNUK_STATS_ALLOCATOR_ARENA, /**< Parser arenas holding the ASTs. */
+
+    SNUK_STATS_ALLOCATOR_MAX,
+} SnukStatsAllocator;
+
+/**
+ * @brief Traffic through one allocator.
+ *
+ * reserved is the memory currently backing the allocator: the committed
+ * chunks of the slabs, the heap size of the global allocator, the committed
+ * pages of the page allocator and the chunks of the arenas. Arena chunks come
+ * from the global allocator and count under both. live counts bytes handed out and not freed yet, only the slabs
+ * know block sizes on free; live_peak against reserved_peak is their
+ * fragmentation.
+ */
+typedef struct SnukAllocatorStats {
+    uint64_t allocations;  // reallocations included
+    uint64_t frees;
+    uint64_t bytes;  // requested, summed over every allocation
+    uint64_t live;
+    uint64_t live_peak;
+    uint64_t reserved;
+    uint64_t reserved_peak;
+} SnukAllocatorStats;
+
+/**
+ * @brief Runtime counters, process wide.
+ *
+ * Counting is compiled in with SNUK_STATS, without it every counter stays
+ * zero. Each site adds to the counter in place, with an atomic add while
+ * snuk_memory_set_shared is on so threads counting at once lose nothing.
+ */
+typedef struct SnukStats {
+    uint64_t refcounters_created;
+    uint64_t refcounters_destroyed;
+    uint64_t scopes_created;
+    uint64_t scopes_destroyed;
+    uint64_t envs_created;
+    uint64_t envs_destroyed;
+    uint64_t trash_peak;  // most values waiting in the trash at once
+    uint64_t arena_high_water;  // most bytes in use in one arena at once
+
+    SnukAllocatorStats allocators[SNUK_STATS_ALLOCATOR_MAX];
+
+    uint64_t peak_rss;  // bytes, sampled by snuk_stats_get
+} SnukStats;
+
+/**
+ * @brief Live counters, read them through snuk_stats_get.
+ */
+SNUK_API extern SnukStats snuk_stats;
+
+/**
+ * @brief Set by snuk_memory_set_shared while several threads may count.
+ */
+SNUK_API extern bool snuk_stats_shared;
+
+/**
+ * @brief Add n to a counter.
+ *
+ * @return The new value.
+ */
+SNUK_INLINE uint64_t snuk_stats_add(uint64_t *counter, uint64_t n) {
+    if (snuk_stats_shared) return snuk_atomic_fetch_add_relaxed(counter, n) + n;
+
+    // No other thread counts, skip the lock prefix
+    uint64_t value = snuk_atomic_load_relaxed(counter) + n;
+    snuk_atomic_store_relaxed(counter, value);
+    return value;
+}
+
+/**
+ * @brief Raise a peak to n if it is lower.
+ */
+SNUK_INLINE void snuk_stats_max(uint64_t *peak, uint64_t n) {
+    if (snuk_stats_shared) snuk_atomic_max_relaxed(peak, n);
+    else if (n > snuk_atomic_load_relaxed(peak)) snuk_atomic_store_relaxed(peak, n);
+}
+
+#if defined(SNUK_STATS)
+    #define SNUK_STATS_ADD(field, n) ((void)snuk_stats_add(&snuk_stats.field, (n)))
+    #define SNUK_STATS_MAX(field, n) snuk_stats_max(&snuk_stats.field, (n))
+    // Add n to field and raise peak to the sum
+    #define SNUK_STATS_ADD_PEAK(field, peak, n) snuk_stats_max(&snuk_stats.peak, snuk_stats_add(&snuk_stats.field, (n)))
+#else
+    #define SNUK_STATS_ADD(field, n) ((void)0)
+    #define SNUK_STATS_MAX(field, n) ((void)0)
+    #define SNUK_STATS_ADD_PEAK(field, peak, n) ((void)0)
+#endif
+
+#define SNUK_STATS_INC(field) SNUK_STATS_ADD(field, 1)
+
+/**
+ * @brief Count an allocation of size bytes.
+ */
+#define SNUK_STATS_ALLOC(allocator, size)                              \
+    do {                                                               \
+        SNUK_STATS_INC(allocators[allocator].allocations);             \
+        SNUK_STATS_ADD(allocators[allocator].bytes, (uint64_t)(size)); \
+    } while (0)
+
+/**
+ * @brief Move the memory backing an allocator by delta bytes, negative to
+ * shrink it.
+ */
+#define SNUK_STATS_RESERVE(allocator, delta) \
+    SNUK_STATS_ADD_PEAK(allocators[allocator].reserved, allocators[allocator].reserved_peak, (uint64_t)(delta))
+
+/**
+ * @brief Copy the counters and sample the peak resident set size.
+ *
+ * @param stats Receives the counters.
+ */
+SNUK_API void snuk_stats_get(SnukStats *stats);
+
+/**
+ * @brief Zero every counter, keeping live and reserved memory.
+ *
+ * Peaks restart from the current live and reserved sizes.
+ */
+SNUK_API void snuk_stats_reset(void);
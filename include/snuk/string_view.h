@@ -72,3 +72,25 @@ SNUK_INLINE bool snuk_string_view_equal_cstr(SnukStringView a, const char *b) {
 SNUK_INLINE bool snuk_string_view_equal_cstr_ignore_case(SnukStringView a, const char *b) {
     return snuk_string_view_equal_ignore_case(a, snuk_string_view_create(b));
 }
+
+SNUK_INLINE bool snuk_string_view_starts_with(SnukStringView view, SnukStringView prefix) {
+    if (prefix.len > view.len) return false;
+    if (prefix.len == 0) return true;
+
+    return memcmp(view.str, prefix.str, prefix.len) == 0;
+}
+
+// Returns a view into the same memory, nothing is copied.
+SNUK_INLINE SnukStringView snuk_string_view_trim(SnukStringView view) {
+    while (view.len && snuk_is_white_space(view.str[0])) {
+        view.str++;
+        view.len--;
+    }
+    while (view.len && snuk_is_white_space(view.str[view.len - 1])) view.len--;
+    return view;
+}
+
+// Returns NULL if not found, see snuk_string_find.
+SNUK_INLINE const char *snuk_string_view_find(SnukStringView view, SnukStringView needle) {
+    return snuk_string_find(view.str, view.len, needle.str, needle.len);
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "defines.h"
+
+#if defined(SNUK_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+/**
+ * @brief Opaque handle of a running thread.
+ */
+typedef struct SnukThread SnukThread;
+
+/**
+ * @brief Entry point of a thread.
+ */
+typedef void (*SnukThreadFn)(void *arg);
+
+/**
+ * @brief Start a thread running fn(arg).
+ *
+ * @param fn Entry point.
+ * @param arg Passed to fn.
+ *
+ * @return Handle to join, or NULL if the thread could not be started.
+ */
+SNUK_API SnukThread *snuk_thread_create(SnukThreadFn fn, void *arg);
+
+/**
+ * @brief Wait for a thread to finish and release its handle.
+ *
+ * @param thread Handle from snuk_thread_create.
+ */
+SNUK_API void snuk_thread_join(SnukThread *thread);
+
+/**
+ * @brief Put the calling thread to sleep.
+ *
+ * @param ms Milliseconds to sleep.
+ */
+SNUK_API void snuk_thread_sleep_ms(uint64_t ms);
+
+/**
+ * @brief Let another thread run, for waits that are expected to be short.
+ */
+SNUK_API void snuk_thread_yield(void);
+
+// Sequentially consistent atomics on 64 bit words, shared between threads
+// through volatile pointers.
+
+SNUK_INLINE uint64_t snuk_atomic_load(volatile uint64_t *ptr) {
+#if defined(SNUK_COMPILER_MSVC)
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#endif
+}
+
+SNUK_INLINE void snuk_atomic_store(volatile uint64_t *ptr, uint64_t value) {
+#if defined(SNUK_COMPILER_MSVC)
+    _InterlockedExchange64((volatile __int64 *)ptr, (__int64)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+SNUK_INLINE uint64_t snuk_atomic_fetch_add(volatile uint64_t *ptr, uint64_t value) {
+#if defined(SNUK_COMPILER_MSVC)
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, (__int64)value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Replace *ptr with desired if it equals *expected.
+ *
+ * @return True on success, otherwise *expected receives the current value.
+ */
+SNUK_INLINE bool snuk_atomic_compare_exchange(volatile uint64_t *ptr, uint64_t *expected, uint64_t desired) {
+#if defined(SNUK_COMPILER_MSVC)
+    uint64_t previous = (uint64_t)_InterlockedCompareExchange64(
+        (volatile __int64 *)ptr, (__int64)desired, (__int64)*expected);
+    if (previous == *expected) return true;
+    *expected = previous;
+    return false;
+#else
+    return __atomic_compare_exchange_n(ptr, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Relaxed atomics for counters that only have to add up, they order nothing
+// else around them.
+
+SNUK_INLINE uint64_t snuk_atomic_load_relaxed(volatile uint64_t *ptr) {
+#if defined(SNUK_COMPILER_MSVC)
+    return (uint64_t)__iso_volatile_load64((volatile __int64 *)ptr);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#endif
+}
+
+SNUK_INLINE void snuk_atomic_store_relaxed(volatile uint64_t *ptr, uint64_t value) {
+#if defined(SNUK_COMPILER_MSVC)
+    __iso_volatile_store64((volatile __int64 *)ptr, (__int64)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+#endif
+}
+
+SNUK_INLINE uint64_t snuk_atomic_fetch_add_relaxed(volatile uint64_t *ptr, uint64_t value) {
+#if defined(SNUK_COMPILER_MSVC)
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, (__int64)value);
+#else
+    return __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+ * @brief Raise *ptr to value if it is lower.
+ */
+SNUK_INLINE void snuk_atomic_max_relaxed(volatile uint64_t *ptr, uint64_t value) {
+    uint64_t current = snuk_atomic_load_relaxed(ptr);
+    while (current < value) {
+#if defined(SNUK_COMPILER_MSVC)
+        uint64_t previous = (uint64_t)_InterlockedCompareExchange64(
+            (volatile __int64 *)ptr, (__int64)value, (__int64)current);
+        if (previous == current) return;
+        current = previous;
+#else
+        if (__atomic_compare_exchange_n(ptr, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
+#endif
+    }
+}
+
+/**
+ * @brief Spin on a zero initialized word until it is ours, yielding between
+ * tries. For short critical sections only.
+ */
+SNUK_INLINE void snuk_spin_lock(volatile uint64_t *lock) {
+    uint64_t expected = 0;
+    while (!snuk_atomic_compare_exchange(lock, &expected, 1)) {
+        expected = 0;
+        snuk_thread_yield();
+    }
+}
+
+SNUK_INLINE void snuk_spin_unlock(volatile uint64_t *lock) {
+    snuk_atomic_store(lock, 0);
+}
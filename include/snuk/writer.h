@@ -0,0 +1,122 @@
+#pragma once
+
+#include "defines.h"
+#include "memory.h"
+
+#include <string.h>
+
+/**
+ * @brief Default size of the output buffer.
+ */
+#define SNUK_WRITER_DEFAULT_CAPACITY KIB(64)
+
+/**
+ * @brief Characters needed for any int64_t, including the sign.
+ */
+#define SNUK_FORMAT_INT_MAX_CHARS 20
+
+/**
+ * @brief Characters needed for any double written by snuk_format_float.
+ */
+#define SNUK_FORMAT_FLOAT_MAX_CHARS 32
+
+/**
+ * @brief When a writer hands its buffer to stdout.
+ */
+typedef enum SnukFlushPolicy {
+    SNUK_FLUSH_ON_FULL, /**< Only when the buffer is full and on deinit. */
+    SNUK_FLUSH_ON_NEWLINE, /**< Also after every write containing a newline. */
+    SNUK_FLUSH_ALWAYS, /**< After every write, for unbuffered output. */
+} SnukFlushPolicy;
+
+/**
+ * @brief Buffered writer to stdout.
+ *
+ * Collects output in memory and writes it out with a single call per flush,
+ * instead of one formatted stdio call per value.
+ */
+typedef struct SnukWriter {
+    char *buffer;
+    uint64_t len;
+    uint64_t capacity;
+    SnukFlushPolicy policy;
+} SnukWriter;
+
+/**
+ * @brief Initialize a writer with an empty buffer.
+ *
+ * @param writer Writer to initialize.
+ * @param capacity Buffer size in bytes.
+ * @param policy When to flush.
+ */
+SNUK_API void snuk_writer_init(SnukWriter *writer, uint64_t capacity, SnukFlushPolicy policy);
+
+/**
+ * @brief Flush pending output and release the buffer.
+ *
+ * @param writer Writer to release.
+ */
+SNUK_API void snuk_writer_deinit(SnukWriter *writer);
+
+/**
+ * @brief Change the flush policy, flushing pending output first.
+ *
+ * @param writer Writer to change.
+ * @param policy New policy.
+ */
+SNUK_API void snuk_writer_set_policy(SnukWriter *writer, SnukFlushPolicy policy);
+
+/**
+ * @brief Write out everything buffered so far.
+ *
+ * @param writer Writer to flush.
+ */
+SNUK_API void snuk_writer_flush(SnukWriter *writer);
+
+/**
+ * @brief Append bytes to the buffer.
+ *
+ * @param writer Writer to append to.
+ * @param data Bytes to write, need not be null terminated.
+ * @param len Number of bytes.
+ */
+SNUK_API void snuk_writer_write(SnukWriter *writer, const char *data, uint64_t len);
+
+/**
+ * @brief Append an int in decimal.
+ */
+SNUK_API void snuk_writer_write_int(SnukWriter *writer, int64_t value);
+
+/**
+ * @brief Append a float, see snuk_format_float.
+ */
+SNUK_API void snuk_writer_write_float(SnukWriter *writer, double value);
+
+SNUK_INLINE void snuk_writer_write_cstr(SnukWriter *writer, const char *str) {
+    snuk_writer_write(writer, str, strlen(str));
+}
+
+/**
+ * @brief Write an int in decimal.
+ *
+ * @param value Value to write.
+ * @param buf Buffer of at least SNUK_FORMAT_INT_MAX_CHARS bytes, not null
+ * terminated.
+ *
+ * @return Number of characters written.
+ */
+SNUK_API uint64_t snuk_format_int(int64_t value, char *buf);
+
+/**
+ * @brief Write the shortest decimal that reads back as the same double.
+ *
+ * Integral values keep a trailing ".0" so they read as floats, large and
+ * small magnitudes use exponent notation.
+ *
+ * @param value Value to write.
+ * @param buf Buffer of at least SNUK_FORMAT_FLOAT_MAX_CHARS bytes, not null
+ * terminated.
+ *
+ * @return Number of characters written.
+ */
+SNUK_API uint64_t snuk_format_float(double value, char *buf);
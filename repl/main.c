@@ -3,7 +3,9 @@
 #include <snuk/io.h>
 #include <snuk/logger.h>
 #include <snuk/memory.h>
+#include <snuk/parser/snuk_image.h>
 #include <snuk/snuk_string.h>
+#include <snuk/stats.h>
 
 #define PROMPT_STR ">>> "
 #define LINE_BUFFER_SIZE 1024
@@ -12,6 +14,7 @@ typedef enum OpMode {
     OP_MODE_FILE,
     OP_MODE_REPL,
     OP_MODE_COMMAND,
+    OP_MODE_COMPILE,
     OP_MODE_QUIT,
 } OpMode;
 
@@ -20,11 +23,20 @@ static OpMode parse_args(int argc, char *argv[], char **data);
 static void run_repl(void);
 static void run_file(const char *path);
 static void run_command(const char *command);
+static void run_image(const char *path);
+static void run_compile(const char *path);
+static void runtime_set_flush_policy(Runtime *rt, SnukFlushPolicy buffered);
 
 static void print_help(void);
 static void print_version(void);
+static void print_stats(void);
 
 static char *program_name;
+static bool unbuffered = false;
+static bool stats = false;
+static bool pipelined = false;
+static const char *output_path = NULL;
+static int exit_code = 0;
 
 int main(int argc, char *argv[]) {
     snuk_logger_init();
@@ -53,15 +65,22 @@ int main(int argc, char *argv[]) {
             run_command(data);
             break;
 
+        case OP_MODE_COMPILE:
+            log_info("Compiling the file: %s", data);
+            run_compile(data);
+            break;
+
         case OP_MODE_QUIT:
         default:
             break;
     }
 
+    if (stats) print_stats();
+
     snuk_memory_deinit();
     snuk_logger_deinit();
 
-    return 0;
+    return exit_code;
 }
 
 static inline bool is_option(const char *opt, const char *short_opt, const char *long_opt) {
@@ -87,19 +106,37 @@ OpMode parse_args(int argc, char *argv[], char **data) {
         } else if (is_option(argv[i], "-v", "--version")) {
             print_version();
             return OP_MODE_QUIT;
+        } else if (is_option(argv[i], "-u", "--unbuffered")) {
+            unbuffered = true;
+        } else if (snuk_string_equal(argv[i], "--stats")) {
+            stats = true;
+        } else if (is_option(argv[i], "-p", "--pipelined")) {
+            pipelined = true;
+        } else if (i == 1 && snuk_string_equal(argv[i], "compile")) {
+            if (++i >= argc) {
+                snuk_eprintln("FILE to compile is not given");
+                exit_code = 1;
+                return OP_MODE_QUIT;
+            }
+            *data = argv[i];
+            if (i + 2 < argc && is_option(argv[i + 1], "-o", "--output")) output_path = argv[i + 2];
+            return OP_MODE_COMPILE;
         } else {
             *data = argv[i];
             return OP_MODE_FILE;
         }
     }
 
-    return OP_MODE_QUIT;
+    // Only options were given
+    return OP_MODE_REPL;
 }
 
 void run_repl(void) {
     char *line_buffer = (char *)snuk_alloc(LINE_BUFFER_SIZE, alignof(char));
     Runtime rt;
     snuk_runtime_init(&rt);
+    // Results show up before the next prompt
+    runtime_set_flush_policy(&rt, SNUK_FLUSH_ON_NEWLINE);
 
     const char *line;
     do {
@@ -112,7 +149,18 @@ void run_repl(void) {
     snuk_println("Bye!");
 }
 
+// Images are picked by extension, anything else is source
+static bool is_image_path(const char *path) {
+    uint64_t len = snuk_string_length(path), ext_len = sizeof(SNUK_IMAGE_EXTENSION) - 1;
+    return len > ext_len && snuk_string_equal(path + len - ext_len, SNUK_IMAGE_EXTENSION);
+}
+
 void run_file(const char *path) {
+    if (is_image_path(path)) {
+        run_image(path);
+        return;
+    }
+
     const char *content = snuk_read_file(path);
     if (!content) {
         log_error("couldn't read file", NULL);
@@ -121,6 +169,8 @@ void run_file(const char *path) {
 
     Runtime rt;
     snuk_runtime_init(&rt);
+    runtime_set_flush_policy(&rt, SNUK_FLUSH_ON_FULL);
+    rt.pipelined = pipelined;
 
     snuk_runtime_execute_file(&rt, content);
 
@@ -132,10 +182,76 @@ void run_file(const char *path) {
 static void run_command(const char *command) {
     Runtime rt;
     snuk_runtime_init(&rt);
+    runtime_set_flush_policy(&rt, SNUK_FLUSH_ON_FULL);
+    rt.pipelined = pipelined;
     snuk_runtime_execute_file(&rt, command);
     snuk_runtime_deinit(&rt);
 }
 
+static void run_image(const char *path) {
+    SnukImage image;
+    switch (snuk_image_load(&image, path)) {
+        case SNUK_IMAGE_NO_SOURCE:
+            snuk_eprintln("%s: source %s not found, running the image unchecked", path, image.source_path);
+            // fall through
+        case SNUK_IMAGE_OK: {
+            Runtime rt;
+            snuk_runtime_init(&rt);
+            runtime_set_flush_policy(&rt, SNUK_FLUSH_ON_FULL);
+            snuk_runtime_execute_items(&rt, image.items, image.item_count);
+            // Values can point into the image until the interpreter is gone
+            snuk_runtime_deinit(&rt);
+            break;
+        }
+
+        case SNUK_IMAGE_STALE:
+            snuk_eprintln("%s is older than %s, running the source", path, image.source_path);
+            run_file(image.source_path);
+            break;
+
+        case SNUK_IMAGE_INVALID:
+            snuk_eprintln("%s is not an image this snuk can run, compile it again", path);
+            exit_code = 1;
+            break;
+
+        case SNUK_IMAGE_UNREADABLE:
+        default:
+            log_error("couldn't read file", NULL);
+            break;
+    }
+    snuk_image_unload(&image);
+}
+
+// Writes next to the source unless -o is given, file.snuk becomes file.snukc
+static void run_compile(const char *path) {
+    const char *content = snuk_read_file(path);
+    if (!content) {
+        snuk_eprintln("%s: couldn't read file", path);
+        exit_code = 1;
+        return;
+    }
+
+    char *default_output = NULL;
+    if (!output_path) {
+        uint64_t len = snuk_string_length(path);
+        bool is_source = len > 5 && snuk_string_equal(path + len - 5, ".snuk");
+        default_output = is_source ? snuk_string_concat(path, len, "c", 1)
+                                   : snuk_string_concat(path, len, SNUK_IMAGE_EXTENSION,
+                                                        sizeof(SNUK_IMAGE_EXTENSION) - 1);
+        output_path = default_output;
+    }
+
+    if (!snuk_image_compile(content, path, output_path)) exit_code = 1;
+
+    if (default_output) snuk_free(default_output);
+    snuk_free((void *)content);
+}
+
+// --unbuffered overrides the policy of the mode
+static void runtime_set_flush_policy(Runtime *rt, SnukFlushPolicy buffered) {
+    snuk_writer_set_policy(&rt->interpreter.output, unbuffered ? SNUK_FLUSH_ALWAYS : buffered);
+}
+
 static void print_help(void) {
     snuk_println(
         "snuk - snuk interpreter\n"
@@ -143,16 +259,55 @@ static void print_help(void) {
         "USAGE:\n"
         "snuk               luanch as REPL\n"
         "snuk file.snuk     runs the file\n"
+        "snuk compile file.snuk [-o file.snukc]\n"
+        "                   parses the file once into an image that runs\n"
+        "                   without parsing, snuk file.snukc runs it\n"
         "if multiple files are given, they will be ignored. Only first file "
         "gets executed."
         "\n"
         "ARGS:\n"
         "-v | --version                 print the version\n"
         "-h | --help                    print this help message and exit\n"
-        "-c | --command \"COMMAND\"     executes the given command and exits\n",
+        "-c | --command \"COMMAND\"     executes the given command and exits\n"
+        "-u | --unbuffered              write output as soon as it is printed\n"
+        "-p | --pipelined               parse files on a second thread while they run\n"
+        "--stats                        print runtime counters to stderr on exit\n",
         SNUK_VERSION_MAJOR, SNUK_VERSION_MINOR, SNUK_VERSION_PATCH);
 }
 
 static void print_version(void) {
     snuk_println("Snuk version: %d.%d.%d", SNUK_VERSION_MAJOR, SNUK_VERSION_MINOR, SNUK_VERSION_PATCH);
 }
+
+// Summary on stderr so it never mixes with program output
+static void print_stats(void) {
+    SnukStats s;
+    snuk_stats_get(&s);
+
+    const char *allocator_names[] = {"slab", "global", "pages", "arena"};
+    SNUK_STATIC_ASSERT(SNUK_ARRAY_LENGTH(allocator_names) == SNUK_STATS_ALLOCATOR_MAX, "name every allocator");
+
+    snuk_eprintln("stats:");
+    snuk_eprintln("  refcounters  created %" PRIu64 ", destroyed %" PRIu64, s.refcounters_created,
+                  s.refcounters_destroyed);
+    snuk_eprintln("  scopes       created %" PRIu64 ", destroyed %" PRIu64, s.scopes_created, s.scopes_destroyed);
+    snuk_eprintln("  envs         created %" PRIu64 ", destroyed %" PRIu64, s.envs_created, s.envs_destroyed);
+    snuk_eprintln("  trash peak   %" PRIu64, s.trash_peak);
+    snuk_eprintln("  arena peak   %" PRIu64 " bytes", s.arena_high_water);
+    for (uint64_t i = 0; i < SNUK_STATS_ALLOCATOR_MAX; ++i) {
+        SnukAllocatorStats *a = &s.allocators[i];
+        snuk_eprintln("  %-12s %" PRIu64 " allocations, %" PRIu64 " frees, %" PRIu64 " bytes, %" PRIu64
+                      " bytes reserved at peak",
+                      allocator_names[i], a->allocations, a->frees, a->bytes, a->reserved_peak);
+    }
+
+    // Share of the committed slab chunks holding live blocks at the busiest point
+    SnukAllocatorStats *slab = &s.allocators[SNUK_STATS_ALLOCATOR_SLAB];
+    if (slab->reserved_peak)
+        snuk_eprintln("  slab use     %" PRIu64 " of %" PRIu64 " bytes at peak (%.1f%%)", slab->live_peak,
+                      slab->reserved_peak, 100.0 * (double)slab->live_peak / (double)slab->reserved_peak);
+    snuk_eprintln("  peak rss     %" PRIu64 " KiB", s.peak_rss / 1024);
+
+    if (s.refcounters_created != s.refcounters_destroyed)
+        snuk_eprintln("  leaked %" PRIu64 " refcounters", s.refcounters_created - s.refcounters_destroyed);
+}
@@ -2,22 +2,149 @@
 
 #include <snuk/logger.h>
 #include <snuk/parser/parser.h>
+#include <snuk/thread.h>
+
+// Items the parser can run ahead of the interpreter
+#define PIPELINE_SLOTS 64
+
+// Most top-level items fit in one chunk, a region held after its item keeps it
+#define AST_CHUNK_SIZE KIB(4)
+
+#define GET_ARENA(rc) ((SnukArena *)snuk_ref_counter_get(rc))
+
+/**
+ * @brief Parsed item waiting to run, with the region holding its AST.
+ */
+typedef struct PipelineSlot {
+    SnukRefCounter *ast;
+    SnukItem *item;
+} PipelineSlot;
+
+/**
+ * @brief Bounded queue between the parser thread and the interpreter.
+ *
+ * Item i goes to slot i % PIPELINE_SLOTS. Only the parser writes produced and
+ * only the interpreter writes consumed, a slot belongs to whichever side the
+ * counters give it to.
+ */
+typedef struct Pipeline {
+    const char *src;
+    PipelineSlot slots[PIPELINE_SLOTS];
+    volatile uint64_t produced;
+    volatile uint64_t consumed;
+    volatile uint64_t finished;  // set once produced is final
+} Pipeline;
+
+static void ast_destroy(void *data, void *ptr) {
+    SNUK_UNUSED(data);
+    snuk_arena_deinit((SnukArena *)ptr);
+    snuk_free(ptr);
+}
+
+SnukRefCounter *snuk_runtime_create_ast(void) {
+    SnukArena *arena = (SnukArena *)snuk_alloc(sizeof(SnukArena), alignof(SnukArena));
+    snuk_arena_init(arena, AST_CHUNK_SIZE);
+    return snuk_ref_counter_create(arena, NULL, ast_destroy);
+}
+
+/**
+ * @brief Make ast ready for the next item. It is reset when the last item
+ * left nothing pointing into it, otherwise whatever does keeps it and a new
+ * region takes its place.
+ */
+static void reclaim_ast(SnukRefCounter **ast) {
+    if (snuk_ref_counter_count(*ast) == 1) {
+        snuk_arena_reset(GET_ARENA(*ast));
+        return;
+    }
+
+    snuk_ref_counter_release(ast);
+    *ast = snuk_runtime_create_ast();
+}
+
+static void execute_item(Runtime *rt, SnukItem *item, SnukRefCounter *ast) {
+    // snuk_item_log(item);
+    // log_trace("", NULL);
+    rt->interpreter.ast = ast;
+    SnukValue value = snuk_interpreter_exec_item(&rt->interpreter, item);
+    snuk_value_log(value);
+    log_trace("", NULL);
+    snuk_value_free(value);
+    rt->interpreter.ast = NULL;
+}
 
 void snuk_runtime_execute(Runtime *rt, const char *src) {
     SnukParser parser;
-    snuk_parser_init(&parser, src, &rt->parser_allocator);
+    // Comments only matter to tooling
+    snuk_parser_init(&parser, src, &rt->parser_allocator, SNUK_LEXER_MODE_EXECUTE);
 
     SnukItem *item;
-    while (true) {
-        item = snuk_parser_next_item(&parser);
-        if (!item) break;
-        // snuk_item_log(item);
-        // log_trace("", NULL);
-        SnukValue value = snuk_interpreter_exec_item(&rt->interpreter, item);
-        snuk_value_log(value);
-        log_trace("", NULL);
-        snuk_value_free(value);
+    while ((item = snuk_parser_next_item(&parser))) {
+        execute_item(rt, item, rt->ast);
+
+        reclaim_ast(&rt->ast);
+        rt->parser_allocator = snuk_arena_allocator(GET_ARENA(rt->ast));
+    }
+
+    snuk_parser_deinit(&parser);
+}
+
+void snuk_runtime_execute_items(Runtime *rt, SnukItem **items, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) execute_item(rt, items[i], NULL);
+}
+
+static void parse_items(void *arg) {
+    Pipeline *pipeline = (Pipeline *)arg;
+    SnukAllocator allocator = snuk_arena_allocator(GET_ARENA(pipeline->slots[0].ast));
+    SnukParser parser;
+    snuk_parser_init(&parser, pipeline->src, &allocator, SNUK_LEXER_MODE_EXECUTE);
+
+    for (uint64_t i = 0;; ++i) {
+        while (i - snuk_atomic_load(&pipeline->consumed) == PIPELINE_SLOTS) snuk_thread_yield();
+
+        // The interpreter reclaimed the slot's region before handing it back
+        PipelineSlot *slot = &pipeline->slots[i % PIPELINE_SLOTS];
+        allocator = snuk_arena_allocator(GET_ARENA(slot->ast));
+        slot->item = snuk_parser_next_item(&parser);
+        if (!slot->item) break;
+        snuk_atomic_store(&pipeline->produced, i + 1);
     }
 
     snuk_parser_deinit(&parser);
+    snuk_atomic_store(&pipeline->finished, 1);
+}
+
+void snuk_runtime_execute_pipelined(Runtime *rt, const char *src) {
+    Pipeline *pipeline = (Pipeline *)snuk_alloc(sizeof(Pipeline), alignof(Pipeline));
+    *pipeline = (Pipeline){.src = src};
+    for (uint64_t i = 0; i < PIPELINE_SLOTS; ++i) pipeline->slots[i].ast = snuk_runtime_create_ast();
+
+    // Both threads allocate until the join
+    snuk_memory_set_shared(true);
+    SnukThread *thread = snuk_thread_create(parse_items, pipeline);
+    if (!thread) {
+        snuk_memory_set_shared(false);
+        snuk_runtime_execute(rt, src);
+    }
+
+    for (uint64_t i = 0; thread; ++i) {
+        while (snuk_atomic_load(&pipeline->produced) == i && !snuk_atomic_load(&pipeline->finished))
+            snuk_thread_yield();
+        // produced is final once finished is set, it may have moved since the wait
+        if (snuk_atomic_load(&pipeline->produced) == i) break;
+
+        PipelineSlot *slot = &pipeline->slots[i % PIPELINE_SLOTS];
+        execute_item(rt, slot->item, slot->ast);
+
+        reclaim_ast(&slot->ast);
+        snuk_atomic_store(&pipeline->consumed, i + 1);
+    }
+
+    if (thread) {
+        snuk_thread_join(thread);
+        snuk_memory_set_shared(false);
+    }
+
+    for (uint64_t i = 0; i < PIPELINE_SLOTS; ++i) snuk_ref_counter_release(&pipeline->slots[i].ast);
+    snuk_free(pipeline);
 }
@@ -1,65 +1,60 @@
 #pragma once
 
-#include <snmemory/linear.h>
+#include <snuk/arena.h>
 #include <snuk/defines.h>
 #include <snuk/interpreter/interpreter.h>
 #include <snuk/memory.h>
+#include <snuk/refcount.h>
 #include <snuk/snuk_string.h>
 
-#define PAGES 50
-
+/**
+ * @brief Interpreter plus the region its next top-level item is parsed into.
+ *
+ * A region is a refcounted arena holding the AST of one item. Closures,
+ * global bindings and string literals retain the region they point into, so
+ * after the item runs the runtime either resets the region for the next item
+ * or, when something still holds it, leaves it to them and starts a new one.
+ * Memory follows the code that is still referenced.
+ *
+ * When pipelined, files are parsed on a second thread into a region per
+ * queue slot, reclaimed the same way.
+ */
 typedef struct Runtime {
-    void *mem;
-    snLinearAllocator la;
+    SnukRefCounter *ast;  // region the next item is parsed into
+    SnukAllocator parser_allocator;  // allocates from the arena of ast
     SnukInterpreter interpreter;
-    SnukAllocator parser_allocator;
+    bool pipelined;  // execute_file overlaps parsing with execution
 } Runtime;
 
-SNUK_INLINE void *runtime_alloc_fn(void *data, uint64_t size, uint64_t align) {
-    snLinearAllocator *la = (snLinearAllocator *)data;
-    return sn_linear_allocator_allocate(la, size, align);
-}
-
-SNUK_INLINE void *runtime_realloc_fn(void *data, void *ptr, uint64_t new_size, uint64_t align) {
-    snLinearAllocator *la = (snLinearAllocator *)data;
-    void *new = sn_linear_allocator_allocate(la, new_size, align);
-    // No need to worry about how much to copy
-    // since it is inside the given memory itself
-    memcpy(new, ptr, new_size);
-    return new;
-}
-
-SNUK_INLINE void runtime_free_fn(void *data, void *ptr) {
-    SNUK_UNUSED(data);
-    SNUK_UNUSED(ptr);
-}
+// Empty region for the AST of a top-level item
+SnukRefCounter *snuk_runtime_create_ast(void);
 
 SNUK_INLINE void snuk_runtime_init(Runtime *rt) {
-    *rt = (Runtime){
-        .mem = snuk_allocate_pages(PAGES),
-        .parser_allocator = {
-           .data = (void *)&rt->la,
-           .alloc = runtime_alloc_fn,
-           .realloc = runtime_realloc_fn,
-           .free = runtime_free_fn,
-       },
-    };
-    sn_linear_allocator_init(&rt->la, rt->mem, PAGES * snuk_page_size());
+    rt->ast = snuk_runtime_create_ast();
+    rt->parser_allocator = snuk_arena_allocator((SnukArena *)snuk_ref_counter_get(rt->ast));
     snuk_interpreter_init(&rt->interpreter);
+    rt->pipelined = false;
 }
 
 SNUK_INLINE void snuk_runtime_deinit(Runtime *rt) {
     if (!rt) return;
     snuk_interpreter_deinit(&rt->interpreter);
-    sn_linear_allocator_deinit(&rt->la);
-    snuk_free_pages(rt->mem, PAGES);
+    snuk_ref_counter_release(&rt->ast);
     *rt = (Runtime){0};
 }
 
 void snuk_runtime_execute(Runtime *rt, const char *src);
 
+// Same items in the same order as snuk_runtime_execute, parsed on a second
+// thread while earlier ones run
+void snuk_runtime_execute_pipelined(Runtime *rt, const char *src);
+
+// Items already parsed, e.g. from an image, owned by the caller
+void snuk_runtime_execute_items(Runtime *rt, SnukItem **items, uint64_t count);
+
 SNUK_INLINE void snuk_runtime_execute_file(Runtime *rt, const char *src) {
-    snuk_runtime_execute(rt, src);
+    if (rt->pipelined) snuk_runtime_execute_pipelined(rt, src);
+    else snuk_runtime_execute(rt, src);
 }
 
 SNUK_INLINE bool snuk_runtime_execute_repl(Runtime *rt, const char *src) {
@@ -0,0 +1,184 @@
+#include "snuk/arena.h"
+
+#include "snuk/stats.h"
+
+#include <string.h>
+
+struct SnukArenaChunk {
+    SnukArenaChunk *prev;
+    uint8_t *top;
+    uint8_t *end;
+};
+
+// Chunk data starts after the header, kept at the alignment snuk_alloc gives
+#define CHUNK_HEADER_SIZE ((sizeof(SnukArenaChunk) + 15) & ~(uint64_t)15)
+
+SNUK_FORCE_INLINE uint8_t *chunk_data(SnukArenaChunk *chunk) {
+    return (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+}
+
+SNUK_FORCE_INLINE uint8_t *align_up(uint8_t *ptr, uint64_t align) {
+    return (uint8_t *)(((uintptr_t)ptr + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+SNUK_FORCE_INLINE bool chunk_fits(SnukArenaChunk *chunk, uint8_t *block, uint64_t size) {
+    return (uintptr_t)block <= (uintptr_t)chunk->end && (uint64_t)(chunk->end - block) >= size;
+}
+
+static SnukArenaChunk *add_chunk(SnukArena *arena, uint64_t min_size) {
+    uint64_t size = min_size > arena->chunk_size ? min_size : arena->chunk_size;
+    SnukArenaChunk *chunk = (SnukArenaChunk *)snuk_alloc(CHUNK_HEADER_SIZE + size, 16);
+    *chunk = (SnukArenaChunk){
+        .prev = arena->current,
+        .top = chunk_data(chunk),
+        .end = chunk_data(chunk) + size,
+    };
+    arena->current = chunk;
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_ARENA, size);
+    return chunk;
+}
+
+static void free_chunk(SnukArenaChunk *chunk) {
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_ARENA, 0 - (uint64_t)(chunk->end - chunk_data(chunk)));
+    snuk_free(chunk);
+}
+
+/**
+ * @brief Move the top of the current chunk, keeping the usage counters.
+ */
+static void set_top(SnukArena *arena, uint8_t *top) {
+    SnukArenaChunk *chunk = arena->current;
+    arena->used = arena->used - (uint64_t)(chunk->top - chunk_data(chunk)) + (uint64_t)(top - chunk_data(chunk));
+    chunk->top = top;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+        SNUK_STATS_MAX(arena_high_water, arena->used);
+    }
+}
+
+void snuk_arena_init(SnukArena *arena, uint64_t chunk_size) {
+    *arena = (SnukArena){.chunk_size = chunk_size};
+    add_chunk(arena, chunk_size);
+}
+
+void snuk_arena_deinit(SnukArena *arena) {
+    if (!arena) return;
+
+    while (arena->current) {
+        SnukArenaChunk *prev = arena->current->prev;
+        free_chunk(arena->current);
+        arena->current = prev;
+    }
+
+    *arena = (SnukArena){0};
+}
+
+void *snuk_arena_alloc(SnukArena *arena, uint64_t size, uint64_t align) {
+    SnukArenaChunk *chunk = arena->current;
+    uint8_t *block = align_up(chunk->top, align);
+    if (!chunk_fits(chunk, block, size)) {
+        // Room for the padding too, the chunk data is only 16 byte aligned
+        chunk = add_chunk(arena, size + align);
+        block = align_up(chunk->top, align);
+    }
+
+    set_top(arena, block + size);
+    arena->last = block;
+    SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_ARENA, size);
+    return block;
+}
+
+void *snuk_arena_realloc(SnukArena *arena, void *ptr, uint64_t new_size, uint64_t align) {
+    if (!ptr) return snuk_arena_alloc(arena, new_size, align);
+
+    uint8_t *block = (uint8_t *)ptr;
+    if (block == arena->last && align_up(block, align) == block && chunk_fits(arena->current, block, new_size)) {
+        set_top(arena, block + new_size);
+        SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_ARENA, new_size);
+        return block;
+    }
+
+    // The old size is unknown, but the block cannot extend past the used
+    // part of its chunk
+    uint64_t old_size = 0;
+    for (SnukArenaChunk *chunk = arena->current; chunk; chunk = chunk->prev) {
+        if ((uintptr_t)block >= (uintptr_t)chunk_data(chunk) && (uintptr_t)block < (uintptr_t)chunk->top) {
+            old_size = (uint64_t)(chunk->top - block);
+            break;
+        }
+    }
+    SNUK_ASSERT(old_size, "reallocating memory the arena does not own");
+
+    void *moved = snuk_arena_alloc(arena, new_size, align);
+    memcpy(moved, block, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+void snuk_arena_free(SnukArena *arena, void *ptr) {
+    if (!ptr || ptr != arena->last) return;
+
+    set_top(arena, (uint8_t *)ptr);
+    arena->last = NULL;
+    SNUK_STATS_INC(allocators[SNUK_STATS_ALLOCATOR_ARENA].frees);
+}
+
+void snuk_arena_reset(SnukArena *arena) {
+    while (arena->current->prev) {
+        SnukArenaChunk *prev = arena->current->prev;
+        free_chunk(arena->current);
+        arena->current = prev;
+    }
+
+    arena->current->top = chunk_data(arena->current);
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+SnukArenaMark snuk_arena_mark(SnukArena *arena) {
+    return (SnukArenaMark){.chunk = arena->current, .top = arena->current->top, .used = arena->used};
+}
+
+void snuk_arena_rewind(SnukArena *arena, SnukArenaMark mark) {
+    while (arena->current != mark.chunk) {
+        SNUK_ASSERT(arena->current->prev, "rewinding to a mark the arena does not own");
+        SnukArenaChunk *prev = arena->current->prev;
+        free_chunk(arena->current);
+        arena->current = prev;
+    }
+
+#ifdef SNUK_DEBUG
+    // Anything still pointing past the mark reads garbage instead of stale data
+    memset(mark.top, 0xdd, (uint64_t)(arena->current->top - mark.top));
+#endif
+    arena->current->top = mark.top;
+    arena->used = mark.used;
+    arena->last = NULL;
+}
+
+void *snuk_arena_contiguous(SnukArena *arena, uint64_t *size) {
+    if (arena->current->prev) return NULL;
+
+    *size = (uint64_t)(arena->current->top - chunk_data(arena->current));
+    return chunk_data(arena->current);
+}
+
+static void *arena_alloc_fn(void *data, uint64_t size, uint64_t align) {
+    return snuk_arena_alloc((SnukArena *)data, size, align);
+}
+
+static void *arena_realloc_fn(void *data, void *ptr, uint64_t new_size, uint64_t align) {
+    return snuk_arena_realloc((SnukArena *)data, ptr, new_size, align);
+}
+
+static void arena_free_fn(void *data, void *ptr) {
+    snuk_arena_free((SnukArena *)data, ptr);
+}
+
+SnukAllocator snuk_arena_allocator(SnukArena *arena) {
+    return (SnukAllocator){
+        .data = (void *)arena,
+        .alloc = arena_alloc_fn,
+        .realloc = arena_realloc_fn,
+        .free = arena_free_fn,
+    };
+}
@@ -3,205 +3,137 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define HEADER_SIZE (sizeof(uint64_t) * SNUK_DARRAY_MAX_FIELDS)
-
-SNUK_INLINE void write_to_bytes(void *ptr, uint64_t value, bool reverse) {
-    uint8_t *p = (uint8_t *)ptr;
-    uint8_t inc = reverse ? -1 : 1;
-    do {
-        *p = value % 0x80;
-        value >>= 7;
-        if (!value) return;
-        *p |= 0x80;
-        p += inc;
-    } while (value);
-}
-
-SNUK_INLINE uint64_t read_from_bytes(void *ptr, bool reverse) {
-    uint8_t *p = (uint8_t *)ptr;
-    uint8_t inc = reverse ? -1 : 1;
-    uint64_t value = 0;
-    uint64_t i = 0;
+#define HEADER_SIZE sizeof(SnukDArray)
 
-    while (*p & 0x80) {
-        value |= (uint64_t)(*p & ~0x80) << i;
-        i += 7;
-        p += inc;
-    }
+// Headers sit at the end of a block of this alignment, so elements get it too
+#define MIN_BLOCK_ALIGN 16
 
-    value |= (uint64_t)(*p) << i;
+SNUK_INLINE uint64_t block_align(uint64_t align) {
+    return align > MIN_BLOCK_ALIGN ? align : MIN_BLOCK_ALIGN;
+}
 
-    return value;
+SNUK_INLINE uint64_t block_size(uint64_t capacity, uint64_t stride, uint32_t offset) {
+    return offset + HEADER_SIZE + capacity * stride;
 }
 
-#define ALIGN_BYTE(ptr) ((void *)((uint64_t)(ptr) - 1))
-#define GET_ALIGN_SHIFT(ptr) (read_from_bytes((void *)((uint64_t)(ptr) - 1), true))
-#define SET_ALIGN_SHIFT(ptr, shift) (write_to_bytes((void *)((uint64_t)(ptr) - 1), (shift), true))
-#define GET_ALIGNED_NEXT(x, align) ((((uint64_t)(x)) + (align)) & ~((align) - 1))
+SNUK_INLINE void *block_start(SnukDArray *header) {
+    return (uint8_t *)header - header->offset;
+}
 
 void *impl_snuk_darray_create(uint64_t capacity, uint64_t stride, uint64_t align, SnukAllocator *allocator) {
     if (!allocator) allocator = &snuk_global_allocator;
-    uint64_t total = (capacity * stride) + HEADER_SIZE + align;
-    uint64_t *ptr = (uint64_t *)allocator->alloc(allocator->data, total, alignof(uint64_t));
-    memset(ptr, 0, total);
-    ptr[SNUK_DARRAY_CAPACITY] = capacity;
-    ptr[SNUK_DARRAY_SIZE] = 0;
-    ptr[SNUK_DARRAY_STRIDE] = stride;
-    ptr[SNUK_DARRAY_ALIGN] = align;
-    ptr[SNUK_DARRAY_ALLOCATOR] = (uint64_t)allocator;
-
-    ptr = (uint64_t *)((uint64_t)ptr + HEADER_SIZE);
 
-    uint64_t aligned = GET_ALIGNED_NEXT(ptr, align);
-    SET_ALIGN_SHIFT(aligned, (aligned - (uint64_t)ptr));
+    uint64_t alignment = block_align(align);
+    // Pad in front of the header until the elements land on the alignment
+    uint32_t offset = (uint32_t)((HEADER_SIZE + alignment - 1) / alignment * alignment - HEADER_SIZE);
+
+    uint8_t *block
+        = (uint8_t *)allocator->alloc(allocator->data, block_size(capacity, stride, offset), alignment);
+    SnukDArray *header = (SnukDArray *)(block + offset);
+    *header = (SnukDArray){
+        .capacity = capacity,
+        .length = 0,
+        .stride = stride,
+        .align = align,
+        .allocator = allocator,
+        .offset = offset,
+        .is_inline = false,
+    };
+
+    return header + 1;
+}
 
-    return (void *)aligned;
+void *impl_snuk_darray_create_inline(
+    SnukDArray *header, void *elements, uint64_t capacity, uint64_t stride, uint64_t align, SnukAllocator *allocator) {
+    SNUK_ASSERT((void *)(header + 1) == elements, "inline darray elements must follow the header");
+    SNUK_UNUSED(elements);
+
+    *header = (SnukDArray){
+        .capacity = capacity,
+        .length = 0,
+        .stride = stride,
+        .align = align,
+        .allocator = allocator ? allocator : &snuk_global_allocator,
+        .offset = 0,
+        .is_inline = true,
+    };
+
+    return header + 1;
 }
 
 void impl_snuk_darray_destroy(void *arr) {
-    uint64_t ptr = (uint64_t)arr;
-    ptr -= GET_ALIGN_SHIFT(ptr);
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
-    SnukAllocator *allocator = (SnukAllocator *)p[SNUK_DARRAY_ALLOCATOR];
-    allocator->free(allocator->data, (void *)ptr);
+    SnukDArray *header = SNUK_DARRAY_HEADER(arr);
+    if (header->is_inline) return;
+    header->allocator->free(header->allocator->data, block_start(header));
 }
 
 void impl_snuk_darray_resize(void **parr, uint64_t capacity) {
-    uint64_t ptr = (uint64_t)(*parr);
-    uint64_t align_shift = GET_ALIGN_SHIFT(ptr);
-    ptr -= align_shift;
-    ptr -= HEADER_SIZE;
+    SnukDArray *header = SNUK_DARRAY_HEADER(*parr);
 
-    uint64_t *p = (uint64_t *)ptr;
+    if (header->is_inline) {
+        // Shrinking keeps the storage, growing leaves it for the allocator
+        if (capacity <= header->capacity) return;
 
-    SnukAllocator *allocator = (SnukAllocator *)p[SNUK_DARRAY_ALLOCATOR];
-    p = (uint64_t *)allocator->realloc(
-        allocator->data, p, (capacity * p[SNUK_DARRAY_STRIDE]) + HEADER_SIZE + p[SNUK_DARRAY_ALIGN],
-        alignof(uint64_t));
-
-    p[SNUK_DARRAY_CAPACITY] = capacity;
+        uint8_t *arr = (uint8_t *)impl_snuk_darray_create(capacity, header->stride, header->align, header->allocator);
+        memcpy(arr, *parr, header->length * header->stride);
+        SNUK_DARRAY_HEADER(arr)->length = header->length;
+        *parr = arr;
+        return;
+    }
 
-    ptr = (uint64_t)p;
-    ptr += HEADER_SIZE;
-    ptr += align_shift;
+    SnukAllocator *allocator = header->allocator;
+    uint32_t offset = header->offset;
+    uint8_t *block = (uint8_t *)allocator->realloc(allocator->data, block_start(header),
+                                                   block_size(capacity, header->stride, offset),
+                                                   block_align(header->align));
+    header = (SnukDArray *)(block + offset);
+    header->capacity = capacity;
 
-    *parr = (void *)ptr;
+    *parr = header + 1;
 }
 
-uint64_t impl_snuk_darray_header(void *arr, SnukDArrayHeader header) {
-    uint64_t ptr = (uint64_t)arr;
-    ptr -= GET_ALIGN_SHIFT(ptr);
-    ptr -= HEADER_SIZE;
-    return ((uint64_t *)ptr)[header];
-}
-
-void impl_snuk_darray_push(void **parr, void *element) {
-    uint64_t ptr = (uint64_t)(*parr);
-    uint64_t align_shift = GET_ALIGN_SHIFT(ptr);
-    ptr -= align_shift;
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
-
-    if (p[SNUK_DARRAY_CAPACITY] <= p[SNUK_DARRAY_SIZE]) {
-        snuk_darray_resize(parr, p[SNUK_DARRAY_CAPACITY] * SNUK_DARRAY_RESIZE_FACTOR);
-        ptr = (uint64_t)(*parr);
-        ptr -= align_shift;
-        ptr -= HEADER_SIZE;
-        p = (uint64_t *)ptr;
-    }
-
-    void *dest = ((uint8_t *)*parr) + (p[SNUK_DARRAY_SIZE] * p[SNUK_DARRAY_STRIDE]);
-    memcpy(dest, element, p[SNUK_DARRAY_STRIDE]);
-    ++p[SNUK_DARRAY_SIZE];
+void impl_snuk_darray_grow(void **parr) {
+    uint64_t capacity = SNUK_DARRAY_HEADER(*parr)->capacity;
+    impl_snuk_darray_resize(parr, capacity ? capacity * SNUK_DARRAY_RESIZE_FACTOR : SNUK_DARRAY_DEFAULT_CAPACITY);
 }
 
 void impl_snuk_darray_push_at(void **parr, uint64_t index, void *element) {
-    uint64_t ptr = (uint64_t)(*parr);
-    uint64_t align_shift = GET_ALIGN_SHIFT(ptr);
-    ptr -= align_shift;
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
-
-    if (index > p[SNUK_DARRAY_SIZE]) {
-        if (p[SNUK_DARRAY_CAPACITY] <= index + 1) {
-            snuk_darray_resize(parr, index + 1);
-            ptr = (uint64_t)(*parr);
-            ptr -= align_shift;
-            ptr -= HEADER_SIZE;
-            p = (uint64_t *)ptr;
-        }
-
-        memset(((uint8_t *)*parr) + (p[SNUK_DARRAY_SIZE] * p[SNUK_DARRAY_STRIDE]), 0,
-               (index - p[SNUK_DARRAY_SIZE] * p[SNUK_DARRAY_STRIDE]));
+    SnukDArray *header = SNUK_DARRAY_HEADER(*parr);
 
-        void *dest = ((uint8_t *)*parr) + (index * p[SNUK_DARRAY_STRIDE]);
-        memcpy(dest, element, p[SNUK_DARRAY_STRIDE]);
+    if (index > header->length) {
+        if (header->capacity <= index) {
+            impl_snuk_darray_resize(parr, index + 1);
+            header = SNUK_DARRAY_HEADER(*parr);
+        }
 
-        p[SNUK_DARRAY_SIZE] = index + 1;
+        // Zero the gap between the old end and index
+        memset((uint8_t *)*parr + header->length * header->stride, 0, (index - header->length) * header->stride);
+        memcpy((uint8_t *)*parr + index * header->stride, element, header->stride);
+        header->length = index + 1;
 
         return;
     }
 
-    if (p[SNUK_DARRAY_CAPACITY] <= p[SNUK_DARRAY_SIZE]) {
-        snuk_darray_resize(parr, p[SNUK_DARRAY_CAPACITY] * SNUK_DARRAY_RESIZE_FACTOR);
-        ptr = (uint64_t)(*parr);
-        ptr -= align_shift;
-        ptr -= HEADER_SIZE;
-        p = (uint64_t *)ptr;
+    if (header->capacity <= header->length) {
+        impl_snuk_darray_grow(parr);
+        header = SNUK_DARRAY_HEADER(*parr);
     }
 
-    void *dest = (uint8_t *)(*parr) + (p[SNUK_DARRAY_STRIDE] * (index + 1));
-    void *src = (uint8_t *)(*parr) + (p[SNUK_DARRAY_STRIDE] * (index));
-    uint64_t size = p[SNUK_DARRAY_STRIDE] * (p[SNUK_DARRAY_SIZE] - index);
-    memmove(dest, src, size);
-
-    dest = (uint8_t *)(*parr) + (index * p[SNUK_DARRAY_STRIDE]);
-    memcpy(dest, element, p[SNUK_DARRAY_STRIDE]);
-
-    ++p[SNUK_DARRAY_SIZE];
-}
-
-void impl_snuk_darray_pop(void **parr, void *element) {
-    uint64_t ptr = (uint64_t)(*parr);
-    ptr -= GET_ALIGN_SHIFT(ptr);
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
+    uint8_t *at = (uint8_t *)*parr + index * header->stride;
+    memmove(at + header->stride, at, (header->length - index) * header->stride);
+    memcpy(at, element, header->stride);
 
-    if (p[SNUK_DARRAY_SIZE] == 0) return;
-
-    --p[SNUK_DARRAY_SIZE];
-
-    if (element) {
-        void *src = ((uint8_t *)*parr) + (p[SNUK_DARRAY_SIZE] * p[SNUK_DARRAY_STRIDE]);
-        memcpy(element, src, p[SNUK_DARRAY_STRIDE]);
-    }
+    ++header->length;
 }
 
 void impl_snuk_darray_pop_at(void **parr, uint64_t index, void *element) {
-    uint64_t ptr = (uint64_t)(*parr);
-    uint64_t align_shift = GET_ALIGN_SHIFT(ptr);
-    ptr -= align_shift;
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
-
-    SNUK_ASSERT(index < p[SNUK_DARRAY_SIZE], "index out of bound while poping element");
+    SnukDArray *header = SNUK_DARRAY_HEADER(*parr);
 
-    void *dest = ((uint8_t *)*parr) + (index * p[SNUK_DARRAY_STRIDE]);
-    void *src = ((uint8_t *)*parr) + ((index + 1) * p[SNUK_DARRAY_STRIDE]);
-    uint64_t size = (p[SNUK_DARRAY_SIZE] - index - 1) * p[SNUK_DARRAY_STRIDE];
+    SNUK_ASSERT(index < header->length, "index out of bound while poping element");
 
-    if (element) memcpy(element, dest, p[SNUK_DARRAY_STRIDE]);
-    memmove(dest, src, size);
+    uint8_t *at = (uint8_t *)*parr + index * header->stride;
+    if (element) memcpy(element, at, header->stride);
+    memmove(at, at + header->stride, (header->length - index - 1) * header->stride);
 
-    --p[SNUK_DARRAY_SIZE];
+    --header->length;
 }
-
-void impl_snuk_darray_clear(void **parr) {
-    uint64_t ptr = (uint64_t)(*parr);
-    ptr -= GET_ALIGN_SHIFT(ptr);
-    ptr -= HEADER_SIZE;
-    uint64_t *p = (uint64_t *)ptr;
-    p[SNUK_DARRAY_SIZE] = 0;
-}
-
@@ -1,10 +1,10 @@
 #include "builtin_common.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
 
-static SnukValue to_int(SnukInterpreter *intpret);
-static SnukValue to_float(SnukInterpreter *intpret);
-static SnukValue to_bool(SnukInterpreter *intpret);
-static SnukValue to_str(SnukInterpreter *intpret);
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref);
@@ -20,7 +20,7 @@ SnukTypeMember bool_members[] = {
 };
 
 SnukValue builtin_bool_create_type(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_type(intpret, bool_members, SNUK_ARRAY_LENGTH(bool_members), weak_ref);
+    return snuk_native_create_lazy_type(intpret, bool_members, SNUK_ARRAY_LENGTH(bool_members), weak_ref);
 }
 
 SnukType bool_type = {
@@ -29,99 +29,78 @@ SnukType bool_type = {
 };
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
 }
 
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
 }
 
 static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
 }
 
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
 }
 
-static SnukValue to_int(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_INT,
         .int_value = value.type == SNUK_VALUE_NULL ? 0 : (int64_t)(value.bool_value == true),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_float(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_FLOAT,
         .float_value = value.type == SNUK_VALUE_NULL ? 0.0 : (double)(value.bool_value == true),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_bool(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_BOOL,
             .bool_value = false,
         };
-        goto end;
     }
 
-    ret = snuk_value_copy(value);
-
-end:
-    snuk_value_free(value);
-    return ret;
+    return snuk_value_copy(value);
 }
 
-static SnukValue to_str(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_BOOL || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     SnukStringView str;
-    if (value.type == SNUK_VALUE_NULL) snuk_string_view_create_with_len("\"null\"", 6);
+    if (value.type == SNUK_VALUE_NULL) str = snuk_string_view_create_with_len("\"null\"", 6);
     else
         str = value.bool_value ? snuk_string_view_create_with_len("\"true\"", 6)
                                : snuk_string_view_create_with_len("\"false\"", 7);
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_STRING,
         .string_value = str,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
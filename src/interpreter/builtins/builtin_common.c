@@ -1,100 +1,112 @@
 #include "builtin_common.h"
 
-SnukType to_int_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &int_type,
-    },
-};
+// Every parameter of a builtin method has the same type, up to three of them
+#define BUILTIN_MAX_PARAMS 3
 
-SnukType to_float_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &float_type,
-    },
-};
+/**
+ * @brief Define a native method type with count parameters of param_type.
+ *
+ * The parameter list is a darray in static storage, so the types are read
+ * only and shared by every interpreter on every thread.
+ */
+#define BUILTIN_FN_TYPE(id, param_type, count, ret)                                         \
+    static SNUK_DARRAY_INLINE_STORAGE(SnukType *, BUILTIN_MAX_PARAMS) id##_params = {        \
+        .header = SNUK_DARRAY_STATIC_HEADER(SnukType *, count, BUILTIN_MAX_PARAMS),          \
+        .elements = {&param_type, &param_type, &param_type},                                 \
+    };                                                                                       \
+    SnukType id = {                                                                          \
+        .type = TYPE_FN,                                                                     \
+        .fn = {.param_types = id##_params.elements, .return_type = &ret},                    \
+    }
 
-SnukType to_bool_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &bool_type,
-    },
-};
+BUILTIN_FN_TYPE(to_int_type, any_type, 0, int_type);
+BUILTIN_FN_TYPE(to_float_type, any_type, 0, float_type);
+BUILTIN_FN_TYPE(to_bool_type, any_type, 0, bool_type);
+BUILTIN_FN_TYPE(to_str_type, any_type, 0, str_type);
 
-SnukType to_str_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &str_type,
-    },
-};
+BUILTIN_FN_TYPE(str_length_type, any_type, 0, int_type);
+BUILTIN_FN_TYPE(str_get_type, int_type, 2, str_type);
+BUILTIN_FN_TYPE(str_find_type, str_type, 1, int_type);
+BUILTIN_FN_TYPE(str_count_type, str_type, 1, int_type);
+BUILTIN_FN_TYPE(str_starts_with_type, str_type, 1, bool_type);
+BUILTIN_FN_TYPE(str_trim_type, str_type, 0, str_type);
+BUILTIN_FN_TYPE(str_replace_type, str_type, 2, str_type);
+BUILTIN_FN_TYPE(str_split_type, str_type, 1, generator_type);
 
-SnukType str_length_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &int_type,
-    },
-};
-SnukType str_get_type = {
-    .type = TYPE_FN,
-    .fn = {
-        .return_type = &str_type,
-    },
+BUILTIN_FN_TYPE(generator_next_type, any_type, 0, any_type);
+BUILTIN_FN_TYPE(generator_done_type, any_type, 0, bool_type);
+
+BUILTIN_FN_TYPE(math_unary_type, any_type, 1, float_type);
+BUILTIN_FN_TYPE(math_binary_type, any_type, 2, float_type);
+BUILTIN_FN_TYPE(math_ternary_type, any_type, 3, float_type);
+BUILTIN_FN_TYPE(math_abs_type, any_type, 1, any_type);
+BUILTIN_FN_TYPE(math_minmax_type, any_type, 2, any_type);
+BUILTIN_FN_TYPE(math_bits_type, int_type, 1, int_type);
+
+SnukValue builtin_math_create_module(SnukInterpreter *intpret, bool weak_ref);
+
+// Native modules, bound as global type values built on first use
+static struct {
+    const char *name;
+    build_value_t build;
+} builtin_modules[] = {
+    {.name = "math", .build = builtin_math_create_module},
 };
 
 void snuk_builtins_init(SnukInterpreter *intpret) {
-    if (!to_int_type.fn.param_types)
-        to_int_type.fn.param_types = snuk_darray_create_with_capacity(0, SnukType *, &intpret->allocator);
-    if (!to_float_type.fn.param_types)
-        to_float_type.fn.param_types = snuk_darray_create_with_capacity(0, SnukType *, &intpret->allocator);
-    if (!to_bool_type.fn.param_types)
-        to_bool_type.fn.param_types = snuk_darray_create_with_capacity(0, SnukType *, &intpret->allocator);
-    if (!to_str_type.fn.param_types)
-        to_str_type.fn.param_types = snuk_darray_create_with_capacity(0, SnukType *, &intpret->allocator);
-
-    if (!str_length_type.fn.param_types)
-        str_length_type.fn.param_types = snuk_darray_create_with_capacity(0, SnukType *, &intpret->allocator);
-    if (!str_get_type.fn.param_types) {
-        str_get_type.fn.param_types = snuk_darray_create_with_capacity(2, SnukType *, &intpret->allocator);
-        snuk_darray_push(&str_get_type.fn.param_types, &int_type);
-        snuk_darray_push(&str_get_type.fn.param_types, &int_type);
-    }
+    SNUK_UNUSED(intpret);
 }
 
 void snuk_builtins_deinit(SnukInterpreter *intpret) {
     SNUK_UNUSED(intpret);
 }
 
-bool snuk_builtins_create_builtin_types(SnukInterpreter *intpret, bool weak_ref) {
-    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(builtin_types); ++i) {
-        SnukValue type = snuk_builtins_create_type(intpret, builtin_types[i].val_type, weak_ref);
-        if (type.type == SNUK_VALUE_UNKOWN) return false;
-        if (!snuk_native_add_value(intpret, builtin_types[i].type, &type_type, type, false))
-            return false;
-        snuk_value_free(type);
-    }
-
-    return true;
-}
-
 SnukValue builtin_int_create_type(SnukInterpreter *intpret, bool weak_ref);
 SnukValue builtin_float_create_type(SnukInterpreter *intpret, bool weak_ref);
 SnukValue builtin_bool_create_type(SnukInterpreter *intpret, bool weak_ref);
 SnukValue builtin_str_create_type(SnukInterpreter *intpret, bool weak_ref);
+SnukValue builtin_generator_create_type(SnukInterpreter *intpret, bool weak_ref);
 
-SnukValue snuk_builtins_create_type(SnukInterpreter *intpret, SnukValueType type, bool weak_ref) {
+static build_value_t get_type_builder(SnukValueType type) {
     switch (type) {
         case SNUK_VALUE_INT:
-            return builtin_int_create_type(intpret, weak_ref);
+            return builtin_int_create_type;
         case SNUK_VALUE_FLOAT:
-            return builtin_float_create_type(intpret, weak_ref);
+            return builtin_float_create_type;
         case SNUK_VALUE_BOOL:
-            return builtin_bool_create_type(intpret, weak_ref);
+            return builtin_bool_create_type;
         case SNUK_VALUE_STRING:
-            return builtin_str_create_type(intpret, weak_ref);
+            return builtin_str_create_type;
+        case SNUK_VALUE_GENERATOR:
+            return builtin_generator_create_type;
 
         default:
             SNUK_SHOULD_NOT_REACH_HERE;
             break;
     }
-    return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return NULL;
+}
+
+// Types and modules are bound lazily, a script only pays for the ones it
+// touches and each type's methods are again built on first access
+bool snuk_builtins_create_builtin_types(SnukInterpreter *intpret, bool weak_ref) {
+    SNUK_UNUSED(weak_ref);
+
+    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(builtin_types); ++i) {
+        build_value_t build = get_type_builder(builtin_types[i].val_type);
+        if (!snuk_native_add_lazy_value(intpret, builtin_types[i].type, &type_type, build, false))
+            return false;
+    }
+
+    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(builtin_modules); ++i)
+        if (!snuk_native_add_lazy_value(intpret, builtin_modules[i].name, &type_type, builtin_modules[i].build, true))
+            return false;
+
+    return true;
+}
+
+SnukValue snuk_builtins_create_type(SnukInterpreter *intpret, SnukValueType type, bool weak_ref) {
+    build_value_t build = get_type_builder(type);
+    if (!build) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return build(intpret, weak_ref);
 }
@@ -13,3 +13,17 @@ extern SnukType to_bool_type;
 extern SnukType to_str_type;
 extern SnukType str_length_type;
 extern SnukType str_get_type;
+extern SnukType str_find_type;
+extern SnukType str_count_type;
+extern SnukType str_starts_with_type;
+extern SnukType str_trim_type;
+extern SnukType str_replace_type;
+extern SnukType str_split_type;
+extern SnukType generator_next_type;
+extern SnukType generator_done_type;
+extern SnukType math_unary_type;
+extern SnukType math_binary_type;
+extern SnukType math_ternary_type;
+extern SnukType math_abs_type;
+extern SnukType math_minmax_type;
+extern SnukType math_bits_type;
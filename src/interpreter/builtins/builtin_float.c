@@ -1,12 +1,12 @@
 #include "builtin_common.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
 
-#include <stdio.h>
+#include "snuk/writer.h"
 
-static SnukValue to_int(SnukInterpreter *intpret);
-static SnukValue to_float(SnukInterpreter *intpret);
-static SnukValue to_bool(SnukInterpreter *intpret);
-static SnukValue to_str(SnukInterpreter *intpret);
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref);
@@ -22,7 +22,7 @@ SnukTypeMember float_members[] = {
 };
 
 SnukValue builtin_float_create_type(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_type(intpret, float_members, SNUK_ARRAY_LENGTH(float_members), weak_ref);
+    return snuk_native_create_lazy_type(intpret, float_members, SNUK_ARRAY_LENGTH(float_members), weak_ref);
 }
 
 SnukType float_type = {
@@ -31,106 +31,85 @@ SnukType float_type = {
 };
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
 }
 
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
 }
 
 static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
 }
 
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
 }
 
-static SnukValue to_int(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_INT,
         .int_value = value.type == SNUK_VALUE_NULL ? 0 : (int64_t)value.float_value,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_float(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_FLOAT,
             .float_value = 0.0,
         };
-        goto end;
     }
 
-    ret = snuk_value_copy(value);
-
-end:
-    snuk_value_free(value);
-    return ret;
+    return snuk_value_copy(value);
 }
 
-static SnukValue to_bool(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_BOOL,
         .bool_value = value.type == SNUK_VALUE_NULL ? false : (bool)value.float_value,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_str(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_FLOAT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_STRING,
             .string_value = snuk_string_view_create_with_len("\"null\"", 6),
         };
-        goto end;
     }
 
-    char *buf = (char *)snuk_alloc(25 * sizeof(char), alignof(char));
-    uint64_t len = 0;
-    len = snprintf(buf, 25, "\"%lf\"", value.float_value);
-    buf[len] = 0;
-    ret = (SnukValue){
+    // Same text print writes
+    char *buf = (char *)snuk_alloc(SNUK_FORMAT_FLOAT_MAX_CHARS + 2, alignof(char));
+    uint64_t len = snuk_format_float(value.float_value, buf + 1);
+    buf[0] = '"';
+    buf[len + 1] = '"';
+    return (SnukValue){
         .type = SNUK_VALUE_STRING,
-        .string_value = snuk_string_view_create_with_len(buf, len),
+        .string_value = snuk_string_view_create_with_len(buf, len + 2),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
@@ -0,0 +1,54 @@
+#include "builtin_common.h"
+#include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/interpreter/snuk_generator.h"
+
+static SnukValue next(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue done(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+
+static SnukValue build_next(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_done(SnukInterpreter *intpret, bool weak_ref);
+
+SnukTypeMember generator_members[] = {
+    {.name = "value", .type = &any_type,            .value = {.type = SNUK_VALUE_NULL}, .is_const = false},
+    {.name = "next",  .type = &generator_next_type, .build_value = build_next,          .is_const = false},
+    {.name = "done",  .type = &generator_done_type, .build_value = build_done,          .is_const = false},
+};
+
+SnukValue builtin_generator_create_type(SnukInterpreter *intpret, bool weak_ref) {
+    return snuk_native_create_lazy_type(intpret, generator_members, SNUK_ARRAY_LENGTH(generator_members), weak_ref);
+}
+
+SnukType generator_type = {
+    .type = TYPE_NAMED,
+    .name = {.str = "generator", .len = 9}
+};
+
+static SnukValue build_next(SnukInterpreter *intpret, bool weak_ref) {
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &generator_next_type, next, weak_ref);
+}
+
+static SnukValue build_done(SnukInterpreter *intpret, bool weak_ref) {
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &generator_done_type, done, weak_ref);
+}
+
+static SnukValue next(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (value.type != SNUK_VALUE_GENERATOR) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    // Exhausted generators keep returning null
+    SnukValue ret;
+    if (!snuk_generator_next(intpret, value.generator, &ret)) ret = (SnukValue){.type = SNUK_VALUE_NULL};
+    return ret;
+}
+
+static SnukValue done(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (value.type != SNUK_VALUE_GENERATOR) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    return (SnukValue){
+        .type = SNUK_VALUE_BOOL,
+        .bool_value = snuk_generator_done(intpret, value.generator),
+    };
+}
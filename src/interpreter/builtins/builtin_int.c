@@ -1,12 +1,13 @@
 #include "builtin_common.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/interpreter/snuk_bigint.h"
 
-#include <stdio.h>
+#include "snuk/writer.h"
 
-static SnukValue to_int(SnukInterpreter *intpret);
-static SnukValue to_float(SnukInterpreter *intpret);
-static SnukValue to_bool(SnukInterpreter *intpret);
-static SnukValue to_str(SnukInterpreter *intpret);
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref);
@@ -22,7 +23,7 @@ SnukTypeMember int_members[] = {
 };
 
 SnukValue builtin_int_create_type(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_type(intpret, int_members, SNUK_ARRAY_LENGTH(int_members), weak_ref);
+    return snuk_native_create_lazy_type(intpret, int_members, SNUK_ARRAY_LENGTH(int_members), weak_ref);
 }
 
 SnukType int_type = {
@@ -31,103 +32,93 @@ SnukType int_type = {
 };
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
 }
 
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
 }
 
 static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
 }
 
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
 }
 
-static SnukValue to_int(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
-
-    if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){.type = SNUK_VALUE_INT, .int_value = 0};
-        goto end;
-    }
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_BIGINT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = snuk_value_copy(value);
+    if (value.type == SNUK_VALUE_NULL) return (SnukValue){.type = SNUK_VALUE_INT, .int_value = 0};
 
-end:
-    snuk_value_free(value);
-    return ret;
+    return snuk_value_copy(value);
 }
 
-static SnukValue to_float(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_BIGINT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_FLOAT,
-        .float_value = value.type == SNUK_VALUE_NULL ? 0.0 : (double)value.int_value,
+        .float_value = value.type == SNUK_VALUE_NULL ? 0.0
+                     : value.type == SNUK_VALUE_BIGINT ? snuk_bigint_to_double(value.bigint)
+                                                       : (double)value.int_value,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_bool(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_BIGINT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_BOOL,
-        .bool_value = value.type == SNUK_VALUE_NULL ? false : (bool)value.int_value,
+        .bool_value = value.type == SNUK_VALUE_NULL ? false : snuk_value_is_true(value),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_str(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_INT || value.type == SNUK_VALUE_BIGINT || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_STRING,
             .string_value = snuk_string_view_create_with_len("\"null\"", 6),
         };
-        goto end;
     }
 
-    char *buf = (char *)snuk_alloc(25 * sizeof(char), alignof(char));
-    uint64_t len = 0;
-    len = snprintf(buf, 25, "\"%" PRId64 "\"", value.int_value);
-    buf[len] = 0;
-    ret = (SnukValue){
+    if (value.type == SNUK_VALUE_BIGINT) {
+        // Room for the quotes
+        char *buf = (char *)snuk_alloc(snuk_bigint_max_chars(value.bigint) + 2, alignof(char));
+        uint64_t len = snuk_bigint_to_chars(value.bigint, buf + 1);
+        buf[0] = '"';
+        buf[len + 1] = '"';
+        return (SnukValue){
+            .type = SNUK_VALUE_STRING,
+            .string_value = snuk_string_view_create_with_len(buf, len + 2),
+        };
+    }
+
+    char *buf = (char *)snuk_alloc(SNUK_FORMAT_INT_MAX_CHARS + 2, alignof(char));
+    uint64_t len = snuk_format_int(value.int_value, buf + 1);
+    buf[0] = '"';
+    buf[len + 1] = '"';
+    return (SnukValue){
         .type = SNUK_VALUE_STRING,
-        .string_value = snuk_string_view_create_with_len(buf, len),
+        .string_value = snuk_string_view_create_with_len(buf, len + 2),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
@@ -0,0 +1,253 @@
+#include "builtin_common.h"
+#include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/interpreter/snuk_bigint.h"
+
+#include <math.h>
+
+// Float functions mapping one to one onto libm, (name, libm function)
+#define MATH_UNARY_FUNCTIONS(X)                                                                     \
+    X(sqrt, sqrt) X(cbrt, cbrt) X(exp, exp) X(exp2, exp2) X(log, log) X(log2, log2) X(log10, log10) \
+    X(sin, sin) X(cos, cos) X(tan, tan) X(asin, asin) X(acos, acos) X(atan, atan)                   \
+    X(sinh, sinh) X(cosh, cosh) X(tanh, tanh)                                                       \
+    X(floor, floor) X(ceil, ceil) X(round, round) X(trunc, trunc)
+
+#define MATH_BINARY_FUNCTIONS(X) X(pow, pow) X(atan2, atan2) X(hypot, hypot) X(fmod, fmod)
+
+#define MATH_BITS_FUNCTIONS(X) X(popcount, bits_popcount) X(clz, bits_clz) X(ctz, bits_ctz)
+
+#define DECLARE_MATH_FUNCTION(id, fn)                                                                          \
+    static SnukValue math_##id(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc); \
+    static SnukValue build_##id(SnukInterpreter *intpret, bool weak_ref);
+
+MATH_UNARY_FUNCTIONS(DECLARE_MATH_FUNCTION)
+MATH_BINARY_FUNCTIONS(DECLARE_MATH_FUNCTION)
+MATH_BITS_FUNCTIONS(DECLARE_MATH_FUNCTION)
+DECLARE_MATH_FUNCTION(fma, fma)
+DECLARE_MATH_FUNCTION(abs, abs)
+DECLARE_MATH_FUNCTION(min, min)
+DECLARE_MATH_FUNCTION(max, max)
+
+#define MATH_MEMBER(id, member_type) \
+    {.name = #id, .type = &member_type, .build_value = build_##id, .is_const = false},
+#define MATH_UNARY_MEMBER(id, fn) MATH_MEMBER(id, math_unary_type)
+#define MATH_BINARY_MEMBER(id, fn) MATH_MEMBER(id, math_binary_type)
+#define MATH_BITS_MEMBER(id, fn) MATH_MEMBER(id, math_bits_type)
+
+#define MATH_CONSTANT(id, constant) \
+    {.name = #id, .type = &float_type, .value = {.type = SNUK_VALUE_FLOAT, .float_value = constant}, .is_const = true},
+
+// Function members are built on first access, see snuk_native_create_lazy_type
+SnukTypeMember math_members[] = {
+    MATH_CONSTANT(pi, 3.14159265358979323846)
+    MATH_CONSTANT(tau, 6.28318530717958647693)
+    MATH_CONSTANT(e, 2.71828182845904523536)
+    MATH_CONSTANT(inf, INFINITY)
+    MATH_CONSTANT(nan, NAN)
+
+    MATH_UNARY_FUNCTIONS(MATH_UNARY_MEMBER)
+    MATH_BINARY_FUNCTIONS(MATH_BINARY_MEMBER)
+    MATH_BITS_FUNCTIONS(MATH_BITS_MEMBER)
+    MATH_MEMBER(fma, math_ternary_type)
+    MATH_MEMBER(abs, math_abs_type)
+    MATH_MEMBER(min, math_minmax_type)
+    MATH_MEMBER(max, math_minmax_type)
+};
+
+SnukValue builtin_math_create_module(SnukInterpreter *intpret, bool weak_ref) {
+    return snuk_native_create_lazy_type(intpret, math_members, SNUK_ARRAY_LENGTH(math_members), weak_ref);
+}
+
+/**
+ * @brief Read a numeric argument as a double.
+ */
+static bool math_get_arg(SnukValue value, double *out) {
+    switch (value.type) {
+        case SNUK_VALUE_INT:
+            *out = (double)value.int_value;
+            return true;
+        case SNUK_VALUE_BIGINT:
+            *out = snuk_bigint_to_double(value.bigint);
+            return true;
+        case SNUK_VALUE_FLOAT:
+            *out = value.float_value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+SNUK_INLINE SnukValue math_float(double value) {
+    return (SnukValue){.type = SNUK_VALUE_FLOAT, .float_value = value};
+}
+
+SNUK_INLINE int64_t bits_popcount(uint64_t x) {
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_popcountll(x);
+#else
+    int64_t count = 0;
+    for (; x; x &= x - 1) count++;
+    return count;
+#endif
+}
+
+SNUK_INLINE int64_t bits_clz(uint64_t x) {
+    if (!x) return 64;
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_clzll(x);
+#else
+    int64_t count = 0;
+    for (; !(x & 0x8000000000000000ull); x <<= 1) count++;
+    return count;
+#endif
+}
+
+SNUK_INLINE int64_t bits_ctz(uint64_t x) {
+    if (!x) return 64;
+#if defined(SNUK_COMPILER_GCC) || defined(SNUK_COMPILER_CLANG)
+    return __builtin_ctzll(x);
+#else
+    int64_t count = 0;
+    for (; !(x & 1); x >>= 1) count++;
+    return count;
+#endif
+}
+
+static SnukValue build_unary(SnukInterpreter *intpret, SnukType *type, native_fast_function_t fn, bool weak_ref) {
+    SnukParameter params[] = {
+        {.name = "x", .value = {.type = SNUK_VALUE_UNKOWN}},
+    };
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), type, fn, weak_ref);
+}
+
+static SnukValue build_binary(SnukInterpreter *intpret, SnukType *type, native_fast_function_t fn, bool weak_ref) {
+    SnukParameter params[] = {
+        {.name = "x", .value = {.type = SNUK_VALUE_UNKOWN}},
+        {.name = "y", .value = {.type = SNUK_VALUE_UNKOWN}},
+    };
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), type, fn, weak_ref);
+}
+
+#define DEFINE_MATH_UNARY(id, fn)                                                                             \
+    static SnukValue build_##id(SnukInterpreter *intpret, bool weak_ref) {                                    \
+        return build_unary(intpret, &math_unary_type, math_##id, weak_ref);                                   \
+    }                                                                                                         \
+    static SnukValue math_##id(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) { \
+        SNUK_UNUSED(intpret);                                                                                 \
+        SNUK_UNUSED(value);                                                                                   \
+        SNUK_UNUSED(argc);                                                                                    \
+        double x;                                                                                             \
+        if (!math_get_arg(args[0], &x)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};                        \
+        return math_float(fn(x));                                                                             \
+    }
+
+#define DEFINE_MATH_BINARY(id, fn)                                                                            \
+    static SnukValue build_##id(SnukInterpreter *intpret, bool weak_ref) {                                    \
+        return build_binary(intpret, &math_binary_type, math_##id, weak_ref);                                 \
+    }                                                                                                         \
+    static SnukValue math_##id(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) { \
+        SNUK_UNUSED(intpret);                                                                                 \
+        SNUK_UNUSED(value);                                                                                   \
+        SNUK_UNUSED(argc);                                                                                    \
+        double x, y;                                                                                          \
+        if (!math_get_arg(args[0], &x) || !math_get_arg(args[1], &y))                                         \
+            return (SnukValue){.type = SNUK_VALUE_UNKOWN};                                                    \
+        return math_float(fn(x, y));                                                                          \
+    }
+
+#define DEFINE_MATH_BITS(id, fn)                                                                              \
+    static SnukValue build_##id(SnukInterpreter *intpret, bool weak_ref) {                                    \
+        return build_unary(intpret, &math_bits_type, math_##id, weak_ref);                                    \
+    }                                                                                                         \
+    static SnukValue math_##id(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) { \
+        SNUK_UNUSED(intpret);                                                                                 \
+        SNUK_UNUSED(value);                                                                                   \
+        SNUK_UNUSED(argc);                                                                                    \
+        if (args[0].type != SNUK_VALUE_INT) return (SnukValue){.type = SNUK_VALUE_UNKOWN};                    \
+        return (SnukValue){.type = SNUK_VALUE_INT, .int_value = fn((uint64_t)args[0].int_value)};            \
+    }
+
+MATH_UNARY_FUNCTIONS(DEFINE_MATH_UNARY)
+MATH_BINARY_FUNCTIONS(DEFINE_MATH_BINARY)
+MATH_BITS_FUNCTIONS(DEFINE_MATH_BITS)
+
+static SnukValue build_fma(SnukInterpreter *intpret, bool weak_ref) {
+    SnukParameter params[] = {
+        {.name = "x", .value = {.type = SNUK_VALUE_UNKOWN}},
+        {.name = "y", .value = {.type = SNUK_VALUE_UNKOWN}},
+        {.name = "z", .value = {.type = SNUK_VALUE_UNKOWN}},
+    };
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), &math_ternary_type, math_fma, weak_ref);
+}
+
+static SnukValue math_fma(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(argc);
+    double x, y, z;
+    if (!math_get_arg(args[0], &x) || !math_get_arg(args[1], &y) || !math_get_arg(args[2], &z))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return math_float(fma(x, y, z));
+}
+
+static SnukValue build_abs(SnukInterpreter *intpret, bool weak_ref) {
+    return build_unary(intpret, &math_abs_type, math_abs, weak_ref);
+}
+
+static SnukValue math_abs(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(argc);
+    SnukValue x = args[0];
+    switch (x.type) {
+        case SNUK_VALUE_INT:
+            // abs(INT64_MIN) promotes to a bigint
+            return x.int_value < 0 ? snuk_bigint_negate(x) : x;
+        case SNUK_VALUE_BIGINT:
+            return GET_BIGINT(x.bigint)->negative ? snuk_bigint_negate(snuk_value_copy(x)) : snuk_value_copy(x);
+        case SNUK_VALUE_FLOAT:
+            return math_float(fabs(x.float_value));
+        default:
+            return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    }
+}
+
+/**
+ * @brief Return x or y, whichever compares as requested, keeping its type.
+ */
+static SnukValue math_pick(SnukValue x, SnukValue y, SnukTokenType op) {
+    bool x_int = x.type == SNUK_VALUE_INT || x.type == SNUK_VALUE_BIGINT;
+    bool y_int = y.type == SNUK_VALUE_INT || y.type == SNUK_VALUE_BIGINT;
+    bool pick_x;
+
+    if (x_int && y_int) {
+        pick_x = snuk_bigint_binary_op(x, y, op).bool_value;
+    } else {
+        double dx, dy;
+        if (!math_get_arg(x, &dx) || !math_get_arg(y, &dy)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+        pick_x = op == SNUK_TOKEN_LESS_EQUAL ? dx <= dy : dx >= dy;
+    }
+
+    return snuk_value_copy(pick_x ? x : y);
+}
+
+static SnukValue build_min(SnukInterpreter *intpret, bool weak_ref) {
+    return build_binary(intpret, &math_minmax_type, math_min, weak_ref);
+}
+
+static SnukValue math_min(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(argc);
+    return math_pick(args[0], args[1], SNUK_TOKEN_LESS_EQUAL);
+}
+
+static SnukValue build_max(SnukInterpreter *intpret, bool weak_ref) {
+    return build_binary(intpret, &math_minmax_type, math_max, weak_ref);
+}
+
+static SnukValue math_max(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(argc);
+    return math_pick(args[0], args[1], SNUK_TOKEN_GREATER_EQUAL);
+}
@@ -1,10 +1,10 @@
 #include "builtin_common.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
 
-static SnukValue to_int(SnukInterpreter *intpret);
-static SnukValue to_float(SnukInterpreter *intpret);
-static SnukValue to_bool(SnukInterpreter *intpret);
-static SnukValue to_str(SnukInterpreter *intpret);
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref);
@@ -26,47 +26,59 @@ SnukValue builtin_null_get_member(SnukInterpreter *intpret, SnukStringView field
 }
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
 }
 
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
 }
 
 static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
 }
 
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
 }
 
-static SnukValue to_int(SnukInterpreter *intpret) {
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
     SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
     return (SnukValue){
         .type = SNUK_VALUE_INT,
         .int_value = 0,
     };
 }
 
-static SnukValue to_float(SnukInterpreter *intpret) {
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
     SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
     return (SnukValue){
         .type = SNUK_VALUE_FLOAT,
         .float_value = 0.0,
     };
 }
 
-static SnukValue to_bool(SnukInterpreter *intpret) {
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
     SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
     return (SnukValue){
         .type = SNUK_VALUE_BOOL,
         .bool_value = false,
     };
 }
 
-static SnukValue to_str(SnukInterpreter *intpret) {
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
     SNUK_UNUSED(intpret);
+    SNUK_UNUSED(value);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
     return (SnukValue){
         .type = SNUK_VALUE_STRING,
         .string_value = snuk_string_view_create_with_len("null", 4),
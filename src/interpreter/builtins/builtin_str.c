@@ -1,14 +1,22 @@
 #include "builtin_common.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/interpreter/snuk_buffer.h"
+#include "snuk/interpreter/snuk_generator.h"
 
 #include <stdio.h>
 
-static SnukValue to_int(SnukInterpreter *intpret);
-static SnukValue to_float(SnukInterpreter *intpret);
-static SnukValue to_bool(SnukInterpreter *intpret);
-static SnukValue to_str(SnukInterpreter *intpret);
-static SnukValue length(SnukInterpreter *intpret);
-static SnukValue get(SnukInterpreter *intpret);
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue length(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue get(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue find(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue count(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue starts_with(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue trim(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue replace(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
+static SnukValue split(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc);
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref);
@@ -16,19 +24,31 @@ static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_length(SnukInterpreter *intpret, bool weak_ref);
 static SnukValue build_get(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_find(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_count(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_starts_with(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_trim(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_replace(SnukInterpreter *intpret, bool weak_ref);
+static SnukValue build_split(SnukInterpreter *intpret, bool weak_ref);
 
 SnukTypeMember str_members[] = {
-    {.name = "value",    .type = &any_type,        .value = {.type = SNUK_VALUE_NULL}, .is_const = false},
-    {.name = "to_int",   .type = &to_int_type,     .build_value = build_to_int,        .is_const = false},
-    {.name = "to_float", .type = &to_float_type,   .build_value = build_to_float,      .is_const = false},
-    {.name = "to_bool",  .type = &to_bool_type,    .build_value = build_to_bool,       .is_const = false},
-    {.name = "to_str",   .type = &to_str_type,     .build_value = build_to_str,        .is_const = false},
-    {.name = "length",   .type = &str_length_type, .build_value = build_length,        .is_const = false},
-    {.name = "get",      .type = &str_get_type,    .build_value = build_get,           .is_const = false},
+    {.name = "value",       .type = &any_type,             .value = {.type = SNUK_VALUE_NULL}, .is_const = false},
+    {.name = "to_int",      .type = &to_int_type,          .build_value = build_to_int,        .is_const = false},
+    {.name = "to_float",    .type = &to_float_type,        .build_value = build_to_float,      .is_const = false},
+    {.name = "to_bool",     .type = &to_bool_type,         .build_value = build_to_bool,       .is_const = false},
+    {.name = "to_str",      .type = &to_str_type,          .build_value = build_to_str,        .is_const = false},
+    {.name = "length",      .type = &str_length_type,      .build_value = build_length,        .is_const = false},
+    {.name = "get",         .type = &str_get_type,         .build_value = build_get,           .is_const = false},
+    {.name = "find",        .type = &str_find_type,        .build_value = build_find,          .is_const = false},
+    {.name = "count",       .type = &str_count_type,       .build_value = build_count,         .is_const = false},
+    {.name = "starts_with", .type = &str_starts_with_type, .build_value = build_starts_with,   .is_const = false},
+    {.name = "trim",        .type = &str_trim_type,        .build_value = build_trim,          .is_const = false},
+    {.name = "replace",     .type = &str_replace_type,     .build_value = build_replace,       .is_const = false},
+    {.name = "split",       .type = &str_split_type,       .build_value = build_split,         .is_const = false},
 };
 
 SnukValue builtin_str_create_type(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_type(intpret, str_members, SNUK_ARRAY_LENGTH(str_members), weak_ref);
+    return snuk_native_create_lazy_type(intpret, str_members, SNUK_ARRAY_LENGTH(str_members), weak_ref);
 }
 
 SnukType str_type = {
@@ -37,23 +57,23 @@ SnukType str_type = {
 };
 
 static SnukValue build_to_int(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_int_type, to_int, weak_ref);
 }
 
 static SnukValue build_to_float(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_float_type, to_float, weak_ref);
 }
 
 static SnukValue build_to_bool(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_bool_type, to_bool, weak_ref);
 }
 
 static SnukValue build_to_str(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &to_str_type, to_str, weak_ref);
 }
 
 static SnukValue build_length(SnukInterpreter *intpret, bool weak_ref) {
-    return snuk_native_create_fn(intpret, NULL, 0, &str_length_type, length, weak_ref);
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &str_length_type, length, weak_ref);
 }
 
 static SnukValue build_get(SnukInterpreter *intpret, bool weak_ref) {
@@ -67,180 +87,336 @@ static SnukValue build_get(SnukInterpreter *intpret, bool weak_ref) {
          .value = {.type = SNUK_VALUE_NULL},
          },
     };
-    return snuk_native_create_fn(intpret, params, SNUK_ARRAY_LENGTH(params), &str_get_type, get, weak_ref);
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), &str_get_type, get, weak_ref);
 }
 
-static SnukValue to_int(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
+static SnukValue build_str_fn(
+    SnukInterpreter *intpret, const char *param, SnukType *type, native_fast_function_t fn, bool weak_ref) {
+    SnukParameter params[] = {
+        {.name = param, .value = {.type = SNUK_VALUE_UNKOWN}},
+    };
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), type, fn, weak_ref);
+}
+
+static SnukValue build_find(SnukInterpreter *intpret, bool weak_ref) {
+    return build_str_fn(intpret, "sub", &str_find_type, find, weak_ref);
+}
+
+static SnukValue build_count(SnukInterpreter *intpret, bool weak_ref) {
+    return build_str_fn(intpret, "sub", &str_count_type, count, weak_ref);
+}
+
+static SnukValue build_starts_with(SnukInterpreter *intpret, bool weak_ref) {
+    return build_str_fn(intpret, "prefix", &str_starts_with_type, starts_with, weak_ref);
+}
+
+static SnukValue build_trim(SnukInterpreter *intpret, bool weak_ref) {
+    return snuk_native_create_fast_fn(intpret, NULL, 0, &str_trim_type, trim, weak_ref);
+}
+
+static SnukValue build_replace(SnukInterpreter *intpret, bool weak_ref) {
+    SnukParameter params[] = {
+        {.name = "old", .value = {.type = SNUK_VALUE_UNKOWN}},
+        {.name = "new", .value = {.type = SNUK_VALUE_UNKOWN}},
+    };
+    return snuk_native_create_fast_fn(intpret, params, SNUK_ARRAY_LENGTH(params), &str_replace_type, replace, weak_ref);
+}
+
+static SnukValue build_split(SnukInterpreter *intpret, bool weak_ref) {
+    return build_str_fn(intpret, "sep", &str_split_type, split, weak_ref);
+}
+
+/**
+ * @brief Read the characters of a string or buffer value without quotes.
+ *
+ * null reads as the empty string.
+ *
+ * @return False if value is not a string.
+ */
+static bool str_contents(SnukValue value, SnukStringView *out) {
+    if (value.type == SNUK_VALUE_NULL) {
+        *out = snuk_string_view_create_with_len("", 0);
+        return true;
     }
+    return snuk_buffer_contents(value, out);
+}
+
+static SnukValue str_create(const char *str, uint64_t len) {
+    char *new_str = snuk_alloc((len + 2) * sizeof(char), alignof(char));
+    new_str[0] = '"';
+    memcpy(new_str + 1, str, len);
+    new_str[len + 1] = '"';
+    return (SnukValue){
+        .type = SNUK_VALUE_STRING,
+        .string_value = snuk_string_view_create_with_len(new_str, len + 2),
+    };
+}
+
+/**
+ * @brief Part of the characters read by str_contents, a buffer shares its
+ * memory and a string gets a copy.
+ */
+static SnukValue str_slice(SnukValue value, SnukStringView string, const char *str, uint64_t len) {
+    if (value.type == SNUK_VALUE_BUFFER) return snuk_buffer_slice(value, (uint64_t)(str - string.str), len);
+    return str_create(str, len);
+}
+
+static SnukValue to_int(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    SnukStringView string;
+    if (!str_contents(value, &string)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_INT,
             .int_value = 0,
         };
-        goto end;
     }
 
-    char *str = snuk_string_view_get_cstr(value.string_value);
+    char *str = snuk_string_view_get_cstr(string);
 
     int64_t int_value = 0;
-    if (sscanf(str, "\"%" PRId64 "\"", &int_value) == 0) {
-        ret = (SnukValue){.type = SNUK_VALUE_NULL};
-        goto end;
-    }
+    int read = sscanf(str, "%" PRId64, &int_value);
+    snuk_free(str);
+    if (read != 1) return (SnukValue){.type = SNUK_VALUE_NULL};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_INT,
         .int_value = int_value,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_float(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_float(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    SnukStringView string;
+    if (!str_contents(value, &string)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_FLOAT,
             .float_value = 0.0,
         };
-        goto end;
     }
 
-    char *str = snuk_string_view_get_cstr(value.string_value);
+    char *str = snuk_string_view_get_cstr(string);
 
     double float_value = 0;
-    if (sscanf(str, "\"%lf\"", &float_value) == 0) return (SnukValue){.type = SNUK_VALUE_NULL};
+    int read = sscanf(str, "%lf", &float_value);
+    snuk_free(str);
+    if (read != 1) return (SnukValue){.type = SNUK_VALUE_NULL};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_FLOAT,
         .float_value = float_value,
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_bool(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_bool(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_BUFFER || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     // Return true if non-empty string
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_BOOL,
-        .bool_value = value.type == SNUK_VALUE_NULL ? false : value.string_value.len != 0,
+        .bool_value = snuk_value_is_true(value),
     };
-
-end:
-    snuk_value_free(value);
-    return ret;
 }
 
-static SnukValue to_str(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue to_str(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_BUFFER || value.type == SNUK_VALUE_NULL))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
     if (value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){
+        return (SnukValue){
             .type = SNUK_VALUE_STRING,
             .string_value = snuk_string_view_create_with_len("\"null\"", 6),
         };
-        goto end;
     }
 
-    ret = snuk_value_copy(value);
-
-end:
-    snuk_value_free(value);
-    return ret;
+    return snuk_value_copy(value);
 }
 
-static SnukValue length(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue length(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    SnukStringView string;
+    if (!str_contents(value, &string)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    ret = (SnukValue){
+    return (SnukValue){
         .type = SNUK_VALUE_INT,
-        .int_value = value.type == SNUK_VALUE_NULL ? 0 : (int64_t)value.string_value.len - 2,
+        .int_value = (int64_t)string.len,
     };
+}
+
+static SnukValue get(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(argc);
+    SnukStringView string;
+    if (!str_contents(value, &string)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    if (value.type == SNUK_VALUE_NULL) return snuk_value_copy(value);
+
+    // start, len
+    if (args[0].type == SNUK_VALUE_NULL) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    int64_t start = args[0].int_value;
+    int64_t len;
+    if (args[1].type == SNUK_VALUE_NULL) len = (int64_t)string.len;
+    else len = args[1].int_value;
+
+    if (start < 0 || start >= (int64_t)string.len) return (SnukValue){.type = SNUK_VALUE_NULL};
+    if (len < 0 || start + len > (int64_t)string.len) return (SnukValue){.type = SNUK_VALUE_NULL};
 
-end:
-    snuk_value_free(value);
-    return ret;
+    return str_slice(value, string, string.str + start, (uint64_t)len);
 }
 
-static SnukValue get(SnukInterpreter *intpret) {
-    SnukValue value = snuk_native_lookup(intpret, "value");
-    SnukValue start_value, len_value;
-    SnukValue ret;
-    if (!(value.type == SNUK_VALUE_STRING || value.type == SNUK_VALUE_NULL)) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+static SnukValue find(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(argc);
+    SnukStringView string, sub;
+    if (!str_contents(value, &string) || !str_contents(args[0], &sub)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    if (value.type == SNUK_VALUE_NULL) {
-        ret = snuk_value_copy(value);
-        goto end;
-    }
+    const char *match = snuk_string_view_find(string, sub);
+    return (SnukValue){
+        .type = SNUK_VALUE_INT,
+        .int_value = match ? (int64_t)(match - string.str) : -1,
+    };
+}
 
-    start_value = snuk_native_lookup(intpret, "start");
-    len_value = snuk_native_lookup(intpret, "len");
+static SnukValue count(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(argc);
+    SnukStringView string, sub;
+    if (!str_contents(value, &string) || !str_contents(args[0], &sub)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    if (start_value.type == SNUK_VALUE_NULL) {
-        ret = (SnukValue){.type = SNUK_VALUE_UNKOWN};
-        goto end;
-    }
+    return (SnukValue){
+        .type = SNUK_VALUE_INT,
+        .int_value = (int64_t)snuk_string_count(string.str, string.len, sub.str, sub.len),
+    };
+}
 
-    int64_t start = start_value.int_value;
-    SnukStringView string = value.string_value;
-    int64_t len;
-    if (len_value.type == SNUK_VALUE_NULL) len = (int64_t)string.len - 2;
-    else len = len_value.int_value;
+static SnukValue starts_with(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(argc);
+    SnukStringView string, prefix;
+    if (!str_contents(value, &string) || !str_contents(args[0], &prefix))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    return (SnukValue){
+        .type = SNUK_VALUE_BOOL,
+        .bool_value = snuk_string_view_starts_with(string, prefix),
+    };
+}
+
+static SnukValue trim(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(args);
+    SNUK_UNUSED(argc);
+    SnukStringView string;
+    if (!str_contents(value, &string)) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    SnukStringView trimmed = snuk_string_view_trim(string);
+    // Nothing to trim, share the original characters
+    if (value.type != SNUK_VALUE_NULL && trimmed.len == string.len) return snuk_value_copy(value);
+    return str_slice(value, string, trimmed.str, trimmed.len);
+}
+
+static SnukValue replace(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(argc);
+    SnukStringView string, old, new;
+    if (!str_contents(value, &string) || !str_contents(args[0], &old) || !str_contents(args[1], &new))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 
-    if (start < 0 || start >= (int64_t)string.len - 2) goto fail;
-    if (len < 0 || start + len > (int64_t)string.len - 2) goto fail;
+    uint64_t matches = snuk_string_count(string.str, string.len, old.str, old.len);
+    if (!matches) return str_slice(value, string, string.str, string.len);
 
+    uint64_t len = string.len - matches * old.len + matches * new.len;
     char *new_str = snuk_alloc((len + 2) * sizeof(char), alignof(char));
-    new_str[0] = '"';
-    memcpy(new_str + 1, string.str + start + 1, len);
-    new_str[len + 1] = '"';
-    ret = (SnukValue){
+    char *out = new_str;
+    *out++ = '"';
+
+    const char *rest = string.str;
+    const char *end = string.str + string.len;
+    for (uint64_t i = 0; i < matches; ++i) {
+        const char *match = snuk_string_find(rest, (uint64_t)(end - rest), old.str, old.len);
+        memcpy(out, rest, (uint64_t)(match - rest));
+        out += match - rest;
+        memcpy(out, new.str, new.len);
+        out += new.len;
+        rest = match + old.len;
+    }
+    memcpy(out, rest, (uint64_t)(end - rest));
+    out += end - rest;
+    *out = '"';
+
+    return (SnukValue){
         .type = SNUK_VALUE_STRING,
         .string_value = snuk_string_view_create_with_len(new_str, len + 2),
     };
+}
 
-end:
-    snuk_value_free(start_value);
-    snuk_value_free(len_value);
-    snuk_value_free(value);
-    return ret;
+/**
+ * @brief Position of a split generator, views into the original string.
+ *
+ * The generator holds the string, sep views a copy stored after the state.
+ */
+typedef struct SplitState {
+    SnukValue source;  // held by the generator
+    SnukStringView string;
+    SnukStringView rest;
+    SnukStringView sep;
+    bool done;
+    char sep_storage[];
+} SplitState;
+
+static bool split_next(SnukInterpreter *intpret, void *state, SnukValue *value) {
+    SNUK_UNUSED(intpret);
+    SplitState *split = (SplitState *)state;
+    if (split->done) return false;
+
+    const char *match = snuk_string_view_find(split->rest, split->sep);
+    if (!match) {
+        *value = str_slice(split->source, split->string, split->rest.str, split->rest.len);
+        split->done = true;
+        return true;
+    }
+
+    uint64_t len = (uint64_t)(match - split->rest.str);
+    *value = str_slice(split->source, split->string, split->rest.str, len);
+    split->rest.str += len + split->sep.len;
+    split->rest.len -= len + split->sep.len;
+    return true;
+}
 
-fail:
-    snuk_value_free(value);
-    return (SnukValue){.type = SNUK_VALUE_NULL};
+static SnukValue split(SnukInterpreter *intpret, SnukValue value, const SnukValue *args, uint64_t argc) {
+    SNUK_UNUSED(argc);
+    SnukStringView string, sep;
+    if (!str_contents(value, &string) || !str_contents(args[0], &sep) || !sep.len)
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    SplitState *state = (SplitState *)snuk_alloc(sizeof(SplitState) + sep.len, alignof(SplitState));
+    *state = (SplitState){
+        .source = value,
+        .string = string,
+        .rest = string,
+        .sep = snuk_string_view_create_with_len(state->sep_storage, sep.len),
+        .done = false,
+    };
+    memcpy(state->sep_storage, sep.str, sep.len);
+    SnukValue generator = snuk_generator_create_native(intpret, split_next, state);
+    // The pieces are read after the receiver is gone, and pieces of a buffer keep sharing it
+    GET_GENERATOR(generator.generator)->source = snuk_value_copy(value);
+    return generator;
 }
@@ -2,31 +2,17 @@
 
 #include "snuk/interpreter/builtins/snuk_builtins.h"
 #include "snuk/interpreter/interpreter_helper.h"
+#include "snuk/interpreter/native.h"
+#include "snuk/interpreter/snuk_bigint.h"
+#include "snuk/interpreter/snuk_buffer.h"
+#include "snuk/interpreter/snuk_generator.h"
 #include "snuk/interpreter/snuk_scope.h"
 #include "snuk/io.h"
 #include "snuk/parser/snuk_var.h"
+#include "snuk/stats.h"
 
 #include <stdio.h>
 
-#define PAGES 10
-
-SNUK_INLINE void *alloc_fn(void *data, uint64_t size, uint64_t align) {
-    snLinearAllocator *la = (snLinearAllocator *)data;
-    return sn_linear_allocator_allocate(la, size, align);
-}
-
-SNUK_INLINE void *realloc_fn(void *data, void *ptr, uint64_t new_size, uint64_t align) {
-    snLinearAllocator *la = (snLinearAllocator *)data;
-    void *new = sn_linear_allocator_allocate(la, new_size, align);
-    memcpy(new, ptr, new_size);
-    return new;
-}
-
-SNUK_INLINE void free_fn(void *data, void *ptr) {
-    SNUK_UNUSED(data);
-    SNUK_UNUSED(ptr);
-}
-
 SnukStringView self_str = {.str = "self", .len = 4};
 
 SnukStringView value_str = {.str = "value", .len = 5};
@@ -35,18 +21,19 @@ static void execute_print_item(SnukInterpreter *intpret, SnukExpr **exprs, bool
 static SnukValue execute_if_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_while_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_for_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
+static SnukValue execute_for_in_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_type_declaration(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
-static SnukValue execute_inst_creation(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
+static SnukValue create_instance(SnukInterpreter *intpret, SnukType *inst_type, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_fn_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_binary_op(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue perform_binary_op(SnukValue left, SnukValue right, SnukTokenType op);
 static SnukValue execute_compound_binary_op(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_unary_op(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
-static SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item, bool weak_ref);
-static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_assign_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
 static SnukValue execute_member_get(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref);
+static SnukValue get_member(SnukInterpreter *intpret, SnukValue type_or_inst, SnukStringView field, bool weak_ref);
+static SnukType *builtin_type_of(SnukValue value);
 static SnukValue execute_extend(SnukInterpreter *intpret, SnukItem *item, bool weak_ref);
 static SnukValue execute_interface(SnukInterpreter *intpret, SnukItem *item, bool weak_ref);
 
@@ -56,17 +43,10 @@ void snuk_interpreter_init(SnukInterpreter *intpret) {
         .signal = SNUK_SIGNAL_NONE,
         .instance = NULL,
         .trash = snuk_darray_create(SnukValue, NULL),
-        .mem = snuk_allocate_pages(PAGES),
-        .allocator = {
-            .data = (void *)&intpret->la,
-            .alloc = alloc_fn,
-            .realloc = realloc_fn,
-            .free = free_fn,
-        },
         .panic_mode = false,
     };
-    sn_linear_allocator_init(&intpret->la, intpret->mem, PAGES * snuk_page_size());
     intpret->current = snuk_ref_counter_retain(intpret->global);
+    snuk_writer_init(&intpret->output, SNUK_WRITER_DEFAULT_CAPACITY, SNUK_FLUSH_ON_FULL);
 
     // Add builtin types
     snuk_builtins_init(intpret);
@@ -77,6 +57,7 @@ void snuk_interpreter_deinit(SnukInterpreter *intpret) {
     if (!intpret) return;
 
     snuk_builtins_deinit(intpret);
+    snuk_writer_deinit(&intpret->output);
 
     interpreter_clear_trash(intpret);
     snuk_darray_destroy(intpret->trash);
@@ -86,9 +67,6 @@ void snuk_interpreter_deinit(SnukInterpreter *intpret) {
     snuk_ref_counter_release(&intpret->current);
     snuk_ref_counter_release(&intpret->global);
 
-    sn_linear_allocator_deinit(&intpret->la);
-    snuk_free_pages(intpret->mem, PAGES);
-
     *intpret = (SnukInterpreter){0};
 }
 
@@ -102,7 +80,7 @@ bool snuk_interpreter_value_is_of_type(SnukInterpreter *intpret, SnukValue value
         return snuk_type_equal(type, value.type_value.type);
 
     if (type->type == TYPE_NAMED) {
-        if (value.type == snuk_builtins_get_value_type(type->name)) return true;
+        if (snuk_builtins_value_type_matches(snuk_builtins_get_value_type(type->name), value.type)) return true;
         if (value.type != SNUK_VALUE_TYPE && value.type != SNUK_VALUE_TYPE_INST) return false;
 
         SnukEnv *env = interpreter_lookup(intpret, type->name);
@@ -137,6 +115,7 @@ bool snuk_interpreter_value_is_of_type(SnukInterpreter *intpret, SnukValue value
                 if (!member && value.type_value.type_scope)
                     member = snuk_scope_lookup(value.type_value.type_scope, members[i]->name);
                 if (!member) return false;
+                interpreter_resolve_env(intpret, member);
                 if (!snuk_interpreter_value_is_of_type(intpret, member->value, members[i]->type)) {
                     return false;
                 }
@@ -170,10 +149,30 @@ bool snuk_interpreter_create_env(
     SNUK_UNUSED(is_const);
     if (!snuk_interpreter_value_is_of_type(intpret, value, type)) return false;
     SnukEnv *env = snuk_env_create(name, type, value);
+    // Global bindings outlive the item, and name and type may point into its AST
+    if (intpret->current == intpret->global && intpret->ast) env->ast = snuk_ref_counter_retain(intpret->ast);
     if (!snuk_scope_add_env(intpret->current, env)) return false;
     return true;
 }
 
+void snuk_interpreter_reset(SnukInterpreter *intpret) {
+    snuk_writer_flush(&intpret->output);
+    interpreter_clear_trash(intpret);
+
+    SNUK_ASSERT(!intpret->instance, "something went wrong");
+
+    snuk_ref_counter_release(&intpret->current);
+    snuk_ref_counter_release(&intpret->global);
+
+    intpret->global = snuk_scope_create(NULL, false);
+    intpret->current = snuk_ref_counter_retain(intpret->global);
+    intpret->signal = SNUK_SIGNAL_NONE;
+    intpret->panic_mode = false;
+    intpret->error = (SnukValue){0};
+
+    snuk_builtins_create_builtin_types(intpret, true);
+}
+
 SnukValue snuk_interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item) {
     interpreter_clear_trash(intpret);
     SnukValue res = interpreter_exec_item(intpret, item, true);
@@ -193,7 +192,7 @@ SnukValue snuk_interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr) {
  * @brief Evaluate a unary expression's operand and apply the operator.
  */
 static SnukValue execute_unary_op(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue value = interpreter_eval_expr(intpret, expr->unary.operand, weak_ref);
+    SnukValue value = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->unary.operand), weak_ref);
     switch (expr->unary.op) {
         case SNUK_TOKEN_PLUS:
             return value;
@@ -201,7 +200,8 @@ static SnukValue execute_unary_op(SnukInterpreter *intpret, SnukExpr *expr, bool
         case SNUK_TOKEN_MINUS:
             switch (value.type) {
                 case SNUK_VALUE_INT:
-                    value.int_value *= -1;
+                case SNUK_VALUE_BIGINT:
+                    value = snuk_bigint_negate(value);
                     break;
                 case SNUK_VALUE_FLOAT:
                     value.float_value *= -1;
@@ -242,6 +242,18 @@ static SnukValue execute_unary_op(SnukInterpreter *intpret, SnukExpr *expr, bool
 }
 
 static SnukValue perform_binary_op(SnukValue left, SnukValue right, SnukTokenType op) {
+    // Any int operand that grew past int64_t takes the slow path
+    if ((left.type == SNUK_VALUE_BIGINT || right.type == SNUK_VALUE_BIGINT)
+        && (left.type == SNUK_VALUE_INT || left.type == SNUK_VALUE_BIGINT)
+        && (right.type == SNUK_VALUE_INT || right.type == SNUK_VALUE_BIGINT))
+        return snuk_bigint_binary_op(left, right, op);
+
+    // A host buffer reads as a string
+    if ((left.type == SNUK_VALUE_BUFFER || right.type == SNUK_VALUE_BUFFER)
+        && (left.type == SNUK_VALUE_STRING || left.type == SNUK_VALUE_BUFFER)
+        && (right.type == SNUK_VALUE_STRING || right.type == SNUK_VALUE_BUFFER))
+        return snuk_buffer_binary_op(left, right, op);
+
     if (left.type != right.type) goto fail;
 
     SnukValue res = {.type = SNUK_VALUE_UNKOWN};
@@ -250,23 +262,29 @@ static SnukValue perform_binary_op(SnukValue left, SnukValue right, SnukTokenTyp
         res.type = left.type;
         switch (op) {
             case SNUK_TOKEN_PLUS:
-                if (left.type == SNUK_VALUE_INT) res.int_value = left.int_value + right.int_value;
-                else res.float_value = left.float_value + right.float_value;
+                if (left.type != SNUK_VALUE_INT) res.float_value = left.float_value + right.float_value;
+                else if (snuk_int_add_overflow(left.int_value, right.int_value, &res.int_value))
+                    return snuk_bigint_binary_op(left, right, op);
                 return res;
 
             case SNUK_TOKEN_MINUS:
-                if (res.type == SNUK_VALUE_INT) res.int_value = left.int_value - right.int_value;
-                else res.float_value = left.float_value - right.float_value;
+                if (res.type != SNUK_VALUE_INT) res.float_value = left.float_value - right.float_value;
+                else if (snuk_int_sub_overflow(left.int_value, right.int_value, &res.int_value))
+                    return snuk_bigint_binary_op(left, right, op);
                 return res;
 
             case SNUK_TOKEN_STAR:
-                if (res.type == SNUK_VALUE_INT) res.int_value = left.int_value * right.int_value;
-                else res.float_value = left.float_value * right.float_value;
+                if (res.type != SNUK_VALUE_INT) res.float_value = left.float_value * right.float_value;
+                else if (snuk_int_mul_overflow(left.int_value, right.int_value, &res.int_value))
+                    return snuk_bigint_binary_op(left, right, op);
                 return res;
 
             case SNUK_TOKEN_SLASH:
-                if (res.type == SNUK_VALUE_INT) res.int_value = left.int_value / right.int_value;
-                else res.float_value = left.float_value / right.float_value;
+                if (res.type != SNUK_VALUE_INT) res.float_value = left.float_value / right.float_value;
+                // INT64_MIN / -1 is the only int division that overflows
+                else if (left.int_value == INT64_MIN && right.int_value == -1)
+                    return snuk_bigint_negate(left);
+                else res.int_value = left.int_value / right.int_value;
                 return res;
 
             case SNUK_TOKEN_LESS:
@@ -294,7 +312,8 @@ static SnukValue perform_binary_op(SnukValue left, SnukValue right, SnukTokenTyp
         res.type = left.type;
         switch (op) {
             case SNUK_TOKEN_PERCENT:
-                res.int_value = left.int_value % right.int_value;
+                // INT64_MIN % -1 traps on some targets
+                res.int_value = right.int_value == -1 ? 0 : left.int_value % right.int_value;
                 return res;
 
             case SNUK_TOKEN_PIPE:
@@ -352,6 +371,10 @@ static SnukValue perform_binary_op(SnukValue left, SnukValue right, SnukTokenTyp
                               left.string_value.str, right.string_value.str, left.string_value.len);
                     break;
 
+                case SNUK_VALUE_GENERATOR:
+                    res.bool_value = left.generator == right.generator;
+                    break;
+
                 // TODO:
                 case SNUK_VALUE_FN:
                     break;
@@ -388,38 +411,39 @@ fail:
     return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 }
 
-static void interpreter_print_type(SnukType *type) {
+static void interpreter_print_type(SnukWriter *out, SnukType *type) {
     uint64_t count;
     switch (type->type) {
         case TYPE_ANY:
-            snuk_print("any", NULL);
+            snuk_writer_write_cstr(out, "any");
             break;
         case TYPE_TYPE:
-            snuk_print("type", NULL);
+            snuk_writer_write_cstr(out, "type");
             break;
 
         case TYPE_NAMED:
-            snuk_print(SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(type->name));
+            snuk_writer_write(out, type->name.str, type->name.len);
             break;
 
         case TYPE_FN:
-            snuk_print("fn(", NULL);
+            snuk_writer_write_cstr(out, "fn(");
             count = snuk_darray_get_length(type->fn.param_types);
             for (uint64_t i = 0; i < count; ++i) {
-                if (i != 0) snuk_print(", ", NULL);
-                interpreter_print_type(type->fn.param_types[i]);
+                if (i != 0) snuk_writer_write_cstr(out, ", ");
+                interpreter_print_type(out, type->fn.param_types[i]);
             }
-            snuk_print(") -> ", NULL);
-            interpreter_print_type(type->fn.return_type);
+            snuk_writer_write_cstr(out, ") -> ");
+            interpreter_print_type(out, type->fn.return_type);
             break;
 
         case TYPE_INTERFACE:
-            snuk_print("interface", NULL);
+            snuk_writer_write_cstr(out, "interface");
             count = snuk_darray_get_length(type->members);
             for (uint64_t i = 0; i < count; ++i) {
-                if (i != 0) snuk_print("; ", NULL);
-                snuk_print(SNUK_STRING_VIEW_FORMAT ": ", SNUK_STRING_VIEW_ARG(type->members[i]->name));
-                interpreter_print_type(type->members[i]->type);
+                if (i != 0) snuk_writer_write_cstr(out, "; ");
+                snuk_writer_write(out, type->members[i]->name.str, type->members[i]->name.len);
+                snuk_writer_write_cstr(out, ": ");
+                interpreter_print_type(out, type->members[i]->type);
             }
             break;
 
@@ -428,79 +452,96 @@ static void interpreter_print_type(SnukType *type) {
     }
 }
 
-static void interpreter_print_value(SnukValue value) {
+static void interpreter_print_value(SnukWriter *out, SnukValue value) {
     uint64_t len;
     SnukScope *scope;
     switch (value.type) {
         case SNUK_VALUE_UNKOWN:
-            snuk_print("Something went wrong, value was UNKNOWN!");
+            snuk_writer_write_cstr(out, "Something went wrong, value was UNKNOWN!");
             break;
 
         case SNUK_VALUE_INT:
-            snuk_print("%ld", value.int_value);
+            snuk_writer_write_int(out, value.int_value);
             break;
 
+        case SNUK_VALUE_BIGINT: {
+            char *buf = (char *)snuk_alloc(snuk_bigint_max_chars(value.bigint), alignof(char));
+            len = snuk_bigint_to_chars(value.bigint, buf);
+            snuk_writer_write(out, buf, len);
+            snuk_free(buf);
+            break;
+        }
+
         case SNUK_VALUE_FLOAT:
-            snuk_print("%lf", value.float_value);
+            snuk_writer_write_float(out, value.float_value);
             break;
 
         case SNUK_VALUE_BOOL:
-            snuk_print("%s", value.bool_value ? "true" : "false");
+            snuk_writer_write_cstr(out, value.bool_value ? "true" : "false");
             break;
 
         case SNUK_VALUE_STRING:
-            if (value.string_value.len > 2)
-                snuk_print(SNUK_STRING_VIEW_FORMAT, (value.string_value.len - 2),
-                           (value.string_value.str + 1));
+            snuk_writer_write(out, value.string_value.str + 1, value.string_value.len - 2);
+            break;
+
+        case SNUK_VALUE_BUFFER:
+            snuk_writer_write(out, value.buffer.view.str, value.buffer.view.len);
             break;
 
         case SNUK_VALUE_NULL:
-            snuk_print("null", NULL);
+            snuk_writer_write_cstr(out, "null");
             break;
 
         case SNUK_VALUE_FN:
-            snuk_print("fn(", NULL);
+            snuk_writer_write_cstr(out, "fn(");
             scope = GET_SCOPE(value.fn_value.closure);
             len = snuk_darray_get_length(scope->vars);
             for (uint64_t i = 0; i < len; ++i) {
-                if (i != 0) snuk_print(", ", NULL);
-                snuk_print(SNUK_STRING_VIEW_FORMAT ": ", SNUK_STRING_VIEW_ARG(scope->vars[i]->name));
-                interpreter_print_type(scope->vars[i]->type);
+                if (i != 0) snuk_writer_write_cstr(out, ", ");
+                snuk_writer_write(out, scope->vars[i]->name.str, scope->vars[i]->name.len);
+                snuk_writer_write_cstr(out, ": ");
+                interpreter_print_type(out, scope->vars[i]->type);
             }
-            snuk_print(") -> ");
-            interpreter_print_type(value.fn_value.type->fn.return_type);
+            snuk_writer_write_cstr(out, ") -> ");
+            interpreter_print_type(out, value.fn_value.type->fn.return_type);
             break;
 
         case SNUK_VALUE_TYPE:
-            snuk_print("type {", NULL);
+            snuk_writer_write_cstr(out, "type {");
             scope = GET_SCOPE(value.type_value.closure);
             len = snuk_darray_get_length(scope->vars);
             for (uint64_t i = 0; i < len; ++i) {
-                if (i != 0) snuk_print("; ", NULL);
+                if (i != 0) snuk_writer_write_cstr(out, "; ");
                 SnukEnv *env = scope->vars[i];
-                snuk_print(SNUK_STRING_VIEW_FORMAT ": ", SNUK_STRING_VIEW_ARG(env->name));
-                interpreter_print_type(env->type);
+                snuk_writer_write(out, env->name.str, env->name.len);
+                snuk_writer_write_cstr(out, ": ");
+                interpreter_print_type(out, env->type);
             }
-            snuk_print("}", NULL);
+            snuk_writer_write_cstr(out, "}");
+            break;
+
+        case SNUK_VALUE_GENERATOR:
+            snuk_writer_write_cstr(out, "generator");
             break;
 
         case SNUK_VALUE_TYPE_INST:
-            snuk_print("type ", NULL);
-            interpreter_print_type(value.type_value.type);
-            snuk_print(" {", NULL);
+            snuk_writer_write_cstr(out, "type ");
+            interpreter_print_type(out, value.type_value.type);
+            snuk_writer_write_cstr(out, " {");
             scope = GET_SCOPE(value.type_value.closure);
             len = snuk_darray_get_length(scope->vars);
             for (uint64_t i = 0; i < len; ++i) {
                 SnukEnv *env = scope->vars[i];
                 if (snuk_string_view_equal_cstr(env->name, "self")) continue;
-                if (i != 0) snuk_print(" ", NULL);
-                snuk_print(SNUK_STRING_VIEW_FORMAT ": ", SNUK_STRING_VIEW_ARG(env->name));
-                interpreter_print_type(env->type);
-                snuk_print(" = ", NULL);
-                interpreter_print_value(env->value);
-                snuk_print(";", NULL);
+                if (i != 0) snuk_writer_write_cstr(out, " ");
+                snuk_writer_write(out, env->name.str, env->name.len);
+                snuk_writer_write_cstr(out, ": ");
+                interpreter_print_type(out, env->type);
+                snuk_writer_write_cstr(out, " = ");
+                interpreter_print_value(out, env->value);
+                snuk_writer_write_cstr(out, ";");
             }
-            snuk_print("}");
+            snuk_writer_write_cstr(out, "}");
             break;
 
         default:
@@ -510,20 +551,23 @@ static void interpreter_print_value(SnukValue value) {
 }
 
 /**
- * @brief Evaluate each expression in the darray and print its value to stdout.
+ * @brief Evaluate each expression in the darray and print its value to the
+ * interpreter's output.
  */
 static void execute_print_item(SnukInterpreter *intpret, SnukExpr **exprs, bool weak_ref) {
     if (!exprs) return;
 
+    SnukWriter *out = &intpret->output;
+
     uint64_t count = snuk_darray_get_length(exprs);
     for (uint64_t i = 0; i < count; ++i) {
         SnukValue value = interpreter_eval_expr(intpret, exprs[i], weak_ref);
-        interpreter_print_value(value);
-        snuk_print(" ", NULL);
+        interpreter_print_value(out, value);
+        snuk_writer_write_cstr(out, " ");
         snuk_value_free(value);
     }
 
-    snuk_println("", NULL);
+    snuk_writer_write(out, "\n", 1);
 }
 
 /**
@@ -534,6 +578,19 @@ SnukValue execute_block_expr(
     SnukInterpreter *intpret, SnukExpr *block, int capture_signals, int propogate_signals, bool weak_ref) {
     interpreter_push_scope(intpret);
 
+    SnukValue value = interpreter_run_block(intpret, block, capture_signals, propogate_signals);
+
+    SnukRefCounter *new_scope = snuk_ref_counter_retain(intpret->current);
+    interpreter_pop_scope(intpret);
+
+    if (weak_ref) snuk_scope_downgrade_parent(new_scope);
+
+    snuk_ref_counter_release(&new_scope);
+
+    return value;
+}
+
+SnukValue interpreter_run_block(SnukInterpreter *intpret, SnukExpr *block, int capture_signals, int propogate_signals) {
     uint64_t count = snuk_darray_get_length(block->block_items);
     SnukValue value = {.type = SNUK_VALUE_NULL};
 
@@ -553,13 +610,6 @@ SnukValue execute_block_expr(
         }
     }
 
-    SnukRefCounter *new_scope = snuk_ref_counter_retain(intpret->current);
-    interpreter_pop_scope(intpret);
-
-    if (weak_ref) snuk_scope_downgrade_parent(new_scope);
-
-    snuk_ref_counter_release(&new_scope);
-
     return value;
 }
 
@@ -567,16 +617,18 @@ SnukValue execute_block_expr(
  * @brief Evaluate an if/else expression by selecting the matching branch block.
  */
 static SnukValue execute_if_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue cond = interpreter_eval_expr(intpret, expr->if_else.condition, weak_ref);
+    SnukValue cond = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->if_else.condition), weak_ref);
     SnukValue res = {.type = SNUK_VALUE_NULL};
 
+    SnukExpr *else_block = snuk_expr_child(expr, expr->if_else.else_block);
     if (snuk_value_is_true(cond)) {
-        res = execute_block_expr(intpret, expr->if_else.then_block, SNUK_SIGNAL_NONE, SNUK_SIGNAL_ALL, weak_ref);
-    } else if (expr->if_else.else_block) {
-        if (expr->if_else.else_block->type == SNUK_EXPR_IF)
-            res = execute_if_expr(intpret, expr->if_else.else_block, weak_ref);
+        res = execute_block_expr(intpret, snuk_expr_child(expr, expr->if_else.then_block), SNUK_SIGNAL_NONE,
+                                 SNUK_SIGNAL_ALL, weak_ref);
+    } else if (else_block) {
+        if (else_block->type == SNUK_EXPR_IF)
+            res = execute_if_expr(intpret, else_block, weak_ref);
         else
-            res = execute_block_expr(intpret, expr->if_else.else_block, SNUK_SIGNAL_NONE, SNUK_SIGNAL_ALL, weak_ref);
+            res = execute_block_expr(intpret, else_block, SNUK_SIGNAL_NONE, SNUK_SIGNAL_ALL, weak_ref);
     }
 
     snuk_value_free(cond);
@@ -594,12 +646,12 @@ static SnukValue execute_while_expr(SnukInterpreter *intpret, SnukExpr *expr, bo
 loop_start:
     if (expr->type == SNUK_EXPR_WHILE) {
         snuk_value_free(cond);
-        cond = interpreter_eval_expr(intpret, expr->while_loop.condition, weak_ref);
+        cond = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->while_loop.condition), weak_ref);
         if (!snuk_value_is_true(cond)) goto end;
     }
 
     snuk_value_free(res);
-    res = execute_block_expr(intpret, expr->while_loop.body, SNUK_SIGNAL_CONTINUE,
+    res = execute_block_expr(intpret, snuk_expr_child(expr, expr->while_loop.body), SNUK_SIGNAL_CONTINUE,
                              SNUK_SIGNAL_RETURN | SNUK_SIGNAL_BREAK, weak_ref);
 
     switch (intpret->signal) {
@@ -622,7 +674,7 @@ loop_start:
 
     if (expr->type == SNUK_EXPR_DO_WHILE) {
         snuk_value_free(cond);
-        cond = interpreter_eval_expr(intpret, expr->while_loop.condition, weak_ref);
+        cond = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->while_loop.condition), weak_ref);
         if (!snuk_value_is_true(cond)) goto end;
     }
 
@@ -642,22 +694,26 @@ static SnukValue execute_for_expr(SnukInterpreter *intpret, SnukExpr *expr, bool
     SnukValue res = {.type = SNUK_VALUE_NULL};
     SnukValue cond = {.type = SNUK_VALUE_NULL};
 
-    if (expr->for_loop.init) {
-        SnukValue val = interpreter_exec_item(intpret, expr->for_loop.init, false);
+    SnukForExpr *loop = expr->for_loop;
+    SnukExpr *condition = snuk_expr_child(expr, loop->condition);
+    SnukExpr *update = snuk_expr_child(expr, loop->update);
+    SnukExpr *body = snuk_expr_child(expr, loop->body);
+
+    if (loop->init) {
+        SnukValue val = interpreter_exec_item(intpret, loop->init, false);
         SNUK_INTERPRETER_CHECK(intpret, intpret->signal == SNUK_SIGNAL_NONE, "signal is not none");
         snuk_value_free(val);
     }
 
 loop_start:
-    if (expr->for_loop.condition) {
+    if (condition) {
         snuk_value_free(cond);
-        cond = interpreter_eval_expr(intpret, expr->for_loop.condition, false);
+        cond = interpreter_eval_expr(intpret, condition, false);
         if (!snuk_value_is_true(cond)) goto end;
     }
 
     snuk_value_free(res);
-    res = execute_block_expr(
-        intpret, expr->for_loop.body, SNUK_SIGNAL_CONTINUE, SNUK_SIGNAL_RETURN | SNUK_SIGNAL_BREAK, false);
+    res = execute_block_expr(intpret, body, SNUK_SIGNAL_CONTINUE, SNUK_SIGNAL_RETURN | SNUK_SIGNAL_BREAK, false);
 
     switch (intpret->signal) {
         case SNUK_SIGNAL_RETURN:
@@ -677,8 +733,8 @@ loop_start:
             break;
     }
 
-    if (expr->for_loop.update) {
-        SnukValue val = interpreter_eval_expr(intpret, expr->for_loop.update, false);
+    if (update) {
+        SnukValue val = interpreter_eval_expr(intpret, update, false);
         snuk_value_free(val);
     }
 
@@ -697,12 +753,59 @@ end:
     return res;
 }
 
+/**
+ * @brief Execute a for-in loop, resuming the generator once per iteration and
+ * binding the yielded value to the loop variable.
+ */
+static SnukValue execute_for_in_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
+    SnukValue iterable = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->for_in.iterable), weak_ref);
+    SNUK_INTERPRETER_CHECK(intpret, iterable.type == SNUK_VALUE_GENERATOR, "for-in loop over non generator");
+
+    interpreter_push_scope(intpret);
+    SnukValue res = {.type = SNUK_VALUE_NULL};
+    SnukValue value = {.type = SNUK_VALUE_NULL};
+
+    SNUK_UNUSED(snuk_interpreter_create_env(intpret, *expr->for_in.name, &any_type, value, false));
+    SnukEnv *env = snuk_scope_lookup(intpret->current, *expr->for_in.name);
+    SnukExpr *body = snuk_expr_child(expr, expr->for_in.body);
+
+    while (snuk_generator_next(intpret, iterable.generator, &value)) {
+        if (value.type == SNUK_VALUE_ERROR) {
+            snuk_value_free(res);
+            res = value;
+            break;
+        }
+
+        snuk_env_assign_value(env, value);
+        snuk_value_free(value);
+
+        snuk_value_free(res);
+        res = execute_block_expr(intpret, body, SNUK_SIGNAL_CONTINUE, SNUK_SIGNAL_RETURN | SNUK_SIGNAL_BREAK, false);
+
+        if (intpret->signal == SNUK_SIGNAL_RETURN) break;
+        if (intpret->signal == SNUK_SIGNAL_BREAK) {
+            intpret->signal = SNUK_SIGNAL_NONE;
+            break;
+        }
+    }
+
+    SnukRefCounter *new_scope = snuk_ref_counter_retain(intpret->current);
+    interpreter_pop_scope(intpret);
+
+    if (weak_ref) snuk_scope_downgrade_parent(new_scope);
+
+    snuk_ref_counter_release(&new_scope);
+
+    snuk_value_free(iterable);
+    return res;
+}
+
 static SnukValue execute_type_declaration(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
     interpreter_push_scope(intpret);
 
-    uint64_t count = snuk_darray_get_length(expr->type_expr.members);
+    uint64_t count = snuk_darray_get_length(expr->type_expr->members);
     for (uint64_t i = 0; i < count; ++i) {
-        SnukValue val = interpreter_exec_item(intpret, expr->type_expr.members[i], true);
+        SnukValue val = interpreter_exec_item(intpret, expr->type_expr->members[i], true);
         SNUK_INTERPRETER_CHECK(intpret, intpret->signal == SNUK_SIGNAL_NONE, "signal is not none");
         snuk_value_free(val);
     }
@@ -710,7 +813,7 @@ static SnukValue execute_type_declaration(SnukInterpreter *intpret, SnukExpr *ex
     SnukValue value = {
         .type = SNUK_VALUE_TYPE,
         .type_value = {
-            .type = expr->type_expr.type,
+            .type = expr->type_expr->type,
             .closure = snuk_ref_counter_retain(intpret->current),
             .weak_ref = false,
         },
@@ -719,19 +822,24 @@ static SnukValue execute_type_declaration(SnukInterpreter *intpret, SnukExpr *ex
     interpreter_pop_scope(intpret);
 
     if (weak_ref) snuk_scope_downgrade_parent(value.type_value.closure);
+    interpreter_hold_ast(intpret, value.type_value.closure);
 
     // Syntax sugar
-    if (expr->type_expr.name.len)
+    if (expr->type_expr->name.len)
         SNUK_INTERPRETER_CHECK(
             intpret,
-            snuk_interpreter_create_env(intpret, expr->type_expr.name, value.type_value.type, value, false),
+            snuk_interpreter_create_env(intpret, expr->type_expr->name, value.type_value.type, value, false),
             "type name is already used");
 
     return value;
 }
 
-static SnukValue execute_inst_creation(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue type = snuk_interpreter_get_env(intpret, expr->type_inst_expr.type->name);
+/**
+ * @brief Create an instance of inst_type, running the initializers of the
+ * type instance expression expr if there is one.
+ */
+static SnukValue create_instance(SnukInterpreter *intpret, SnukType *inst_type, SnukExpr *expr, bool weak_ref) {
+    SnukValue type = snuk_interpreter_get_env(intpret, inst_type->name);
     SNUK_INTERPRETER_CHECK(intpret, type.type == SNUK_VALUE_TYPE, "type instance creation expression on non type");
 
     // We will copy the values from type to instance only when it is assigned.
@@ -744,25 +852,26 @@ static SnukValue execute_inst_creation(SnukInterpreter *intpret, SnukExpr *expr,
     SnukValue value = {
         .type = SNUK_VALUE_TYPE_INST,
         .type_value = {
-            .type = expr->type_inst_expr.type,
+            .type = inst_type,
             .closure = snuk_ref_counter_retain(intpret->current),
             .weak_ref = false,
             .type_scope = snuk_ref_counter_retain(type.type_value.closure),
         },
     };
 
-    uint64_t init_count = snuk_darray_get_length(expr->type_inst_expr.init);
+    uint64_t init_count = expr ? snuk_darray_get_length(expr->type_inst_expr->init) : 0;
     for (uint64_t i = 0; i < init_count; ++i) {
-        SnukExpr *assign = expr->type_inst_expr.init[i];
+        SnukExpr *assign = snuk_expr_child(expr, expr->type_inst_expr->init[i]);
         SNUK_INTERPRETER_CHECK(intpret, assign->type == SNUK_EXPR_ASSIGN, "Expected assign expressions");
-        SnukStringView name = assign->assign.identifier->identifier;
+        SnukStringView name = snuk_expr_child(assign, assign->assign.identifier)->identifier;
         // The instance itself is the closure, so not adding instance scope
-        SnukValue val = interpreter_eval_expr(intpret, assign->assign.value, true);
+        SnukValue val = interpreter_eval_expr(intpret, snuk_expr_child(assign, assign->assign.value), true);
 
         // if builtin type, make sure value of value member is right
         SnukValueType val_type = snuk_builtins_get_value_type(value.type_value.type->name);
         if (val_type != SNUK_VALUE_UNKOWN && snuk_string_view_equal(name, value_str))
-            SNUK_INTERPRETER_CHECK(intpret, val.type == val_type, "invalid value to the member value");
+            SNUK_INTERPRETER_CHECK(intpret, snuk_builtins_value_type_matches(val_type, val.type),
+                                   "invalid value to the member value");
 
         SNUK_INTERPRETER_CHECK(intpret, interpreter_set_member(intpret, value, name, val), "failed to initialize member");
         snuk_value_free(val);
@@ -781,12 +890,13 @@ static SnukValue execute_inst_creation(SnukInterpreter *intpret, SnukExpr *expr,
     interpreter_pop_scope(intpret);
 
     if (weak_ref) snuk_scope_downgrade_parent(value.type_value.closure);
+    interpreter_hold_ast(intpret, value.type_value.closure);
 
     // Syntax sugar
-    if (expr->type_inst_expr.name.len)
+    if (expr && expr->type_inst_expr->name.len)
         SNUK_INTERPRETER_CHECK(
             intpret,
-            snuk_interpreter_create_env(intpret, expr->type_inst_expr.name, value.type_value.type, value, false),
+            snuk_interpreter_create_env(intpret, expr->type_inst_expr->name, value.type_value.type, value, false),
             "type instance name already exists");
 
     interpreter_trash(intpret, type);
@@ -831,32 +941,25 @@ static SnukValue execute_compound_binary_op(SnukInterpreter *intpret, SnukExpr *
             break;
     }
 
-    SnukExpr binary_expr = {
-        .type = SNUK_EXPR_BINARY,
-        .binary = {
-            .op = op,
-            .left = expr->compound_assign.identifier,
-            .right = expr->compound_assign.value,
-        },
-    };
-
-    SnukExpr assign_expr = {
-        .type = SNUK_EXPR_ASSIGN,
-        .assign = {
-            .identifier = expr->compound_assign.identifier,
-            .value = &binary_expr,
-        },
-    };
+    // Parsing makes sure the target is an identifier
+    SnukExpr *identifier = snuk_expr_child(expr, expr->compound_assign.identifier);
+    SnukValue left = interpreter_eval_expr(intpret, identifier, weak_ref);
+    SnukValue right = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->compound_assign.value), weak_ref);
+    SnukValue value = perform_binary_op(left, right, op);
+    snuk_value_free(left);
+    snuk_value_free(right);
 
-    return interpreter_eval_expr(intpret, &assign_expr, weak_ref);
+    SNUK_INTERPRETER_CHECK(intpret, snuk_interpreter_set_env(intpret, identifier->identifier, value),
+                           "failed to set env value");
+    return value;
 }
 
 static SnukValue execute_fn_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
     interpreter_push_scope(intpret);
 
-    uint64_t param_count = snuk_darray_get_length(expr->fn_expr.params);
+    uint64_t param_count = snuk_darray_get_length(expr->fn_expr->params);
     for (uint64_t i = 0; i < param_count; ++i) {
-        SnukVar *param = expr->fn_expr.params[i];
+        SnukVar *param = expr->fn_expr->params[i];
         SnukValue value = (SnukValue){.type = SNUK_VALUE_UNKOWN};
         if (param->value) value = interpreter_eval_expr(intpret, param->value, false);
         SNUK_INTERPRETER_CHECK(
@@ -871,33 +974,139 @@ static SnukValue execute_fn_expr(SnukInterpreter *intpret, SnukExpr *expr, bool
             .closure = snuk_ref_counter_retain(intpret->current),
             .weak_ref = false,
             .instance = NULL,
-            .body = expr->fn_expr.body,
-            .type = expr->fn_expr.type,
+            .body = expr->fn_expr->body,
+            .type = expr->fn_expr->type,
+            .is_generator = expr->fn_expr->is_generator,
         },
     };
 
     interpreter_pop_scope(intpret);
 
     if (weak_ref) snuk_scope_downgrade_parent(value.fn_value.closure);
+    interpreter_hold_ast(intpret, value.fn_value.closure);
 
     // Syntax sugar
-    if (expr->fn_expr.name.len)
+    if (expr->fn_expr->name.len)
         SNUK_INTERPRETER_CHECK(
-            intpret, snuk_interpreter_create_env(intpret, expr->fn_expr.name, value.fn_value.type, value, false),
+            intpret, snuk_interpreter_create_env(intpret, expr->fn_expr->name, value.fn_value.type, value, false),
             "function name is already used");
 
     return value;
 }
 
+/**
+ * @brief Call a fast native with the call's arguments in parameter order,
+ * without a scope for them. fn and receiver stay owned by the caller.
+ */
+static SnukValue call_fast_native(SnukInterpreter *intpret, SnukExpr *expr, SnukValue fn, SnukValue receiver) {
+    SnukScope *fn_scope = GET_SCOPE(fn.native_fn.closure);
+
+    uint64_t fn_param_count = snuk_darray_get_length(fn_scope->vars);
+    uint64_t param_count = snuk_darray_get_length(expr->call.params);
+
+    SNUK_INTERPRETER_CHECK(intpret, fn_param_count >= param_count, "param count mismatch");
+
+    SnukValue args[SNUK_NATIVE_MAX_ARGS];
+    uint64_t given = 0;  // bit per parameter with a value in args
+    const char *err_msg = NULL;
+    bool named_params = false;
+    for (uint64_t i = 0; i < param_count && !err_msg; ++i) {
+        SnukExpr *param = snuk_expr_child(expr, expr->call.params[i]);
+        uint64_t index = i;
+        SnukExpr *value = param;
+
+        if (param->type == SNUK_EXPR_ASSIGN) {
+            named_params = true;
+            index = interpreter_param_index(fn_scope, snuk_expr_child(param, param->assign.identifier)->identifier);
+            value = snuk_expr_child(param, param->assign.value);
+            if (index == fn_param_count) err_msg = "parameter doesn't exists";
+        } else if (named_params || param->type == SNUK_EXPR_COMPOUND_ASSIGN) {
+            err_msg = "Parameter error";
+        }
+        if (!err_msg && given & (1ull << index)) err_msg = "something went wrong while creating parameter";
+        if (err_msg) break;
+
+        SnukValue val = interpreter_eval_expr(intpret, value, true);
+        if (!snuk_interpreter_value_is_of_type(intpret, val, fn_scope->vars[index]->type)) {
+            snuk_value_free(val);
+            err_msg = "something went wrong while creating parameter";
+            break;
+        }
+        args[index] = val;
+        given |= 1ull << index;
+    }
+
+    // Fill the rest with default values
+    for (uint64_t i = 0; i < fn_param_count && !err_msg; ++i) {
+        if (given & (1ull << i)) continue;
+        SnukEnv *fn_env = fn_scope->vars[i];
+        if (fn_env->value.type == SNUK_VALUE_UNKOWN) {
+            err_msg = "parameter was not given";
+            break;
+        }
+        args[i] = snuk_value_copy(fn_env->value);
+        given |= 1ull << i;
+    }
+
+    SnukValue ret;
+    if (err_msg) ret = interpreter_error(intpret, err_msg);
+    else ret = fn.native_fn.fast(intpret, receiver, args, fn_param_count);
+
+    for (uint64_t i = 0; i < fn_param_count; ++i)
+        if (given & (1ull << i)) snuk_value_free(args[i]);
+    return ret;
+}
+
+/**
+ * @brief Method of a primitive's builtin type, without wrapping the
+ * primitive in an instance. NULL if value is not a primitive or has no
+ * such member.
+ */
+static SnukEnv *builtin_method_env(SnukInterpreter *intpret, SnukValue value, SnukStringView field) {
+    SnukType *type = builtin_type_of(value);
+    if (!type) return NULL;
+
+    SnukEnv *type_env = interpreter_lookup(intpret, type->name);
+    if (!type_env || type_env->value.type != SNUK_VALUE_TYPE) return NULL;
+    return interpreter_get_member_env(intpret, type_env->value, field);
+}
+
 /**
  * @brief Bind call arguments to a function's parameters in a new scope and
  * execute its body.
  */
 static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue fn = interpreter_eval_expr(intpret, expr->call.fn, weak_ref);
+    SnukExpr *callee = snuk_expr_child(expr, expr->call.fn);
+    SnukValue fn;
+    if (callee->type == SNUK_EXPR_MEMBER) {
+        SnukValue receiver
+            = interpreter_eval_expr(intpret, snuk_expr_child(callee, callee->member_access.type), weak_ref);
+        SnukStringView field = snuk_expr_child(callee, callee->member_access.field)->identifier;
+
+        // Fast methods of primitives take the receiver as it is
+        SnukEnv *method = builtin_method_env(intpret, receiver, field);
+        if (method && method->value.type == SNUK_VALUE_FN_NATIVE && method->value.native_fn.fast) {
+            // Arguments may run code that extends the type and replaces the method
+            fn = snuk_value_copy(method->value);
+            SnukValue ret = call_fast_native(intpret, expr, fn, receiver);
+            snuk_value_free(fn);
+            snuk_value_free(receiver);
+            return ret;
+        }
+
+        fn = get_member(intpret, receiver, field, weak_ref);
+    } else {
+        fn = interpreter_eval_expr(intpret, callee, weak_ref);
+    }
     SNUK_INTERPRETER_CHECK(intpret, fn.type == SNUK_VALUE_FN || fn.type == SNUK_VALUE_FN_NATIVE,
                            "call expression on non function");
 
+    if (fn.type == SNUK_VALUE_FN_NATIVE && fn.native_fn.fast) {
+        SnukValue ret = call_fast_native(intpret, expr, fn, interpreter_fast_receiver(fn));
+        interpreter_trash(intpret, fn);
+        return ret;
+    }
+
     SnukRefCounter *fn_scope_rc = NULL;
     if (fn.type == SNUK_VALUE_FN) fn_scope_rc = fn.fn_value.closure;
     else fn_scope_rc = fn.native_fn.closure;
@@ -921,7 +1130,7 @@ static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, boo
     bool named_params = false;
     for (uint64_t i = 0; i < param_count; ++i) {
         // NOTE: we are storing in darray, so order is maintained
-        SnukExpr *param = expr->call.params[i];
+        SnukExpr *param = snuk_expr_child(expr, expr->call.params[i]);
         SnukEnv *fn_env = fn_scope->vars[i];
 
         SnukStringView name;
@@ -930,11 +1139,11 @@ static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, boo
 
         if (param->type == SNUK_EXPR_ASSIGN) {
             named_params = true;
-            name = param->assign.identifier->identifier;
+            name = snuk_expr_child(param, param->assign.identifier)->identifier;
             fn_env = snuk_scope_lookup(fn_scope_rc, name);
             SNUK_INTERPRETER_CHECK(intpret, fn_env, "parameter doesn't exists");
             type = fn_env->type;
-            value = param->assign.value;
+            value = snuk_expr_child(param, param->assign.value);
         } else if (!named_params && param->type != SNUK_EXPR_COMPOUND_ASSIGN) {
             name = fn_env->name;
             type = fn_env->type;
@@ -973,11 +1182,18 @@ static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, boo
     SnukRefCounter *temp = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&new_scope);
 
+    // The body's literals belong to the item that defined the function
+    SnukRefCounter *caller_ast = intpret->ast;
+    if (fn.type == SNUK_VALUE_FN) intpret->ast = fn_scope->ast;
+
     SnukValue ret;
-    if (fn.type == SNUK_VALUE_FN)
+    if (fn.type == SNUK_VALUE_FN && fn.fn_value.is_generator)
+        ret = snuk_generator_create(intpret, fn.fn_value.body);
+    else if (fn.type == SNUK_VALUE_FN)
         ret = execute_block_expr(intpret, fn.fn_value.body, SNUK_SIGNAL_RETURN, SNUK_SIGNAL_NONE, false);
     else ret = fn.native_fn.fn(intpret);
 
+    intpret->ast = caller_ast;
     new_scope = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&temp);
 
@@ -992,7 +1208,7 @@ static SnukValue execute_call_expr(SnukInterpreter *intpret, SnukExpr *expr, boo
 }
 
 static SnukValue execute_binary_op(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue left = interpreter_eval_expr(intpret, expr->binary.left, weak_ref);
+    SnukValue left = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->binary.left), weak_ref);
     SnukValue right;
     switch (expr->binary.op) {
         case SNUK_TOKEN_PIPE_PIPE:
@@ -1000,7 +1216,7 @@ static SnukValue execute_binary_op(SnukInterpreter *intpret, SnukExpr *expr, boo
             bool bool_value = snuk_value_is_true(left);
             snuk_value_free(left);
             if (!bool_value) {
-                right = interpreter_eval_expr(intpret, expr->binary.right, weak_ref);
+                right = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->binary.right), weak_ref);
                 bool_value = snuk_value_is_true(right);
                 snuk_value_free(right);
             }
@@ -1016,7 +1232,7 @@ static SnukValue execute_binary_op(SnukInterpreter *intpret, SnukExpr *expr, boo
             bool bool_value = snuk_value_is_true(left);
             snuk_value_free(left);
             if (bool_value) {
-                right = interpreter_eval_expr(intpret, expr->binary.right, weak_ref);
+                right = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->binary.right), weak_ref);
                 bool_value = snuk_value_is_true(right);
                 snuk_value_free(right);
             }
@@ -1031,14 +1247,14 @@ static SnukValue execute_binary_op(SnukInterpreter *intpret, SnukExpr *expr, boo
             break;
     }
 
-    right = interpreter_eval_expr(intpret, expr->binary.right, weak_ref);
+    right = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->binary.right), weak_ref);
     SnukValue res = perform_binary_op(left, right, expr->binary.op);
     snuk_value_free(left);
     snuk_value_free(right);
     return res;
 }
 
-static SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item, bool weak_ref) {
+SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item, bool weak_ref) {
     switch (item->type) {
         case SNUK_ITEM_EXPR:
             return interpreter_eval_expr(intpret, item->expr, weak_ref);
@@ -1071,6 +1287,10 @@ static SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item,
             intpret->signal = SNUK_SIGNAL_CONTINUE;
             return (SnukValue){.type = SNUK_VALUE_NULL};
 
+        // Generator bodies handle yield items themselves
+        case SNUK_ITEM_YIELD:
+            return interpreter_error(intpret, "yield is only allowed as an item of a generator body");
+
         case SNUK_ITEM_EXTEND:
             return execute_extend(intpret, item, weak_ref);
 
@@ -1078,7 +1298,8 @@ static SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item,
             return execute_interface(intpret, item, weak_ref);
 
         case SNUK_ITEM_ERROR:
-            log_error("Error: %s", item->error.msg);
+            log_error("Error at %" PRIu64 ":%" PRIu64 ": %s", item->error.line + 1, item->error.col + 1,
+                      item->error.msg);
             return (SnukValue){.type = SNUK_VALUE_NULL};
 
         case SNUK_ITEM_MAX:
@@ -1090,7 +1311,7 @@ static SnukValue interpreter_exec_item(SnukInterpreter *intpret, SnukItem *item,
     return (SnukValue){.type = SNUK_VALUE_UNKOWN};
 }
 
-static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
+SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
     switch (expr->type) {
         case SNUK_EXPR_IDENTIFIER:
             return snuk_interpreter_get_env(intpret, expr->identifier);
@@ -1108,9 +1329,11 @@ static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr,
             };
 
         case SNUK_EXPR_STRING:
+            // The value is a view of the literal
             return (SnukValue){
                 .type = SNUK_VALUE_STRING,
                 .string_value = expr->string_literal,
+                .string_owner = intpret->ast ? snuk_ref_counter_retain(intpret->ast) : NULL,
             };
 
         case SNUK_EXPR_BOOL:
@@ -1150,6 +1373,9 @@ static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr,
         case SNUK_EXPR_FOR:
             return execute_for_expr(intpret, expr, weak_ref);
 
+        case SNUK_EXPR_FOR_IN:
+            return execute_for_in_expr(intpret, expr, weak_ref);
+
         case SNUK_EXPR_FN:
             return execute_fn_expr(intpret, expr, weak_ref);
 
@@ -1157,7 +1383,7 @@ static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr,
             return execute_type_declaration(intpret, expr, weak_ref);
 
         case SNUK_EXPR_TYPE_INST:
-            return execute_inst_creation(intpret, expr, weak_ref);
+            return create_instance(intpret, expr->type_inst_expr->type, expr, weak_ref);
 
         case SNUK_EXPR_BLOCK:
             return execute_block_expr(
@@ -1191,8 +1417,8 @@ static SnukValue interpreter_eval_expr(SnukInterpreter *intpret, SnukExpr *expr,
 }
 
 static SnukValue execute_assign_expr(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue value = interpreter_eval_expr(intpret, expr->assign.value, weak_ref);
-    SnukExpr *identifier = expr->assign.identifier;
+    SnukValue value = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->assign.value), weak_ref);
+    SnukExpr *identifier = snuk_expr_child(expr, expr->assign.identifier);
     switch (identifier->type) {
         case SNUK_EXPR_IDENTIFIER:
             SNUK_INTERPRETER_CHECK(intpret, snuk_interpreter_set_env(intpret, identifier->identifier, value),
@@ -1200,8 +1426,9 @@ static SnukValue execute_assign_expr(SnukInterpreter *intpret, SnukExpr *expr, b
             break;
 
         case SNUK_EXPR_MEMBER: {
-            SnukExpr *field = identifier->member_access.field;
-            SnukValue type_or_inst = interpreter_eval_expr(intpret, identifier->member_access.type, weak_ref);
+            SnukExpr *field = snuk_expr_child(identifier, identifier->member_access.field);
+            SnukValue type_or_inst
+                = interpreter_eval_expr(intpret, snuk_expr_child(identifier, identifier->member_access.type), weak_ref);
             SNUK_INTERPRETER_CHECK(
                 intpret, interpreter_set_member(intpret, type_or_inst, field->identifier, value),
                 "failed to set env value");
@@ -1216,74 +1443,51 @@ static SnukValue execute_assign_expr(SnukInterpreter *intpret, SnukExpr *expr, b
     return value;
 }
 
-static SnukValue execute_member_get(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
-    SnukValue type_or_inst = interpreter_eval_expr(intpret, expr->member_access.type, weak_ref);
+/**
+ * @brief Builtin type whose methods a primitive value has, NULL for values
+ * that are not primitives.
+ */
+static SnukType *builtin_type_of(SnukValue value) {
+    switch (value.type) {
+        case SNUK_VALUE_INT:
+        case SNUK_VALUE_BIGINT:
+            return &int_type;
+        case SNUK_VALUE_FLOAT:
+            return &float_type;
+        case SNUK_VALUE_BOOL:
+            return &bool_type;
+        case SNUK_VALUE_STRING:
+        case SNUK_VALUE_BUFFER:
+            return &str_type;
+        case SNUK_VALUE_GENERATOR:
+            return &generator_type;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Read a member of an evaluated value, wrapping primitives in an
+ * instance of their builtin type. Takes ownership of type_or_inst.
+ */
+static SnukValue get_member(SnukInterpreter *intpret, SnukValue type_or_inst, SnukStringView field, bool weak_ref) {
     SnukValue res;
     if (type_or_inst.type == SNUK_VALUE_TYPE || type_or_inst.type == SNUK_VALUE_TYPE_INST) {
-        res = interpreter_get_member(intpret, type_or_inst, expr->member_access.field->identifier);
+        res = interpreter_get_member(intpret, type_or_inst, field);
     } else if (type_or_inst.type == SNUK_VALUE_NULL) {
-        res = builtin_null_get_member(intpret, expr->member_access.field->identifier);
+        res = builtin_null_get_member(intpret, field);
     } else {
-        SnukExpr inst_expr = {
-            .type = SNUK_EXPR_TYPE_INST,
-            .type_inst_expr = {
-                .type = NULL,
-                .name = (SnukStringView){0},
-                .init = snuk_darray_create(SnukExpr *, &intpret->allocator),
-            },
-        };
-
-        SnukExpr value_expr;
-
-        switch (type_or_inst.type) {
-            case SNUK_VALUE_INT:
-                inst_expr.type_inst_expr.type = &int_type;
-                value_expr = (SnukExpr){
-                    .type = SNUK_EXPR_INT,
-                    .int_literal = type_or_inst.int_value,
-                };
-                break;
-            case SNUK_VALUE_FLOAT:
-                inst_expr.type_inst_expr.type = &float_type;
-                value_expr = (SnukExpr){
-                    .type = SNUK_EXPR_FLOAT,
-                    .float_literal = type_or_inst.float_value,
-                };
-                break;
-            case SNUK_VALUE_BOOL:
-                inst_expr.type_inst_expr.type = &bool_type;
-                value_expr = (SnukExpr){
-                    .type = SNUK_EXPR_BOOL,
-                    .bool_literal = type_or_inst.bool_value,
-                };
-                break;
-            case SNUK_VALUE_STRING:
-                inst_expr.type_inst_expr.type = &str_type;
-                value_expr = (SnukExpr){
-                    .type = SNUK_EXPR_STRING,
-                    .string_literal = type_or_inst.string_value,
-                };
-                break;
-            default:
-                SNUK_SHOULD_NOT_REACH_HERE;
-                break;
-        }
-
-        SnukExpr identifier_expr = {
-            .type = SNUK_EXPR_IDENTIFIER,
-            .identifier = value_str,
-        };
-
-        SnukExpr assign_expr = {
-            .type = SNUK_EXPR_ASSIGN,
-            .assign = {.identifier = &identifier_expr, .value = &value_expr},
-        };
-
-        snuk_darray_push(&inst_expr.type_inst_expr.init, &assign_expr);
+        SnukType *inst_type = builtin_type_of(type_or_inst);
+        if (!inst_type) SNUK_SHOULD_NOT_REACH_HERE;
+
+        // Wrap the primitive, the value member is set after creation
+        SnukValue value = type_or_inst;
+        type_or_inst = create_instance(intpret, inst_type, NULL, weak_ref);
+        SNUK_INTERPRETER_CHECK(intpret, interpreter_set_member(intpret, type_or_inst, value_str, value),
+                               "failed to initialize member");
+        snuk_value_free(value);
 
-        snuk_value_free(type_or_inst);
-        type_or_inst = execute_inst_creation(intpret, &inst_expr, weak_ref);
-        res = interpreter_get_member(intpret, type_or_inst, expr->member_access.field->identifier);
+        res = interpreter_get_member(intpret, type_or_inst, field);
     }
 
     // insert the instance scope
@@ -1300,12 +1504,19 @@ static SnukValue execute_member_get(SnukInterpreter *intpret, SnukExpr *expr, bo
     return res;
 }
 
+static SnukValue execute_member_get(SnukInterpreter *intpret, SnukExpr *expr, bool weak_ref) {
+    SnukValue type_or_inst = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->member_access.type), weak_ref);
+    SnukStringView field = snuk_expr_child(expr, expr->member_access.field)->identifier;
+    return get_member(intpret, type_or_inst, field, weak_ref);
+}
+
 static SnukValue execute_extend(SnukInterpreter *intpret, SnukItem *item, bool weak_ref) {
     SnukValue type = interpreter_eval_expr(intpret, item->extend_item.type, weak_ref);
     SNUK_INTERPRETER_CHECK(intpret, type.type == SNUK_VALUE_TYPE, "trying to extend non type");
 
     SnukRefCounter *temp = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&type.type_value.closure);
+    uint64_t first_member = snuk_darray_get_length(GET_SCOPE(intpret->current)->vars);
 
     uint64_t count = snuk_darray_get_length(item->extend_item.members);
     for (uint64_t i = 0; i < count; ++i) {
@@ -1314,6 +1525,12 @@ static SnukValue execute_extend(SnukInterpreter *intpret, SnukItem *item, bool w
         snuk_value_free(val);
     }
 
+    // The type outlives this item, the new members are named by its AST
+    SnukScope *scope = GET_SCOPE(intpret->current);
+    uint64_t member_count = snuk_darray_get_length(scope->vars);
+    for (uint64_t i = first_member; intpret->ast && i < member_count; ++i)
+        scope->vars[i]->ast = snuk_ref_counter_retain(intpret->ast);
+
     type.type_value.closure = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&temp);
 
@@ -3,6 +3,7 @@
 #include "snuk/darray.h"
 #include "snuk/interpreter/builtins/snuk_builtins.h"
 #include "snuk/interpreter/interpreter_helper.h"
+#include "snuk/interpreter/snuk_generator.h"
 
 SnukValue snuk_native_lookup(SnukInterpreter *intpret, const char *name) {
     return snuk_interpreter_get_env(intpret, snuk_string_view_create(name));
@@ -22,6 +23,7 @@ SnukValue snuk_native_get_member(SnukInterpreter *intpret, SnukValue type_or_ins
         };
         switch (type_or_inst.type) {
             case SNUK_VALUE_INT:
+            case SNUK_VALUE_BIGINT:
                 members[0].type = &int_type;
                 break;
             case SNUK_VALUE_FLOAT:
@@ -31,8 +33,12 @@ SnukValue snuk_native_get_member(SnukInterpreter *intpret, SnukValue type_or_ins
                 members[0].type = &bool_type;
                 break;
             case SNUK_VALUE_STRING:
+            case SNUK_VALUE_BUFFER:
                 members[0].type = &str_type;
                 break;
+            case SNUK_VALUE_GENERATOR:
+                members[0].type = &generator_type;
+                break;
             default:
                 SNUK_SHOULD_NOT_REACH_HERE;
                 break;
@@ -57,9 +63,52 @@ SnukValue snuk_native_get_member(SnukInterpreter *intpret, SnukValue type_or_ins
     return res;
 }
 
+/**
+ * @brief Call a fast native, placing each named argument at its parameter's
+ * position. Takes ownership of the argument values like the scope would.
+ */
+static SnukValue call_fast_function(SnukInterpreter *intpret, SnukValue fn, SnukParameter *params, uint64_t count) {
+    SnukScope *fn_scope = GET_SCOPE(fn.native_fn.closure);
+    uint64_t fn_param_count = snuk_darray_get_length(fn_scope->vars);
+
+    SnukValue args[SNUK_NATIVE_MAX_ARGS];
+    uint64_t given = 0;
+    bool failed = fn_param_count < count;
+    for (uint64_t i = 0; i < count; ++i) {
+        SnukValue value;
+        if (params[i].build_value) value = params[i].build_value(intpret, true);
+        else value = params[i].value;
+
+        uint64_t index = interpreter_param_index(fn_scope, snuk_string_view_create(params[i].name));
+        if (failed || index == fn_param_count || given & (1ull << index)
+            || !snuk_interpreter_value_is_of_type(intpret, value, fn_scope->vars[index]->type)) {
+            snuk_value_free(value);
+            failed = true;
+            continue;
+        }
+        args[index] = value;
+        given |= 1ull << index;
+    }
+
+    for (uint64_t i = 0; i < fn_param_count && !failed; ++i) {
+        if (given & (1ull << i)) continue;
+        if (fn_scope->vars[i]->value.type == SNUK_VALUE_UNKOWN) failed = true;
+        else args[i] = snuk_value_copy(fn_scope->vars[i]->value);
+        if (!failed) given |= 1ull << i;
+    }
+
+    SnukValue ret = {.type = SNUK_VALUE_UNKOWN};
+    if (!failed) ret = fn.native_fn.fast(intpret, interpreter_fast_receiver(fn), args, fn_param_count);
+
+    for (uint64_t i = 0; i < fn_param_count; ++i)
+        if (given & (1ull << i)) snuk_value_free(args[i]);
+    return ret;
+}
+
 SnukValue snuk_native_call_function(SnukInterpreter *intpret, SnukValue fn, SnukParameter *params, uint64_t count) {
     if (fn.type != SNUK_VALUE_FN && fn.type != SNUK_VALUE_FN_NATIVE)
         return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    if (fn.type == SNUK_VALUE_FN_NATIVE && fn.native_fn.fast) return call_fast_function(intpret, fn, params, count);
 
     SnukRefCounter *fn_scope_rc = NULL;
     if (fn.type == SNUK_VALUE_FN) fn_scope_rc = fn.fn_value.closure;
@@ -110,11 +159,17 @@ SnukValue snuk_native_call_function(SnukInterpreter *intpret, SnukValue fn, Snuk
     SnukRefCounter *temp = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&new_scope);
 
+    SnukRefCounter *caller_ast = intpret->ast;
+    if (fn.type == SNUK_VALUE_FN) intpret->ast = fn_scope->ast;
+
     SnukValue ret;
-    if (fn.type == SNUK_VALUE_FN)
+    if (fn.type == SNUK_VALUE_FN && fn.fn_value.is_generator)
+        ret = snuk_generator_create(intpret, fn.fn_value.body);
+    else if (fn.type == SNUK_VALUE_FN)
         ret = execute_block_expr(intpret, fn.fn_value.body, SNUK_SIGNAL_RETURN, SNUK_SIGNAL_NONE, false);
     else ret = fn.native_fn.fn(intpret);
 
+    intpret->ast = caller_ast;
     new_scope = snuk_ref_counter_move(&intpret->current);
     intpret->current = snuk_ref_counter_move(&temp);
 
@@ -155,8 +210,38 @@ SnukValue snuk_native_create_type(SnukInterpreter *intpret, SnukTypeMember *memb
     return type;
 }
 
-SnukValue snuk_native_create_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
-                                SnukType *fn_type, native_function_t fn, bool weak_ref) {
+SnukValue snuk_native_create_lazy_type(
+    SnukInterpreter *intpret, SnukTypeMember *members, uint64_t count, bool weak_ref) {
+    interpreter_push_scope(intpret);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        bool added = members[i].build_value
+                       ? snuk_native_add_lazy_value(intpret, members[i].name, members[i].type,
+                                                    members[i].build_value, members[i].is_const)
+                       : snuk_native_add_value(intpret, members[i].name, members[i].type, members[i].value,
+                                               members[i].is_const);
+        if (!added) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    }
+
+    SnukValue type = {
+        .type = SNUK_VALUE_TYPE,
+        .type_value = {
+            .type_scope = NULL,
+            .closure = snuk_ref_counter_retain(intpret->current),
+            .weak_ref = false,
+            .type = &type_type,
+        },
+    };
+
+    interpreter_pop_scope(intpret);
+
+    if (weak_ref) snuk_scope_downgrade_parent(type.type_value.closure);
+
+    return type;
+}
+
+static SnukValue create_native_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
+                                  SnukType *fn_type, native_function_t fn, native_fast_function_t fast, bool weak_ref) {
     interpreter_push_scope(intpret);
 
     uint64_t param_count = snuk_darray_get_length(fn_type->fn.param_types);
@@ -177,6 +262,7 @@ SnukValue snuk_native_create_fn(SnukInterpreter *intpret, SnukParameter *params,
             .closure = snuk_ref_counter_retain(intpret->current),
             .type = fn_type,
             .fn = fn,
+            .fast = fast,
         },
     };
 
@@ -187,6 +273,17 @@ SnukValue snuk_native_create_fn(SnukInterpreter *intpret, SnukParameter *params,
     return function;
 }
 
+SnukValue snuk_native_create_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
+                                SnukType *fn_type, native_function_t fn, bool weak_ref) {
+    return create_native_fn(intpret, params, count, fn_type, fn, NULL, weak_ref);
+}
+
+SnukValue snuk_native_create_fast_fn(SnukInterpreter *intpret, SnukParameter *params, uint64_t count,
+                                     SnukType *fn_type, native_fast_function_t fn, bool weak_ref) {
+    if (count > SNUK_NATIVE_MAX_ARGS) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return create_native_fn(intpret, params, count, fn_type, NULL, fn, weak_ref);
+}
+
 SnukValue snuk_native_create_inst(
     SnukInterpreter *intpret, SnukType *type, SnukTypeMember *members, uint64_t count, bool weak_ref) {
     SnukEnv *env = interpreter_lookup(intpret, type->name);
@@ -209,8 +306,9 @@ SnukValue snuk_native_create_inst(
         SnukValue value;
         if (members[i].build_value) value = members[i].build_value(intpret, true);
         else value = members[i].value;
-        SnukValueType val_type = snuk_builtins_get_value_type(value.type_value.type->name);
-        if (val_type != SNUK_VALUE_UNKOWN && snuk_string_view_equal(name, value_str) && value.type != val_type)
+        SnukValueType val_type = snuk_builtins_get_value_type(type->name);
+        if (val_type != SNUK_VALUE_UNKOWN && snuk_string_view_equal(name, value_str)
+            && !snuk_builtins_value_type_matches(val_type, value.type))
             return (SnukValue){.type = SNUK_VALUE_UNKOWN};
         if (!interpreter_set_member(intpret, value, name, value))
             return (SnukValue){.type = SNUK_VALUE_UNKOWN};
@@ -287,3 +385,10 @@ SnukValue snuk_native_create_string(SnukInterpreter *intpret, const char *str, b
         .string_value = snuk_string_view_create(str),
     };
 }
+
+SnukValue snuk_native_create_buffer(SnukInterpreter *intpret, const char *bytes, uint64_t len,
+                                    SnukBufferReleaseFn release, void *data, bool weak_ref) {
+    SNUK_UNUSED(intpret);
+    SNUK_UNUSED(weak_ref);
+    return snuk_buffer_create(bytes, len, release, data);
+}
@@ -0,0 +1,518 @@
+#include "snuk/interpreter/snuk_bigint.h"
+
+#include "snuk/memory.h"
+
+#include <string.h>
+
+#define LIMB_BITS 32
+#define LIMB_BASE ((uint64_t)1 << LIMB_BITS)
+#define CHUNK_BASE 1000000000u
+#define CHUNK_DIGITS 9
+
+/**
+ * @brief Sign and magnitude view of an integer operand.
+ *
+ * small backs the limbs of a SNUK_VALUE_INT operand, so an operand must not
+ * be copied once initialized.
+ */
+typedef struct Operand {
+    const uint32_t *limbs;
+    uint64_t len;
+    bool negative;
+    uint32_t small[2];
+} Operand;
+
+static void bigint_destroy(void *data, void *ptr);
+static void operand_init(Operand *operand, SnukValue value);
+static SnukValue bigint_make(const uint32_t *limbs, uint64_t len, bool negative);
+
+static int mag_cmp(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn);
+static void mag_add(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out);
+static void mag_sub(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out);
+static void mag_add_into(uint32_t *dst, uint64_t dn, const uint32_t *src, uint64_t sn);
+static void mag_sub_into(uint32_t *dst, uint64_t dn, const uint32_t *src, uint64_t sn);
+static void mag_mul(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out);
+static void mag_divmod(const uint32_t *u, uint64_t un, const uint32_t *v, uint64_t vn, uint32_t *q, uint32_t *r);
+
+static SnukValue bigint_add(Operand *a, Operand *b, bool negate_b);
+static SnukValue bigint_mul(Operand *a, Operand *b);
+static SnukValue bigint_divmod(Operand *a, Operand *b, bool want_rem);
+static int bigint_cmp(Operand *a, Operand *b);
+
+SNUK_INLINE uint32_t *limbs_alloc(uint64_t len) {
+    // Never zero sized, callers may ask for an empty intermediate
+    return (uint32_t *)snuk_alloc((len ? len : 1) * sizeof(uint32_t), alignof(uint32_t));
+}
+
+SNUK_INLINE uint64_t mag_trim(const uint32_t *limbs, uint64_t len) {
+    while (len && !limbs[len - 1]) len--;
+    return len;
+}
+
+SNUK_INLINE uint32_t limb_clz(uint32_t x) {
+    uint32_t n = 0;
+    if (x <= 0x0000FFFF) n += 16, x <<= 16;
+    if (x <= 0x00FFFFFF) n += 8, x <<= 8;
+    if (x <= 0x0FFFFFFF) n += 4, x <<= 4;
+    if (x <= 0x3FFFFFFF) n += 2, x <<= 2;
+    if (x <= 0x7FFFFFFF) n += 1;
+    return n;
+}
+
+SnukValue snuk_bigint_binary_op(SnukValue left, SnukValue right, SnukTokenType op) {
+    Operand a, b;
+    operand_init(&a, left);
+    operand_init(&b, right);
+
+    SnukValue res = {.type = SNUK_VALUE_BOOL};
+    switch (op) {
+        case SNUK_TOKEN_PLUS:
+            return bigint_add(&a, &b, false);
+        case SNUK_TOKEN_MINUS:
+            return bigint_add(&a, &b, true);
+        case SNUK_TOKEN_STAR:
+            return bigint_mul(&a, &b);
+        case SNUK_TOKEN_SLASH:
+            return bigint_divmod(&a, &b, false);
+        case SNUK_TOKEN_PERCENT:
+            return bigint_divmod(&a, &b, true);
+
+        case SNUK_TOKEN_EQUAL:
+            res.bool_value = bigint_cmp(&a, &b) == 0;
+            return res;
+        case SNUK_TOKEN_BANG_EQUAL:
+            res.bool_value = bigint_cmp(&a, &b) != 0;
+            return res;
+        case SNUK_TOKEN_LESS:
+            res.bool_value = bigint_cmp(&a, &b) < 0;
+            return res;
+        case SNUK_TOKEN_LESS_EQUAL:
+            res.bool_value = bigint_cmp(&a, &b) <= 0;
+            return res;
+        case SNUK_TOKEN_GREATER:
+            res.bool_value = bigint_cmp(&a, &b) > 0;
+            return res;
+        case SNUK_TOKEN_GREATER_EQUAL:
+            res.bool_value = bigint_cmp(&a, &b) >= 0;
+            return res;
+
+        default:
+            break;
+    }
+
+    return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+}
+
+SnukValue snuk_bigint_negate(SnukValue value) {
+    if (value.type == SNUK_VALUE_INT) {
+        if (value.int_value != INT64_MIN) {
+            value.int_value = -value.int_value;
+            return value;
+        }
+        // -INT64_MIN is the only int negation that overflows
+        uint32_t limbs[2] = {0, 0x80000000u};
+        return bigint_make(limbs, 2, false);
+    }
+
+    SnukBigInt *bigint = GET_BIGINT(value.bigint);
+    SnukValue res = bigint_make(bigint->limbs, bigint->len, !bigint->negative);
+    snuk_value_free(value);
+    return res;
+}
+
+uint64_t snuk_bigint_max_chars(SnukRefCounter *bigint) {
+    // A limb holds less than 10 decimal digits
+    return GET_BIGINT(bigint)->len * 10 + 1;
+}
+
+uint64_t snuk_bigint_to_chars(SnukRefCounter *bigint, char *buf) {
+    SnukBigInt *value = GET_BIGINT(bigint);
+
+    uint64_t len = value->len;
+    uint32_t *limbs = limbs_alloc(len);
+    memcpy(limbs, value->limbs, len * sizeof(uint32_t));
+
+    // Peel off base 10^9 chunks, least significant first
+    uint32_t *chunks = limbs_alloc(len * 2);
+    uint64_t chunk_count = 0;
+    while (len) {
+        uint64_t rem = 0;
+        for (uint64_t i = len; i-- > 0;) {
+            uint64_t cur = (rem << LIMB_BITS) | limbs[i];
+            limbs[i] = (uint32_t)(cur / CHUNK_BASE);
+            rem = cur % CHUNK_BASE;
+        }
+        chunks[chunk_count++] = (uint32_t)rem;
+        len = mag_trim(limbs, len);
+    }
+
+    uint64_t written = 0;
+    if (value->negative) buf[written++] = '-';
+
+    for (uint64_t i = chunk_count; i-- > 0;) {
+        char digits[CHUNK_DIGITS];
+        uint32_t chunk = chunks[i];
+        uint64_t count = 0;
+        do {
+            digits[count++] = (char)('0' + chunk % 10);
+            chunk /= 10;
+        } while (chunk);
+        // Only the leading chunk is unpadded
+        if (i != chunk_count - 1)
+            while (count < CHUNK_DIGITS) digits[count++] = '0';
+        while (count) buf[written++] = digits[--count];
+    }
+
+    snuk_free(chunks);
+    snuk_free(limbs);
+    return written;
+}
+
+double snuk_bigint_to_double(SnukRefCounter *bigint) {
+    SnukBigInt *value = GET_BIGINT(bigint);
+    double res = 0;
+    for (uint64_t i = value->len; i-- > 0;) res = res * (double)LIMB_BASE + (double)value->limbs[i];
+    return value->negative ? -res : res;
+}
+
+static void bigint_destroy(void *data, void *ptr) {
+    SNUK_UNUSED(data);
+    snuk_free(ptr);
+}
+
+static void operand_init(Operand *operand, SnukValue value) {
+    if (value.type == SNUK_VALUE_BIGINT) {
+        SnukBigInt *bigint = GET_BIGINT(value.bigint);
+        operand->limbs = bigint->limbs;
+        operand->len = bigint->len;
+        operand->negative = bigint->negative;
+        return;
+    }
+
+    SNUK_ASSERT(value.type == SNUK_VALUE_INT, "bigint operand is not an integer");
+    // Magnitude of INT64_MIN does not fit in int64_t
+    uint64_t mag = value.int_value < 0 ? (uint64_t)(-(value.int_value + 1)) + 1 : (uint64_t)value.int_value;
+    operand->small[0] = (uint32_t)mag;
+    operand->small[1] = (uint32_t)(mag >> LIMB_BITS);
+    operand->limbs = operand->small;
+    operand->len = mag_trim(operand->small, 2);
+    operand->negative = value.int_value < 0;
+}
+
+/**
+ * @brief Build a value from a magnitude, demoting it to an int when it fits.
+ *
+ * limbs is copied, the caller keeps ownership.
+ */
+static SnukValue bigint_make(const uint32_t *limbs, uint64_t len, bool negative) {
+    len = mag_trim(limbs, len);
+
+    if (len <= 2) {
+        uint64_t mag = len ? limbs[0] : 0;
+        if (len == 2) mag |= (uint64_t)limbs[1] << LIMB_BITS;
+        if (mag <= (uint64_t)INT64_MAX)
+            return (SnukValue){.type = SNUK_VALUE_INT, .int_value = negative ? -(int64_t)mag : (int64_t)mag};
+        if (negative && mag == (uint64_t)INT64_MAX + 1)
+            return (SnukValue){.type = SNUK_VALUE_INT, .int_value = INT64_MIN};
+    }
+
+    SnukBigInt *bigint = (SnukBigInt *)snuk_alloc(sizeof(SnukBigInt) + len * sizeof(uint32_t), alignof(SnukBigInt));
+    bigint->len = len;
+    bigint->negative = negative;
+    memcpy(bigint->limbs, limbs, len * sizeof(uint32_t));
+
+    return (SnukValue){
+        .type = SNUK_VALUE_BIGINT,
+        .bigint = snuk_ref_counter_create(bigint, NULL, bigint_destroy),
+    };
+}
+
+static SnukValue bigint_add(Operand *a, Operand *b, bool negate_b) {
+    bool b_negative = b->negative != negate_b;
+
+    uint64_t len = (a->len > b->len ? a->len : b->len) + 1;
+    uint32_t *out = limbs_alloc(len);
+    bool negative;
+
+    if (a->negative == b_negative) {
+        mag_add(a->limbs, a->len, b->limbs, b->len, out);
+        negative = a->negative;
+    } else if (mag_cmp(a->limbs, a->len, b->limbs, b->len) >= 0) {
+        mag_sub(a->limbs, a->len, b->limbs, b->len, out);
+        negative = a->negative;
+        len = a->len;
+    } else {
+        mag_sub(b->limbs, b->len, a->limbs, a->len, out);
+        negative = b_negative;
+        len = b->len;
+    }
+
+    SnukValue res = bigint_make(out, len, negative);
+    snuk_free(out);
+    return res;
+}
+
+static SnukValue bigint_mul(Operand *a, Operand *b) {
+    if (!a->len || !b->len) return (SnukValue){.type = SNUK_VALUE_INT, .int_value = 0};
+
+    uint64_t len = a->len + b->len;
+    uint32_t *out = limbs_alloc(len);
+    mag_mul(a->limbs, a->len, b->limbs, b->len, out);
+    SnukValue res = bigint_make(out, len, a->negative != b->negative);
+    snuk_free(out);
+    return res;
+}
+
+static SnukValue bigint_divmod(Operand *a, Operand *b, bool want_rem) {
+    if (!b->len) return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    if (mag_cmp(a->limbs, a->len, b->limbs, b->len) < 0) {
+        if (!want_rem) return (SnukValue){.type = SNUK_VALUE_INT, .int_value = 0};
+        return bigint_make(a->limbs, a->len, a->negative);
+    }
+
+    uint32_t *q = limbs_alloc(a->len - b->len + 1);
+    uint32_t *r = limbs_alloc(b->len);
+    mag_divmod(a->limbs, a->len, b->limbs, b->len, q, r);
+
+    // Truncated division: quotient toward zero, remainder takes the dividend sign
+    SnukValue res = want_rem ? bigint_make(r, b->len, a->negative)
+                             : bigint_make(q, a->len - b->len + 1, a->negative != b->negative);
+    snuk_free(r);
+    snuk_free(q);
+    return res;
+}
+
+static int bigint_cmp(Operand *a, Operand *b) {
+    // Zero has no sign
+    bool a_negative = a->negative && a->len;
+    bool b_negative = b->negative && b->len;
+    if (a_negative != b_negative) return a_negative ? -1 : 1;
+    int cmp = mag_cmp(a->limbs, a->len, b->limbs, b->len);
+    return a_negative ? -cmp : cmp;
+}
+
+static int mag_cmp(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (uint64_t i = an; i-- > 0;)
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief out = a + b, out has max(an, bn) + 1 limbs.
+ */
+static void mag_add(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out) {
+    if (an < bn) {
+        const uint32_t *tmp = a;
+        a = b, b = tmp;
+        uint64_t tmp_len = an;
+        an = bn, bn = tmp_len;
+    }
+
+    uint64_t carry = 0;
+    for (uint64_t i = 0; i < an; ++i) {
+        uint64_t sum = (uint64_t)a[i] + (i < bn ? b[i] : 0) + carry;
+        out[i] = (uint32_t)sum;
+        carry = sum >> LIMB_BITS;
+    }
+    out[an] = (uint32_t)carry;
+}
+
+/**
+ * @brief out = a - b, requires a >= b, out has an limbs.
+ */
+static void mag_sub(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out) {
+    uint64_t borrow = 0;
+    for (uint64_t i = 0; i < an; ++i) {
+        uint64_t diff = (uint64_t)a[i] - (i < bn ? b[i] : 0) - borrow;
+        out[i] = (uint32_t)diff;
+        borrow = (diff >> LIMB_BITS) & 1;
+    }
+}
+
+/**
+ * @brief dst += src, the sum must fit in dn limbs.
+ */
+static void mag_add_into(uint32_t *dst, uint64_t dn, const uint32_t *src, uint64_t sn) {
+    sn = mag_trim(src, sn);
+    SNUK_ASSERT(sn <= dn, "bigint addition overflows destination");
+
+    uint64_t carry = 0;
+    uint64_t i = 0;
+    for (; i < sn; ++i) {
+        uint64_t sum = (uint64_t)dst[i] + src[i] + carry;
+        dst[i] = (uint32_t)sum;
+        carry = sum >> LIMB_BITS;
+    }
+    for (; carry && i < dn; ++i) {
+        uint64_t sum = (uint64_t)dst[i] + carry;
+        dst[i] = (uint32_t)sum;
+        carry = sum >> LIMB_BITS;
+    }
+}
+
+/**
+ * @brief dst -= src, requires dst >= src.
+ */
+static void mag_sub_into(uint32_t *dst, uint64_t dn, const uint32_t *src, uint64_t sn) {
+    sn = mag_trim(src, sn);
+    SNUK_ASSERT(sn <= dn, "bigint subtraction underflows destination");
+
+    uint64_t borrow = 0;
+    uint64_t i = 0;
+    for (; i < sn; ++i) {
+        uint64_t diff = (uint64_t)dst[i] - src[i] - borrow;
+        dst[i] = (uint32_t)diff;
+        borrow = (diff >> LIMB_BITS) & 1;
+    }
+    for (; borrow && i < dn; ++i) {
+        uint64_t diff = (uint64_t)dst[i] - borrow;
+        dst[i] = (uint32_t)diff;
+        borrow = (diff >> LIMB_BITS) & 1;
+    }
+}
+
+/**
+ * @brief out = a * b, out has an + bn limbs.
+ *
+ * Schoolbook below SNUK_BIGINT_KARATSUBA_THRESHOLD limbs, Karatsuba above.
+ * Splitting at half of the longer operand, with a = a1 * B^m + a0 and
+ * b = b1 * B^m + b0:
+ *   a * b = z2 * B^2m + (z1 - z2 - z0) * B^m + z0
+ * where z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1).
+ */
+static void mag_mul(const uint32_t *a, uint64_t an, const uint32_t *b, uint64_t bn, uint32_t *out) {
+    if (an < bn) {
+        const uint32_t *tmp = a;
+        a = b, b = tmp;
+        uint64_t tmp_len = an;
+        an = bn, bn = tmp_len;
+    }
+
+    memset(out, 0, (an + bn) * sizeof(uint32_t));
+
+    if (bn < SNUK_BIGINT_KARATSUBA_THRESHOLD) {
+        for (uint64_t i = 0; i < bn; ++i) {
+            uint64_t carry = 0;
+            uint64_t bi = b[i];
+            if (!bi) continue;
+            for (uint64_t j = 0; j < an; ++j) {
+                uint64_t cur = (uint64_t)a[j] * bi + out[i + j] + carry;
+                out[i + j] = (uint32_t)cur;
+                carry = cur >> LIMB_BITS;
+            }
+            out[i + an] = (uint32_t)carry;
+        }
+        return;
+    }
+
+    uint64_t m = an / 2;
+
+    if (bn <= m) {
+        // Unbalanced, b has no high half: a * b = a1 * b * B^m + a0 * b
+        mag_mul(a, m, b, bn, out);
+        uint64_t high_len = an - m + bn;
+        uint32_t *high = limbs_alloc(high_len);
+        mag_mul(a + m, an - m, b, bn, high);
+        mag_add_into(out + m, an + bn - m, high, high_len);
+        snuk_free(high);
+        return;
+    }
+
+    // z0 and z2 land directly in their final place, they don't overlap
+    mag_mul(a, m, b, m, out);
+    mag_mul(a + m, an - m, b + m, bn - m, out + 2 * m);
+
+    uint64_t sa_len = an - m + 1;
+    uint64_t sb_len = (m > bn - m ? m : bn - m) + 1;
+    uint32_t *sa = limbs_alloc(sa_len);
+    uint32_t *sb = limbs_alloc(sb_len);
+    mag_add(a, m, a + m, an - m, sa);
+    mag_add(b, m, b + m, bn - m, sb);
+
+    uint64_t z1_len = sa_len + sb_len;
+    uint32_t *z1 = limbs_alloc(z1_len);
+    mag_mul(sa, sa_len, sb, sb_len, z1);
+    mag_sub_into(z1, z1_len, out, 2 * m);
+    mag_sub_into(z1, z1_len, out + 2 * m, an + bn - 2 * m);
+    mag_add_into(out + m, an + bn - m, z1, z1_len);
+
+    snuk_free(z1);
+    snuk_free(sb);
+    snuk_free(sa);
+}
+
+/**
+ * @brief q = u / v, r = u % v (Knuth, TAOCP vol. 2, algorithm D).
+ *
+ * Requires un >= vn, v[vn - 1] != 0. q has un - vn + 1 limbs, r has vn limbs.
+ */
+static void mag_divmod(const uint32_t *u, uint64_t un, const uint32_t *v, uint64_t vn, uint32_t *q, uint32_t *r) {
+    if (vn == 1) {
+        uint64_t rem = 0;
+        for (uint64_t i = un; i-- > 0;) {
+            uint64_t cur = (rem << LIMB_BITS) | u[i];
+            q[i] = (uint32_t)(cur / v[0]);
+            rem = cur % v[0];
+        }
+        r[0] = (uint32_t)rem;
+        return;
+    }
+
+    // Normalize so the top limb of the divisor has its high bit set
+    uint32_t shift = limb_clz(v[vn - 1]);
+    uint32_t *nv = limbs_alloc(vn);
+    uint32_t *nu = limbs_alloc(un + 1);
+    for (uint64_t i = vn - 1; i > 0; --i)
+        nv[i] = (uint32_t)(((uint64_t)v[i] << shift) | ((uint64_t)v[i - 1] >> (LIMB_BITS - shift)));
+    nv[0] = v[0] << shift;
+    nu[un] = (uint32_t)((uint64_t)u[un - 1] >> (LIMB_BITS - shift));
+    for (uint64_t i = un - 1; i > 0; --i)
+        nu[i] = (uint32_t)(((uint64_t)u[i] << shift) | ((uint64_t)u[i - 1] >> (LIMB_BITS - shift)));
+    nu[0] = u[0] << shift;
+
+    for (uint64_t j = un - vn + 1; j-- > 0;) {
+        // Estimate the quotient limb from the top two limbs, off by at most 2
+        uint64_t num = ((uint64_t)nu[j + vn] << LIMB_BITS) | nu[j + vn - 1];
+        uint64_t qhat = num / nv[vn - 1];
+        uint64_t rhat = num % nv[vn - 1];
+        while (qhat >= LIMB_BASE || qhat * nv[vn - 2] > ((rhat << LIMB_BITS) | nu[j + vn - 2])) {
+            qhat--;
+            rhat += nv[vn - 1];
+            if (rhat >= LIMB_BASE) break;
+        }
+
+        // Multiply and subtract
+        int64_t borrow = 0;
+        int64_t t;
+        for (uint64_t i = 0; i < vn; ++i) {
+            uint64_t p = qhat * nv[i];
+            t = (int64_t)nu[i + j] - borrow - (int64_t)(p & 0xFFFFFFFFu);
+            nu[i + j] = (uint32_t)t;
+            borrow = (int64_t)(p >> LIMB_BITS) - (t >> LIMB_BITS);
+        }
+        t = (int64_t)nu[j + vn] - borrow;
+        nu[j + vn] = (uint32_t)t;
+
+        q[j] = (uint32_t)qhat;
+        if (t < 0) {
+            // Estimate was one too large, add the divisor back
+            q[j]--;
+            uint64_t carry = 0;
+            for (uint64_t i = 0; i < vn; ++i) {
+                uint64_t sum = (uint64_t)nu[i + j] + nv[i] + carry;
+                nu[i + j] = (uint32_t)sum;
+                carry = sum >> LIMB_BITS;
+            }
+            nu[j + vn] = (uint32_t)(nu[j + vn] + carry);
+        }
+    }
+
+    // Unnormalize the remainder
+    for (uint64_t i = 0; i < vn; ++i)
+        r[i] = (uint32_t)(((uint64_t)nu[i] >> shift) | ((uint64_t)nu[i + 1] << (LIMB_BITS - shift)));
+
+    snuk_free(nu);
+    snuk_free(nv);
+}
@@ -0,0 +1,70 @@
+#include "snuk/interpreter/snuk_buffer.h"
+
+#include "snuk/memory.h"
+
+#include <string.h>
+
+static void buffer_destroy(void *data, void *ptr) {
+    SNUK_UNUSED(data);
+    SnukBuffer *buffer = (SnukBuffer *)ptr;
+    if (buffer->release) buffer->release(buffer->data, buffer->bytes, buffer->len);
+    snuk_free(buffer);
+}
+
+SnukValue snuk_buffer_create(const char *bytes, uint64_t len, SnukBufferReleaseFn release, void *data) {
+    SnukBuffer *buffer = (SnukBuffer *)snuk_alloc(sizeof(SnukBuffer), alignof(SnukBuffer));
+    *buffer = (SnukBuffer){
+        .bytes = bytes,
+        .len = len,
+        .release = release,
+        .data = data,
+    };
+
+    return (SnukValue){
+        .type = SNUK_VALUE_BUFFER,
+        .buffer = {
+            .ref = snuk_ref_counter_create(buffer, NULL, buffer_destroy),
+            .view = snuk_string_view_create_with_len(bytes, len),
+        },
+    };
+}
+
+SnukValue snuk_buffer_slice(SnukValue value, uint64_t start, uint64_t len) {
+    SNUK_ASSERT(value.type == SNUK_VALUE_BUFFER, "slicing a value that is not a buffer");
+    SNUK_ASSERT(start + len <= value.buffer.view.len, "slice past the end of the buffer");
+
+    value.buffer.ref = snuk_ref_counter_retain(value.buffer.ref);
+    value.buffer.view = snuk_string_view_create_with_len(value.buffer.view.str + start, len);
+    return value;
+}
+
+SnukValue snuk_buffer_binary_op(SnukValue left, SnukValue right, SnukTokenType op) {
+    SnukStringView a, b;
+    if (!snuk_buffer_contents(left, &a) || !snuk_buffer_contents(right, &b))
+        return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    switch (op) {
+        case SNUK_TOKEN_EQUAL:
+        case SNUK_TOKEN_BANG_EQUAL:
+            return (SnukValue){
+                .type = SNUK_VALUE_BOOL,
+                .bool_value = snuk_string_view_equal(a, b) == (op == SNUK_TOKEN_EQUAL),
+            };
+
+        case SNUK_TOKEN_PLUS: {
+            // Joining copies, the result no longer borrows host memory
+            char *str = snuk_alloc(a.len + b.len + 2, alignof(char));
+            str[0] = '"';
+            if (a.len) memcpy(str + 1, a.str, a.len);
+            if (b.len) memcpy(str + 1 + a.len, b.str, b.len);
+            str[a.len + b.len + 1] = '"';
+            return (SnukValue){
+                .type = SNUK_VALUE_STRING,
+                .string_value = snuk_string_view_create_with_len(str, a.len + b.len + 2),
+            };
+        }
+
+        default:
+            return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    }
+}
@@ -0,0 +1,172 @@
+#include "snuk/interpreter/snuk_call.h"
+
+#include "snuk/interpreter/builtins/snuk_builtins.h"
+#include "snuk/interpreter/interpreter_helper.h"
+#include "snuk/interpreter/native.h"
+#include "snuk/interpreter/snuk_generator.h"
+
+bool snuk_call_handle_prepare(
+    SnukCallHandle *handle, SnukInterpreter *intpret, SnukValue fn, const char *const *names, uint64_t argc) {
+    *handle = (SnukCallHandle){.intpret = intpret, .fn = {.type = SNUK_VALUE_NULL}};
+    if (fn.type != SNUK_VALUE_FN && fn.type != SNUK_VALUE_FN_NATIVE) return false;
+
+    handle->fn = snuk_value_copy(fn);
+    // A copied script function may only hold its closure weakly
+    handle->closure = snuk_ref_counter_retain(fn.type == SNUK_VALUE_FN ? fn.fn_value.closure : fn.native_fn.closure);
+    if (!handle->closure) return false;
+
+    SnukScope *fn_scope = GET_SCOPE(handle->closure);
+    uint64_t param_count = snuk_darray_get_length(fn_scope->vars);
+    if (argc > param_count) return false;
+
+    handle->argc = argc;
+    handle->param_count = param_count;
+    handle->slots = snuk_alloc((param_count ? param_count : 1) * sizeof(uint64_t), alignof(uint64_t));
+    for (uint64_t i = 0; i < param_count; ++i) handle->slots[i] = argc;
+
+    for (uint64_t i = 0; i < argc; ++i) {
+        uint64_t index = names ? interpreter_param_index(fn_scope, snuk_string_view_create(names[i])) : i;
+        if (index == param_count || handle->slots[index] != argc) return false;
+        handle->slots[index] = i;
+    }
+
+    for (uint64_t i = 0; i < param_count; ++i)
+        if (handle->slots[i] == argc && fn_scope->vars[i]->value.type == SNUK_VALUE_UNKOWN) return false;
+
+    if (fn.type == SNUK_VALUE_FN_NATIVE && fn.native_fn.fast && fn.native_fn.instance) {
+        // A method whose instance is gone has nothing to run on
+        handle->instance = snuk_ref_counter_retain(fn.native_fn.instance);
+        if (!handle->instance) return false;
+        handle->receiver = snuk_scope_lookup(handle->instance, value_str);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Create the scope of the parameters, and the scope of the body for
+ * a script function.
+ */
+static void create_scopes(SnukCallHandle *handle) {
+    SnukScope *fn_scope = GET_SCOPE(handle->closure);
+
+    handle->params = snuk_scope_create(snuk_ref_counter_retain(handle->closure), false);
+    for (uint64_t i = 0; i < handle->param_count; ++i) {
+        SnukEnv *fn_env = fn_scope->vars[i];
+        SnukEnv *env = snuk_env_create(fn_env->name, fn_env->type, (SnukValue){.type = SNUK_VALUE_NULL});
+        snuk_scope_add_env(handle->params, env);
+    }
+
+    if (handle->fn.type == SNUK_VALUE_FN && !handle->fn.fn_value.is_generator)
+        handle->locals = snuk_scope_create(snuk_ref_counter_retain(handle->params), false);
+}
+
+/**
+ * @brief Keep the scopes for the next call if nothing else holds them, or
+ * give them up so the next call creates new ones.
+ */
+static void reclaim_scopes(SnukCallHandle *handle) {
+    uint64_t owners = 1;
+    if (handle->locals) {
+        if (snuk_ref_counter_count(handle->locals) == 1) {
+            snuk_scope_destroy_envs(GET_SCOPE(handle->locals));
+            owners = 2;
+        } else {
+            snuk_ref_counter_release(&handle->locals);
+        }
+    }
+
+    SnukScope *params = GET_SCOPE(handle->params);
+    if (snuk_ref_counter_count(handle->params) != owners
+        || snuk_darray_get_length(params->vars) != handle->param_count) {
+        if (handle->locals) snuk_ref_counter_release(&handle->locals);
+        snuk_ref_counter_release(&handle->params);
+        return;
+    }
+
+    // The handle should not keep the arguments alive until the next call
+    for (uint64_t i = 0; i < handle->param_count; ++i) {
+        snuk_value_free(params->vars[i]->value);
+        params->vars[i]->value = (SnukValue){.type = SNUK_VALUE_NULL};
+    }
+}
+
+/**
+ * @brief Call a script function or a native that reads its arguments from
+ * the current scope.
+ */
+static SnukValue call_in_scope(SnukCallHandle *handle, const SnukValue *args) {
+    SnukInterpreter *intpret = handle->intpret;
+    SnukValue fn = handle->fn;
+    if (!handle->params) create_scopes(handle);
+
+    SnukScope *fn_scope = GET_SCOPE(handle->closure);
+    SnukScope *params = GET_SCOPE(handle->params);
+    for (uint64_t i = 0; i < handle->param_count; ++i) {
+        uint64_t slot = handle->slots[i];
+        snuk_env_assign_value(params->vars[i], slot < handle->argc ? args[slot] : fn_scope->vars[i]->value);
+    }
+
+    SnukRefCounter *prev_instance = snuk_ref_counter_move(&intpret->instance);
+    SnukRefCounter *instance = fn.type == SNUK_VALUE_FN ? fn.fn_value.instance : fn.native_fn.instance;
+    if (instance) intpret->instance = snuk_ref_counter_retain(instance);
+
+    SnukRefCounter *prev_scope = snuk_ref_counter_move(&intpret->current);
+    SnukRefCounter *caller_ast = intpret->ast;
+    if (fn.type == SNUK_VALUE_FN) intpret->ast = fn_scope->ast;
+    SnukValue ret;
+    if (handle->locals) {
+        intpret->current = snuk_ref_counter_retain(handle->locals);
+        ret = interpreter_run_block(intpret, fn.fn_value.body, SNUK_SIGNAL_RETURN, SNUK_SIGNAL_NONE);
+    } else {
+        intpret->current = snuk_ref_counter_retain(handle->params);
+        if (fn.type == SNUK_VALUE_FN) ret = snuk_generator_create(intpret, fn.fn_value.body);
+        else ret = fn.native_fn.fn(intpret);
+    }
+    snuk_ref_counter_release(&intpret->current);
+    intpret->current = snuk_ref_counter_move(&prev_scope);
+    intpret->ast = caller_ast;
+
+    if (intpret->instance) snuk_ref_counter_release(&intpret->instance);
+    intpret->instance = snuk_ref_counter_move(&prev_instance);
+
+    reclaim_scopes(handle);
+    return ret;
+}
+
+SnukValue snuk_call_handle_invoke(SnukCallHandle *handle, const SnukValue *args) {
+    SnukScope *fn_scope = GET_SCOPE(handle->closure);
+    for (uint64_t i = 0; i < handle->param_count; ++i) {
+        uint64_t slot = handle->slots[i];
+        if (slot < handle->argc
+            && !snuk_interpreter_value_is_of_type(handle->intpret, args[slot], fn_scope->vars[i]->type))
+            return (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    }
+
+    SnukValue fn = handle->fn;
+    if (fn.type != SNUK_VALUE_FN_NATIVE || !fn.native_fn.fast) return call_in_scope(handle, args);
+
+    // Fast natives borrow their arguments, defaults included
+    SnukValue values[SNUK_NATIVE_MAX_ARGS];
+    for (uint64_t i = 0; i < handle->param_count; ++i) {
+        uint64_t slot = handle->slots[i];
+        values[i] = slot < handle->argc ? args[slot] : fn_scope->vars[i]->value;
+    }
+
+    SnukValue receiver = {.type = SNUK_VALUE_NULL};
+    if (handle->instance)
+        receiver = handle->receiver ? handle->receiver->value : (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return fn.native_fn.fast(handle->intpret, receiver, values, handle->param_count);
+}
+
+void snuk_call_handle_destroy(SnukCallHandle *handle) {
+    if (!handle) return;
+
+    if (handle->locals) snuk_ref_counter_release(&handle->locals);
+    if (handle->params) snuk_ref_counter_release(&handle->params);
+    if (handle->instance) snuk_ref_counter_release(&handle->instance);
+    if (handle->closure) snuk_ref_counter_release(&handle->closure);
+    snuk_value_free(handle->fn);
+    snuk_free(handle->slots);
+    *handle = (SnukCallHandle){0};
+}
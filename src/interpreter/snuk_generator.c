@@ -0,0 +1,419 @@
+#include "snuk/interpreter/snuk_generator.h"
+
+#include "snuk/interpreter/interpreter_helper.h"
+
+typedef enum LoopPhase {
+    LOOP_PHASE_CONDITION,
+    LOOP_PHASE_BODY,
+    LOOP_PHASE_UPDATE,
+} LoopPhase;
+
+static void generator_destroy(void *data, void *ptr);
+static bool generator_resume(SnukInterpreter *intpret, SnukGenerator *gen, SnukValue *value);
+static bool generator_run(SnukInterpreter *intpret, SnukGenerator *gen, SnukValue *value);
+static SnukSignal generator_exec_item(SnukInterpreter *intpret, SnukGenerator *gen, SnukItem *item);
+static void generator_enter_loop(SnukInterpreter *intpret, SnukGenerator *gen, SnukExpr *expr);
+static void generator_step_loop(SnukInterpreter *intpret, SnukGenerator *gen);
+static bool generator_unwind(SnukInterpreter *intpret, SnukGenerator *gen, SnukSignal signal);
+
+SNUK_INLINE SnukGeneratorFrame *generator_top_frame(SnukGenerator *gen) {
+    return &gen->frames[snuk_darray_get_length(gen->frames) - 1];
+}
+
+SNUK_INLINE void generator_push_frame(
+    SnukInterpreter *intpret, SnukGenerator *gen, SnukExpr *expr, int capture_signals, bool owns_scope) {
+    if (owns_scope) interpreter_push_scope(intpret);
+    SnukGeneratorFrame frame = {
+        .expr = expr,
+        .index = 0,
+        .capture_signals = capture_signals,
+        .phase = LOOP_PHASE_CONDITION,
+        .owns_scope = owns_scope,
+        .iterable = {.type = SNUK_VALUE_NULL},
+    };
+    snuk_darray_push(&gen->frames, frame);
+}
+
+SNUK_INLINE void generator_pop_frame(SnukInterpreter *intpret, SnukGenerator *gen) {
+    SnukGeneratorFrame frame;
+    snuk_darray_pop(&gen->frames, &frame);
+    snuk_value_free(frame.iterable);
+    if (frame.owns_scope) interpreter_pop_scope(intpret);
+}
+
+/**
+ * @brief Drop all frames without touching the scopes, the scope chain is
+ * released as a whole by the owner of the innermost scope.
+ */
+SNUK_INLINE void generator_clear_frames(SnukGenerator *gen) {
+    uint64_t count = snuk_darray_get_length(gen->frames);
+    for (uint64_t i = 0; i < count; ++i) snuk_value_free(gen->frames[i].iterable);
+    snuk_darray_clear(&gen->frames);
+}
+
+SnukValue snuk_generator_create(SnukInterpreter *intpret, SnukExpr *body) {
+    SnukGenerator *gen = (SnukGenerator *)snuk_alloc(sizeof(SnukGenerator), alignof(SnukGenerator));
+    *gen = (SnukGenerator){
+        .frames = snuk_darray_create(SnukGeneratorFrame, NULL),
+        .scope = NULL,
+        .instance = intpret->instance ? snuk_ref_counter_retain_weak(intpret->instance) : NULL,
+        .pending = {.type = SNUK_VALUE_UNKOWN},
+        .state = SNUK_GENERATOR_SUSPENDED,
+        .native = NULL,
+        .native_state = NULL,
+        .source = {.type = SNUK_VALUE_NULL},
+        .ast = intpret->ast ? snuk_ref_counter_retain(intpret->ast) : NULL,
+    };
+
+    // Body block gets its own scope, same as execute_block_expr
+    generator_push_frame(intpret, gen, body, SNUK_SIGNAL_RETURN, false);
+    gen->frames[0].owns_scope = true;
+    gen->scope = snuk_scope_create(snuk_ref_counter_retain(intpret->current), false);
+
+    return (SnukValue){
+        .type = SNUK_VALUE_GENERATOR,
+        .generator = snuk_ref_counter_create(gen, NULL, generator_destroy),
+    };
+}
+
+SnukValue snuk_generator_create_native(SnukInterpreter *intpret, SnukGeneratorNativeFn next, void *state) {
+    SNUK_UNUSED(intpret);
+    SnukGenerator *gen = (SnukGenerator *)snuk_alloc(sizeof(SnukGenerator), alignof(SnukGenerator));
+    *gen = (SnukGenerator){
+        .frames = NULL,
+        .scope = NULL,
+        .instance = NULL,
+        .pending = {.type = SNUK_VALUE_UNKOWN},
+        .state = SNUK_GENERATOR_SUSPENDED,
+        .native = next,
+        .native_state = state,
+        .source = {.type = SNUK_VALUE_NULL},
+        .ast = NULL,
+    };
+
+    return (SnukValue){
+        .type = SNUK_VALUE_GENERATOR,
+        .generator = snuk_ref_counter_create(gen, NULL, generator_destroy),
+    };
+}
+
+bool snuk_generator_next(SnukInterpreter *intpret, SnukRefCounter *generator, SnukValue *value) {
+    SnukGenerator *gen = GET_GENERATOR(generator);
+
+    if (gen->pending.type != SNUK_VALUE_UNKOWN) {
+        *value = gen->pending;
+        gen->pending = (SnukValue){.type = SNUK_VALUE_UNKOWN};
+        return true;
+    }
+
+    return generator_resume(intpret, gen, value);
+}
+
+bool snuk_generator_done(SnukInterpreter *intpret, SnukRefCounter *generator) {
+    SnukGenerator *gen = GET_GENERATOR(generator);
+
+    if (gen->pending.type != SNUK_VALUE_UNKOWN) return false;
+    if (generator_resume(intpret, gen, &gen->pending)) return false;
+
+    gen->pending = (SnukValue){.type = SNUK_VALUE_UNKOWN};
+    return true;
+}
+
+static void generator_destroy(void *data, void *ptr) {
+    SNUK_UNUSED(data);
+    SnukGenerator *gen = (SnukGenerator *)ptr;
+
+    if (gen->frames) {
+        generator_clear_frames(gen);
+        snuk_darray_destroy(gen->frames);
+    }
+    if (gen->native_state) snuk_free(gen->native_state);
+    snuk_value_free(gen->source);
+
+    if (gen->scope) snuk_ref_counter_release(&gen->scope);
+    if (gen->instance) snuk_ref_counter_release_weak(&gen->instance);
+    if (gen->ast) snuk_ref_counter_release(&gen->ast);
+
+    snuk_value_free(gen->pending);
+
+    snuk_free(gen);
+}
+
+/**
+ * @brief Swap the generator's scope and instance in, run the body up to the
+ * next yield and swap the caller's back.
+ *
+ * @return True if a value (or an error) was produced.
+ */
+static bool generator_resume(SnukInterpreter *intpret, SnukGenerator *gen, SnukValue *value) {
+    *value = (SnukValue){.type = SNUK_VALUE_UNKOWN};
+
+    if (gen->state == SNUK_GENERATOR_DONE) return false;
+    if (gen->state == SNUK_GENERATOR_RUNNING) {
+        *value = interpreter_error(intpret, "generator is already running");
+        return true;
+    }
+
+    if (gen->native) {
+        if (gen->native(intpret, gen->native_state, value)) return true;
+        gen->state = SNUK_GENERATOR_DONE;
+        return false;
+    }
+
+    SnukRefCounter *caller_scope = snuk_ref_counter_move(&intpret->current);
+    SnukRefCounter *caller_instance = snuk_ref_counter_move(&intpret->instance);
+    SnukRefCounter *caller_ast = intpret->ast;
+
+    intpret->current = snuk_ref_counter_move(&gen->scope);
+    if (gen->instance) intpret->instance = snuk_ref_counter_retain(gen->instance);
+    intpret->ast = gen->ast;
+
+    gen->state = SNUK_GENERATOR_RUNNING;
+    bool suspended = generator_run(intpret, gen, value);
+
+    gen->scope = snuk_ref_counter_move(&intpret->current);
+    if (intpret->instance) snuk_ref_counter_release(&intpret->instance);
+
+    intpret->current = snuk_ref_counter_move(&caller_scope);
+    intpret->instance = snuk_ref_counter_move(&caller_instance);
+    intpret->ast = caller_ast;
+
+    if (suspended) {
+        gen->state = SNUK_GENERATOR_SUSPENDED;
+        return true;
+    }
+
+    // Finished, release everything the body was holding
+    gen->state = SNUK_GENERATOR_DONE;
+    generator_clear_frames(gen);
+    snuk_ref_counter_release(&gen->scope);
+    if (gen->instance) snuk_ref_counter_release_weak(&gen->instance);
+    if (gen->ast) snuk_ref_counter_release(&gen->ast);
+
+    return value->type == SNUK_VALUE_ERROR;
+}
+
+/**
+ * @brief Execute the body over the frame stack until a yield or the end.
+ *
+ * @return True if suspended at a yield, false if finished. On error value is
+ * set to the error and false is returned.
+ */
+static bool generator_run(SnukInterpreter *intpret, SnukGenerator *gen, SnukValue *value) {
+    while (snuk_darray_get_length(gen->frames)) {
+        SnukGeneratorFrame *frame = generator_top_frame(gen);
+        SnukSignal signal = SNUK_SIGNAL_NONE;
+
+        if (frame->expr->type == SNUK_EXPR_BLOCK) {
+            if (frame->index == snuk_darray_get_length(frame->expr->block_items)) {
+                generator_pop_frame(intpret, gen);
+                continue;
+            }
+
+            SnukItem *item = frame->expr->block_items[frame->index++];
+            if (item->type == SNUK_ITEM_YIELD) {
+                *value = (SnukValue){.type = SNUK_VALUE_NULL};
+                if (item->expr) *value = interpreter_eval_expr(intpret, item->expr, false);
+                if (!intpret->panic_mode) return true;
+            } else {
+                signal = generator_exec_item(intpret, gen, item);
+            }
+        } else {
+            generator_step_loop(intpret, gen);
+        }
+
+        if (intpret->panic_mode) {
+            snuk_value_free(*value);
+            *value = intpret->error;
+            return false;
+        }
+
+        if (signal != SNUK_SIGNAL_NONE && !generator_unwind(intpret, gen, signal)) {
+            *value = interpreter_error(intpret, "signal is not none");
+            return false;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Execute a block item, entering blocks, branches and loops as new
+ * frames so a yield inside them can suspend the body.
+ *
+ * @return Signal raised by the item.
+ */
+static SnukSignal generator_exec_item(SnukInterpreter *intpret, SnukGenerator *gen, SnukItem *item) {
+    switch (item->type) {
+        case SNUK_ITEM_RETURN:
+        case SNUK_ITEM_BREAK:
+            if (item->expr) snuk_value_free(interpreter_eval_expr(intpret, item->expr, false));
+            return item->type == SNUK_ITEM_RETURN ? SNUK_SIGNAL_RETURN : SNUK_SIGNAL_BREAK;
+
+        case SNUK_ITEM_CONTINUE:
+            return SNUK_SIGNAL_CONTINUE;
+
+        case SNUK_ITEM_EXPR:
+            switch (item->expr->type) {
+                case SNUK_EXPR_BLOCK:
+                    generator_push_frame(intpret, gen, item->expr, SNUK_SIGNAL_BREAK, true);
+                    return SNUK_SIGNAL_NONE;
+
+                case SNUK_EXPR_IF: {
+                    SnukExpr *expr = item->expr;
+                    while (expr && expr->type == SNUK_EXPR_IF) {
+                        SnukValue cond
+                            = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->if_else.condition), false);
+                        bool is_true = snuk_value_is_true(cond);
+                        snuk_value_free(cond);
+                        expr = snuk_expr_child(expr, is_true ? expr->if_else.then_block : expr->if_else.else_block);
+                    }
+                    if (expr) generator_push_frame(intpret, gen, expr, SNUK_SIGNAL_NONE, true);
+                    return SNUK_SIGNAL_NONE;
+                }
+
+                case SNUK_EXPR_WHILE:
+                case SNUK_EXPR_DO_WHILE:
+                case SNUK_EXPR_FOR:
+                case SNUK_EXPR_FOR_IN:
+                    generator_enter_loop(intpret, gen, item->expr);
+                    return SNUK_SIGNAL_NONE;
+
+                default:
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    SnukValue value = interpreter_exec_item(intpret, item, false);
+    snuk_value_free(value);
+
+    SnukSignal signal = intpret->signal;
+    intpret->signal = SNUK_SIGNAL_NONE;
+    return signal;
+}
+
+static void generator_enter_loop(SnukInterpreter *intpret, SnukGenerator *gen, SnukExpr *expr) {
+    switch (expr->type) {
+        case SNUK_EXPR_WHILE:
+            generator_push_frame(intpret, gen, expr, SNUK_SIGNAL_BREAK, false);
+            break;
+
+        case SNUK_EXPR_DO_WHILE:
+            generator_push_frame(intpret, gen, expr, SNUK_SIGNAL_BREAK, false);
+            generator_top_frame(gen)->phase = LOOP_PHASE_BODY;
+            break;
+
+        case SNUK_EXPR_FOR:
+            generator_push_frame(intpret, gen, expr, SNUK_SIGNAL_BREAK, true);
+            if (expr->for_loop->init) {
+                SnukValue val = interpreter_exec_item(intpret, expr->for_loop->init, false);
+                snuk_value_free(val);
+                if (intpret->signal != SNUK_SIGNAL_NONE) interpreter_error(intpret, "signal is not none");
+            }
+            break;
+
+        case SNUK_EXPR_FOR_IN: {
+            SnukValue iterable = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->for_in.iterable), false);
+            if (iterable.type != SNUK_VALUE_GENERATOR) {
+                snuk_value_free(iterable);
+                interpreter_error(intpret, "for-in loop over non generator");
+                return;
+            }
+            generator_push_frame(intpret, gen, expr, SNUK_SIGNAL_BREAK, true);
+            generator_top_frame(gen)->iterable = iterable;
+            SnukValue null_value = {.type = SNUK_VALUE_NULL};
+            SNUK_UNUSED(snuk_interpreter_create_env(intpret, *expr->for_in.name, &any_type, null_value, false));
+            break;
+        }
+
+        default:
+            SNUK_SHOULD_NOT_REACH_HERE;
+            break;
+    }
+}
+
+/**
+ * @brief Advance the loop on top of the frame stack by one phase.
+ */
+static void generator_step_loop(SnukInterpreter *intpret, SnukGenerator *gen) {
+    SnukGeneratorFrame *frame = generator_top_frame(gen);
+    SnukExpr *expr = frame->expr;
+    SnukValue cond;
+    bool keep_going = true;
+
+    switch (frame->phase) {
+        case LOOP_PHASE_CONDITION:
+            switch (expr->type) {
+                case SNUK_EXPR_WHILE:
+                case SNUK_EXPR_DO_WHILE:
+                    cond = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->while_loop.condition), false);
+                    keep_going = snuk_value_is_true(cond);
+                    snuk_value_free(cond);
+                    break;
+
+                case SNUK_EXPR_FOR:
+                    if (!expr->for_loop->condition) break;
+                    cond = interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->for_loop->condition), false);
+                    keep_going = snuk_value_is_true(cond);
+                    snuk_value_free(cond);
+                    break;
+
+                case SNUK_EXPR_FOR_IN:
+                    keep_going = snuk_generator_next(intpret, frame->iterable.generator, &cond);
+                    if (!keep_going || intpret->panic_mode) break;
+                    snuk_env_assign_value(snuk_scope_lookup(intpret->current, *expr->for_in.name), cond);
+                    snuk_value_free(cond);
+                    break;
+
+                default:
+                    SNUK_SHOULD_NOT_REACH_HERE;
+                    break;
+            }
+
+            if (!keep_going) {
+                generator_pop_frame(intpret, gen);
+                return;
+            }
+
+            frame->phase = LOOP_PHASE_BODY;
+            return;
+
+        case LOOP_PHASE_BODY:
+            frame->phase = LOOP_PHASE_UPDATE;
+            generator_push_frame(intpret, gen,
+                                 snuk_expr_child(expr, expr->type == SNUK_EXPR_FOR_IN ? expr->for_in.body
+                                                       : expr->type == SNUK_EXPR_FOR  ? expr->for_loop->body
+                                                                                      : expr->while_loop.body),
+                                 SNUK_SIGNAL_CONTINUE, true);
+            return;
+
+        case LOOP_PHASE_UPDATE:
+            if (expr->type == SNUK_EXPR_FOR && expr->for_loop->update)
+                snuk_value_free(interpreter_eval_expr(intpret, snuk_expr_child(expr, expr->for_loop->update), false));
+            frame->phase = LOOP_PHASE_CONDITION;
+            return;
+
+        default:
+            SNUK_SHOULD_NOT_REACH_HERE;
+            break;
+    }
+}
+
+/**
+ * @brief Pop frames until one captures the signal. Loop frames capture break,
+ * block frames capture what execute_block_expr would capture for them.
+ *
+ * @return False if the signal escaped the body.
+ */
+static bool generator_unwind(SnukInterpreter *intpret, SnukGenerator *gen, SnukSignal signal) {
+    while (snuk_darray_get_length(gen->frames)) {
+        int capture_signals = generator_top_frame(gen)->capture_signals;
+        generator_pop_frame(intpret, gen);
+        if (capture_signals & signal) return true;
+    }
+    return false;
+}
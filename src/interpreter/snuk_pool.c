@@ -0,0 +1,371 @@
+#include "snuk/interpreter/snuk_pool.h"
+
+#include "snuk/arena.h"
+#include "snuk/interpreter/interpreter.h"
+#include "snuk/parser/parser.h"
+#include "snuk/thread.h"
+
+#include <string.h>
+
+#define POOL_QUEUE_CAPACITY 64
+// Rounds of yielding before an idle thread falls back to sleeping
+#define POOL_SPIN_ROUNDS 64
+#define POOL_SLEEP_MS 1
+
+/**
+ * @brief One submitted script, with its source, inputs and their names
+ * copied into the same allocation.
+ */
+typedef struct PoolJob {
+    const char *src;  // NULL when running a program
+    SnukProgram program;  // borrows the items of the submitted program
+    SnukProgramInput *inputs;
+    uint64_t input_count;
+    SnukFuture *future;
+} PoolJob;
+
+struct SnukFuture {
+    volatile uint64_t done;
+    SnukValue result;
+    char *text;  // owns the bytes of a string result
+};
+
+/**
+ * @brief Ring of jobs taken from both ends under a spin lock.
+ *
+ * The owner takes the oldest job from head and thieves the newest from the
+ * back, so they only meet on the last job.
+ */
+typedef struct PoolQueue {
+    volatile uint64_t lock;
+    PoolJob **jobs;
+    uint64_t capacity;
+    uint64_t head;
+    volatile uint64_t count;  // stored atomically so takers can peek without the lock
+} PoolQueue;
+
+typedef struct PoolWorker {
+    SnukPool *pool;
+    uint32_t index;
+    PoolQueue queue;
+    SnukThread *thread;
+    SnukInterpreter interpreter;  // kept warm between jobs
+    SnukArena parser_arena;  // reset after every job
+    SnukAllocator parser_allocator;
+} PoolWorker;
+
+struct SnukPool {
+    PoolWorker *workers;
+    uint32_t count;
+    volatile uint64_t next;  // round robin over the queues for submissions
+    volatile uint64_t running;
+};
+
+static void worker_run(void *arg);
+
+static void backoff(uint64_t *idle) {
+    if (++*idle < POOL_SPIN_ROUNDS) snuk_thread_yield();
+    else snuk_thread_sleep_ms(POOL_SLEEP_MS);
+}
+
+static void queue_push(PoolQueue *queue, PoolJob *job) {
+    snuk_spin_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        uint64_t capacity = queue->capacity * 2;
+        PoolJob **jobs = snuk_alloc(capacity * sizeof(PoolJob *), alignof(PoolJob *));
+        for (uint64_t i = 0; i < queue->count; ++i) jobs[i] = queue->jobs[(queue->head + i) % queue->capacity];
+        snuk_free(queue->jobs);
+        queue->jobs = jobs;
+        queue->capacity = capacity;
+        queue->head = 0;
+    }
+    queue->jobs[(queue->head + queue->count) % queue->capacity] = job;
+    snuk_atomic_store(&queue->count, queue->count + 1);
+    snuk_spin_unlock(&queue->lock);
+}
+
+static PoolJob *queue_take(PoolQueue *queue, bool steal) {
+    if (!snuk_atomic_load(&queue->count)) return NULL;
+
+    PoolJob *job = NULL;
+    snuk_spin_lock(&queue->lock);
+    if (queue->count) {
+        if (steal) {
+            job = queue->jobs[(queue->head + queue->count - 1) % queue->capacity];
+        } else {
+            job = queue->jobs[queue->head];
+            queue->head = (queue->head + 1) % queue->capacity;
+        }
+        snuk_atomic_store(&queue->count, queue->count - 1);
+    }
+    snuk_spin_unlock(&queue->lock);
+    return job;
+}
+
+SnukPool *snuk_pool_create(uint32_t threads) {
+    if (!threads) threads = 1;
+
+    SnukPool *pool = snuk_alloc(sizeof(SnukPool), alignof(SnukPool));
+    *pool = (SnukPool){
+        .workers = snuk_alloc(threads * sizeof(PoolWorker), alignof(PoolWorker)),
+        .count = threads,
+        .next = 0,
+        .running = 1,
+    };
+
+    for (uint32_t i = 0; i < threads; ++i) {
+        pool->workers[i] = (PoolWorker){
+            .pool = pool,
+            .index = i,
+            .queue = {
+                .jobs = snuk_alloc(POOL_QUEUE_CAPACITY * sizeof(PoolJob *), alignof(PoolJob *)),
+                .capacity = POOL_QUEUE_CAPACITY,
+            },
+        };
+    }
+
+    snuk_memory_set_shared(true);
+
+    uint32_t started = 0;
+    for (uint32_t i = 0; i < threads; ++i) {
+        pool->workers[i].thread = snuk_thread_create(worker_run, &pool->workers[i]);
+        if (pool->workers[i].thread) ++started;
+    }
+
+    if (!started) {
+        snuk_memory_set_shared(false);
+        snuk_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void snuk_pool_destroy(SnukPool *pool) {
+    if (!pool) return;
+
+    snuk_atomic_store(&pool->running, 0);
+    for (uint32_t i = 0; i < pool->count; ++i) snuk_thread_join(pool->workers[i].thread);
+    snuk_memory_set_shared(false);
+
+    for (uint32_t i = 0; i < pool->count; ++i) snuk_free(pool->workers[i].queue.jobs);
+    snuk_free(pool->workers);
+    snuk_free(pool);
+}
+
+/**
+ * @brief Whether a value can be handed to another thread, everything else
+ * points into an interpreter's scopes.
+ */
+static bool value_is_portable(SnukValue value) {
+    switch (value.type) {
+        case SNUK_VALUE_INT:
+        case SNUK_VALUE_FLOAT:
+        case SNUK_VALUE_BOOL:
+        case SNUK_VALUE_STRING:
+        case SNUK_VALUE_NULL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static SnukFuture *submit(
+    SnukPool *pool, const char *src, const SnukProgram *program, const SnukProgramInput *inputs, uint64_t count) {
+    uint64_t size = sizeof(PoolJob) + count * sizeof(SnukProgramInput);
+    uint64_t text_size = src ? strlen(src) + 1 : 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        text_size += strlen(inputs[i].name) + 1;
+        if (inputs[i].value.type == SNUK_VALUE_STRING) text_size += inputs[i].value.string_value.len;
+        else if (inputs[i].value.type == SNUK_VALUE_BUFFER) text_size += inputs[i].value.buffer.view.len + 2;
+    }
+
+    PoolJob *job = snuk_alloc(size + text_size, alignof(PoolJob));
+    SnukFuture *future = snuk_alloc(sizeof(SnukFuture), alignof(SnukFuture));
+    *future = (SnukFuture){.done = 0, .result = {.type = SNUK_VALUE_NULL}, .text = NULL};
+
+    *job = (PoolJob){
+        .src = NULL,
+        .program = program ? (SnukProgram){.items = program->items, .item_count = program->item_count}
+                           : (SnukProgram){0},
+        .inputs = (SnukProgramInput *)(job + 1),
+        .input_count = count,
+        .future = future,
+    };
+
+    char *text = (char *)job + size;
+    if (src) {
+        uint64_t len = strlen(src) + 1;
+        memcpy(text, src, len);
+        job->src = text;
+        text += len;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        SnukProgramInput *input = &job->inputs[i];
+        uint64_t len = strlen(inputs[i].name) + 1;
+        memcpy(text, inputs[i].name, len);
+        input->name = text;
+        text += len;
+
+        input->value = value_is_portable(inputs[i].value) ? inputs[i].value : (SnukValue){.type = SNUK_VALUE_NULL};
+        if (input->value.type == SNUK_VALUE_STRING) {
+            memcpy(text, input->value.string_value.str, input->value.string_value.len);
+            input->value.string_value.str = text;
+            text += input->value.string_value.len;
+        } else if (inputs[i].value.type == SNUK_VALUE_BUFFER) {
+            // The refcount of a buffer is not shared between threads
+            SnukStringView view = inputs[i].value.buffer.view;
+            text[0] = '"';
+            if (view.len) memcpy(text + 1, view.str, view.len);
+            text[view.len + 1] = '"';
+            input->value = (SnukValue){
+                .type = SNUK_VALUE_STRING,
+                .string_value = snuk_string_view_create_with_len(text, view.len + 2),
+            };
+            text += view.len + 2;
+        }
+    }
+
+    uint64_t index = snuk_atomic_fetch_add(&pool->next, 1) % pool->count;
+    queue_push(&pool->workers[index].queue, job);
+    return future;
+}
+
+SnukFuture *snuk_pool_submit(SnukPool *pool, const char *src, const SnukProgramInput *inputs, uint64_t count) {
+    return submit(pool, src, NULL, inputs, count);
+}
+
+SnukFuture *snuk_pool_submit_program(
+    SnukPool *pool, const SnukProgram *program, const SnukProgramInput *inputs, uint64_t count) {
+    return submit(pool, NULL, program, inputs, count);
+}
+
+SnukFuture *
+    snuk_pool_submit_image(SnukPool *pool, const SnukImage *image, const SnukProgramInput *inputs, uint64_t count) {
+    SnukProgram program = snuk_program_from_image(image);
+    return submit(pool, NULL, &program, inputs, count);
+}
+
+/**
+ * @brief Move the result of a job into its future before the interpreter
+ * is reset. A string or buffer is copied, a bigint is immutable and keeps
+ * its only reference once the bindings are gone.
+ */
+static void store_result(SnukFuture *future, SnukValue value) {
+    switch (value.type) {
+        case SNUK_VALUE_INT:
+        case SNUK_VALUE_FLOAT:
+        case SNUK_VALUE_BOOL:
+        case SNUK_VALUE_NULL:
+        case SNUK_VALUE_ERROR:
+        case SNUK_VALUE_BIGINT:
+            future->result = snuk_value_copy(value);
+            break;
+
+        case SNUK_VALUE_STRING:
+            future->text = snuk_alloc(value.string_value.len ? value.string_value.len : 1, alignof(char));
+            memcpy(future->text, value.string_value.str, value.string_value.len);
+            future->result = value;
+            future->result.string_value.str = future->text;
+            break;
+
+        case SNUK_VALUE_BUFFER:
+            future->text = snuk_alloc(value.buffer.view.len + 2, alignof(char));
+            future->text[0] = '"';
+            if (value.buffer.view.len) memcpy(future->text + 1, value.buffer.view.str, value.buffer.view.len);
+            future->text[value.buffer.view.len + 1] = '"';
+            future->result = (SnukValue){
+                .type = SNUK_VALUE_STRING,
+                .string_value = snuk_string_view_create_with_len(future->text, value.buffer.view.len + 2),
+            };
+            break;
+
+        default:
+            future->result = (SnukValue){.type = SNUK_VALUE_NULL};
+            break;
+    }
+}
+
+static void run_job(PoolWorker *worker, PoolJob *job) {
+    SnukInterpreter *intpret = &worker->interpreter;
+
+    // The program of a source job is empty, so this only binds the inputs
+    SnukValue result = snuk_program_run(&job->program, intpret, job->inputs, job->input_count);
+    if (job->src) {
+        SnukParser parser;
+        snuk_parser_init(&parser, job->src, &worker->parser_allocator, SNUK_LEXER_MODE_EXECUTE);
+
+        SnukItem *item;
+        while (result.type != SNUK_VALUE_ERROR && (item = snuk_parser_next_item(&parser))) {
+            snuk_value_free(result);
+            if (item->type == SNUK_ITEM_ERROR)
+                result = (SnukValue){.type = SNUK_VALUE_ERROR, .err_msg = "failed to parse"};
+            else result = snuk_interpreter_exec_item(intpret, item);
+        }
+
+        snuk_parser_deinit(&parser);
+    }
+
+    store_result(job->future, result);
+    snuk_value_free(result);
+
+    snuk_interpreter_reset(intpret);
+    snuk_arena_reset(&worker->parser_arena);
+
+    SnukFuture *future = job->future;
+    snuk_free(job);
+    snuk_atomic_store(&future->done, 1);
+}
+
+static PoolJob *find_job(PoolWorker *worker) {
+    PoolJob *job = queue_take(&worker->queue, false);
+    if (job) return job;
+
+    SnukPool *pool = worker->pool;
+    for (uint32_t i = 1; i < pool->count && !job; ++i)
+        job = queue_take(&pool->workers[(worker->index + i) % pool->count].queue, true);
+    return job;
+}
+
+static void worker_run(void *arg) {
+    PoolWorker *worker = (PoolWorker *)arg;
+    snuk_interpreter_init(&worker->interpreter);
+    snuk_arena_init(&worker->parser_arena, SNUK_ARENA_DEFAULT_CHUNK_SIZE);
+    worker->parser_allocator = snuk_arena_allocator(&worker->parser_arena);
+
+    uint64_t idle = 0;
+    while (true) {
+        PoolJob *job = find_job(worker);
+        if (job) {
+            run_job(worker, job);
+            idle = 0;
+            continue;
+        }
+
+        // Queued jobs still run after destroy was called
+        if (!snuk_atomic_load(&worker->pool->running)) break;
+        backoff(&idle);
+    }
+
+    snuk_arena_deinit(&worker->parser_arena);
+    snuk_interpreter_deinit(&worker->interpreter);
+}
+
+bool snuk_future_done(SnukFuture *future) {
+    return snuk_atomic_load(&future->done) != 0;
+}
+
+SnukValue snuk_future_wait(SnukFuture *future) {
+    uint64_t idle = 0;
+    while (!snuk_future_done(future)) backoff(&idle);
+    return future->result;
+}
+
+void snuk_future_destroy(SnukFuture *future) {
+    if (!future) return;
+
+    snuk_future_wait(future);
+    if (future->result.type == SNUK_VALUE_BIGINT) snuk_value_free(future->result);
+    snuk_free(future->text);
+    snuk_free(future);
+}
@@ -0,0 +1,74 @@
+#include "snuk/interpreter/snuk_program.h"
+
+#include "snuk/darray.h"
+#include "snuk/interpreter/snuk_scope.h"
+#include "snuk/io.h"
+#include "snuk/parser/parser.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+bool snuk_program_compile(SnukProgram *program, const char *src, const char *source_path) {
+    *program = (SnukProgram){0};
+    snuk_arena_init(&program->arena, SNUK_ARENA_DEFAULT_CHUNK_SIZE);
+
+    // Names and literals in the trees are views into the source
+    uint64_t len = strlen(src) + 1;
+    char *text = snuk_arena_alloc(&program->arena, len, alignof(char));
+    memcpy(text, src, len);
+
+    SnukAllocator allocator = snuk_arena_allocator(&program->arena);
+    SnukParser parser;
+    snuk_parser_init(&parser, text, &allocator, SNUK_LEXER_MODE_EXECUTE);
+
+    SnukItem **parsed = snuk_darray_create(SnukItem *, NULL);
+    bool failed = false;
+    SnukItem *item;
+    while ((item = snuk_parser_next_item(&parser))) {
+        if (item->type == SNUK_ITEM_ERROR) {
+            snuk_eprintln("%s:%" PRIu64 ":%" PRIu64 ": %s", source_path, item->error.line + 1, item->error.col + 1,
+                          item->error.msg);
+            failed = true;
+        }
+        snuk_darray_push(&parsed, item);
+    }
+    snuk_parser_deinit(&parser);
+
+    // A program that failed to parse runs no items
+    uint64_t count = failed ? 0 : snuk_darray_get_length(parsed);
+    program->items = snuk_arena_alloc(&program->arena, (count ? count : 1) * sizeof(SnukItem *), alignof(SnukItem *));
+    memcpy(program->items, parsed, count * sizeof(SnukItem *));
+    program->item_count = count;
+    snuk_darray_destroy(parsed);
+
+    return !failed;
+}
+
+void snuk_program_destroy(SnukProgram *program) {
+    if (!program) return;
+
+    snuk_arena_deinit(&program->arena);
+    *program = (SnukProgram){0};
+}
+
+SnukValue snuk_program_run(
+    const SnukProgram *program, SnukInterpreter *intpret, const SnukProgramInput *inputs, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) {
+        SnukStringView name = snuk_string_view_create(inputs[i].name);
+        // A rerun without a reset sees the bindings of the last run
+        SnukEnv *env = snuk_scope_lookup(intpret->current, name);
+        bool bound = env ? snuk_interpreter_value_is_of_type(intpret, inputs[i].value, env->type)
+                         : snuk_interpreter_create_env(intpret, name, &any_type, inputs[i].value, false);
+        if (!bound) return (SnukValue){.type = SNUK_VALUE_ERROR, .err_msg = "failed to bind an input"};
+        if (env) snuk_env_assign_value(env, inputs[i].value);
+    }
+
+    // Each item's value lives until the next item runs, so only the last is kept
+    SnukValue result = {.type = SNUK_VALUE_NULL};
+    for (uint64_t i = 0; i < program->item_count && result.type != SNUK_VALUE_ERROR; ++i) {
+        snuk_value_free(result);
+        result = snuk_interpreter_exec_item(intpret, program->items[i]);
+    }
+
+    return result;
+}
@@ -29,11 +29,26 @@ SnukValue snuk_value_copy(SnukValue value) {
                 value.type_value.type_scope = snuk_ref_counter_retain(value.type_value.type_scope);
             break;
 
+        case SNUK_VALUE_GENERATOR:
+            value.generator = snuk_ref_counter_retain(value.generator);
+            break;
+
+        case SNUK_VALUE_BIGINT:
+            value.bigint = snuk_ref_counter_retain(value.bigint);
+            break;
+
+        case SNUK_VALUE_BUFFER:
+            value.buffer.ref = snuk_ref_counter_retain(value.buffer.ref);
+            break;
+
+        case SNUK_VALUE_STRING:
+            if (value.string_owner) value.string_owner = snuk_ref_counter_retain(value.string_owner);
+            break;
+
         case SNUK_VALUE_UNKOWN:
         case SNUK_VALUE_INT:
         case SNUK_VALUE_FLOAT:
         case SNUK_VALUE_BOOL:
-        case SNUK_VALUE_STRING:
         case SNUK_VALUE_NULL:
         case SNUK_VALUE_INTERFACE:
         case SNUK_VALUE_MAX:
@@ -64,11 +79,26 @@ void snuk_value_free(SnukValue value) {
             if (value.type_value.type_scope) snuk_ref_counter_release(&value.type_value.type_scope);
             break;
 
+        case SNUK_VALUE_GENERATOR:
+            snuk_ref_counter_release(&value.generator);
+            break;
+
+        case SNUK_VALUE_BIGINT:
+            snuk_ref_counter_release(&value.bigint);
+            break;
+
+        case SNUK_VALUE_BUFFER:
+            snuk_ref_counter_release(&value.buffer.ref);
+            break;
+
+        case SNUK_VALUE_STRING:
+            if (value.string_owner) snuk_ref_counter_release(&value.string_owner);
+            break;
+
         case SNUK_VALUE_UNKOWN:
         case SNUK_VALUE_INT:
         case SNUK_VALUE_FLOAT:
         case SNUK_VALUE_BOOL:
-        case SNUK_VALUE_STRING:
         case SNUK_VALUE_NULL:
         case SNUK_VALUE_INTERFACE:
         case SNUK_VALUE_MAX:
@@ -86,6 +116,9 @@ void snuk_value_log(SnukValue value) {
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_INT));
             log_trace("value: %ld", value.int_value);
             break;
+        case SNUK_VALUE_BIGINT:
+            log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_BIGINT));
+            break;
         case SNUK_VALUE_FLOAT:
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_FLOAT));
             log_trace("value: %lf", value.float_value);
@@ -98,12 +131,19 @@ void snuk_value_log(SnukValue value) {
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_STRING));
             log_trace("value: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(value.string_value));
             break;
+        case SNUK_VALUE_BUFFER:
+            log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_BUFFER));
+            log_trace("value: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(value.buffer.view));
+            break;
         case SNUK_VALUE_NULL:
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_NULL));
             break;
         case SNUK_VALUE_FN:
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_FN));
             break;
+        case SNUK_VALUE_FN_NATIVE:
+            log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_FN_NATIVE));
+            break;
         case SNUK_VALUE_TYPE:
             log_trace("type: %s", SNUK_STRINGIFY(SNUK_VALUE_TYPE));
             break;
@@ -113,6 +153,9 @@ void snuk_value_log(SnukValue value) {
         case SNUK_VALUE_INTERFACE:
             log_trace("type %s", SNUK_STRINGIFY(SNUK_VALUE_INTERFACE));
             break;
+        case SNUK_VALUE_GENERATOR:
+            log_trace("type %s", SNUK_STRINGIFY(SNUK_VALUE_GENERATOR));
+            break;
         case SNUK_VALUE_ERROR:
             log_trace("error %s", SNUK_STRINGIFY(SNUK_VALUE_ERROR));
             log_trace("%s", value.err_msg);
@@ -1,3 +1,8 @@
+#if !defined(_WIN32)
+    // realpath is X/Open, hidden by strict C17
+    #define _XOPEN_SOURCE 700
+#endif
+
 #include "snuk/io.h"
 
 #include "snuk/logger.h"
@@ -7,6 +12,17 @@
 #include <snfile/snfile.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(SNUK_OS_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 // reads one line from stdin, caller should free
 char *snuk_read_line(char *buffer, uint64_t size) {
@@ -31,6 +47,86 @@ char *snuk_read_file(const char *path) {
     return content;
 }
 
+// creates or truncates the file and writes len bytes to it
+bool snuk_write_file(const char *path, const void *data, uint64_t len) {
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    bool written = fwrite(data, sizeof(char), len, file) == len;
+    return fclose(file) == 0 && written;
+}
+
+// maps entire file copy on write, writes never reach the file, NULL on failure
+void *snuk_map_file(const char *path, uint64_t *size) {
+#if defined(SNUK_OS_WINDOWS)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER file_size;
+    HANDLE mapping = NULL;
+    void *data = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    // The view keeps the mapping alive after its handle is closed
+    if (mapping) data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    if (data) *size = (uint64_t)file_size.QuadPart;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void *data = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) data = NULL;
+    }
+
+    // The mapping holds its own reference to the file
+    close(fd);
+    if (data) *size = (uint64_t)st.st_size;
+    return data;
+#endif
+}
+
+// unmaps memory from snuk_map_file
+void snuk_unmap_file(void *data, uint64_t size) {
+#if defined(SNUK_OS_WINDOWS)
+    SNUK_UNUSED(size);
+    UnmapViewOfFile(data);
+#else
+    munmap(data, (size_t)size);
+#endif
+}
+
+// absolute form of an existing path, caller should free, NULL on failure
+char *snuk_absolute_path(const char *path) {
+#if defined(SNUK_OS_WINDOWS)
+    DWORD len = GetFullPathNameA(path, 0, NULL, NULL);
+    if (!len || GetFileAttributesA(path) == INVALID_FILE_ATTRIBUTES) return NULL;
+
+    char *absolute = (char *)snuk_alloc(len, alignof(char));
+    if (GetFullPathNameA(path, len, absolute, NULL) >= len) {
+        snuk_free(absolute);
+        return NULL;
+    }
+    return absolute;
+#else
+    char *resolved = realpath(path, NULL);
+    if (!resolved) return NULL;
+
+    // realpath allocates with malloc, hand out memory snuk_free takes
+    uint64_t len = strlen(resolved) + 1;
+    char *absolute = (char *)snuk_alloc(len, alignof(char));
+    memcpy(absolute, resolved, len);
+    free(resolved);
+    return absolute;
+#endif
+}
+
 void snuk_print(const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -46,6 +142,16 @@ void snuk_println(const char *fmt, ...) {
     fputc('\n', stdout);
 }
 
+// writes len bytes to stdout as is
+void snuk_write(const char *data, uint64_t len) {
+    fwrite(data, sizeof(char), len, stdout);
+}
+
+// flushes stdout
+void snuk_flush(void) {
+    fflush(stdout);
+}
+
 // stderr, for error output
 void snuk_eprint(const char *fmt, ...) {
     va_list args;
@@ -12,6 +12,13 @@ struct ScopeDepth {
     uint64_t bracket;
 };
 
+// Comments attached to the token at offset, in token order
+struct SnukTokenTrivia {
+    uint32_t offset;
+    SnukStringView leading;
+    SnukStringView trailing;
+};
+
 SNUK_INLINE bool scope_depth_zero(ScopeDepth *sd) {
     uint64_t last = snuk_darray_get_length(sd) - 1;
     return sd[last].paren == sd[last].bracket && sd[last].paren == 0;
@@ -51,51 +58,90 @@ SNUK_INLINE void scope_depth_remove_bracket(ScopeDepth *sd) {
 
 typedef struct KeyWord {
     const char *keyword;
+    uint64_t len;
     SnukTokenType type;
 } KeyWord;
 
-typedef struct Value {
-    const char *value;
-    SnukTokenType type;
-    bool ignore_case;
-} Value;
-
-KeyWord keywords[] = {
-    {.keyword = "var",       .type = SNUK_TOKEN_VAR      },
-    {.keyword = "const",     .type = SNUK_TOKEN_CONST    },
-    {.keyword = "any",       .type = SNUK_TOKEN_ANY      },
-    {.keyword = "if",        .type = SNUK_TOKEN_IF       },
-    {.keyword = "else",      .type = SNUK_TOKEN_ELSE     },
-    {.keyword = "match",     .type = SNUK_TOKEN_MATCH    },
-    {.keyword = "case",      .type = SNUK_TOKEN_CASE     },
-    {.keyword = "while",     .type = SNUK_TOKEN_WHILE    },
-    {.keyword = "do",        .type = SNUK_TOKEN_DO       },
-    {.keyword = "for",       .type = SNUK_TOKEN_FOR      },
-    {.keyword = "in",        .type = SNUK_TOKEN_IN       },
-    {.keyword = "return",    .type = SNUK_TOKEN_RETURN   },
-    {.keyword = "break",     .type = SNUK_TOKEN_BREAK    },
-    {.keyword = "continue",  .type = SNUK_TOKEN_CONTINUE },
-    {.keyword = "fn",        .type = SNUK_TOKEN_FN       },
-    {.keyword = "print",     .type = SNUK_TOKEN_PRINT    },
-    {.keyword = "self",      .type = SNUK_TOKEN_SELF     },
-    {.keyword = "type",      .type = SNUK_TOKEN_TYPE     },
-    {.keyword = "interface", .type = SNUK_TOKEN_INTERFACE},
-    {.keyword = "extend",    .type = SNUK_TOKEN_EXTEND   },
-    {.keyword = "or",        .type = SNUK_TOKEN_KW_OR    },
-    {.keyword = "and",       .type = SNUK_TOKEN_KW_AND   },
-    {.keyword = "not",       .type = SNUK_TOKEN_KW_NOT   },
+#define KEYWORD_TABLE_SIZE 64
+#define KEYWORD_MIN_LEN 2
+#define KEYWORD_MAX_LEN 9
+
+/**
+ * @brief Perfect hash of the case-sensitive reserved words.
+ *
+ * Every word in keywords lands in its own slot, so a lookup is one hash and
+ * one compare. Adding a word means finding new multipliers that keep the
+ * slots distinct and regenerating the table.
+ */
+SNUK_FORCE_INLINE uint64_t keyword_hash(const char *word, uint64_t len) {
+    uint64_t first = (uint8_t)word[0], second = (uint8_t)word[1], last = (uint8_t)word[len - 1];
+    return (first * 7 + second * 2 + last * 10 + len) & (KEYWORD_TABLE_SIZE - 1);
+}
+
+// Indexed by keyword_hash, empty slots have len 0
+static const KeyWord keywords[KEYWORD_TABLE_SIZE] = {
+    [ 0] = {.keyword = "any",        .len = 3, .type = SNUK_TOKEN_ANY      },
+    [ 1] = {.keyword = "print",      .len = 5, .type = SNUK_TOKEN_PRINT    },
+    [ 3] = {.keyword = "false",      .len = 5, .type = SNUK_TOKEN_FALSE    },
+    [ 5] = {.keyword = "break",      .len = 5, .type = SNUK_TOKEN_BREAK    },
+    [ 6] = {.keyword = "true",       .len = 4, .type = SNUK_TOKEN_TRUE     },
+    [ 8] = {.keyword = "while",      .len = 5, .type = SNUK_TOKEN_WHILE    },
+    [ 9] = {.keyword = "in",         .len = 2, .type = SNUK_TOKEN_IN       },
+    [13] = {.keyword = "continue",   .len = 8, .type = SNUK_TOKEN_CONTINUE },
+    [14] = {.keyword = "yield",      .len = 5, .type = SNUK_TOKEN_YIELD    },
+    [17] = {.keyword = "else",       .len = 4, .type = SNUK_TOKEN_ELSE     },
+    [18] = {.keyword = "match",      .len = 5, .type = SNUK_TOKEN_MATCH    },
+    [20] = {.keyword = "type",       .len = 4, .type = SNUK_TOKEN_TYPE     },
+    [31] = {.keyword = "for",        .len = 3, .type = SNUK_TOKEN_FOR      },
+    [32] = {.keyword = "const",      .len = 5, .type = SNUK_TOKEN_CONST    },
+    [33] = {.keyword = "extend",     .len = 6, .type = SNUK_TOKEN_EXTEND   },
+    [35] = {.keyword = "or",         .len = 2, .type = SNUK_TOKEN_KW_OR    },
+    [40] = {.keyword = "null",       .len = 4, .type = SNUK_TOKEN_NULL     },
+    [41] = {.keyword = "if",         .len = 2, .type = SNUK_TOKEN_IF       },
+    [43] = {.keyword = "not",        .len = 3, .type = SNUK_TOKEN_KW_NOT   },
+    [45] = {.keyword = "case",       .len = 4, .type = SNUK_TOKEN_CASE     },
+    [46] = {.keyword = "and",        .len = 3, .type = SNUK_TOKEN_KW_AND   },
+    [47] = {.keyword = "self",       .len = 4, .type = SNUK_TOKEN_SELF     },
+    [50] = {.keyword = "do",         .len = 2, .type = SNUK_TOKEN_DO       },
+    [51] = {.keyword = "var",        .len = 3, .type = SNUK_TOKEN_VAR      },
+    [52] = {.keyword = "fn",         .len = 2, .type = SNUK_TOKEN_FN       },
+    [54] = {.keyword = "interface",  .len = 9, .type = SNUK_TOKEN_INTERFACE},
+    [58] = {.keyword = "return",     .len = 6, .type = SNUK_TOKEN_RETURN   },
 };
 
-Value values[] = {
-    {.value = "true",     .type = SNUK_TOKEN_TRUE,  .ignore_case = false},
-    {.value = "false",    .type = SNUK_TOKEN_FALSE, .ignore_case = false},
-    {.value = "null",     .type = SNUK_TOKEN_NULL,  .ignore_case = false},
+enum {
+    CHAR_BLANK = 1 << 0,  // space, tab and carriage return
+    CHAR_NEWLINE = 1 << 1,
+    CHAR_DIGIT = 1 << 2,
+    CHAR_HEX = 1 << 3,
+    CHAR_WORD = 1 << 4,  // letters, digits and underscore
+};
 
-    {.value = "nan",      .type = SNUK_TOKEN_NAN,   .ignore_case = true },
-    {.value = "inf",      .type = SNUK_TOKEN_INF,   .ignore_case = true },
-    {.value = "infinity", .type = SNUK_TOKEN_INF,   .ignore_case = true },
+#define CHAR_RANGE_6(c, class)                                                                        \
+    [(c)] = (class), [(c) + 1] = (class), [(c) + 2] = (class), [(c) + 3] = (class), [(c) + 4] = (class), \
+    [(c) + 5] = (class)
+#define CHAR_RANGE_10(c, class) CHAR_RANGE_6(c, class), [(c) + 6] = (class), [(c) + 7] = (class), \
+    [(c) + 8] = (class), [(c) + 9] = (class)
+
+static const uint8_t char_class[256] = {
+    [' '] = CHAR_BLANK,
+    ['\t'] = CHAR_BLANK,
+    ['\r'] = CHAR_BLANK,
+    ['\n'] = CHAR_NEWLINE,
+    ['_'] = CHAR_WORD,
+    CHAR_RANGE_10('0', CHAR_DIGIT | CHAR_HEX | CHAR_WORD),
+    CHAR_RANGE_6('a', CHAR_HEX | CHAR_WORD),
+    CHAR_RANGE_10('g', CHAR_WORD),
+    CHAR_RANGE_10('q', CHAR_WORD),
+    CHAR_RANGE_6('A', CHAR_HEX | CHAR_WORD),
+    CHAR_RANGE_10('G', CHAR_WORD),
+    CHAR_RANGE_10('Q', CHAR_WORD),
 };
 
+SNUK_FORCE_INLINE bool char_is(char c, uint8_t class) {
+    return char_class[(uint8_t)c] & class;
+}
+
 /**
  * @brief Check whether the lexer cursor is at the end of the source.
  *
@@ -131,29 +177,15 @@ SNUK_INLINE char lexer_peek_next(SnukLexer *lexer) {
 }
 
 /**
- * @brief Consume the current source character and update cursor position.
+ * @brief Consume the current source character.
  *
  * @param lexer Lexer state to advance.
  *
  * @return The consumed character, or '\0' when already at EOF.
- *
- * @note Newlines increment the line counter and reset the column to zero.
  */
 SNUK_INLINE char lexer_advance(SnukLexer *lexer) {
     if (lexer_is_eof(lexer)) return '\0';
-
-    char c = *lexer->cur;
-
-    lexer->cur++;
-
-    if (c == '\n') {
-        lexer->col = 0;
-        lexer->line++;
-    } else {
-        lexer->col++;
-    }
-
-    return c;
+    return *lexer->cur++;
 }
 
 /**
@@ -170,6 +202,35 @@ SNUK_INLINE bool lexer_match(SnukLexer *lexer, char expected) {
     return true;
 }
 
+/**
+ * @brief Find the end of the comment that starts at cur.
+ *
+ * @param lexer Lexer state positioned after the comment opener.
+ * @param multi_line True for block comments, false for line comments.
+ *
+ * @return The newline ending a line comment, the '*' of the closing marker
+ * of a block comment, or the end of the source when there is neither.
+ */
+SNUK_INLINE const char *lexer_find_comment_end(SnukLexer *lexer, bool multi_line) {
+    if (!multi_line) {
+        const char *newline = snuk_string_find_byte(lexer->cur, (uint64_t)(lexer->end - lexer->cur), '\n');
+        return newline ? newline : lexer->end;
+    }
+
+    const char *star = lexer->cur;
+    while ((star = snuk_string_find_byte(star, (uint64_t)(lexer->end - star), '*')) && star[1] != '/') ++star;
+    return star ? star : lexer->end;
+}
+
+/**
+ * @brief Skip spaces, tabs and carriage returns, stopping at newlines.
+ *
+ * @param lexer Lexer state to advance.
+ */
+SNUK_INLINE void lexer_skip_blanks(SnukLexer *lexer) {
+    while (char_is(*lexer->cur, CHAR_BLANK)) ++lexer->cur;
+}
+
 /**
  * @brief Build a token spanning from token_start to the current cursor.
  *
@@ -206,18 +267,30 @@ SNUK_INLINE SnukToken lexer_build_token(SnukLexer *lexer, SnukTokenType type) {
             break;
     }
 
-    uint64_t len = lexer->cur - lexer->token_start;
     return (SnukToken){
         .type = type,
-        .string_literal = snuk_string_view_create_with_len(lexer->token_start, len),
-        .line = lexer->token_start_line,
-        .col = lexer->token_start_col,
-        .err_msg = NULL,
+        .offset = (uint32_t)(lexer->token_start - lexer->src),
+        .len = (uint32_t)(lexer->cur - lexer->token_start),
     };
 }
 
 /**
- * @brief Build an error token for the current source line.
+ * @brief Append a value to the literal table and point token at it.
+ *
+ * @param lexer Lexer state owning the table.
+ * @param token Token to attach the literal to.
+ * @param literal The value.
+ *
+ * @return The token.
+ */
+SNUK_INLINE SnukToken lexer_attach_literal(SnukLexer *lexer, SnukToken token, SnukTokenLiteral literal) {
+    token.literal = (uint32_t)snuk_darray_get_length(lexer->literals);
+    snuk_darray_push(&lexer->literals, literal);
+    return token;
+}
+
+/**
+ * @brief Build an error token at the cursor.
  *
  * Also updates the lexer's context required to decide for emitting
  * SNUK_TOKEN_VSEMICOLON.
@@ -225,22 +298,16 @@ SNUK_INLINE SnukToken lexer_build_token(SnukLexer *lexer, SnukTokenType type) {
  * @param lexer Lexer state at the error location.
  * @param err_msg Static error message describing the failure.
  *
- * @return Error token containing the current line text and location.
+ * @return Empty error token at the cursor with err_msg as its literal.
  */
 SNUK_INLINE SnukToken lexer_build_error_token(SnukLexer *lexer, const char *err_msg) {
     lexer->previous_token_type = SNUK_TOKEN_ERROR;
 
-    const char *line_start = lexer->cur - lexer->col;
-    uint64_t len = 0;
-    for (len = 0; line_start[len] && line_start[len] != '\n'; ++len);
-
-    return (SnukToken){
+    SnukToken token = {
         .type = SNUK_TOKEN_ERROR,
-        .string_literal = snuk_string_view_create_with_len(line_start, len),
-        .line = lexer->line,
-        .col = lexer->col,
-        .err_msg = err_msg,
+        .offset = (uint32_t)(lexer->cur - lexer->src),
     };
+    return lexer_attach_literal(lexer, token, (SnukTokenLiteral){.err_msg = err_msg});
 }
 
 static SnukTokenType check_keyword(SnukStringView word);
@@ -251,6 +318,7 @@ static SnukToken lexer_scan_string(SnukLexer *lexer, char quote);
 static SnukToken lexer_scan_comment(SnukLexer *lexer, bool multi_line);
 static bool lexer_should_insert_vsemicolon(SnukLexer *lexer);
 static SnukToken lexer_next_token(SnukLexer *lexer);
+static void lexer_skip_comment(SnukLexer *lexer, bool multi_line);
 
 /**
  * @brief Scan an identifier-like word and classify keywords or literal values.
@@ -262,13 +330,7 @@ static SnukToken lexer_next_token(SnukLexer *lexer);
 static SnukToken lexer_scan_word(SnukLexer *lexer) {
     // assumes the first character is valid for identifier
     lexer->token_start = lexer->cur;
-    lexer->token_start_line = lexer->line;
-    lexer->token_start_col = lexer->col;
-    char c;
-    while ((c = lexer_peek(lexer))) {
-        if (!snuk_is_alpha_numeric(c) && c != '_') break;
-        lexer_advance(lexer);
-    }
+    while (char_is(*lexer->cur, CHAR_WORD)) ++lexer->cur;
 
     SnukStringView word = snuk_string_view_create_with_len(lexer->token_start, lexer->cur - lexer->token_start);
 
@@ -292,16 +354,10 @@ static SnukToken lexer_scan_word(SnukLexer *lexer) {
  */
 static SnukToken lexer_scan_number(SnukLexer *lexer) {
     lexer->token_start = lexer->cur;
-    lexer->token_start_line = lexer->line;
-    lexer->token_start_col = lexer->col;
 
     bool is_float = false;
     int base = 10;
-    SnukToken token = {
-        .line = lexer->line,
-        .col = lexer->col,
-        .err_msg = NULL,
-    };
+    SnukTokenLiteral literal;
 
     // detect base
     if (lexer_peek(lexer) == '0' && lexer_peek_next(lexer) != '.') {
@@ -310,9 +366,9 @@ static SnukToken lexer_scan_number(SnukLexer *lexer) {
                 base = 16;
                 lexer_advance(lexer);
                 lexer_advance(lexer);
-                if (!snuk_is_hex_digit(lexer_peek(lexer)))
+                if (!char_is(lexer_peek(lexer), CHAR_HEX))
                     return lexer_build_error_token(lexer, "invalid hex literal");
-                while (snuk_is_hex_digit(lexer_peek(lexer))) lexer_advance(lexer);
+                while (char_is(lexer_peek(lexer), CHAR_HEX)) lexer_advance(lexer);
                 break;
             case 'b':
                 base = 2;
@@ -336,7 +392,7 @@ static SnukToken lexer_scan_number(SnukLexer *lexer) {
                 break;
         }
     } else {
-        while (snuk_is_digit(lexer_peek(lexer))) lexer_advance(lexer);
+        while (char_is(lexer_peek(lexer), CHAR_DIGIT)) lexer_advance(lexer);
     }
 
     // fraction
@@ -344,19 +400,19 @@ static SnukToken lexer_scan_number(SnukLexer *lexer) {
         is_float = true;
         lexer_advance(lexer);
 
-        while (snuk_is_digit(lexer_peek(lexer))) lexer_advance(lexer);
+        while (char_is(lexer_peek(lexer), CHAR_DIGIT)) lexer_advance(lexer);
     }
 
     if (base == 10 && snuk_lower_case(lexer_peek(lexer)) == 'e') {
         is_float = true;
         lexer_advance(lexer);
 
-        if (snuk_char_in_string(lexer_peek(lexer), "+-")) lexer_advance(lexer);
+        if (lexer_peek(lexer) == '+' || lexer_peek(lexer) == '-') lexer_advance(lexer);
 
-        if (!snuk_is_digit(lexer_peek(lexer)))
+        if (!char_is(lexer_peek(lexer), CHAR_DIGIT))
             return lexer_build_error_token(lexer, "invalid exponent");
 
-        while (snuk_is_digit(lexer_peek(lexer))) lexer_advance(lexer);
+        while (char_is(lexer_peek(lexer), CHAR_DIGIT)) lexer_advance(lexer);
     }
 
     errno = 0;
@@ -364,33 +420,28 @@ static SnukToken lexer_scan_number(SnukLexer *lexer) {
     if (is_float) {
         char *endptr;
 
-        token.float_literal = strtod(lexer->token_start, &endptr);
+        literal.float_literal = strtod(lexer->token_start, &endptr);
 
         if (errno == ERANGE) return lexer_build_error_token(lexer, "float literal out of range");
-        token.type = SNUK_TOKEN_FLOAT;
-    } else {
-        if (base == 2) {
-            token.int_literal = 0;
-            const char *p = lexer->token_start + 2;
-            while (snuk_char_in_string(*p, "01")) {
-                if (token.int_literal > (INT64_MAX >> 1))
-                    return lexer_build_error_token(lexer, "integer literal out of range");
-                token.int_literal = (token.int_literal << 1) | (*p - '0');
-                ++p;
-            }
-        } else {
-            char *endptr;
-            token.int_literal = strtoll(lexer->token_start, &endptr, base);
-            if (errno == ERANGE)
+        return lexer_attach_literal(lexer, lexer_build_token(lexer, SNUK_TOKEN_FLOAT), literal);
+    }
+
+    if (base == 2) {
+        literal.int_literal = 0;
+        const char *p = lexer->token_start + 2;
+        while (*p == '0' || *p == '1') {
+            if (literal.int_literal > (INT64_MAX >> 1))
                 return lexer_build_error_token(lexer, "integer literal out of range");
+            literal.int_literal = (literal.int_literal << 1) | (*p - '0');
+            ++p;
         }
-
-        token.type = SNUK_TOKEN_INTEGER;
+    } else {
+        char *endptr;
+        literal.int_literal = strtoll(lexer->token_start, &endptr, base);
+        if (errno == ERANGE) return lexer_build_error_token(lexer, "integer literal out of range");
     }
 
-    lexer->previous_token_type = token.type;
-
-    return token;
+    return lexer_attach_literal(lexer, lexer_build_token(lexer, SNUK_TOKEN_INTEGER), literal);
 }
 
 /**
@@ -406,7 +457,8 @@ static SnukToken lexer_scan_number(SnukLexer *lexer) {
 static SnukToken lexer_scan_string(SnukLexer *lexer, char quote) {
     // starting quote is consumed
 
-    while (lexer_peek(lexer) != quote && !lexer_is_eof(lexer)) lexer_advance(lexer);
+    const char *closing = snuk_string_find_byte(lexer->cur, (uint64_t)(lexer->end - lexer->cur), quote);
+    lexer->cur = closing ? closing : lexer->end;
 
     if (lexer_is_eof(lexer)) return lexer_build_error_token(lexer, "unterminated string");
 
@@ -416,30 +468,38 @@ static SnukToken lexer_scan_string(SnukLexer *lexer, char quote) {
 }
 
 /**
- * @brief Check whether a word is a reserved keyword.
+ * @brief Check whether a word is a reserved keyword or a case-sensitive value.
  *
  * @param word The word to check.
  *
  * @return Keyword token type, or SNUK_TOKEN_EOF when the word is not a keyword.
  */
 static SnukTokenType check_keyword(SnukStringView word) {
-    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(keywords); ++i)
-        if (snuk_string_view_equal_cstr(word, keywords[i].keyword)) return keywords[i].type;
+    if (word.len < KEYWORD_MIN_LEN || word.len > KEYWORD_MAX_LEN) return SNUK_TOKEN_EOF;
+
+    const KeyWord *keyword = &keywords[keyword_hash(word.str, word.len)];
+    if (keyword->len == word.len && memcmp(keyword->keyword, word.str, word.len) == 0) return keyword->type;
     return SNUK_TOKEN_EOF;
 }
 
 /**
- * @brief Check whether a word is a built-in literal value.
+ * @brief Check whether a word is one of the float values, which ignore case.
  *
  * @param word The word to check.
  *
  * @return Value token type, or SNUK_TOKEN_EOF when the word is not a value.
  */
 static SnukTokenType check_values(SnukStringView word) {
-    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(values); ++i) {
-        if (values[i].ignore_case && snuk_string_view_equal_cstr_ignore_case(word, values[i].value))
-            return values[i].type;
-        else if (snuk_string_view_equal_cstr(word, values[i].value)) return values[i].type;
+    switch (word.len) {
+        case 3:
+            if (snuk_string_view_equal_cstr_ignore_case(word, "nan")) return SNUK_TOKEN_NAN;
+            if (snuk_string_view_equal_cstr_ignore_case(word, "inf")) return SNUK_TOKEN_INF;
+            break;
+        case 8:
+            if (snuk_string_view_equal_cstr_ignore_case(word, "infinity")) return SNUK_TOKEN_INF;
+            break;
+        default:
+            break;
     }
 
     return SNUK_TOKEN_EOF;
@@ -457,18 +517,10 @@ static SnukTokenType check_values(SnukStringView word) {
  */
 static SnukToken lexer_scan_comment(SnukLexer *lexer, bool multi_line) {
     lexer->token_start = lexer->cur;
-    lexer->token_start_line = lexer->line;
-    lexer->token_start_col = lexer->col;
+    // Do not consume new line
+    lexer->cur = lexer_find_comment_end(lexer, multi_line);
 
-    if (!multi_line) {
-        while (!lexer_is_eof(lexer) && lexer_peek(lexer) != '\n') lexer_advance(lexer);
-        SnukToken token = lexer_build_token(lexer, SNUK_TOKEN_LINE_COMMENT);
-        // Do not consume new line
-        return token;
-    }
-
-    while (!lexer_is_eof(lexer) && (lexer_peek(lexer) != '*' || lexer_peek_next(lexer) != '/'))
-        lexer_advance(lexer);
+    if (!multi_line) return lexer_build_token(lexer, SNUK_TOKEN_LINE_COMMENT);
 
     if (lexer_is_eof(lexer))
         return lexer_build_error_token(lexer, "unterminated multi-line comment");
@@ -479,6 +531,21 @@ static SnukToken lexer_scan_comment(SnukLexer *lexer, bool multi_line) {
     return token;
 }
 
+/**
+ * @brief Skip a line or block comment without building a token.
+ *
+ * @param lexer Lexer state positioned after the comment opener.
+ * @param multi_line True for block comments, false for line comments.
+ *
+ * @note The caller must have already consumed both opener characters. Like
+ * lexer_scan_comment, line comments stop before the newline and an
+ * unterminated block comment runs to the end of the source.
+ */
+static void lexer_skip_comment(SnukLexer *lexer, bool multi_line) {
+    lexer->cur = lexer_find_comment_end(lexer, multi_line);
+    if (multi_line && !lexer_is_eof(lexer)) lexer->cur += 2;  // closing */
+}
+
 /**
  * @brief Check whether to insert SNUK_TOKEN_VSEMICOLON or not.
  *
@@ -504,6 +571,7 @@ static bool lexer_should_insert_vsemicolon(SnukLexer *lexer) {
         case SNUK_TOKEN_RETURN:
         case SNUK_TOKEN_BREAK:
         case SNUK_TOKEN_CONTINUE:
+        case SNUK_TOKEN_YIELD:
         case SNUK_TOKEN_RPAREN:
         case SNUK_TOKEN_RBRACE:
         case SNUK_TOKEN_RBRACKET:
@@ -519,15 +587,13 @@ static bool lexer_should_insert_vsemicolon(SnukLexer *lexer) {
 
 static SnukToken lexer_next_token(SnukLexer *lexer) {
     lexer->token_start = lexer->cur;
-    lexer->token_start_line = lexer->line;
-    lexer->token_start_col = lexer->col;
 
     char c = lexer_peek(lexer);
 
-    if (snuk_is_digit(c)) return lexer_scan_number(lexer);
-    if (c == '.' && snuk_is_digit(lexer_peek_next(lexer))) return lexer_scan_number(lexer);
+    if (char_is(c, CHAR_DIGIT)) return lexer_scan_number(lexer);
+    if (c == '.' && char_is(lexer_peek_next(lexer), CHAR_DIGIT)) return lexer_scan_number(lexer);
 
-    if (snuk_is_alpha_numeric(c) || c == '_') return lexer_scan_word(lexer);
+    if (char_is(c, CHAR_WORD)) return lexer_scan_word(lexer);
 
     switch (lexer_advance(lexer)) {
         case '\0':
@@ -619,17 +685,21 @@ static SnukToken lexer_next_token(SnukLexer *lexer) {
     return lexer_build_error_token(lexer, "unexpected character");
 }
 
-void snuk_lexer_init(SnukLexer *lexer, const char *src) {
+void snuk_lexer_init(SnukLexer *lexer, const char *src, SnukLexerMode mode) {
+    uint64_t len = strlen(src);
+    SNUK_ASSERT(len <= UINT32_MAX, "source too large for 32 bit token offsets");
+
     *lexer = (SnukLexer){
         .src = src,
+        .end = src + len,
         .cur = src,
         .token_start = src,
-        .token_start_line = 0,
-        .token_start_col = 0,
-        .line = 0,
-        .col = 0,
         .previous_token_type = SNUK_TOKEN_MAX,
         .sd = snuk_darray_create(ScopeDepth, NULL),
+        .mode = mode,
+        .literals = snuk_darray_create(SnukTokenLiteral, NULL),
+        .trivia = mode == SNUK_LEXER_MODE_COMMENTS ? snuk_darray_create(SnukTokenTrivia, NULL) : NULL,
+        .newlines = NULL,
     };
     scope_depth_push(&lexer->sd);
 }
@@ -637,6 +707,9 @@ void snuk_lexer_init(SnukLexer *lexer, const char *src) {
 void snuk_lexer_deinit(SnukLexer *lexer) {
     if (!lexer) return;
     snuk_darray_destroy(lexer->sd);
+    snuk_darray_destroy(lexer->literals);
+    if (lexer->trivia) snuk_darray_destroy(lexer->trivia);
+    if (lexer->newlines) snuk_darray_destroy(lexer->newlines);
     *lexer = (SnukLexer){0};
 }
 
@@ -652,43 +725,66 @@ void snuk_lexer_deinit(SnukLexer *lexer) {
  * This makes the standalone comment never interfere witht the parsing
  * and also preserves the comments.
  */
+/**
+ * @brief snuk_lexer_next_token for SNUK_LEXER_MODE_EXECUTE.
+ *
+ * Comments are dropped where the full mode would attach or emit them, and the
+ * previous token type is left alone, so virtual semicolons land in the same
+ * places apart from the ones a standalone comment would have ended.
+ */
+static SnukToken lexer_next_token_skip_comments(SnukLexer *lexer) {
+    while (true) {
+        lexer_skip_blanks(lexer);
+
+        lexer->token_start = lexer->cur;
+
+        if ((lexer_peek(lexer) == '}' || lexer_peek(lexer) == '\n') && lexer_should_insert_vsemicolon(lexer))
+            return lexer_build_token(lexer, SNUK_TOKEN_VSEMICOLON);
+
+        while (char_is(lexer_peek(lexer), CHAR_BLANK | CHAR_NEWLINE)) ++lexer->cur;
+
+        if (lexer_peek(lexer) != '/' || (lexer_peek_next(lexer) != '/' && lexer_peek_next(lexer) != '*'))
+            return lexer_next_token(lexer);
+
+        lexer_advance(lexer);
+        lexer_skip_comment(lexer, lexer_advance(lexer) == '*');
+    }
+}
+
 SnukToken snuk_lexer_next_token(SnukLexer *lexer) {
+    if (lexer->mode == SNUK_LEXER_MODE_EXECUTE) return lexer_next_token_skip_comments(lexer);
+
     SnukToken leading_comment = {0};
     SnukToken trailing_comment = {0};
 
-#define AUTO_SEMICOLON_CANDIDATES "}\n"
-#define IGNORED_WHITE_SPACES " \t\r"
-
-    while (snuk_char_in_string(lexer_peek(lexer), IGNORED_WHITE_SPACES)) lexer_advance(lexer);
+    lexer_skip_blanks(lexer);
 
     lexer->token_start = lexer->cur;
-    lexer->token_start_line = lexer->line;
-    lexer->token_start_col = lexer->col;
 
-    if (snuk_char_in_string(lexer_peek(lexer), AUTO_SEMICOLON_CANDIDATES) && lexer_should_insert_vsemicolon(lexer))
+    if ((lexer_peek(lexer) == '}' || lexer_peek(lexer) == '\n') && lexer_should_insert_vsemicolon(lexer))
         return lexer_build_token(lexer, SNUK_TOKEN_VSEMICOLON);
 
-    while (snuk_is_white_space(lexer_peek(lexer))) lexer_advance(lexer);
+    while (char_is(lexer_peek(lexer), CHAR_BLANK | CHAR_NEWLINE)) ++lexer->cur;
 
-    if (lexer_peek(lexer) == '/' && snuk_char_in_string(lexer_peek_next(lexer), "/*")) {
+    if (lexer_peek(lexer) == '/' && (lexer_peek_next(lexer) == '/' || lexer_peek_next(lexer) == '*')) {
         // previous token type gets either overridden or set correctly
         lexer_advance(lexer);
         leading_comment = lexer_scan_comment(lexer, lexer_advance(lexer) == '*');
         uint64_t count = 0;
-        for (uint64_t i = 0; snuk_is_white_space(lexer->cur[i]); ++i)
+        for (uint64_t i = 0; char_is(lexer->cur[i], CHAR_BLANK | CHAR_NEWLINE); ++i)
             if (lexer->cur[i] == '\n') ++count;
 
         // standalone comment
         if (count > 1) return leading_comment;
     }
 
-    while (snuk_is_white_space(lexer_peek(lexer))) lexer_advance(lexer);
+    while (char_is(lexer_peek(lexer), CHAR_BLANK | CHAR_NEWLINE)) ++lexer->cur;
 
     SnukToken token = lexer_next_token(lexer);
 
-    while (snuk_char_in_string(lexer_peek(lexer), IGNORED_WHITE_SPACES)) lexer_advance(lexer);
+    lexer_skip_blanks(lexer);
 
-    if (lexer_peek(lexer) == '/' && snuk_char_in_string(lexer_peek_next(lexer), "/*")) {
+    if (lexer_peek(lexer) == '/' && (lexer_peek_next(lexer) == '/' || lexer_peek_next(lexer) == '*')) {
         // Save the previous token type
         SnukTokenType previous_token_type = lexer->previous_token_type;
         lexer_advance(lexer);
@@ -697,22 +793,79 @@ SnukToken snuk_lexer_next_token(SnukLexer *lexer) {
         lexer->previous_token_type = previous_token_type;
     }
 
-    token.leading_comment = leading_comment.string_literal;
-    token.trailing_comment = trailing_comment.string_literal;
+    if (leading_comment.len || trailing_comment.len) {
+        SnukTokenTrivia trivia = {
+            .offset = token.offset,
+            .leading = snuk_lexer_token_text(lexer, leading_comment),
+            .trailing = snuk_lexer_token_text(lexer, trailing_comment),
+        };
+        snuk_darray_push(&lexer->trivia, trivia);
+    }
 
     return token;
 }
 
-void snuk_lexer_log_token(SnukToken token) {
+uint64_t snuk_lexer_next_tokens(SnukLexer *lexer, SnukToken *tokens, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) {
+        tokens[i] = snuk_lexer_next_token(lexer);
+        if (tokens[i].type == SNUK_TOKEN_EOF) return i + 1;
+    }
+    return count;
+}
+
+void snuk_lexer_token_position(SnukLexer *lexer, SnukToken token, uint64_t *line, uint64_t *col) {
+    if (!lexer->newlines) {
+        lexer->newlines = snuk_darray_create(uint32_t, NULL);
+        for (const char *p = lexer->src;
+             (p = snuk_string_find_byte(p, (uint64_t)(lexer->end - p), '\n')); ++p)
+            snuk_darray_push(&lexer->newlines, (uint32_t)(p - lexer->src));
+    }
+
+    // Count the newlines before the token
+    uint64_t low = 0, high = snuk_darray_get_length(lexer->newlines);
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (lexer->newlines[mid] < token.offset) low = mid + 1;
+        else high = mid;
+    }
+
+    *line = low;
+    *col = token.offset - (low ? lexer->newlines[low - 1] + 1 : 0);
+}
+
+void snuk_lexer_token_comments(
+    const SnukLexer *lexer, SnukToken token, SnukStringView *leading, SnukStringView *trailing) {
+    *leading = *trailing = (SnukStringView){0};
+    // A virtual semicolon can share its offset with the brace after it
+    if (!lexer->trivia || token.type == SNUK_TOKEN_VSEMICOLON) return;
+
+    uint64_t low = 0, high = snuk_darray_get_length(lexer->trivia);
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (lexer->trivia[mid].offset < token.offset) low = mid + 1;
+        else high = mid;
+    }
+
+    if (low == snuk_darray_get_length(lexer->trivia) || lexer->trivia[low].offset != token.offset) return;
+    *leading = lexer->trivia[low].leading;
+    *trailing = lexer->trivia[low].trailing;
+}
+
+void snuk_lexer_log_token(SnukLexer *lexer, SnukToken token) {
+    uint64_t line, col;
+    snuk_lexer_token_position(lexer, token, &line, &col);
+
     log_trace("Token type: %s", snuk_lexer_token_type_to_string(token.type));
-    if (token.type == SNUK_TOKEN_INTEGER) log_trace("\tInteger value: %ld", token.int_literal);
-    else if (token.type == SNUK_TOKEN_FLOAT) log_trace("\tFloat value: %lf", token.float_literal);
+    if (token.type == SNUK_TOKEN_INTEGER)
+        log_trace("\tInteger value: %ld", snuk_lexer_token_literal(lexer, token).int_literal);
+    else if (token.type == SNUK_TOKEN_FLOAT)
+        log_trace("\tFloat value: %lf", snuk_lexer_token_literal(lexer, token).float_literal);
     else if (token.type == SNUK_TOKEN_ERROR)
-        log_trace("\tError line: " SNUK_STRING_VIEW_FORMAT " and err_msg: %s",
-                  SNUK_STRING_VIEW_ARG(token.string_literal), token.err_msg);
+        log_trace("\tError: %s", snuk_lexer_token_literal(lexer, token).err_msg);
     else
-        log_trace("\tString value: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(token.string_literal));
-    log_trace("\tLine: %d, Column: %d", token.line, token.col);
+        log_trace("\tString value: " SNUK_STRING_VIEW_FORMAT,
+                  SNUK_STRING_VIEW_ARG(snuk_lexer_token_text(lexer, token)));
+    log_trace("\tLine: %d, Column: %d", line, col);
 }
 
 const char *snuk_lexer_token_type_to_string(SnukTokenType type) {
@@ -765,6 +918,8 @@ const char *snuk_lexer_token_type_to_string(SnukTokenType type) {
             return SNUK_STRINGIFY(SNUK_TOKEN_BREAK);
         case SNUK_TOKEN_CONTINUE:
             return SNUK_STRINGIFY(SNUK_TOKEN_CONTINUE);
+        case SNUK_TOKEN_YIELD:
+            return SNUK_STRINGIFY(SNUK_TOKEN_YIELD);
         case SNUK_TOKEN_FN:
             return SNUK_STRINGIFY(SNUK_TOKEN_FN);
         case SNUK_TOKEN_TYPE:
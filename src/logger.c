@@ -6,6 +6,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "snuk/thread.h"
+
 #if defined(SN_OS_WINDOWS)
     #include <windows.h>
 
@@ -16,6 +18,11 @@ static bool enableVTProcessing(DWORD handle_type);
 
 #define LOGGER_BUFFER_SIZE 1024
 
+SNUK_STATIC_ASSERT(SNUK_LOG_LEVEL_TRACE == SN_LOG_LEVEL_TRACE && SNUK_LOG_LEVEL_DEBUG == SN_LOG_LEVEL_DEBUG
+                       && SNUK_LOG_LEVEL_INFO == SN_LOG_LEVEL_INFO && SNUK_LOG_LEVEL_WARN == SN_LOG_LEVEL_WARN
+                       && SNUK_LOG_LEVEL_ERROR == SN_LOG_LEVEL_ERROR && SNUK_LOG_LEVEL_FATAL == SN_LOG_LEVEL_FATAL,
+                   "SNUK_LOG_LEVEL_* must match snLogLevel");
+
 typedef struct stdout_stderr_sink {
     // 0 -> stdout, 1 -> stderr
     bool colored_enabled[2];
@@ -27,16 +34,79 @@ static void stdout_stderr_sink_flush(void *data);
 
 static snStaticLogger sl;
 static char log_buffer[LOGGER_BUFFER_SIZE];
+static volatile uint64_t log_lock;  // the buffer is shared by every thread logging synchronously
 static stdout_stderr_sink sink_data;
 static snSink sinks[] = {
     {.open = stdout_stderr_sink_open, .flush = stdout_stderr_sink_flush, .write = stdout_stderr_sink_write, .data = &sink_data}
 };
 
+#if defined(SNUK_LOG_ASYNC)
+    // Must be a power of two
+    #define LOG_RING_SLOTS 1024
+    #define LOG_SLOT_SIZE 256
+    #define LOG_DRAIN_INTERVAL_MS 1
+
+/**
+ * @brief One formatted message.
+ *
+ * sequence tells whose turn the slot is: equal to the enqueue position when
+ * free for a producer, one past it once the message is ready to drain.
+ */
+typedef struct LogSlot {
+    volatile uint64_t sequence;
+    snLogLevel level;
+    uint32_t len;
+    char msg[LOG_SLOT_SIZE];
+} LogSlot;
+
+/**
+ * @brief Bounded multi producer, single consumer queue of formatted messages.
+ *
+ * Producers claim a slot by advancing head with a compare exchange and never
+ * wait, a message that finds the ring full is dropped and counted. Only the
+ * drain thread touches tail.
+ */
+static struct {
+    LogSlot slots[LOG_RING_SLOTS];
+    volatile uint64_t head;
+    uint64_t tail;
+    volatile uint64_t dropped;
+    volatile uint64_t running;
+    SnukThread *thread;
+} ring;
+
+static void log_async(snLogLevel level, const char *file, const char *function, long line,
+                      const char *format_string, va_list args);
+static bool ring_drain(void);
+static void ring_thread(void *arg);
+#endif
+
 void snuk_logger_init(void) {
     sn_static_logger_init(&sl, log_buffer, LOGGER_BUFFER_SIZE, sinks, SNUK_ARRAY_LENGTH(sinks));
+
+#if defined(SNUK_LOG_ASYNC)
+    for (uint64_t i = 0; i < LOG_RING_SLOTS; ++i) ring.slots[i].sequence = i;
+    ring.head = 0;
+    ring.tail = 0;
+    ring.dropped = 0;
+    ring.running = 1;
+    ring.thread = snuk_thread_create(ring_thread, NULL);
+    // Fall back to logging synchronously
+    if (!ring.thread) ring.running = 0;
+#endif
 }
 
 void snuk_logger_deinit(void) {
+#if defined(SNUK_LOG_ASYNC)
+    if (ring.thread) {
+        snuk_atomic_store(&ring.running, 0);
+        snuk_thread_join(ring.thread);
+        ring.thread = NULL;
+        // Whatever was queued while the thread was stopping
+        ring_drain();
+    }
+#endif
+
     sn_static_logger_deinit(&sl);
 }
 
@@ -44,6 +114,17 @@ void snuk_log_msg(
     snLogLevel level, const char *file, const char *function, long line, const char *format_string, ...) {
     if (level < sl.level) return;
 
+#if defined(SNUK_LOG_ASYNC)
+    // Fatal messages are usually followed by an abort, write them right away
+    if (ring.thread && level < SN_LOG_LEVEL_FATAL) {
+        va_list args;
+        va_start(args, format_string);
+        log_async(level, file, function, line, format_string, args);
+        va_end(args);
+        return;
+    }
+#endif
+
     const char *level_string = NULL;
     const char *level_strings[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
     level_string = level_strings[level];
@@ -71,10 +152,101 @@ void snuk_log_msg(
 
     va_list args;
     va_start(args, format_string);
+    snuk_spin_lock(&log_lock);
     sn_static_logger_log_va(&sl, level, buffer, args);
+    snuk_spin_unlock(&log_lock);
     va_end(args);
 }
 
+#if defined(SNUK_LOG_ASYNC)
+/**
+ * @brief Format a message straight into a ring slot, the caller never blocks.
+ */
+static void log_async(snLogLevel level, const char *file, const char *function, long line,
+                      const char *format_string, va_list args) {
+    const char *level_strings[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+    uint64_t pos = snuk_atomic_load(&ring.head);
+    LogSlot *slot;
+    while (true) {
+        slot = &ring.slots[pos & (LOG_RING_SLOTS - 1)];
+        int64_t diff = (int64_t)snuk_atomic_load(&slot->sequence) - (int64_t)pos;
+        if (diff == 0) {
+            if (snuk_atomic_compare_exchange(&ring.head, &pos, pos + 1)) break;
+        } else if (diff < 0) {
+            // Drain thread is a full lap behind
+            snuk_atomic_fetch_add(&ring.dropped, 1);
+            return;
+        } else {
+            pos = snuk_atomic_load(&ring.head);
+        }
+    }
+
+    int len;
+    if (level < SN_LOG_LEVEL_WARN)
+        len = snprintf(slot->msg, LOG_SLOT_SIZE, "[%s]: ", level_strings[level]);
+    else
+        len = snprintf(slot->msg, LOG_SLOT_SIZE, "[%s]: %s:%lu in function %s: ", level_strings[level], file,
+                       line, function);
+    if (len < 0) len = 0;
+
+    // Long messages are cut short, keeping room for the newline
+    if (len < LOG_SLOT_SIZE - 1) {
+        int written = vsnprintf(slot->msg + len, LOG_SLOT_SIZE - 1 - len, format_string, args);
+        if (written > 0) len += written;
+    }
+    if (len > LOG_SLOT_SIZE - 2) len = LOG_SLOT_SIZE - 2;
+    slot->msg[len++] = '\n';
+
+    slot->level = level;
+    slot->len = (uint32_t)len;
+    snuk_atomic_store(&slot->sequence, pos + 1);
+}
+
+/**
+ * @brief Write every ready message to the sinks.
+ *
+ * @return True if anything was written.
+ */
+static bool ring_drain(void) {
+    bool wrote = false;
+    while (true) {
+        LogSlot *slot = &ring.slots[ring.tail & (LOG_RING_SLOTS - 1)];
+        if (snuk_atomic_load(&slot->sequence) != ring.tail + 1) break;
+
+        for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(sinks); ++i)
+            sinks[i].write(slot->msg, slot->len, slot->level, sinks[i].data);
+
+        // Hand the slot to the producers of the next lap
+        snuk_atomic_store(&slot->sequence, ring.tail + LOG_RING_SLOTS);
+        ring.tail++;
+        wrote = true;
+    }
+
+    uint64_t dropped = snuk_atomic_load(&ring.dropped);
+    if (dropped) {
+        snuk_atomic_fetch_add(&ring.dropped, (uint64_t)0 - dropped);
+        char msg[64];
+        int len = snprintf(msg, sizeof(msg), "[WARN]: log ring full, dropped %llu messages\n",
+                           (unsigned long long)dropped);
+        for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(sinks); ++i)
+            sinks[i].write(msg, (size_t)len, SN_LOG_LEVEL_WARN, sinks[i].data);
+        wrote = true;
+    }
+
+    if (wrote)
+        for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(sinks); ++i) sinks[i].flush(sinks[i].data);
+
+    return wrote;
+}
+
+static void ring_thread(void *arg) {
+    SNUK_UNUSED(arg);
+    while (snuk_atomic_load(&ring.running))
+        if (!ring_drain()) snuk_thread_sleep_ms(LOG_DRAIN_INTERVAL_MS);
+}
+#endif
+
 static void stdout_stderr_sink_write(const char *msg, size_t len, snLogLevel level, void *data) {
     stdout_stderr_sink *sink = (stdout_stderr_sink *)data;
 
@@ -1,8 +1,18 @@
 #include "snuk/memory.h"
 
 #include "snuk/logger.h"
+#include "snuk/stats.h"
+#include "snuk/thread.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+// Slabs get this share of the reserved address space
+#define SLAB_RESERVE_DIVISOR 4
+#define SLAB_CHUNK_SIZE KIB(16)
+#define SLAB_GRANULE 16
+#define SLAB_MAX_SIZE 256
+#define SLAB_CLASS_COUNT 8
 
 typedef struct SnukPageAllocator {
     uint8_t *base;
@@ -17,10 +27,58 @@ static void *commit_pages(SnukPageAllocator *allocator, uint32_t pages);
 static void *reverse_commit_pages(SnukPageAllocator *allocator, uint32_t pages);
 static void reverse_decommit_pages(SnukPageAllocator *allocator, void *base, uint32_t pages);
 
+/**
+ * @brief Blocks of one size, carved from chunks that hold nothing else.
+ */
+typedef struct SlabClass {
+    void *free;  // singly linked through the first word of each block
+    uint8_t *bump;  // uncarved rest of the newest chunk
+    uint8_t *bump_end;
+} SlabClass;
+
+/**
+ * @brief Size-class front-end for small allocations.
+ *
+ * Chunks are committed on demand from a dedicated reservation, so whether a
+ * pointer belongs to a slab is a range check and its class is a table lookup
+ * by chunk index. The table sits in the first chunks of the reservation.
+ * Every thread carves and recycles blocks through its own slab_classes, only
+ * taking a chunk or the blocks of an exited thread needs the lock.
+ */
+typedef struct SnukSlabAllocator {
+    uint8_t *base;
+    uint8_t *chunk_class;
+    uint32_t total_chunks;
+    uint32_t used_chunks;
+    void *orphans[SLAB_CLASS_COUNT];  // free lists left by exited threads
+} SnukSlabAllocator;
+
+// Multiples of SLAB_GRANULE, so every block is SLAB_GRANULE aligned
+static const uint16_t slab_class_size[SLAB_CLASS_COUNT] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+// Indexed by size rounded up to SLAB_GRANULE, in granules
+static const uint8_t slab_class_of[SLAB_MAX_SIZE / SLAB_GRANULE + 1]
+    = {0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7};
+
+static bool create_slab(SnukSlabAllocator *slab, uint64_t reserve_size);
+static void destroy_slab(SnukSlabAllocator *slab);
+static bool slab_refill(SnukSlabAllocator *slab, uint8_t class);
+static bool slab_grow(SnukSlabAllocator *slab, uint8_t class);
+
+SNUK_FORCE_INLINE bool slab_owns(SnukSlabAllocator *slab, void *ptr) {
+    return (uintptr_t)ptr - (uintptr_t)slab->base < (uint64_t)slab->total_chunks * SLAB_CHUNK_SIZE;
+}
+
+SNUK_FORCE_INLINE uint8_t slab_class_of_ptr(SnukSlabAllocator *slab, void *ptr) {
+    return slab->chunk_class[((uintptr_t)ptr - (uintptr_t)slab->base) / SLAB_CHUNK_SIZE];
+}
+
 static void try_increasing_allocator_size(void);
 
 static SnukPageAllocator page_allocator;
 static snFreeListAllocator galloc;
+static SnukSlabAllocator slab;
+static SNUK_THREAD_LOCAL SlabClass slab_classes[SLAB_CLASS_COUNT];
 
 bool snuk_memory_init(uint64_t reserve_size) {
     uint64_t page_size = sn_vm_get_page_size();
@@ -31,45 +89,188 @@ bool snuk_memory_init(uint64_t reserve_size) {
     if (!base) return false;
 
     if (!sn_freelist_allocator_init(&galloc, base, page_size)) return false;
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_GLOBAL, page_size);
+
+    // Without slabs every allocation goes to the freelist, still correct
+    if (!create_slab(&slab, reserve_size / SLAB_RESERVE_DIVISOR)) slab = (SnukSlabAllocator){0};
 
     return true;
 }
 
 void snuk_memory_deinit(void) {
+    // Other threads are gone by now, the caller's blocks die with the slab
+    memset(slab_classes, 0, sizeof(slab_classes));
+    destroy_slab(&slab);
     sn_freelist_allocator_deinit(&galloc);
     destroy_allocator(&page_allocator);
 }
 
+/**
+ * @brief Taken around the freelist, the page allocator and slab chunk
+ * handouts while shared is set, snuk_memory_set_shared only flips it with a
+ * single thread running.
+ */
+static bool shared;
+static volatile uint64_t lock;
+
+void snuk_memory_set_shared(bool value) {
+    shared = value;
+    snuk_stats_shared = value;
+}
+
+void snuk_memory_thread_exit(void) {
+    bool locked = false;
+    for (uint8_t class = 0; class < SLAB_CLASS_COUNT; ++class) {
+        SlabClass *slab_class = &slab_classes[class];
+
+        // The uncarved rest of the chunk goes along with the freed blocks
+        for (; slab_class->bump != slab_class->bump_end; slab_class->bump += slab_class_size[class]) {
+            *(void **)slab_class->bump = slab_class->free;
+            slab_class->free = slab_class->bump;
+        }
+        if (!slab_class->free) continue;
+
+        void *tail = slab_class->free;
+        while (*(void **)tail) tail = *(void **)tail;
+
+        if (!locked) snuk_spin_lock(&lock);
+        locked = true;
+        *(void **)tail = slab.orphans[class];
+        slab.orphans[class] = slab_class->free;
+    }
+    if (locked) snuk_spin_unlock(&lock);
+
+    memset(slab_classes, 0, sizeof(slab_classes));
+}
+
 void *snuk_allocate_pages(uint32_t pages) {
+    bool locked = shared;
+    if (locked) snuk_spin_lock(&lock);
     void *base = reverse_commit_pages(&page_allocator, pages);
     if (!base) {
         log_fatal("Ran out of memory!", NULL);
         exit(EXIT_FAILURE);
     }
+    SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_PAGES, (uint64_t)pages * sn_vm_get_page_size());
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_PAGES, (uint64_t)pages * sn_vm_get_page_size());
+    if (locked) snuk_spin_unlock(&lock);
     return base;
 }
 
 void snuk_free_pages(void *base, uint32_t pages) {
+    bool locked = shared;
+    if (locked) snuk_spin_lock(&lock);
     reverse_decommit_pages(&page_allocator, base, pages);
+    SNUK_STATS_INC(allocators[SNUK_STATS_ALLOCATOR_PAGES].frees);
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_PAGES, 0 - (uint64_t)pages * sn_vm_get_page_size());
+    if (locked) snuk_spin_unlock(&lock);
+}
+
+// Blocks come from the calling thread's classes, NULL once the slabs ran out
+SNUK_FORCE_INLINE void *slab_alloc(uint64_t size) {
+    uint8_t class = slab_class_of[(size + SLAB_GRANULE - 1) / SLAB_GRANULE];
+    SlabClass *slab_class = &slab_classes[class];
+
+    void *block = slab_class->free;
+    if (block) {
+        slab_class->free = *(void **)block;
+    } else {
+        if (slab_class->bump == slab_class->bump_end && !slab_refill(&slab, class)) return NULL;
+        // A refill may have brought back freed blocks instead of a chunk
+        block = slab_class->free;
+        if (block) {
+            slab_class->free = *(void **)block;
+        } else {
+            block = slab_class->bump;
+            slab_class->bump += slab_class_size[class];
+        }
+    }
+
+    SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_SLAB, size);
+    SNUK_STATS_ADD_PEAK(allocators[SNUK_STATS_ALLOCATOR_SLAB].live, allocators[SNUK_STATS_ALLOCATOR_SLAB].live_peak,
+                        slab_class_size[class]);
+    return block;
+}
+
+// Any thread may free a block, it joins that thread's list
+SNUK_FORCE_INLINE void slab_free(void *ptr) {
+    uint8_t class = slab_class_of_ptr(&slab, ptr);
+    *(void **)ptr = slab_classes[class].free;
+    slab_classes[class].free = ptr;
+    SNUK_STATS_INC(allocators[SNUK_STATS_ALLOCATOR_SLAB].frees);
+    SNUK_STATS_ADD(allocators[SNUK_STATS_ALLOCATOR_SLAB].live, 0 - (uint64_t)slab_class_size[class]);
 }
 
+// Callers hold the lock, loops instead of retrying through a call keep them inlinable
+SNUK_FORCE_INLINE void *heap_alloc(uint64_t size, uint64_t align) {
+    void *ptr;
+    while (!(ptr = sn_freelist_allocator_allocate(&galloc, size, align))) try_increasing_allocator_size();
+    SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_GLOBAL, size);
+    return ptr;
+}
+
+SNUK_FORCE_INLINE void heap_free(void *ptr) {
+    sn_freelist_allocator_free(&galloc, ptr);
+    SNUK_STATS_INC(allocators[SNUK_STATS_ALLOCATOR_GLOBAL].frees);
+}
+
+static void *heap_realloc(void *ptr, uint64_t new_size, uint64_t align) {
+    void *new_ptr;
+    while (!(new_ptr = sn_freelist_allocator_reallocate(&galloc, ptr, new_size, align)))
+        try_increasing_allocator_size();
+    SNUK_STATS_ALLOC(SNUK_STATS_ALLOCATOR_GLOBAL, new_size);
+    return new_ptr;
+}
+
+// The single threaded path stays as short as it was without the lock
 void *snuk_alloc(uint64_t size, uint64_t align) {
-    void *ptr = sn_freelist_allocator_allocate(&galloc, size, align);
+    if (size <= SLAB_MAX_SIZE && align <= SLAB_GRANULE) {
+        void *block = slab_alloc(size);
+        if (block) return block;
+        // Slab space ran out, the freelist takes it
+    }
 
-    if (ptr) return ptr;
-    try_increasing_allocator_size();
-    return snuk_alloc(size, align);
+    if (!shared) return heap_alloc(size, align);
+
+    snuk_spin_lock(&lock);
+    void *ptr = heap_alloc(size, align);
+    snuk_spin_unlock(&lock);
+    return ptr;
 }
 
 void *snuk_realloc(void *ptr, uint64_t new_size, uint64_t align) {
-    void *new_ptr = sn_freelist_allocator_reallocate(&galloc, ptr, new_size, align);
-    if (new_ptr) return new_ptr;
-    try_increasing_allocator_size();
-    return snuk_realloc(ptr, new_size, align);
+    if (slab_owns(&slab, ptr)) {
+        uint64_t old_size = slab_class_size[slab_class_of_ptr(&slab, ptr)];
+        if (new_size <= old_size && align <= SLAB_GRANULE) return ptr;
+
+        void *moved = snuk_alloc(new_size, align);
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+        slab_free(ptr);
+        return moved;
+    }
+
+    if (!shared) return heap_realloc(ptr, new_size, align);
+
+    snuk_spin_lock(&lock);
+    void *new_ptr = heap_realloc(ptr, new_size, align);
+    snuk_spin_unlock(&lock);
+    return new_ptr;
 }
 
 void snuk_free(void *ptr) {
-    sn_freelist_allocator_free(&galloc, ptr);
+    if (slab_owns(&slab, ptr)) {
+        slab_free(ptr);
+        return;
+    }
+
+    if (!shared) {
+        heap_free(ptr);
+        return;
+    }
+
+    snuk_spin_lock(&lock);
+    heap_free(ptr);
+    snuk_spin_unlock(&lock);
 }
 
 static bool create_allocator(SnukPageAllocator *allocator, uint32_t pages) {
@@ -128,6 +329,66 @@ static void reverse_decommit_pages(SnukPageAllocator *allocator, void *base, uin
     allocator->reverse_committed_pages -= pages;
 }
 
+static bool create_slab(SnukSlabAllocator *slab, uint64_t reserve_size) {
+    uint64_t page_size = sn_vm_get_page_size();
+    if (SLAB_CHUNK_SIZE % page_size != 0) return false;
+
+    uint32_t total_chunks = (uint32_t)(reserve_size / SLAB_CHUNK_SIZE);
+    // One byte of class table per chunk, rounded up to whole chunks
+    uint32_t table_chunks = (total_chunks + SLAB_CHUNK_SIZE - 1) / SLAB_CHUNK_SIZE;
+    if (total_chunks <= table_chunks) return false;
+
+    *slab = (SnukSlabAllocator){
+        .base = sn_vm_reserve((uint64_t)total_chunks * (SLAB_CHUNK_SIZE / page_size)),
+        .total_chunks = total_chunks,
+        .used_chunks = table_chunks,
+    };
+    if (!slab->base) return false;
+
+    if (!sn_vm_commit(slab->base, (uint64_t)table_chunks * (SLAB_CHUNK_SIZE / page_size))) return false;
+    slab->chunk_class = slab->base;
+
+    return true;
+}
+
+static void destroy_slab(SnukSlabAllocator *slab) {
+    if (!slab->base) return;
+    sn_vm_decommit(slab->base, (uint64_t)slab->total_chunks * (SLAB_CHUNK_SIZE / sn_vm_get_page_size()));
+    *slab = (SnukSlabAllocator){0};
+}
+
+// Blocks an exited thread left behind go first, a new chunk otherwise
+static bool slab_refill(SnukSlabAllocator *slab, uint8_t class) {
+    bool locked = shared;
+    if (locked) snuk_spin_lock(&lock);
+
+    bool refilled = true;
+    if (slab->orphans[class]) {
+        slab_classes[class].free = slab->orphans[class];
+        slab->orphans[class] = NULL;
+    } else {
+        refilled = slab_grow(slab, class);
+    }
+
+    if (locked) snuk_spin_unlock(&lock);
+    return refilled;
+}
+
+static bool slab_grow(SnukSlabAllocator *slab, uint8_t class) {
+    if (slab->used_chunks == slab->total_chunks) return false;
+
+    uint8_t *chunk = slab->base + (uint64_t)slab->used_chunks * SLAB_CHUNK_SIZE;
+    if (!sn_vm_commit(chunk, SLAB_CHUNK_SIZE / sn_vm_get_page_size())) return false;
+
+    slab->chunk_class[slab->used_chunks++] = class;
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_SLAB, SLAB_CHUNK_SIZE);
+
+    uint64_t size = slab_class_size[class];
+    slab_classes[class].bump = chunk;
+    slab_classes[class].bump_end = chunk + SLAB_CHUNK_SIZE / size * size;
+    return true;
+}
+
 static void try_increasing_allocator_size(void) {
     void *base = commit_pages(&page_allocator, 1);
     if (!base) {
@@ -136,6 +397,7 @@ static void try_increasing_allocator_size(void) {
     }
 
     sn_freelist_allocator_increase_memory_size(&galloc, base, sn_vm_get_page_size());
+    SNUK_STATS_RESERVE(SNUK_STATS_ALLOCATOR_GLOBAL, sn_vm_get_page_size());
 }
 
 SNUK_INLINE void *snuk_allocator_global_alloc(void *data, uint64_t size, uint64_t align) {
@@ -1,24 +1,44 @@
 #include "snuk/parser/parser.h"
 
 #include "snuk/parser/parser_common.h"
+#include "snuk/parser/snuk_expr.h"
 #include "snuk/parser/snuk_item.h"
 
-void snuk_parser_init(SnukParser *parser, const char *src, SnukAllocator *allocator) {
+void snuk_parser_init(SnukParser *parser, const char *src, SnukAllocator *allocator, SnukLexerMode mode) {
     *parser = (SnukParser){
         .allocator = allocator,
         .panic_mode = false,
     };
-    snuk_lexer_init(&parser->lexer, src);
+    snuk_lexer_init(&parser->lexer, src, mode);
 
-    parser->previous = (SnukToken){0};
-    parser->current = snuk_lexer_next_token(&parser->lexer);
-    if (parser->current.type == SNUK_TOKEN_ERROR) parser_error(parser, "lexer error");
-    parser->next = snuk_lexer_next_token(&parser->lexer);
+    // The last slot stays zeroed as the previous of the first token
+    parser->previous = &parser->tokens[SNUK_PARSER_TOKEN_BUFFER_SIZE - 1];
+    parser_fill_tokens(parser);
+    parser->current = &parser->tokens[0];
+    if (parser->current->type == SNUK_TOKEN_ERROR) parser_error(parser, "lexer error");
+    if (parser->token_count == 1) parser_fill_tokens(parser);
+    parser->next = &parser->tokens[1];
+}
+
+void parser_fill_tokens(SnukParser *parser) {
+    uint64_t start = parser->token_count & (SNUK_PARSER_TOKEN_BUFFER_SIZE - 1);
+    // Up to the end of the buffer, leaving previous and current alone
+    uint64_t count = SNUK_PARSER_TOKEN_BUFFER_SIZE - start;
+    if (count > SNUK_PARSER_TOKEN_BUFFER_SIZE - 2) count = SNUK_PARSER_TOKEN_BUFFER_SIZE - 2;
+    parser->token_count += snuk_lexer_next_tokens(&parser->lexer, &parser->tokens[start], count);
 }
 
 void snuk_parser_deinit(SnukParser *parser) {
     if (!parser) return;
     snuk_lexer_deinit(&parser->lexer);
+    if (parser->nodes) {
+        uint64_t count = snuk_darray_get_length(parser->nodes);
+        for (uint64_t i = 0; i < count; ++i) {
+            snuk_darray_destroy(parser->nodes[i].nodes);
+            snuk_darray_destroy(parser->nodes[i].fixups);
+        }
+        snuk_darray_destroy(parser->nodes);
+    }
     *parser = (SnukParser){0};
 }
 
@@ -28,19 +48,24 @@ void parser_error(SnukParser *parser, const char *err_msg) {
     parser->panic_mode = true;
 
     parser->err_msg = err_msg;
-    parser->err_token = parser->current;
+    parser->err_token = *parser->current;
 }
 
 SnukItem *parser_sync(SnukParser *parser) {
     parser->panic_mode = false;
-    if (parser->previous.type != SNUK_TOKEN_VSEMICOLON && parser->previous.type != SNUK_TOKEN_SEMICOLON)
+    if (parser->previous->type != SNUK_TOKEN_VSEMICOLON && parser->previous->type != SNUK_TOKEN_SEMICOLON)
         while (!parser_match_item_end(parser)) parser_advance(parser);
     return build_error_item(parser, parser->err_msg, parser->err_token);
 }
 
 SnukItem *snuk_parser_next_item(SnukParser *parser) {
-    if (parser->current.type == SNUK_TOKEN_EOF) return NULL;
+    if (parser->current->type == SNUK_TOKEN_EOF) return NULL;
+
+    // The item's nodes outside of fn bodies
+    parser_begin_nodes(parser);
     SnukItem *item = snuk_item_parse(parser);
+    parser_end_nodes(parser, SNUK_EXPR_NONE);
+
     if (parser->panic_mode) return parser_sync(parser);
     return item;
 }
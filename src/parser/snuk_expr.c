@@ -5,14 +5,6 @@
 #include "snuk/parser/snuk_type.h"
 #include "snuk/parser/snuk_var.h"
 
-SnukExpr null_expr = {
-    .type = SNUK_EXPR_NULL,
-};
-
-SnukExpr self_expr = {
-    .type = SNUK_EXPR_SELF,
-};
-
 /**
  * @brief Pratt parser precedence levels.
  */
@@ -39,9 +31,9 @@ typedef enum Precedence {
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-typedef SnukExpr *(*prefix_fn)(SnukParser *parser);
+typedef SnukExprId (*prefix_fn)(SnukParser *parser);
 
 /**
  * @brief Infix parse function for tokens that continue expressions.
@@ -49,9 +41,9 @@ typedef SnukExpr *(*prefix_fn)(SnukParser *parser);
  * @param parser Parser context to operate on.
  * @param expr Left-hand expression already parsed.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-typedef SnukExpr *(*infix_fn)(SnukParser *parser, SnukExpr *expr);
+typedef SnukExprId (*infix_fn)(SnukParser *parser, SnukExprId expr);
 
 /**
  * @brief Pratt parser rule for a token type.
@@ -68,36 +60,36 @@ typedef struct ParseRule {
  * @param parser Parser context to operate on.
  * @param precedence Minimum precedence to parse.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_precedence(SnukParser *parser, Precedence precedence);
+static SnukExprId parse_precedence(SnukParser *parser, Precedence precedence);
 
 /**
  * @brief Parse a primary expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_primary(SnukParser *parser);
+static SnukExprId parse_primary(SnukParser *parser);
 
 /**
  * @brief Parse a grouped expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_grouping(SnukParser *parser);
+static SnukExprId parse_grouping(SnukParser *parser);
 
 /**
  * @brief Parse a unary expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_unary(SnukParser *parser);
+static SnukExprId parse_unary(SnukParser *parser);
 
 /**
  * @brief Parse a binary expression.
@@ -105,9 +97,9 @@ static SnukExpr *parse_unary(SnukParser *parser);
  * @param parser Parser context to operate on.
  * @param left Left-hand expression.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_binary(SnukParser *parser, SnukExpr *left);
+static SnukExprId parse_binary(SnukParser *parser, SnukExprId left);
 
 /**
  * @brief Parse an assignment expression.
@@ -115,9 +107,9 @@ static SnukExpr *parse_binary(SnukParser *parser, SnukExpr *left);
  * @param parser Parser context to operate on.
  * @param left Candidate assignment target.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_assignment(SnukParser *parser, SnukExpr *left);
+static SnukExprId parse_assignment(SnukParser *parser, SnukExprId left);
 
 /**
  * @brief Parse an compound assignment expression.
@@ -125,63 +117,63 @@ static SnukExpr *parse_assignment(SnukParser *parser, SnukExpr *left);
  * @param parser Parser context to operate on.
  * @param left Candidate assignment target.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_compound_assignment(SnukParser *parser, SnukExpr *left);
+static SnukExprId parse_compound_assignment(SnukParser *parser, SnukExprId left);
 
 /**
  * @brief Parse an if expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_if(SnukParser *parser);
+static SnukExprId parse_if(SnukParser *parser);
 
 /**
  * @brief Parse an match expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_match(SnukParser *parser);
+static SnukExprId parse_match(SnukParser *parser);
 
 /**
  * @brief Parse an while or do while loop expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_while(SnukParser *parser);
+static SnukExprId parse_while(SnukParser *parser);
 
 /**
  * @brief Parse an for loop expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_for(SnukParser *parser);
+static SnukExprId parse_for(SnukParser *parser);
 
 /**
  * @brief Parse an function expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_fn(SnukParser *parser);
+static SnukExprId parse_fn(SnukParser *parser);
 
 /**
  * @brief Parse an block expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_block(SnukParser *parser);
+static SnukExprId parse_block(SnukParser *parser);
 
 /**
  * @brief Parse function call expression.
@@ -189,36 +181,36 @@ static SnukExpr *parse_block(SnukParser *parser);
  * @param parser Parser context to operate on.
  * @param left Name of the function
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_call(SnukParser *parser, SnukExpr *left);
+static SnukExprId parse_call(SnukParser *parser, SnukExprId left);
 
 /**
  * @brief Parse comment expression.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_comment(SnukParser *parser);
+static SnukExprId parse_comment(SnukParser *parser);
 
 /**
  * @brief Parse a list literal.
  *
  * @param parser Parser context to work on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_list(SnukParser *parser);
+static SnukExprId parse_list(SnukParser *parser);
 
 /**
  * @brief Parse the type token.
  *
  * @param parser Parser context to operate on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_type_token(SnukParser *parser);
+static SnukExprId parse_type_token(SnukParser *parser);
 
 /**
  * @brief Parse member access.
@@ -226,18 +218,18 @@ static SnukExpr *parse_type_token(SnukParser *parser);
  * @param parser Parser context to operate on.
  * @param left type to access field from.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_member(SnukParser *parser, SnukExpr *left);
+static SnukExprId parse_member(SnukParser *parser, SnukExprId left);
 
 /**
  * @brief Parse self.
  *
  * @param parser Parser context to work on.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_self(SnukParser *parser);
+static SnukExprId parse_self(SnukParser *parser);
 
 // clang-format off
 
@@ -338,9 +330,9 @@ SNUK_FORCE_INLINE ParseRule *get_rule(SnukTokenType type) {
  * @param parser Parser context to operate on.
  * @param name Name in case of syntax sugar.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_type(SnukParser *parser, SnukStringView name);
+static SnukExprId parse_type(SnukParser *parser, SnukStringView name);
 
 /**
  * @brief Parse type instance.
@@ -348,36 +340,36 @@ static SnukExpr *parse_type(SnukParser *parser, SnukStringView name);
  * @param parser Parser context to operate on.
  * @param type The type of instance.
  *
- * @return Parsed expression, or NULL on parse failure.
+ * @return Parsed expression, or SNUK_EXPR_NONE on parse failure.
  */
-static SnukExpr *parse_type_inst(SnukParser *parser, SnukType *type);
+static SnukExprId parse_type_inst(SnukParser *parser, SnukType *type);
 
-SnukExpr *snuk_expr_parse(SnukParser *parser) {
+SnukExprId snuk_expr_parse(SnukParser *parser) {
     return parse_precedence(parser, PRECEDENCE_ASSIGNMENT);
 }
 
-static SnukExpr *parse_precedence(SnukParser *parser, Precedence precedence) {
+static SnukExprId parse_precedence(SnukParser *parser, Precedence precedence) {
     parser_advance(parser);
-    prefix_fn pfn = get_rule(parser->previous.type)->pfn;
+    prefix_fn pfn = get_rule(parser->previous->type)->pfn;
     if (!pfn) {
         parser_error(parser, "expected expression");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
 
-    SnukExpr *left = pfn(parser);
+    SnukExprId left = pfn(parser);
 
-    while (precedence <= get_rule(parser->current.type)->precedence) {
+    while (precedence <= get_rule(parser->current->type)->precedence) {
         parser_advance(parser);
-        infix_fn ifn = get_rule(parser->previous.type)->ifn;
+        infix_fn ifn = get_rule(parser->previous->type)->ifn;
         left = ifn(parser, left);
     }
 
     return left;
 }
 
-static SnukExpr *parse_primary(SnukParser *parser) {
-    SnukToken t = parser->previous;
-    switch (t.type) {
+static SnukExprId parse_primary(SnukParser *parser) {
+    const SnukToken *t = parser->previous;
+    switch (t->type) {
         case SNUK_TOKEN_IDENTIFIER:
             return build_identifier_expr(parser);
         case SNUK_TOKEN_INTEGER:
@@ -402,48 +394,48 @@ static SnukExpr *parse_primary(SnukParser *parser) {
             break;
     }
 
-    return NULL;
+    return SNUK_EXPR_NONE;
 }
 
-static SnukExpr *parse_grouping(SnukParser *parser) {
-    SnukExpr *expr = snuk_expr_parse(parser);
+static SnukExprId parse_grouping(SnukParser *parser) {
+    SnukExprId expr = snuk_expr_parse(parser);
     parser_expect(parser, SNUK_TOKEN_RPAREN, "expected ')'");
     return expr;
 }
 
-static SnukExpr *parse_unary(SnukParser *parser) {
-    SnukToken op = parser->previous;
-    SnukExpr *right = parse_precedence(parser, PRECEDENCE_UNARY);
-    return build_unary_expr(parser, op.type, right);
+static SnukExprId parse_unary(SnukParser *parser) {
+    SnukTokenType op = parser->previous->type;
+    SnukExprId right = parse_precedence(parser, PRECEDENCE_UNARY);
+    return build_unary_expr(parser, op, right);
 }
 
-static SnukExpr *parse_binary(SnukParser *parser, SnukExpr *left) {
-    SnukToken op = parser->previous;
-    ParseRule *rule = get_rule(op.type);
-    SnukExpr *right = parse_precedence(parser, rule->precedence + 1);
-    return build_binary_expr(parser, op.type, left, right);
+static SnukExprId parse_binary(SnukParser *parser, SnukExprId left) {
+    SnukTokenType op = parser->previous->type;
+    ParseRule *rule = get_rule(op);
+    SnukExprId right = parse_precedence(parser, rule->precedence + 1);
+    return build_binary_expr(parser, op, left, right);
 }
 
-static SnukExpr *parse_assignment(SnukParser *parser, SnukExpr *left) {
-    SnukExpr *value = parse_precedence(parser, PRECEDENCE_ASSIGNMENT);
+static SnukExprId parse_assignment(SnukParser *parser, SnukExprId left) {
+    SnukExprId value = parse_precedence(parser, PRECEDENCE_ASSIGNMENT);
     return build_assign_expr(parser, left, value);
 }
 
-static SnukExpr *parse_compound_assignment(SnukParser *parser, SnukExpr *left) {
-    if (left->type != SNUK_EXPR_IDENTIFIER) {
+static SnukExprId parse_compound_assignment(SnukParser *parser, SnukExprId left) {
+    if (!left || parser_expr(parser, left)->type != SNUK_EXPR_IDENTIFIER) {
         parser_error(parser, "invalid assignment target");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
-    SnukTokenType op = parser->previous.type;
-    SnukExpr *value = parse_precedence(parser, PRECEDENCE_ASSIGNMENT);
+    SnukTokenType op = parser->previous->type;
+    SnukExprId value = parse_precedence(parser, PRECEDENCE_ASSIGNMENT);
     return build_compound_assign_expr(parser, op, left, value);
 }
 
-static SnukExpr *parse_if(SnukParser *parser) {
-    SnukExpr *condition = snuk_expr_parse(parser);
+static SnukExprId parse_if(SnukParser *parser) {
+    SnukExprId condition = snuk_expr_parse(parser);
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
-    SnukExpr *then_block = parse_block(parser);
-    SnukExpr *else_block = NULL;
+    SnukExprId then_block = parse_block(parser);
+    SnukExprId else_block = SNUK_EXPR_NONE;
     if (parser_match(parser, SNUK_TOKEN_ELSE)) {
         if (parser_match(parser, SNUK_TOKEN_IF)) {
             else_block = parse_if(parser);
@@ -455,16 +447,16 @@ static SnukExpr *parse_if(SnukParser *parser) {
     return build_if_expr(parser, condition, then_block, else_block);
 }
 
-static SnukExpr *parse_match(SnukParser *parser) {
+static SnukExprId parse_match(SnukParser *parser) {
     // TODO:
-    return build_match_expr(parser, NULL);
+    return build_match_expr(parser, SNUK_EXPR_NONE);
 }
 
-static SnukExpr *parse_while(SnukParser *parser) {
-    SnukExpr *condition = NULL;
-    SnukExpr *body = NULL;
+static SnukExprId parse_while(SnukParser *parser) {
+    SnukExprId condition = SNUK_EXPR_NONE;
+    SnukExprId body = SNUK_EXPR_NONE;
 
-    if (parser->previous.type == SNUK_TOKEN_DO) {
+    if (parser->previous->type == SNUK_TOKEN_DO) {
         parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
         body = parse_block(parser);
         parser_expect(parser, SNUK_TOKEN_WHILE, "expected while");
@@ -478,15 +470,15 @@ static SnukExpr *parse_while(SnukParser *parser) {
     return build_while_expr(parser, condition, body, false);
 }
 
-static SnukExpr *parse_for(SnukParser *parser) {
+static SnukExprId parse_for(SnukParser *parser) {
     // Case 1: for { ... }
     if (parser_match(parser, SNUK_TOKEN_LBRACE))
-        return build_for_expr(parser, NULL, NULL, NULL, parse_block(parser));
+        return build_for_expr(parser, NULL, SNUK_EXPR_NONE, SNUK_EXPR_NONE, parse_block(parser));
 
-    SnukItem *init = NULL;
-    SnukExpr *condition = NULL;
-    SnukExpr *update = NULL;
-    SnukExpr *body = NULL;
+    SnukItem *init = SNUK_EXPR_NONE;
+    SnukExprId condition = SNUK_EXPR_NONE;
+    SnukExprId update = SNUK_EXPR_NONE;
+    SnukExprId body = SNUK_EXPR_NONE;
 
     // Case 2: for var ... → must be C-style
     if (parser_check(parser, SNUK_TOKEN_VAR)) {
@@ -518,22 +510,36 @@ static SnukExpr *parse_for(SnukParser *parser) {
         return build_for_expr(parser, NULL, condition, update, body);
     }
 
+    // Case 4: for name in iterable { ... }
+    if (parser_check(parser, SNUK_TOKEN_IDENTIFIER) && parser_check_next(parser, SNUK_TOKEN_IN)) {
+        parser_advance(parser);
+        SnukStringView name = parser_token_text(parser, parser->previous);
+        parser_advance(parser);
+
+        SnukExprId iterable = snuk_expr_parse(parser);
+
+        parser_expect(parser, SNUK_TOKEN_LBRACE, "expected body of for loop");
+        body = parse_block(parser);
+
+        return build_for_in_expr(parser, name, iterable, body);
+    }
+
     // Otherwise parse an expression first
     // Well, we are preventing user from having type inst if it is init position
     // of for loop
-    SnukExpr *first = snuk_expr_parse(parser);
+    SnukExprId first = snuk_expr_parse(parser);
 
-    // Case 4: for condition { ... }
+    // Case 5: for condition { ... }
     if (parser_check(parser, SNUK_TOKEN_LBRACE)) {
         condition = first;
 
         parser_expect(parser, SNUK_TOKEN_LBRACE, "expected body of for loop");
         body = parse_block(parser);
 
-        return build_for_expr(parser, NULL, condition, NULL, body);
+        return build_for_expr(parser, NULL, condition, SNUK_EXPR_NONE, body);
     }
 
-    // Case 5: must be C-style → first is init
+    // Case 6: must be C-style → first is init
     parser_expect(parser, SNUK_TOKEN_SEMICOLON, "expected ';' or '{' after for expression");
 
     init = build_expr_item(parser, first);
@@ -549,15 +555,18 @@ static SnukExpr *parse_for(SnukParser *parser) {
     return build_for_expr(parser, init, condition, update, body);
 }
 
-static SnukExpr *parse_fn(SnukParser *parser) {
+static SnukExprId parse_fn(SnukParser *parser) {
     SnukStringView name = {0};
-    if (parser_match(parser, SNUK_TOKEN_IDENTIFIER)) name = parser->previous.string_literal;
+    if (parser_match(parser, SNUK_TOKEN_IDENTIFIER)) name = parser_token_text(parser, parser->previous);
+
+    // Default values and the body get a node array of their own
+    parser_begin_nodes(parser);
 
     SnukVar **params = snuk_darray_create(SnukVar *, parser->allocator);
     SnukType *fn_type = build_fn_type(parser, NULL, NULL, NULL);
 
     parser_expect(parser, SNUK_TOKEN_LPAREN, "expected '('");
-    while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current.type != SNUK_TOKEN_EOF) {
+    while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current->type != SNUK_TOKEN_EOF) {
         SnukVar *var = snuk_var_parse(parser, false);
 
         fn_type = build_fn_type(parser, fn_type, var->type, NULL);
@@ -567,78 +576,87 @@ static SnukExpr *parse_fn(SnukParser *parser) {
             parser_expect(parser, SNUK_TOKEN_COMMA, "expected comma");
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RPAREN) {
+    if (parser->previous->type != SNUK_TOKEN_RPAREN) {
         parser_error(parser, "expected ')'");
-        return NULL;
+        parser_end_nodes(parser, SNUK_EXPR_NONE);
+        return SNUK_EXPR_NONE;
     }
 
-    SnukType *ret_type = NULL;
+    SnukType *ret_type = SNUK_EXPR_NONE;
     if (parser_match(parser, SNUK_TOKEN_ARROW)) ret_type = snuk_type_parse(parser);
     else ret_type = build_any_type(parser);
 
     fn_type = build_fn_type(parser, fn_type, NULL, ret_type);
 
+    bool yielded = parser->yielded;
+    parser->yielded = false;
+    parser->fn_depth++;
+
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected body of function");
-    SnukExpr *body = parse_block(parser);
+    SnukExpr *body = parser_end_nodes(parser, parse_block(parser));
 
-    return build_fn_expr(parser, params, body, name, fn_type);
+    bool is_generator = parser->yielded;
+    parser->yielded = yielded;
+    parser->fn_depth--;
+
+    return build_fn_expr(parser, params, body, name, fn_type, is_generator);
 }
 
-static SnukExpr *parse_call(SnukParser *parser, SnukExpr *left) {
-    SnukExpr **params = snuk_darray_create(SnukExpr *, parser->allocator);
-    while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current.type != SNUK_TOKEN_EOF) {
-        SnukExpr *expr = snuk_expr_parse(parser);
+static SnukExprId parse_call(SnukParser *parser, SnukExprId left) {
+    SnukExprId *params = snuk_darray_create(SnukExprId, parser->allocator);
+    while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current->type != SNUK_TOKEN_EOF) {
+        SnukExprId expr = snuk_expr_parse(parser);
         snuk_darray_push(&params, expr);
         if (!parser_check(parser, SNUK_TOKEN_RPAREN))
             parser_expect(parser, SNUK_TOKEN_COMMA, "expected comma");
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RPAREN) {
+    if (parser->previous->type != SNUK_TOKEN_RPAREN) {
         parser_error(parser, "expected ')'");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
     return build_call_expr(parser, left, params);
 }
 
-static SnukExpr *parse_member(SnukParser *parser, SnukExpr *left) {
+static SnukExprId parse_member(SnukParser *parser, SnukExprId left) {
     parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected a member");
-    SnukExpr *expr = parse_primary(parser);
+    SnukExprId expr = parse_primary(parser);
     return build_member_access_expr(parser, left, expr);
 }
 
-static SnukExpr *parse_self(SnukParser *parser) {
+static SnukExprId parse_self(SnukParser *parser) {
     return build_self_expr(parser);
 }
 
-static SnukExpr *parse_comment(SnukParser *parser) {
-    SnukToken t = parser->previous;
+static SnukExprId parse_comment(SnukParser *parser) {
+    const SnukToken *t = parser->previous;
     return build_comment_expr(parser, t);
 }
 
-static SnukExpr *parse_list(SnukParser *parser) {
-    SnukExpr **elements = snuk_darray_create(SnukExpr *, parser->allocator);
-    while (!parser_match(parser, SNUK_TOKEN_RBRACKET) && parser->current.type != SNUK_TOKEN_EOF) {
-        SnukExpr *expr = snuk_expr_parse(parser);
+static SnukExprId parse_list(SnukParser *parser) {
+    SnukExprId *elements = snuk_darray_create(SnukExprId, parser->allocator);
+    while (!parser_match(parser, SNUK_TOKEN_RBRACKET) && parser->current->type != SNUK_TOKEN_EOF) {
+        SnukExprId expr = snuk_expr_parse(parser);
         snuk_darray_push(&elements, expr);
         if (!parser_check(parser, SNUK_TOKEN_RBRACKET))
             parser_expect(parser, SNUK_TOKEN_COMMA, "expected ',' or ']' after list element");
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACKET) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACKET) {
         parser_error(parser, "expected ']' after list elements");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
 
     return build_list_expr(parser, elements);
 }
 
-static SnukExpr *parse_type(SnukParser *parser, SnukStringView name) {
+static SnukExprId parse_type(SnukParser *parser, SnukStringView name) {
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
 
     SnukItem **members = snuk_darray_create(SnukItem *, parser->allocator);
     SnukType *type_type = build_type_type(parser);
 
-    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current.type != SNUK_TOKEN_EOF) {
+    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current->type != SNUK_TOKEN_EOF) {
         if (parser_check(parser, SNUK_TOKEN_VAR) || parser_check(parser, SNUK_TOKEN_CONST)
             || parser_check(parser, SNUK_TOKEN_FN) || parser_check(parser, SNUK_TOKEN_TYPE)) {
             SnukItem *item = snuk_item_parse(parser);
@@ -648,48 +666,48 @@ static SnukExpr *parse_type(SnukParser *parser, SnukStringView name) {
         }
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACE) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACE) {
         parser_error(parser, "expected '}'");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
 
     return build_type_expr(parser, members, name, type_type);
 }
 
-static SnukExpr *parse_type_inst(SnukParser *parser, SnukType *type) {
+static SnukExprId parse_type_inst(SnukParser *parser, SnukType *type) {
     SnukStringView name = {0};
     if (parser_match(parser, SNUK_TOKEN_IDENTIFIER)) {
-        name = parser->previous.string_literal;
+        name = parser_token_text(parser, parser->previous);
         parser_match(parser, SNUK_TOKEN_ASSIGN);  // optional '='
     }
 
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
 
-    SnukExpr **init = snuk_darray_create(SnukExpr *, parser->allocator);
-    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current.type != SNUK_TOKEN_EOF) {
+    SnukExprId *init = snuk_darray_create(SnukExprId, parser->allocator);
+    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current->type != SNUK_TOKEN_EOF) {
         parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected an member name");
-        SnukExpr *identifier = parse_primary(parser);
+        SnukExprId identifier = parse_primary(parser);
         parser_expect(parser, SNUK_TOKEN_COLON, "expected ':'");
-        SnukExpr *value = snuk_expr_parse(parser);
+        SnukExprId value = snuk_expr_parse(parser);
         parser_expect_item_end(parser);
-        SnukExpr *assign = build_assign_expr(parser, identifier, value);
+        SnukExprId assign = build_assign_expr(parser, identifier, value);
         snuk_darray_push(&init, assign);
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACE) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACE) {
         parser_error(parser, "expected '}'");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
 
     return build_type_inst_expr(parser, type, init, name);
 }
 
-static SnukExpr *parse_type_token(SnukParser *parser) {
+static SnukExprId parse_type_token(SnukParser *parser) {
     SnukStringView name = {0};
 
     if (!parser_match(parser, SNUK_TOKEN_IDENTIFIER)) return parse_type(parser, name);
 
-    name = parser->previous.string_literal;
+    name = parser_token_text(parser, parser->previous);
 
     if (parser_check_next(parser, SNUK_TOKEN_VAR) || parser_check_next(parser, SNUK_TOKEN_CONST)
         || parser_check_next(parser, SNUK_TOKEN_FN) || parser_check_next(parser, SNUK_TOKEN_TYPE))
@@ -699,20 +717,58 @@ static SnukExpr *parse_type_token(SnukParser *parser) {
     return parse_type_inst(parser, type);
 }
 
-static SnukExpr *parse_block(SnukParser *parser) {
-    SnukExpr *block_expr = build_block_expr(parser, NULL, NULL);
+static SnukExprId parse_block(SnukParser *parser) {
+    SnukExprId block_expr = build_block_expr(parser, SNUK_EXPR_NONE, NULL);
 
-    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current.type != SNUK_TOKEN_EOF)
+    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current->type != SNUK_TOKEN_EOF)
         block_expr = build_block_expr(parser, block_expr, snuk_item_parse(parser));
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACE) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACE) {
         parser_error(parser, "block was not closed");
-        return NULL;
+        return SNUK_EXPR_NONE;
     }
 
     return block_expr;
 }
 
+void parser_begin_nodes(SnukParser *parser) {
+    if (!parser->nodes) parser->nodes = snuk_darray_create(SnukParserNodes, NULL);
+
+    // Arrays of finished items and fns are kept for the next ones
+    if (parser->nodes_depth == snuk_darray_get_length(parser->nodes)) {
+        SnukParserNodes nodes = {
+            .nodes = snuk_darray_create(SnukExpr, NULL),
+            .fixups = snuk_darray_create(SnukExpr **, NULL),
+        };
+        snuk_darray_push(&parser->nodes, nodes);
+    }
+
+    SnukParserNodes *nodes = &parser->nodes[parser->nodes_depth++];
+    snuk_darray_clear(&nodes->nodes);
+    snuk_darray_clear(&nodes->fixups);
+}
+
+SnukExpr *parser_end_nodes(SnukParser *parser, SnukExprId id) {
+    SnukParserNodes *nodes = &parser->nodes[--parser->nodes_depth];
+
+    uint64_t count = snuk_darray_get_length(nodes->nodes);
+    SnukExpr *copy = NULL;
+    if (count) {
+        copy = (SnukExpr *)parser->allocator->alloc(
+            parser->allocator->data, count * sizeof(SnukExpr), alignof(SnukExpr));
+        SNUK_ASSERT(copy, "allocator is full, increase memory size!");
+        memcpy(copy, nodes->nodes, count * sizeof(SnukExpr));
+    }
+
+    uint64_t fixup_count = snuk_darray_get_length(nodes->fixups);
+    for (uint64_t i = 0; i < fixup_count; ++i) {
+        SnukExpr **slot = nodes->fixups[i];
+        *slot = &copy[(uintptr_t)*slot - 1];
+    }
+
+    return id ? &copy[id - 1] : NULL;
+}
+
 const char *snuk_expr_type_to_string(SnukExprType type) {
     switch (type) {
         case SNUK_EXPR_IDENTIFIER:
@@ -745,6 +801,8 @@ const char *snuk_expr_type_to_string(SnukExprType type) {
             return SNUK_STRINGIFY(SNUK_EXPR_DO_WHILE);
         case SNUK_EXPR_FOR:
             return SNUK_STRINGIFY(SNUK_EXPR_FOR);
+        case SNUK_EXPR_FOR_IN:
+            return SNUK_STRINGIFY(SNUK_EXPR_FOR_IN);
         case SNUK_EXPR_FN:
             return SNUK_STRINGIFY(SNUK_EXPR_FN);
         case SNUK_EXPR_TYPE:
@@ -801,30 +859,30 @@ void snuk_expr_log(SnukExpr *expr) {
         case SNUK_EXPR_UNARY:
             log_trace("Unary:", NULL);
             log_trace("%s", snuk_lexer_token_type_to_string(expr->unary.op));
-            snuk_expr_log(expr->unary.operand);
+            snuk_expr_log(snuk_expr_child(expr, expr->unary.operand));
             break;
         case SNUK_EXPR_BINARY:
             log_trace("Binary:", NULL);
-            snuk_expr_log(expr->binary.left);
+            snuk_expr_log(snuk_expr_child(expr, expr->binary.left));
             log_trace("%s", snuk_lexer_token_type_to_string(expr->binary.op));
-            snuk_expr_log(expr->binary.right);
+            snuk_expr_log(snuk_expr_child(expr, expr->binary.right));
             break;
         case SNUK_EXPR_ASSIGN:
-            snuk_expr_log(expr->assign.identifier);
-            snuk_expr_log(expr->assign.value);
+            snuk_expr_log(snuk_expr_child(expr, expr->assign.identifier));
+            snuk_expr_log(snuk_expr_child(expr, expr->assign.value));
             break;
         case SNUK_EXPR_COMPOUND_ASSIGN:
-            snuk_expr_log(expr->compound_assign.identifier);
+            snuk_expr_log(snuk_expr_child(expr, expr->compound_assign.identifier));
             log_trace("%s", snuk_lexer_token_type_to_string(expr->compound_assign.op));
-            snuk_expr_log(expr->compound_assign.value);
+            snuk_expr_log(snuk_expr_child(expr, expr->compound_assign.value));
             break;
         case SNUK_EXPR_IF:
             log_trace("if:", NULL);
-            snuk_expr_log(expr->if_else.condition);
+            snuk_expr_log(snuk_expr_child(expr, expr->if_else.condition));
             log_trace("then:", NULL);
-            snuk_expr_log(expr->if_else.then_block);
+            snuk_expr_log(snuk_expr_child(expr, expr->if_else.then_block));
             log_trace("else:", NULL);
-            snuk_expr_log(expr->if_else.else_block);
+            snuk_expr_log(snuk_expr_child(expr, expr->if_else.else_block));
             break;
         case SNUK_EXPR_MATCH:
             // TODO:
@@ -832,40 +890,47 @@ void snuk_expr_log(SnukExpr *expr) {
             break;
         case SNUK_EXPR_WHILE:
             log_trace("while:", NULL);
-            snuk_expr_log(expr->while_loop.condition);
+            snuk_expr_log(snuk_expr_child(expr, expr->while_loop.condition));
             log_trace("run:", NULL);
-            snuk_expr_log(expr->while_loop.body);
+            snuk_expr_log(snuk_expr_child(expr, expr->while_loop.body));
             break;
         case SNUK_EXPR_DO_WHILE:
             log_trace("do:", NULL);
-            snuk_expr_log(expr->while_loop.body);
+            snuk_expr_log(snuk_expr_child(expr, expr->while_loop.body));
             log_trace("while:", NULL);
-            snuk_expr_log(expr->while_loop.condition);
+            snuk_expr_log(snuk_expr_child(expr, expr->while_loop.condition));
             break;
         case SNUK_EXPR_FOR:
             log_trace("for:", NULL);
-            snuk_item_log(expr->for_loop.init);
-            snuk_expr_log(expr->for_loop.condition);
-            snuk_expr_log(expr->for_loop.update);
+            snuk_item_log(expr->for_loop->init);
+            snuk_expr_log(snuk_expr_child(expr, expr->for_loop->condition));
+            snuk_expr_log(snuk_expr_child(expr, expr->for_loop->update));
+            log_trace("run:", NULL);
+            snuk_expr_log(snuk_expr_child(expr, expr->for_loop->body));
+            break;
+        case SNUK_EXPR_FOR_IN:
+            log_trace("for " SNUK_STRING_VIEW_FORMAT " in:", SNUK_STRING_VIEW_ARG(*expr->for_in.name));
+            snuk_expr_log(snuk_expr_child(expr, expr->for_in.iterable));
             log_trace("run:", NULL);
-            snuk_expr_log(expr->for_loop.body);
+            snuk_expr_log(snuk_expr_child(expr, expr->for_in.body));
             break;
         case SNUK_EXPR_FN:
             log_trace("fn expression:", NULL);
-            if (expr->fn_expr.name.len)
-                log_trace("Name: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(expr->fn_expr.name));
-            count = snuk_darray_get_length(expr->fn_expr.params);
-            for (uint64_t i = 0; i < count; ++i) snuk_var_log(expr->fn_expr.params[i]);
+            if (expr->fn_expr->name.len)
+                log_trace("Name: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(expr->fn_expr->name));
+            count = snuk_darray_get_length(expr->fn_expr->params);
+            for (uint64_t i = 0; i < count; ++i) snuk_var_log(expr->fn_expr->params[i]);
+            if (expr->fn_expr->is_generator) log_trace("generator", NULL);
             log_trace("body:", NULL);
-            snuk_expr_log(expr->fn_expr.body);
-            snuk_type_log(expr->fn_expr.type);
+            snuk_expr_log(expr->fn_expr->body);
+            snuk_type_log(expr->fn_expr->type);
             break;
         case SNUK_EXPR_TYPE:
             log_trace("type expression:", NULL);
-            if (expr->type_expr.name.len)
-                log_trace("Name: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(expr->type_expr.name));
-            count = snuk_darray_get_length(expr->type_expr.members);
-            for (uint64_t i = 0; i < count; ++i) snuk_item_log(expr->type_expr.members[i]);
+            if (expr->type_expr->name.len)
+                log_trace("Name: " SNUK_STRING_VIEW_FORMAT, SNUK_STRING_VIEW_ARG(expr->type_expr->name));
+            count = snuk_darray_get_length(expr->type_expr->members);
+            for (uint64_t i = 0; i < count; ++i) snuk_item_log(expr->type_expr->members[i]);
             break;
         case SNUK_EXPR_BLOCK:
             log_trace("block expression:", NULL);
@@ -874,14 +939,14 @@ void snuk_expr_log(SnukExpr *expr) {
             break;
         case SNUK_EXPR_CALL:
             // TODO:
-            snuk_expr_log(expr->call.fn);
+            snuk_expr_log(snuk_expr_child(expr, expr->call.fn));
             count = snuk_darray_get_length(expr->call.params);
-            for (uint64_t i = 0; i < count; ++i) snuk_expr_log(expr->call.params[i]);
+            for (uint64_t i = 0; i < count; ++i) snuk_expr_log(snuk_expr_child(expr, expr->call.params[i]));
             break;
         case SNUK_EXPR_MEMBER:
             log_trace("Member:", NULL);
-            snuk_expr_log(expr->member_access.type);
-            snuk_expr_log(expr->member_access.field);
+            snuk_expr_log(snuk_expr_child(expr, expr->member_access.type));
+            snuk_expr_log(snuk_expr_child(expr, expr->member_access.field));
             break;
         case SNUK_EXPR_SELF:
             log_trace("self", NULL);
@@ -894,7 +959,7 @@ void snuk_expr_log(SnukExpr *expr) {
             log_trace("List:", NULL);
             uint64_t len = snuk_darray_get_length(expr->list.elements);
             for (uint64_t i = 0; i < len; ++i) {
-                snuk_expr_log(expr->list.elements[i]);
+                snuk_expr_log(snuk_expr_child(expr, expr->list.elements[i]));
             }
             break;
         }
@@ -0,0 +1,586 @@
+#include "snuk/parser/snuk_image.h"
+
+#include "snuk/arena.h"
+#include "snuk/darray.h"
+#include "snuk/io.h"
+#include "snuk/parser/parser.h"
+#include "snuk/parser/snuk_expr.h"
+#include "snuk/parser/snuk_type.h"
+#include "snuk/parser/snuk_var.h"
+
+#include <string.h>
+
+#if defined(SNUK_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+#define IMAGE_MAGIC "SNUKIMG"
+#define IMAGE_VERSION 1
+
+// Images only load into builds that lay the AST out the same way
+#define IMAGE_LAYOUT                                                                              \
+    ((uint32_t)(sizeof(void *) | sizeof(SnukExpr) << 8 | sizeof(SnukItem) << 16 | sizeof(SnukType) << 24))
+
+// Start of the AST in the file, above every alignment the parser asks for
+#define IMAGE_DATA_ALIGN 64
+
+/**
+ * @brief File header, followed by the source path, the AST and the tables.
+ *
+ * Offsets are from the start of the file except those in the tables and
+ * items, which are from the start of the AST. A version written with the
+ * other byte order does not match, so neither does the image.
+ */
+typedef struct ImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t layout;
+    uint64_t source_hash;  // of the source text the image was compiled from
+    uint64_t source_path;  // null terminated
+    uint64_t data;
+    uint64_t data_size;
+    uint64_t relocs;  // bitmap of the pointer sized words holding an offset into the AST
+    uint64_t reloc_words;
+    uint64_t globals;  // ImageGlobal entries
+    uint64_t global_count;
+    uint64_t items;  // array of item pointers
+    uint64_t item_count;
+} ImageHeader;
+
+/**
+ * @brief Pointer field holding one of the parser's statically allocated
+ * nodes, which have a different address every run.
+ */
+typedef struct ImageGlobal {
+    uint64_t offset;
+    uint64_t index;  // into image_globals
+} ImageGlobal;
+
+static void *const image_globals[] = {&any_type, &type_type, &continue_item};
+
+/**
+ * @brief Pointer fields found while walking the AST of a program.
+ *
+ * A field is a bit in a bitmap, so the fields of shared types count once and
+ * the table stays small enough not to cost more than the pages it relocates.
+ */
+typedef struct ImageWriter {
+    uint8_t *data;
+    uint64_t size;
+    uint64_t *fields;  // bit i set when word i of data is a non-NULL pointer
+} ImageWriter;
+
+// Words of a bitmap with a bit per pointer sized word of size bytes
+SNUK_INLINE uint64_t bitmap_words(uint64_t size) {
+    return (size / sizeof(void *) + 63) / 64;
+}
+
+// Index of the lowest set bit of a non zero word
+SNUK_FORCE_INLINE uint64_t lowest_bit(uint64_t bits) {
+#if defined(SNUK_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return index;
+#else
+    return (uint64_t)__builtin_ctzll(bits);
+#endif
+}
+
+static void walk_item(ImageWriter *w, SnukItem *item);
+static void walk_expr(ImageWriter *w, SnukExpr *expr);
+static void walk_var(ImageWriter *w, SnukVar *var);
+static void walk_type(ImageWriter *w, SnukType *type);
+
+/**
+ * @brief FNV-1a, enough to tell an edited source from the compiled one.
+ */
+static uint64_t hash_source(const char *src, uint64_t len) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint64_t i = 0; i < len; ++i) hash = (hash ^ (uint8_t)src[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+SNUK_INLINE bool in_image(ImageWriter *w, const void *ptr) {
+    return (const uint8_t *)ptr >= w->data && (const uint8_t *)ptr <= w->data + w->size;
+}
+
+// field points to a pointer, NULL pointers need no relocation
+static void add_field(ImageWriter *w, void *field) {
+    if (!*(void **)field) return;
+
+    SNUK_ASSERT(in_image(w, field), "pointer field outside the image");
+    uint64_t word = (uint64_t)((uint8_t *)field - w->data) / sizeof(void *);
+    w->fields[word / 64] |= 1ull << (word % 64);
+}
+
+// Empty views may point anywhere, including into the source
+static void add_string(ImageWriter *w, SnukStringView *sv) {
+    if (!sv->len) sv->str = NULL;
+    add_field(w, &sv->str);
+}
+
+/**
+ * @brief Add a darray field and detach the array from its allocator, the
+ * mapping is never freed or grown through it.
+ *
+ * @return The array, NULL if the field is NULL.
+ */
+static void *add_darray(ImageWriter *w, void *field) {
+    void *arr = *(void **)field;
+    if (!arr) return NULL;
+
+    add_field(w, field);
+    SnukDArray *header = SNUK_DARRAY_HEADER(arr);
+    header->allocator = NULL;
+    header->is_inline = true;
+    return arr;
+}
+
+static void walk_item(ImageWriter *w, SnukItem *item) {
+    if (!in_image(w, item)) return;  // continue_item
+
+    switch (item->type) {
+        case SNUK_ITEM_EXPR:
+        case SNUK_ITEM_RETURN:
+        case SNUK_ITEM_BREAK:
+        case SNUK_ITEM_YIELD:
+            add_field(w, &item->expr);
+            if (item->expr) walk_expr(w, item->expr);
+            break;
+
+        case SNUK_ITEM_VAR_DECL:
+        case SNUK_ITEM_CONST_DECL:
+            add_field(w, &item->var);
+            walk_var(w, item->var);
+            break;
+
+        case SNUK_ITEM_PRINT: {
+            SnukExpr **exprs = add_darray(w, &item->print_exprs);
+            uint64_t count = exprs ? snuk_darray_get_length(exprs) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &exprs[i]);
+                walk_expr(w, exprs[i]);
+            }
+            break;
+        }
+
+        case SNUK_ITEM_EXTEND: {
+            add_field(w, &item->extend_item.type);
+            if (item->extend_item.type) walk_expr(w, item->extend_item.type);
+            SnukItem **members = add_darray(w, &item->extend_item.members);
+            uint64_t count = members ? snuk_darray_get_length(members) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &members[i]);
+                walk_item(w, members[i]);
+            }
+            break;
+        }
+
+        case SNUK_ITEM_INTERFACE:
+            add_string(w, &item->interface_item.name);
+            add_field(w, &item->interface_item.type);
+            walk_type(w, item->interface_item.type);
+            break;
+
+        case SNUK_ITEM_CONTINUE:
+            break;
+
+        case SNUK_ITEM_ERROR:
+        case SNUK_ITEM_MAX:
+        default:
+            SNUK_SHOULD_NOT_REACH_HERE;
+            break;
+    }
+}
+
+static void walk_var(ImageWriter *w, SnukVar *var) {
+    add_string(w, &var->name);
+    add_field(w, &var->type);
+    if (var->type) walk_type(w, var->type);
+    add_field(w, &var->value);
+    if (var->value) walk_expr(w, var->value);
+}
+
+static void walk_type(ImageWriter *w, SnukType *type) {
+    if (!in_image(w, type)) return;  // any_type and type_type
+
+    switch (type->type) {
+        case TYPE_NAMED:
+            add_string(w, &type->name);
+            break;
+
+        case TYPE_FN: {
+            SnukType **params = add_darray(w, &type->fn.param_types);
+            uint64_t count = params ? snuk_darray_get_length(params) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &params[i]);
+                walk_type(w, params[i]);
+            }
+            add_field(w, &type->fn.return_type);
+            if (type->fn.return_type) walk_type(w, type->fn.return_type);
+            break;
+        }
+
+        case TYPE_INTERFACE: {
+            SnukVar **members = add_darray(w, &type->members);
+            uint64_t count = members ? snuk_darray_get_length(members) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &members[i]);
+                walk_var(w, members[i]);
+            }
+            break;
+        }
+
+        case TYPE_ANY:
+        case TYPE_TYPE:
+        default:
+            break;
+    }
+}
+
+// Children are relative to their parent, only the refs in darrays need the array
+static void walk_child(ImageWriter *w, SnukExpr *expr, SnukExprRef ref) {
+    if (ref) walk_expr(w, snuk_expr_child(expr, ref));
+}
+
+static void walk_children(ImageWriter *w, SnukExpr *expr, SnukExprRef **field) {
+    SnukExprRef *refs = add_darray(w, field);
+    uint64_t count = refs ? snuk_darray_get_length(refs) : 0;
+    for (uint64_t i = 0; i < count; ++i) walk_child(w, expr, refs[i]);
+}
+
+static void walk_expr(ImageWriter *w, SnukExpr *expr) {
+    switch (expr->type) {
+        case SNUK_EXPR_IDENTIFIER:
+            add_string(w, &expr->identifier);
+            break;
+        case SNUK_EXPR_STRING:
+            add_string(w, &expr->string_literal);
+            break;
+        case SNUK_EXPR_LINE_COMMENT:
+        case SNUK_EXPR_BLOCK_COMMENT:
+            add_string(w, &expr->comment);
+            break;
+
+        case SNUK_EXPR_UNARY:
+            walk_child(w, expr, expr->unary.operand);
+            break;
+        case SNUK_EXPR_BINARY:
+            walk_child(w, expr, expr->binary.left);
+            walk_child(w, expr, expr->binary.right);
+            break;
+        case SNUK_EXPR_ASSIGN:
+            walk_child(w, expr, expr->assign.identifier);
+            walk_child(w, expr, expr->assign.value);
+            break;
+        case SNUK_EXPR_COMPOUND_ASSIGN:
+            walk_child(w, expr, expr->compound_assign.identifier);
+            walk_child(w, expr, expr->compound_assign.value);
+            break;
+        case SNUK_EXPR_IF:
+            walk_child(w, expr, expr->if_else.condition);
+            walk_child(w, expr, expr->if_else.then_block);
+            walk_child(w, expr, expr->if_else.else_block);
+            break;
+        case SNUK_EXPR_MATCH:
+            walk_child(w, expr, expr->match.value);
+            break;
+        case SNUK_EXPR_WHILE:
+        case SNUK_EXPR_DO_WHILE:
+            walk_child(w, expr, expr->while_loop.condition);
+            walk_child(w, expr, expr->while_loop.body);
+            break;
+
+        case SNUK_EXPR_FOR: {
+            add_field(w, &expr->for_loop);
+            SnukForExpr *loop = expr->for_loop;
+            add_field(w, &loop->init);
+            if (loop->init) walk_item(w, loop->init);
+            walk_child(w, expr, loop->condition);
+            walk_child(w, expr, loop->update);
+            walk_child(w, expr, loop->body);
+            break;
+        }
+
+        case SNUK_EXPR_FOR_IN:
+            walk_child(w, expr, expr->for_in.iterable);
+            walk_child(w, expr, expr->for_in.body);
+            add_field(w, &expr->for_in.name);
+            if (expr->for_in.name) add_string(w, expr->for_in.name);
+            break;
+
+        case SNUK_EXPR_FN: {
+            add_field(w, &expr->fn_expr);
+            SnukFnExpr *fn = expr->fn_expr;
+            SnukVar **params = add_darray(w, &fn->params);
+            uint64_t count = params ? snuk_darray_get_length(params) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &params[i]);
+                walk_var(w, params[i]);
+            }
+            add_field(w, &fn->body);
+            if (fn->body) walk_expr(w, fn->body);
+            add_string(w, &fn->name);
+            add_field(w, &fn->type);
+            if (fn->type) walk_type(w, fn->type);
+            break;
+        }
+
+        case SNUK_EXPR_TYPE: {
+            add_field(w, &expr->type_expr);
+            SnukTypeExpr *type = expr->type_expr;
+            SnukItem **members = add_darray(w, &type->members);
+            uint64_t count = members ? snuk_darray_get_length(members) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &members[i]);
+                walk_item(w, members[i]);
+            }
+            add_string(w, &type->name);
+            add_field(w, &type->type);
+            if (type->type) walk_type(w, type->type);
+            break;
+        }
+
+        case SNUK_EXPR_TYPE_INST: {
+            add_field(w, &expr->type_inst_expr);
+            SnukTypeInstExpr *inst = expr->type_inst_expr;
+            add_field(w, &inst->type);
+            if (inst->type) walk_type(w, inst->type);
+            add_string(w, &inst->name);
+            walk_children(w, expr, &inst->init);
+            break;
+        }
+
+        case SNUK_EXPR_BLOCK: {
+            SnukItem **items = add_darray(w, &expr->block_items);
+            uint64_t count = items ? snuk_darray_get_length(items) : 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                add_field(w, &items[i]);
+                walk_item(w, items[i]);
+            }
+            break;
+        }
+
+        case SNUK_EXPR_CALL:
+            walk_child(w, expr, expr->call.fn);
+            walk_children(w, expr, &expr->call.params);
+            break;
+        case SNUK_EXPR_MEMBER:
+            walk_child(w, expr, expr->member_access.type);
+            walk_child(w, expr, expr->member_access.field);
+            break;
+        case SNUK_EXPR_LIST:
+            walk_children(w, expr, &expr->list.elements);
+            break;
+
+        case SNUK_EXPR_INT:
+        case SNUK_EXPR_FLOAT:
+        case SNUK_EXPR_BOOL:
+        case SNUK_EXPR_NULL:
+        case SNUK_EXPR_SELF:
+        case SNUK_EXPR_INDEX:
+        case SNUK_EXPR_MAX:
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Parse the whole program into one block of the arena.
+ *
+ * @return The item array in the arena, NULL on parse errors.
+ */
+static SnukItem **parse_program(const char *src, const char *source_path, SnukArena *arena, uint64_t *count) {
+    SnukAllocator allocator = snuk_arena_allocator(arena);
+    SnukParser parser;
+    snuk_parser_init(&parser, src, &allocator, SNUK_LEXER_MODE_EXECUTE);
+
+    SnukItem **parsed = snuk_darray_create(SnukItem *, NULL);
+    bool failed = false;
+    SnukItem *item;
+    while ((item = snuk_parser_next_item(&parser))) {
+        if (item->type == SNUK_ITEM_ERROR) {
+            snuk_eprintln("%s:%" PRIu64 ":%" PRIu64 ": %s", source_path, item->error.line + 1, item->error.col + 1,
+                          item->error.msg);
+            failed = true;
+        }
+        snuk_darray_push(&parsed, item);
+    }
+    snuk_parser_deinit(&parser);
+
+    *count = snuk_darray_get_length(parsed);
+    SnukItem **items = NULL;
+    if (!failed) {
+        items = snuk_arena_alloc(arena, (*count ? *count : 1) * sizeof(SnukItem *), alignof(SnukItem *));
+        memcpy(items, parsed, *count * sizeof(SnukItem *));
+    }
+    snuk_darray_destroy(parsed);
+    return items;
+}
+
+bool snuk_image_compile(const char *src, const char *source_path, const char *path) {
+    uint64_t src_len = strlen(src);
+
+    // Parsed trees run around ten bytes per source byte, relocating needs them
+    // in one block so parse again with a bigger chunk if it spills
+    uint64_t chunk_size = src_len * 16 > SNUK_ARENA_DEFAULT_CHUNK_SIZE ? src_len * 16 : SNUK_ARENA_DEFAULT_CHUNK_SIZE;
+    SnukArena arena;
+    SnukItem **items;
+    uint64_t item_count, data_size;
+    uint8_t *data;
+    while (true) {
+        snuk_arena_init(&arena, chunk_size);
+        items = parse_program(src, source_path, &arena, &item_count);
+        if (!items) {
+            snuk_arena_deinit(&arena);
+            return false;
+        }
+        data = snuk_arena_contiguous(&arena, &data_size);
+        if (data) break;
+        snuk_arena_deinit(&arena);
+        chunk_size *= 2;
+    }
+
+    uint64_t reloc_words = bitmap_words(data_size);
+    ImageWriter w = {
+        .data = data,
+        .size = data_size,
+        .fields = snuk_alloc(reloc_words * sizeof(uint64_t), alignof(uint64_t)),
+    };
+    memset(w.fields, 0, reloc_words * sizeof(uint64_t));
+    for (uint64_t i = 0; i < item_count; ++i) walk_item(&w, items[i]);
+    for (uint64_t i = 0; i < item_count; ++i) add_field(&w, &items[i]);
+
+    // Pointers into the AST become offsets, those to globals go in their own table
+    ImageGlobal *globals = snuk_darray_create(ImageGlobal, NULL);
+    for (uint64_t i = 0; i < reloc_words; ++i) {
+        for (uint64_t bits = w.fields[i]; bits; bits &= bits - 1) {
+            uint64_t offset = (i * 64 + lowest_bit(bits)) * sizeof(void *);
+            uint8_t **field = (uint8_t **)(data + offset);
+            if (in_image(&w, *field)) {
+                *(uint64_t *)field = (uint64_t)(*field - data);
+                continue;
+            }
+
+            uint64_t index = 0;
+            while (index < SNUK_ARRAY_LENGTH(image_globals) && image_globals[index] != *field) ++index;
+            SNUK_ASSERT(index < SNUK_ARRAY_LENGTH(image_globals), "AST points outside the image");
+            *field = NULL;
+            w.fields[i] &= ~(1ull << (offset / sizeof(void *) % 64));
+            snuk_darray_push(&globals, ((ImageGlobal){.offset = offset, .index = index}));
+        }
+    }
+
+    // Stored absolute so the image can be run from any directory
+    char *absolute = source_path[0] ? snuk_absolute_path(source_path) : NULL;
+    if (absolute) source_path = absolute;
+    uint64_t path_len = strlen(source_path) + 1;
+    uint64_t global_count = snuk_darray_get_length(globals);
+    ImageHeader header = {
+        .magic = IMAGE_MAGIC,
+        .version = IMAGE_VERSION,
+        .layout = IMAGE_LAYOUT,
+        .source_hash = hash_source(src, src_len),
+        .source_path = sizeof(ImageHeader),
+        .data = (sizeof(ImageHeader) + path_len + IMAGE_DATA_ALIGN - 1) / IMAGE_DATA_ALIGN * IMAGE_DATA_ALIGN,
+        .data_size = data_size,
+        .reloc_words = reloc_words,
+        .global_count = global_count,
+        .items = (uint64_t)((uint8_t *)items - data),
+        .item_count = item_count,
+    };
+    header.relocs = (header.data + data_size + 7) & ~(uint64_t)7;
+    header.globals = header.relocs + reloc_words * sizeof(uint64_t);
+    uint64_t size = header.globals + global_count * sizeof(ImageGlobal);
+
+    uint8_t *file = snuk_alloc(size, alignof(ImageHeader));
+    memset(file, 0, size);
+    memcpy(file, &header, sizeof(header));
+    memcpy(file + header.source_path, source_path, path_len);
+    if (absolute) snuk_free(absolute);
+    memcpy(file + header.data, data, data_size);
+    memcpy(file + header.relocs, w.fields, reloc_words * sizeof(uint64_t));
+    if (global_count) memcpy(file + header.globals, globals, global_count * sizeof(ImageGlobal));
+
+    bool written = snuk_write_file(path, file, size);
+    if (!written) snuk_eprintln("%s: could not write the image", path);
+
+    snuk_free(file);
+    snuk_darray_destroy(globals);
+    snuk_free(w.fields);
+    snuk_arena_deinit(&arena);
+    return written;
+}
+
+// Every offset stays inside the file, a truncated or foreign file is invalid
+static bool header_valid(const ImageHeader *header, uint64_t size) {
+    if (size < sizeof(ImageHeader) || memcmp(header->magic, IMAGE_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != IMAGE_VERSION || header->layout != IMAGE_LAYOUT) return false;
+
+    bool aligned = header->data % IMAGE_DATA_ALIGN == 0 && header->relocs % 8 == 0 && header->globals % 8 == 0
+                && header->items % alignof(SnukItem *) == 0;
+    return aligned && header->source_path < header->data && header->data <= size
+        && header->data_size <= size - header->data && header->relocs <= size
+        && header->reloc_words == bitmap_words(header->data_size)
+        && header->reloc_words <= (size - header->relocs) / sizeof(uint64_t) && header->globals <= size
+        && header->global_count <= (size - header->globals) / sizeof(ImageGlobal)
+        && header->items <= header->data_size
+        && header->item_count <= (header->data_size - header->items) / sizeof(SnukItem *);
+}
+
+// Room for a pointer at offset into the AST
+SNUK_INLINE bool field_in_data(const ImageHeader *header, uint64_t offset) {
+    return offset <= header->data_size && header->data_size - offset >= sizeof(void *);
+}
+
+SnukImageStatus snuk_image_load(SnukImage *image, const char *path) {
+    *image = (SnukImage){0};
+
+    uint64_t size;
+    uint8_t *file = snuk_map_file(path, &size);
+    if (!file) return SNUK_IMAGE_UNREADABLE;
+    image->mapping = file;
+    image->size = size;
+
+    const ImageHeader *header = (const ImageHeader *)file;
+    if (!header_valid(header, size) || !memchr(file + header->source_path, 0, header->data - header->source_path))
+        return SNUK_IMAGE_INVALID;
+    image->source_path = (const char *)(file + header->source_path);
+
+    SnukImageStatus status = SNUK_IMAGE_OK;
+    if (image->source_path[0]) {
+        char *src = snuk_read_file(image->source_path);
+        if (!src) {
+            status = SNUK_IMAGE_NO_SOURCE;
+        } else {
+            bool stale = hash_source(src, strlen(src)) != header->source_hash;
+            snuk_free(src);
+            if (stale) return SNUK_IMAGE_STALE;
+        }
+    }
+
+    uint8_t *data = file + header->data;
+    const uint64_t *relocs = (const uint64_t *)(file + header->relocs);
+    uint64_t words = header->data_size / sizeof(void *);
+    // Bits past the last whole word would relocate past the AST
+    if (words % 64 && relocs[words / 64] >> (words % 64)) return SNUK_IMAGE_INVALID;
+    uintptr_t *fields = (uintptr_t *)data;
+    for (uint64_t i = 0; i < header->reloc_words; ++i)
+        for (uint64_t bits = relocs[i]; bits; bits &= bits - 1) fields[i * 64 + lowest_bit(bits)] += (uintptr_t)data;
+
+    const ImageGlobal *globals = (const ImageGlobal *)(file + header->globals);
+    for (uint64_t i = 0; i < header->global_count; ++i) {
+        if (!field_in_data(header, globals[i].offset) || globals[i].index >= SNUK_ARRAY_LENGTH(image_globals))
+            return SNUK_IMAGE_INVALID;
+        *(void **)(data + globals[i].offset) = image_globals[globals[i].index];
+    }
+
+    image->items = (SnukItem **)(data + header->items);
+    image->item_count = header->item_count;
+    return status;
+}
+
+void snuk_image_unload(SnukImage *image) {
+    if (image->mapping) snuk_unmap_file(image->mapping, image->size);
+    *image = (SnukImage){0};
+}
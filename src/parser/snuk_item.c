@@ -28,7 +28,7 @@ static SnukItem *parse_expr_item(SnukParser *parser);
 static SnukItem *parse_decl_item(SnukParser *parser, bool is_const);
 
 /**
- * @brief Parse return, break, or continue items.
+ * @brief Parse return, break, continue, or yield items.
  *
  * @param parser Parser context to operate on.
  *
@@ -65,10 +65,10 @@ static SnukItem *parse_interface_item(SnukParser *parser);
 
 SnukItem *snuk_item_parse(SnukParser *parser) {
     if (parser_match(parser, SNUK_TOKEN_VAR) || parser_match(parser, SNUK_TOKEN_CONST))
-        return parse_decl_item(parser, parser->previous.type == SNUK_TOKEN_CONST);
+        return parse_decl_item(parser, parser->previous->type == SNUK_TOKEN_CONST);
 
     if (parser_match(parser, SNUK_TOKEN_RETURN) || parser_match(parser, SNUK_TOKEN_CONTINUE)
-        || parser_match(parser, SNUK_TOKEN_BREAK))
+        || parser_match(parser, SNUK_TOKEN_BREAK) || parser_match(parser, SNUK_TOKEN_YIELD))
         return parse_flow_item(parser);
 
     if (parser_match(parser, SNUK_TOKEN_PRINT)) return parse_print_item(parser);
@@ -81,7 +81,7 @@ SnukItem *snuk_item_parse(SnukParser *parser) {
 }
 
 static SnukItem *parse_expr_item(SnukParser *parser) {
-    SnukExpr *expr = snuk_expr_parse(parser);
+    SnukExprId expr = snuk_expr_parse(parser);
     parser_expect_item_end(parser);
     return build_expr_item(parser, expr);
 }
@@ -95,10 +95,16 @@ static SnukItem *parse_decl_item(SnukParser *parser, bool is_const) {
 }
 
 static SnukItem *parse_flow_item(SnukParser *parser) {
-    SnukTokenType type = parser->previous.type;
-    SnukExpr *value = NULL;
-    if ((parser->previous.type == SNUK_TOKEN_RETURN || parser->previous.type == SNUK_TOKEN_BREAK)
-        && !parser_check_item_end(parser))
+    SnukTokenType type = parser->previous->type;
+    SnukExprId value = SNUK_EXPR_NONE;
+
+    if (type == SNUK_TOKEN_YIELD) {
+        // A function containing yield becomes a generator function
+        if (!parser->fn_depth) parser_error(parser, "yield outside of function");
+        parser->yielded = true;
+    }
+
+    if (type != SNUK_TOKEN_CONTINUE && !parser_check_item_end(parser))
         value = snuk_expr_parse(parser);
 
     parser_expect_item_end(parser);
@@ -111,29 +117,33 @@ static SnukItem *parse_print_item(SnukParser *parser) {
     while (parser_match(parser, SNUK_TOKEN_COMMA))
         print_item = build_print_item(parser, print_item, snuk_expr_parse(parser));
 
+    // Done growing, the slots stay put now
+    uint64_t count = snuk_darray_get_length(print_item->print_exprs);
+    for (uint64_t i = 0; i < count; ++i) parser_fixup_expr(parser, &print_item->print_exprs[i]);
+
     parser_expect_item_end(parser);
 
     return print_item;
 }
 
 static SnukItem *parse_extend_item(SnukParser *parser) {
-    SnukItem *extend_item = build_extend_item(parser, NULL, NULL, NULL);
+    SnukItem *extend_item = build_extend_item(parser, NULL, SNUK_EXPR_NONE, NULL);
 
     parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected type name to extend");
     build_extend_item(parser, extend_item, build_identifier_expr(parser), NULL);
 
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
-    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current.type != SNUK_TOKEN_EOF) {
+    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current->type != SNUK_TOKEN_EOF) {
         if (parser_check(parser, SNUK_TOKEN_VAR) || parser_check(parser, SNUK_TOKEN_CONST)
             || parser_check(parser, SNUK_TOKEN_FN) || parser_check(parser, SNUK_TOKEN_TYPE)) {
             SnukItem *item = snuk_item_parse(parser);
-            build_extend_item(parser, extend_item, NULL, item);
+            build_extend_item(parser, extend_item, SNUK_EXPR_NONE, item);
         } else {
             parser_error(parser, "unexpected token");
         }
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACE) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACE) {
         parser_error(parser, "expected '}'");
         return NULL;
     }
@@ -145,7 +155,7 @@ static SnukItem *parse_extend_item(SnukParser *parser) {
 
 static SnukItem *parse_interface_item(SnukParser *parser) {
     parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected interface name");
-    SnukStringView name = parser->previous.string_literal;
+    SnukStringView name = parser_token_text(parser, parser->previous);
 
     SnukType *type = snuk_type_parse_interface(parser);
 
@@ -170,6 +180,8 @@ const char *snuk_item_type_to_string(SnukItemType type) {
             return SNUK_STRINGIFY(SNUK_ITEM_BREAK);
         case SNUK_ITEM_CONTINUE:
             return SNUK_STRINGIFY(SNUK_ITEM_CONTINUE);
+        case SNUK_ITEM_YIELD:
+            return SNUK_STRINGIFY(SNUK_ITEM_YIELD);
         case SNUK_ITEM_EXTEND:
             return SNUK_STRINGIFY(SNUK_ITEM_EXTEND);
         case SNUK_ITEM_MAX:
@@ -214,6 +226,10 @@ void snuk_item_log(SnukItem *item) {
         case SNUK_ITEM_CONTINUE:
             log_trace("continue", NULL);
             break;
+        case SNUK_ITEM_YIELD:
+            log_trace("yield", NULL);
+            snuk_expr_log(item->expr);
+            break;
         case SNUK_ITEM_EXTEND:
             log_trace("extend", NULL);
             snuk_expr_log(item->extend_item.type);
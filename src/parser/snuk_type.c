@@ -14,7 +14,7 @@ SnukType *snuk_type_parse_interface(SnukParser *parser) {
     SnukType *type = build_interface_type(parser, NULL, NULL);
     parser_expect(parser, SNUK_TOKEN_LBRACE, "expected '{'");
 
-    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current.type != SNUK_TOKEN_EOF) {
+    while (!parser_match(parser, SNUK_TOKEN_RBRACE) && parser->current->type != SNUK_TOKEN_EOF) {
         if (!parser_match(parser, SNUK_TOKEN_VAR) && !parser_match(parser, SNUK_TOKEN_CONST)) {
             parser_error(parser, "expected var or const");
             return NULL;
@@ -26,7 +26,7 @@ SnukType *snuk_type_parse_interface(SnukParser *parser) {
         type = build_interface_type(parser, type, var);
     }
 
-    if (parser->previous.type != SNUK_TOKEN_RBRACE) {
+    if (parser->previous->type != SNUK_TOKEN_RBRACE) {
         parser_error(parser, "expected '}'");
         return NULL;
     }
@@ -38,14 +38,14 @@ SnukType *snuk_type_parse(SnukParser *parser) {
     if (parser_match(parser, SNUK_TOKEN_FN)) {
         SnukType *type = build_fn_type(parser, NULL, NULL, NULL);
         parser_expect(parser, SNUK_TOKEN_LPAREN, "exptected '('");
-        while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current.type != SNUK_TOKEN_EOF) {
+        while (!parser_match(parser, SNUK_TOKEN_RPAREN) && parser->current->type != SNUK_TOKEN_EOF) {
             SnukType *param = snuk_type_parse(parser);
             type = build_fn_type(parser, type, param, NULL);
             if (!parser_check(parser, SNUK_TOKEN_RPAREN))
                 parser_expect(parser, SNUK_TOKEN_COMMA, "expected ','");
         }
 
-        if (parser->previous.type != SNUK_TOKEN_RPAREN) {
+        if (parser->previous->type != SNUK_TOKEN_RPAREN) {
             parser_error(parser, "expected ')'");
             return NULL;
         }
@@ -65,7 +65,7 @@ SnukType *snuk_type_parse(SnukParser *parser) {
 
     parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected a type name");
 
-    return build_named_type(parser, parser->previous.string_literal);
+    return build_named_type(parser, parser_token_text(parser, parser->previous));
 }
 
 void snuk_type_log(SnukType *type) {
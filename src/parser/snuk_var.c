@@ -6,16 +6,16 @@
 SnukVar *snuk_var_parse(SnukParser *parser, bool default_null) {
     parser_expect(parser, SNUK_TOKEN_IDENTIFIER, "expected an identifier");
 
-    SnukStringView name = parser->previous.string_literal;
+    SnukStringView name = parser_token_text(parser, parser->previous);
 
     SnukType *type;
     if (parser_match(parser, SNUK_TOKEN_COLON)) type = snuk_type_parse(parser);
     else type = build_any_type(parser);
 
-    SnukExpr *value;
+    SnukExprId value;
     if (parser_match(parser, SNUK_TOKEN_ASSIGN)) value = snuk_expr_parse(parser);
     else if (default_null) value = build_null_expr(parser);
-    else value = NULL;
+    else value = SNUK_EXPR_NONE;
 
     return build_var(parser, name, type, value);
 }
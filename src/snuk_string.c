@@ -0,0 +1,166 @@
+#include "snuk/snuk_string.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+
+    #define SIMD_WIDTH 32
+
+typedef __m256i SimdVector;
+
+    #define simd_splat(c) _mm256_set1_epi8(c)
+    #define simd_load(p) _mm256_loadu_si256((const __m256i *)(p))
+    #define simd_eq_mask(a, b) ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)))
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+
+    #define SIMD_WIDTH 16
+
+typedef __m128i SimdVector;
+
+    #define simd_splat(c) _mm_set1_epi8(c)
+    #define simd_load(p) _mm_loadu_si128((const __m128i *)(p))
+    #define simd_eq_mask(a, b) ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)))
+#endif
+
+#if defined(SIMD_WIDTH) && defined(SNUK_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+#if defined(SIMD_WIDTH)
+/**
+ * @brief Index of the lowest set bit of a non zero match mask.
+ */
+SNUK_FORCE_INLINE uint32_t first_match(uint32_t mask) {
+    #if defined(SNUK_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (uint32_t)index;
+    #else
+    return (uint32_t)__builtin_ctz(mask);
+    #endif
+}
+
+/**
+ * @brief Index of the highest set bit of a non zero match mask.
+ */
+SNUK_FORCE_INLINE uint32_t last_match(uint32_t mask) {
+    #if defined(SNUK_COMPILER_MSVC)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (uint32_t)index;
+    #else
+    return 31 - (uint32_t)__builtin_clz(mask);
+    #endif
+}
+
+/**
+ * @brief Number of set bits in a match mask.
+ */
+SNUK_FORCE_INLINE uint32_t count_matches(uint32_t mask) {
+    #if defined(SNUK_COMPILER_MSVC)
+    // __popcnt needs a CPU with POPCNT, SSE2 alone does not promise it
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+    #else
+    return (uint32_t)__builtin_popcount(mask);
+    #endif
+}
+#endif
+
+const char *snuk_string_find_byte(const char *s, uint64_t len, char c) {
+    uint64_t i = 0;
+
+#if defined(SIMD_WIDTH)
+    SimdVector needle = simd_splat(c);
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+        uint32_t mask = simd_eq_mask(simd_load(s + i), needle);
+        if (mask) return s + i + first_match(mask);
+    }
+#endif
+
+    for (; i < len; ++i)
+        if (s[i] == c) return s + i;
+
+    return NULL;
+}
+
+const char *snuk_string_find_last_byte(const char *s, uint64_t len, char c) {
+    uint64_t i = len;
+
+#if defined(SIMD_WIDTH)
+    SimdVector needle = simd_splat(c);
+    for (; i >= SIMD_WIDTH; i -= SIMD_WIDTH) {
+        uint32_t mask = simd_eq_mask(simd_load(s + i - SIMD_WIDTH), needle);
+        if (mask) return s + i - SIMD_WIDTH + last_match(mask);
+    }
+#endif
+
+    while (i--)
+        if (s[i] == c) return s + i;
+
+    return NULL;
+}
+
+uint64_t snuk_string_count_byte(const char *s, uint64_t len, char c) {
+    uint64_t count = 0;
+    uint64_t i = 0;
+
+#if defined(SIMD_WIDTH)
+    SimdVector needle = simd_splat(c);
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) count += count_matches(simd_eq_mask(simd_load(s + i), needle));
+#endif
+
+    for (; i < len; ++i) count += s[i] == c;
+
+    return count;
+}
+
+const char *snuk_string_find(
+    const char *haystack, uint64_t haystack_len, const char *needle, uint64_t needle_len) {
+    if (needle_len == 0) return haystack;
+    if (needle_len > haystack_len) return NULL;
+    if (needle_len == 1) return snuk_string_find_byte(haystack, haystack_len, needle[0]);
+
+    uint64_t last = needle_len - 1;
+    // Number of positions a match can start at
+    uint64_t positions = haystack_len - last;
+    uint64_t i = 0;
+
+#if defined(SIMD_WIDTH)
+    // Compare the first and last byte of needle against a block of candidate
+    // positions at once, the last byte load never reads past the haystack
+    SimdVector first_byte = simd_splat(needle[0]);
+    SimdVector last_byte = simd_splat(needle[last]);
+    for (; i + SIMD_WIDTH <= positions; i += SIMD_WIDTH) {
+        uint32_t mask = simd_eq_mask(simd_load(haystack + i), first_byte)
+                      & simd_eq_mask(simd_load(haystack + i + last), last_byte);
+        for (; mask; mask &= mask - 1) {
+            uint64_t pos = i + first_match(mask);
+            if (memcmp(haystack + pos + 1, needle + 1, needle_len - 2) == 0) return haystack + pos;
+        }
+    }
+#endif
+
+    for (; i < positions; ++i) {
+        if (haystack[i] != needle[0] || haystack[i + last] != needle[last]) continue;
+        if (memcmp(haystack + i + 1, needle + 1, needle_len - 2) == 0) return haystack + i;
+    }
+
+    return NULL;
+}
+
+uint64_t snuk_string_count(
+    const char *haystack, uint64_t haystack_len, const char *needle, uint64_t needle_len) {
+    if (needle_len == 0) return 0;
+
+    uint64_t count = 0;
+    const char *end = haystack + haystack_len;
+    const char *match;
+    while ((match = snuk_string_find(haystack, (uint64_t)(end - haystack), needle, needle_len))) {
+        count++;
+        haystack = match + needle_len;
+    }
+
+    return count;
+}
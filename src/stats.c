@@ -0,0 +1,62 @@
+#include "snuk/stats.h"
+
+#if defined(SNUK_OS_WINDOWS)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+SnukStats snuk_stats;
+bool snuk_stats_shared;
+
+static uint64_t peak_rss(void) {
+#if defined(SNUK_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (uint64_t)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #if defined(SNUK_OS_MAC)
+    return (uint64_t)usage.ru_maxrss;  // already in bytes
+    #else
+    return (uint64_t)usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
+
+// Every counter is a 64 bit word, copied one at a time as other threads may be counting
+SNUK_STATIC_ASSERT(sizeof(SnukStats) % sizeof(uint64_t) == 0, "stats are whole words");
+
+static void load_stats(SnukStats *stats) {
+    uint64_t *from = (uint64_t *)&snuk_stats, *to = (uint64_t *)stats;
+    for (uint64_t i = 0; i < sizeof(SnukStats) / sizeof(uint64_t); ++i) to[i] = snuk_atomic_load_relaxed(&from[i]);
+}
+
+static void store_stats(const SnukStats *stats) {
+    const uint64_t *from = (const uint64_t *)stats;
+    uint64_t *to = (uint64_t *)&snuk_stats;
+    for (uint64_t i = 0; i < sizeof(SnukStats) / sizeof(uint64_t); ++i) snuk_atomic_store_relaxed(&to[i], from[i]);
+}
+
+void snuk_stats_get(SnukStats *stats) {
+    load_stats(stats);
+    stats->peak_rss = peak_rss();
+}
+
+void snuk_stats_reset(void) {
+    SnukStats current, kept = {0};
+    load_stats(&current);
+    // Live memory is state, not history, frees after the reset still subtract from it
+    for (uint64_t i = 0; i < SNUK_STATS_ALLOCATOR_MAX; ++i) {
+        SnukAllocatorStats *from = &current.allocators[i];
+        kept.allocators[i] = (SnukAllocatorStats){
+            .live = from->live,
+            .live_peak = from->live,
+            .reserved = from->reserved,
+            .reserved_peak = from->reserved,
+        };
+    }
+    store_stats(&kept);
+}
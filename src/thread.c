@@ -0,0 +1,95 @@
+#if !defined(_WIN32)
+    // nanosleep is POSIX, hidden by strict C17
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "snuk/thread.h"
+
+#include "snuk/memory.h"
+
+#include <stdlib.h>
+
+#if defined(SNUK_OS_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <time.h>
+#endif
+
+struct SnukThread {
+#if defined(SNUK_OS_WINDOWS)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    SnukThreadFn fn;
+    void *arg;
+};
+
+#if defined(SNUK_OS_WINDOWS)
+static DWORD WINAPI thread_start(LPVOID data) {
+    SnukThread *thread = (SnukThread *)data;
+    thread->fn(thread->arg);
+    snuk_memory_thread_exit();
+    return 0;
+}
+#else
+static void *thread_start(void *data) {
+    SnukThread *thread = (SnukThread *)data;
+    thread->fn(thread->arg);
+    snuk_memory_thread_exit();
+    return NULL;
+}
+#endif
+
+// Handles come from malloc, the logger starts its thread before snuk_memory_init
+SnukThread *snuk_thread_create(SnukThreadFn fn, void *arg) {
+    SnukThread *thread = (SnukThread *)malloc(sizeof(SnukThread));
+    if (!thread) return NULL;
+    thread->fn = fn;
+    thread->arg = arg;
+
+#if defined(SNUK_OS_WINDOWS)
+    thread->handle = CreateThread(NULL, 0, thread_start, thread, 0, NULL);
+    if (thread->handle) return thread;
+#else
+    if (pthread_create(&thread->handle, NULL, thread_start, thread) == 0) return thread;
+#endif
+
+    free(thread);
+    return NULL;
+}
+
+void snuk_thread_join(SnukThread *thread) {
+    if (!thread) return;
+
+#if defined(SNUK_OS_WINDOWS)
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+
+    free(thread);
+}
+
+void snuk_thread_sleep_ms(uint64_t ms) {
+#if defined(SNUK_OS_WINDOWS)
+    Sleep((DWORD)ms);
+#else
+    struct timespec ts = {
+        .tv_sec = (time_t)(ms / 1000),
+        .tv_nsec = (long)(ms % 1000) * 1000000,
+    };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+void snuk_thread_yield(void) {
+#if defined(SNUK_OS_WINDOWS)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
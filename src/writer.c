@@ -0,0 +1,192 @@
+#include "snuk/writer.h"
+
+#include "snuk/io.h"
+#include "snuk/snuk_string.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// "00" "01" ... "99", two digits per division
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+/**
+ * @brief Write digits / 10^places in fixed notation.
+ */
+static uint64_t format_fixed(int64_t digits, int places, char *buf) {
+    char tmp[SNUK_FORMAT_INT_MAX_CHARS];
+    uint64_t written = 0;
+    if (digits < 0) buf[written++] = '-';
+
+    uint64_t count = snuk_format_int(digits < 0 ? -digits : digits, tmp);
+    uint64_t frac = (uint64_t)places;
+
+    if (count <= frac) {
+        buf[written++] = '0';
+        buf[written++] = '.';
+        for (uint64_t i = count; i < frac; ++i) buf[written++] = '0';
+        memcpy(buf + written, tmp, count);
+        return written + count;
+    }
+
+    memcpy(buf + written, tmp, count - frac);
+    written += count - frac;
+    buf[written++] = '.';
+    memcpy(buf + written, tmp + count - frac, frac);
+    return written + frac;
+}
+
+void snuk_writer_init(SnukWriter *writer, uint64_t capacity, SnukFlushPolicy policy) {
+    *writer = (SnukWriter){
+        .buffer = (char *)snuk_alloc(capacity, alignof(char)),
+        .len = 0,
+        .capacity = capacity,
+        .policy = policy,
+    };
+}
+
+void snuk_writer_deinit(SnukWriter *writer) {
+    if (!writer || !writer->buffer) return;
+
+    snuk_writer_flush(writer);
+    snuk_flush();
+    snuk_free(writer->buffer);
+
+    *writer = (SnukWriter){0};
+}
+
+void snuk_writer_set_policy(SnukWriter *writer, SnukFlushPolicy policy) {
+    snuk_writer_flush(writer);
+    writer->policy = policy;
+}
+
+void snuk_writer_flush(SnukWriter *writer) {
+    if (writer->len) snuk_write(writer->buffer, writer->len);
+    writer->len = 0;
+    if (writer->policy != SNUK_FLUSH_ON_FULL) snuk_flush();
+}
+
+void snuk_writer_write(SnukWriter *writer, const char *data, uint64_t len) {
+    if (writer->len + len > writer->capacity) {
+        snuk_writer_flush(writer);
+        // Too big to be worth buffering
+        if (len > writer->capacity) {
+            snuk_write(data, len);
+            len = 0;
+        }
+    }
+
+    memcpy(writer->buffer + writer->len, data, len);
+    writer->len += len;
+
+    if (writer->policy == SNUK_FLUSH_ALWAYS
+        || (writer->policy == SNUK_FLUSH_ON_NEWLINE && snuk_string_find_byte(data, len, '\n')))
+        snuk_writer_flush(writer);
+}
+
+void snuk_writer_write_int(SnukWriter *writer, int64_t value) {
+    char buf[SNUK_FORMAT_INT_MAX_CHARS];
+    snuk_writer_write(writer, buf, snuk_format_int(value, buf));
+}
+
+void snuk_writer_write_float(SnukWriter *writer, double value) {
+    char buf[SNUK_FORMAT_FLOAT_MAX_CHARS];
+    snuk_writer_write(writer, buf, snuk_format_float(value, buf));
+}
+
+uint64_t snuk_format_int(int64_t value, char *buf) {
+    // Negate as unsigned so INT64_MIN does not overflow
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+
+    char digits[SNUK_FORMAT_INT_MAX_CHARS];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+
+    while (magnitude >= 100) {
+        uint64_t pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (magnitude >= 10) {
+        *--p = digit_pairs[magnitude * 2 + 1];
+        *--p = digit_pairs[magnitude * 2];
+    } else {
+        *--p = (char)('0' + magnitude);
+    }
+
+    uint64_t written = 0;
+    if (value < 0) buf[written++] = '-';
+    memcpy(buf + written, p, (uint64_t)(end - p));
+    return written + (uint64_t)(end - p);
+}
+
+uint64_t snuk_format_float(double value, char *buf) {
+    if (isnan(value)) {
+        memcpy(buf, "nan", 3);
+        return 3;
+    }
+    if (isinf(value)) {
+        if (value < 0) {
+            memcpy(buf, "-inf", 4);
+            return 4;
+        }
+        memcpy(buf, "inf", 3);
+        return 3;
+    }
+
+    // Integral values below 2^53 are exact as int64_t, skip stdio entirely
+    if (value == floor(value) && fabs(value) < 9007199254740992.0) {
+        uint64_t written = 0;
+        if (value == 0 && signbit(value)) buf[written++] = '-';
+        written += snuk_format_int((int64_t)value, buf + written);
+        memcpy(buf + written, ".0", 2);
+        return written + 2;
+    }
+
+    // Few decimal places, the common case for values written as literals.
+    // Exact when value * 10^k is an integer that divides back to value
+    double magnitude = fabs(value);
+    if (magnitude >= 1e-4 && magnitude < 1e15) {
+        for (int places = 1; places < (int)SNUK_ARRAY_LENGTH(powers_of_ten); ++places) {
+            double scaled = value * powers_of_ten[places];
+            // Past 15 digits %.15g may find a shorter form
+            if (fabs(scaled) >= 1e15) break;
+            if (scaled != floor(scaled) || scaled / powers_of_ten[places] != value) continue;
+
+            // An inexact product can land on an integer only at a later power
+            int64_t digits = (int64_t)scaled;
+            while (places > 1 && digits % 10 == 0) {
+                digits /= 10;
+                places--;
+            }
+            return format_fixed(digits, places, buf);
+        }
+    }
+
+    // Fewest significant digits that read back as the same value, almost
+    // every double written from a decimal literal needs at most 15
+    int len = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        len = snprintf(buf, SNUK_FORMAT_FLOAT_MAX_CHARS, "%.*g", precision, value);
+        if (strtod(buf, NULL) == value) break;
+    }
+
+    // Keep it reading as a float
+    for (int i = 0; i < len; ++i)
+        if (buf[i] == '.' || buf[i] == 'e') return (uint64_t)len;
+    memcpy(buf + len, ".0", 2);
+    return (uint64_t)len + 2;
+}
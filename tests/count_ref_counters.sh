@@ -1,44 +1,9 @@
 #!/bin/sh
 
-for file in tests/*.snuk
+# Needs a build with SNUK_STATS (the default)
+for file in tests/*.snuk docs/snuk_language.snuk
 do
     echo $file
-    build/repl/snuk "$file" \
-    | grep -E '\[DEBUG\]: (created a ref counter|a ref counter got destroyed)' \
-    | awk '
-    BEGIN {
-        created = 0
-        destroyed = 0
-    }
-    {
-        if ($0 ~ /created/) created++;
-        else destroyed++;
-    }
-    END {
-        print "Created: " created
-        print "Destroyed: " destroyed
-    }
-    '
-    echo -e "\n"
+    build/repl/snuk --stats "$file" 2>&1 >/dev/null | grep -E '^  (refcounters|leaked)'
+    echo
 done
-
-file=docs/snuk_language.snuk
-
-echo $file
-build/repl/snuk "$file" \
-| grep -E '\[DEBUG\]: (created a ref counter|a ref counter got destroyed)' \
-| awk '
-BEGIN {
-    created = 0
-    destroyed = 0
-}
-{
-    if ($0 ~ /created/) created++;
-    else destroyed++;
-}
-END {
-    print "Created: " created
-    print "Destroyed: " destroyed
-}
-'
-echo -e "\n"
@@ -0,0 +1,138 @@
+#include "test_framework.h"
+
+#include <snuk/arena.h>
+
+ADD_TEST(test_arena_alloc_aligned) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+
+    uint8_t *a = snuk_arena_alloc(&arena, 3, 1);
+    uint64_t *b = snuk_arena_alloc(&arena, sizeof(uint64_t), alignof(uint64_t));
+    void *c = snuk_arena_alloc(&arena, 16, 64);
+    ASSERT_NOT_NULL(a);
+    ASSERT_EQ((uintptr_t)b % alignof(uint64_t), 0);
+    ASSERT_EQ((uintptr_t)c % 64, 0);
+    ASSERT((uint8_t *)b >= a + 3);
+
+    uint64_t size;
+    ASSERT_EQ(snuk_arena_contiguous(&arena, &size), a);
+    ASSERT_EQ(size, (uint64_t)((uint8_t *)c + 16 - a));
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_arena_grows) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+
+    // Far more than one chunk, including a block larger than a chunk
+    uint8_t *blocks[100];
+    for (int i = 0; i < 100; ++i) {
+        blocks[i] = snuk_arena_alloc(&arena, 100, 8);
+        memset(blocks[i], i, 100);
+    }
+    uint8_t *big = snuk_arena_alloc(&arena, KIB(4), 8);
+    memset(big, 0xff, KIB(4));
+
+    for (int i = 0; i < 100; ++i) ASSERT_EQ(blocks[i][99], i);
+    ASSERT(arena.used >= 100 * 100 + KIB(4));
+    uint64_t size;
+    ASSERT_NULL(snuk_arena_contiguous(&arena, &size));
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_arena_realloc) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+
+    // The newest block grows in place
+    uint8_t *a = snuk_arena_alloc(&arena, 8, 8);
+    memcpy(a, "abcdefgh", 8);
+    ASSERT_PTR_EQ(snuk_arena_realloc(&arena, a, 64, 8), a);
+
+    // An older block moves and keeps its contents
+    uint8_t *b = snuk_arena_alloc(&arena, 8, 8);
+    uint8_t *moved = snuk_arena_realloc(&arena, a, 128, 8);
+    ASSERT_PTR_NE(moved, a);
+    ASSERT_MEM_EQ(moved, "abcdefgh", 8);
+
+    // Moving the last block of a full chunk copies only what the chunk holds
+    uint8_t *tail = snuk_arena_alloc(&arena, KIB(1) - 256, 8);
+    tail[0] = 42;
+    uint8_t *grown = snuk_arena_realloc(&arena, tail, KIB(2), 8);
+    ASSERT_EQ(grown[0], 42);
+    SNUK_UNUSED(b);
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_arena_free_and_reset) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+
+    void *a = snuk_arena_alloc(&arena, 100, 8);
+    uint64_t used = arena.used;
+    void *b = snuk_arena_alloc(&arena, 100, 8);
+
+    // Only the newest allocation is given back
+    snuk_arena_free(&arena, a);
+    ASSERT(arena.used > used);
+    snuk_arena_free(&arena, b);
+    ASSERT_EQ(arena.used, (uint64_t)((uint8_t *)b - (uint8_t *)a));
+    ASSERT_PTR_EQ(snuk_arena_alloc(&arena, 100, 8), b);
+
+    for (int i = 0; i < 50; ++i) snuk_arena_alloc(&arena, 100, 8);
+    uint64_t high_water = arena.used;
+    snuk_arena_reset(&arena);
+    ASSERT_EQ(arena.used, 0);
+    ASSERT_EQ(arena.high_water, high_water);
+    ASSERT_PTR_EQ(snuk_arena_alloc(&arena, 100, 8), a);
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_arena_mark_rewind) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+
+    uint8_t *kept = snuk_arena_alloc(&arena, 96, 8);
+    SnukArenaMark mark = snuk_arena_mark(&arena);
+    uint64_t used = arena.used;
+
+    // Spill into more chunks, rewinding releases them
+    for (int i = 0; i < 50; ++i) snuk_arena_alloc(&arena, 100, 8);
+    ASSERT_PTR_NE(arena.current, mark.chunk);
+    snuk_arena_rewind(&arena, mark);
+    ASSERT_PTR_EQ(arena.current, mark.chunk);
+    ASSERT_EQ(arena.used, used);
+
+    // Allocations before the mark stay, the next one reuses the space after it
+    ASSERT_PTR_EQ(snuk_arena_alloc(&arena, 100, 8), kept + 96);
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_arena_allocator) {
+    SnukArena arena;
+    snuk_arena_init(&arena, KIB(1));
+    SnukAllocator allocator = snuk_arena_allocator(&arena);
+
+    uint64_t *numbers = allocator.alloc(allocator.data, 4 * sizeof(uint64_t), alignof(uint64_t));
+    for (uint64_t i = 0; i < 4; ++i) numbers[i] = i;
+    numbers = allocator.realloc(allocator.data, numbers, 400 * sizeof(uint64_t), alignof(uint64_t));
+    ASSERT_EQ(numbers[3], 3);
+    allocator.free(allocator.data, numbers);
+    // The first block stays behind in the old chunk
+    ASSERT_EQ(arena.used, 4 * sizeof(uint64_t));
+
+    snuk_arena_deinit(&arena);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();
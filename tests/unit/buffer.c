@@ -0,0 +1,176 @@
+#include "test_framework.h"
+
+#include <snuk/interpreter/native.h>
+#include <snuk/interpreter/snuk_pool.h>
+#include <snuk/interpreter/snuk_program.h>
+#include <string.h>
+
+static const char payload[] = "  alpha,beta,gamma  ";
+
+static int64_t releases = 0;
+
+// Only counts releases of the whole payload
+static void count_release(void *data, const char *bytes, uint64_t len) {
+    if (data == (void *)payload && bytes == payload && len == sizeof(payload) - 1) ++releases;
+}
+
+static SnukValue payload_value(void) {
+    return snuk_native_create_buffer(NULL, payload, sizeof(payload) - 1, count_release, (void *)payload, false);
+}
+
+// Globals point into the programs, so they are destroyed after the interpreter
+static SnukProgram programs[8];
+static uint64_t program_count = 0;
+
+static SnukValue run(SnukInterpreter *intpret, const char *src, SnukValue data) {
+    SnukProgram *program = &programs[program_count++];
+    if (!snuk_program_compile(program, src, "script")) return (SnukValue){.type = SNUK_VALUE_ERROR};
+
+    SnukProgramInput inputs[] = {
+        {.name = "data", .value = data},
+    };
+    return snuk_program_run(program, intpret, inputs, data.type == SNUK_VALUE_NULL ? 0 : 1);
+}
+
+static void destroy_programs(void) {
+    for (uint64_t i = 0; i < program_count; ++i) snuk_program_destroy(&programs[i]);
+    program_count = 0;
+}
+
+static bool in_payload(const char *str) {
+    return str >= payload && str < payload + sizeof(payload);
+}
+
+ADD_TEST(test_buffer_reads) {
+    releases = 0;
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    SnukValue data = payload_value();
+    SnukValue value = run(&intpret,
+                          "var total = 0\n"
+                          "if data.starts_with(\"  al\") { total += 1 }\n"
+                          "if data.trim() == \"alpha,beta,gamma\" { total += 10 }\n"
+                          "if data.get(2, 5) != \"beta\" { total += 100 }\n"
+                          "fn first(s: str) { s.get(0, 1) }\n"
+                          "total + data.length() * 1000 + data.find(\"beta\") * 100000 + data.count(\"a\") * 10000000\n",
+                          data);
+    ASSERT_EQ(value.type, SNUK_VALUE_INT);
+    ASSERT_EQ(value.int_value, 111 + 20 * 1000 + 8 * 100000 + 5 * 10000000LL);
+    snuk_value_free(value);
+
+    // Slices view the host memory
+    value = run(&intpret, "data.trim().get(6, 4)\n", data);
+    ASSERT_EQ(value.type, SNUK_VALUE_BUFFER);
+    ASSERT_EQ(value.buffer.view.len, 4);
+    ASSERT_EQ(in_payload(value.buffer.view.str), true);
+    ASSERT_STR_N_EQ(value.buffer.view.str, "beta", 4);
+    snuk_value_free(value);
+
+    value = run(&intpret, "var n = 0\nfor part in data.trim().split(\",\") { n += part.length() }\nn\n", data);
+    ASSERT_EQ(value.int_value, 14);
+
+    // Joining makes a string of its own
+    value = run(&intpret, "data.get(2, 5) + \"!\"\n", data);
+    ASSERT_EQ(value.type, SNUK_VALUE_STRING);
+    ASSERT_STR_N_EQ(value.string_value.str, "\"alpha!\"", 8);
+    snuk_value_free(value);
+
+    value = run(&intpret, "first(data)\n", data);
+    ASSERT_EQ(value.type, SNUK_VALUE_BUFFER);
+    snuk_value_free(value);
+
+    snuk_interpreter_deinit(&intpret);
+    destroy_programs();
+    ASSERT_EQ(releases, 0);
+    snuk_value_free(data);
+    ASSERT_EQ(releases, 1);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_buffer_lifetime) {
+    releases = 0;
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    SnukValue data = payload_value();
+    SnukValue value = run(&intpret,
+                          "var word = data.get(2, 5)\n"
+                          "var parts = data.split(\",\")\n"
+                          "null\n",
+                          data);
+    ASSERT_EQ(value.type, SNUK_VALUE_NULL);
+
+    // The host is done with it, the script still holds a slice and a generator
+    snuk_value_free(data);
+    ASSERT_EQ(releases, 0);
+
+    value = run(&intpret, "parts.next()\n", (SnukValue){.type = SNUK_VALUE_NULL});
+    ASSERT_EQ(value.type, SNUK_VALUE_BUFFER);
+    ASSERT_STR_N_EQ(value.buffer.view.str, "  alpha", 7);
+    snuk_value_free(value);
+
+    snuk_interpreter_deinit(&intpret);
+    destroy_programs();
+    ASSERT_EQ(releases, 1);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_buffer_split_sep) {
+    releases = 0;
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    // The separator comes from the host and is gone before the pieces are read
+    char sep[] = "\",\"";
+    SnukProgram program;
+    ASSERT_EQ(snuk_program_compile(&program, "var parts = data.split(sep)\nnull\n", "script"), true);
+    SnukProgramInput inputs[] = {
+        {.name = "data", .value = payload_value()},
+        {.name = "sep", .value = {.type = SNUK_VALUE_STRING, .string_value = snuk_string_view_create(sep)}},
+    };
+    SnukValue value = snuk_program_run(&program, &intpret, inputs, SNUK_ARRAY_LENGTH(inputs));
+    ASSERT_EQ(value.type, SNUK_VALUE_NULL);
+    snuk_value_free(inputs[0].value);
+    memset(sep, 'x', sizeof(sep) - 1);
+
+    value = run(&intpret, "parts.next()\n", (SnukValue){.type = SNUK_VALUE_NULL});
+    ASSERT_STR_N_EQ(value.buffer.view.str, "  alpha", 7);
+    snuk_value_free(value);
+    value = run(&intpret, "parts.next()\n", (SnukValue){.type = SNUK_VALUE_NULL});
+    ASSERT_EQ(value.buffer.view.len, 4);
+    ASSERT_STR_N_EQ(value.buffer.view.str, "beta", 4);
+    snuk_value_free(value);
+
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    destroy_programs();
+    ASSERT_EQ(releases, 1);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_buffer_pool) {
+    releases = 0;
+    SnukPool *pool = snuk_pool_create(2);
+    ASSERT_NOT_NULL(pool);
+
+    // Workers get their own copy, the host keeps the only reference
+    SnukValue data = payload_value();
+    SnukProgramInput inputs[] = {
+        {.name = "data", .value = data},
+    };
+    SnukFuture *future = snuk_pool_submit(pool, "data.trim()\n", inputs, 1);
+    SnukValue value = snuk_future_wait(future);
+    ASSERT_EQ(value.type, SNUK_VALUE_STRING);
+    ASSERT_EQ(value.string_value.len, 18);
+    ASSERT_STR_N_EQ(value.string_value.str, "\"alpha,beta,gamma\"", 18);
+    ASSERT_EQ(in_payload(value.string_value.str), false);
+
+    snuk_future_destroy(future);
+    snuk_pool_destroy(pool);
+    snuk_value_free(data);
+    ASSERT_EQ(releases, 1);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS_WITH_MEM_SIZE(MIB(64));
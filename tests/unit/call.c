@@ -0,0 +1,198 @@
+#include "test_framework.h"
+
+#include <snuk/interpreter/snuk_call.h>
+#include <snuk/interpreter/snuk_generator.h>
+#include <snuk/interpreter/snuk_program.h>
+
+static const char script[] = "fn less(a, b) { return a < b }\n"
+                             "fn sum(a, b = 10, c = 100) { var total = a + b; total + c }\n"
+                             "fn adder(x) { fn(y) { x + y } }\n"
+                             "fn typed(x: int) { x }\n"
+                             "fn count(to) { var i = 0; while i < to { yield i; i += 1 } }\n"
+                             "var largest = math.max\n";
+
+static SnukValue int_value(int64_t value) {
+    return (SnukValue){.type = SNUK_VALUE_INT, .int_value = value};
+}
+
+static uint64_t allocations(void) {
+    return snuk_stats.allocators[SNUK_STATS_ALLOCATOR_SLAB].allocations
+         + snuk_stats.allocators[SNUK_STATS_ALLOCATOR_GLOBAL].allocations;
+}
+
+static bool load(SnukInterpreter *intpret, SnukProgram *program) {
+    if (!snuk_program_compile(program, script, "script")) return false;
+    snuk_interpreter_init(intpret);
+    return snuk_program_run(program, intpret, NULL, 0).type != SNUK_VALUE_ERROR;
+}
+
+static SnukValue lookup(SnukInterpreter *intpret, const char *name) {
+    return snuk_interpreter_get_env(intpret, snuk_string_view_create(name));
+}
+
+ADD_TEST(test_call_script) {
+    SnukInterpreter intpret;
+    SnukProgram program;
+    ASSERT_EQ(load(&intpret, &program), true);
+
+    SnukValue fn = lookup(&intpret, "less");
+    SnukCallHandle handle;
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, NULL, 2), true);
+    snuk_value_free(fn);
+
+    // The first call creates the scopes, later ones reuse them
+    SnukValue args[] = {int_value(1), int_value(2)};
+    SnukValue value = snuk_call_handle_invoke(&handle, args);
+    ASSERT_EQ(value.type, SNUK_VALUE_BOOL);
+    ASSERT_EQ(value.bool_value, true);
+
+    uint64_t before = allocations();
+    uint64_t failures = 0;
+    for (int64_t i = 0; i < 1000; ++i) {
+        args[0] = int_value(i % 7);
+        args[1] = int_value(3);
+        value = snuk_call_handle_invoke(&handle, args);
+        if (value.type != SNUK_VALUE_BOOL || value.bool_value != (i % 7 < 3)) ++failures;
+    }
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(allocations(), before);
+
+    snuk_call_handle_destroy(&handle);
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_call_names_and_defaults) {
+    SnukInterpreter intpret;
+    SnukProgram program;
+    ASSERT_EQ(load(&intpret, &program), true);
+
+    SnukValue fn = lookup(&intpret, "sum");
+    SnukCallHandle handle;
+    const char *names[] = {"c", "a"};
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, names, 2), true);
+
+    // Locals of one call are gone by the next
+    for (int64_t i = 0; i < 3; ++i) {
+        SnukValue args[] = {int_value(i), int_value(1000)};
+        SnukValue value = snuk_call_handle_invoke(&handle, args);
+        ASSERT_EQ(value.type, SNUK_VALUE_INT);
+        ASSERT_EQ(value.int_value, 1010 + i);
+    }
+    snuk_call_handle_destroy(&handle);
+
+    const char *unknown[] = {"d"};
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, unknown, 1), false);
+    snuk_call_handle_destroy(&handle);
+
+    const char *repeated[] = {"a", "a"};
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, repeated, 2), false);
+    snuk_call_handle_destroy(&handle);
+
+    // a has no default
+    const char *missing[] = {"b"};
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, missing, 1), false);
+    snuk_call_handle_destroy(&handle);
+
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, NULL, 4), false);
+    snuk_call_handle_destroy(&handle);
+    snuk_value_free(fn);
+
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, int_value(1), NULL, 0), false);
+    snuk_call_handle_destroy(&handle);
+
+    fn = lookup(&intpret, "typed");
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, NULL, 1), true);
+    SnukValue text = {.type = SNUK_VALUE_STRING, .string_value = snuk_string_view_create("\"x\"")};
+    ASSERT_EQ(snuk_call_handle_invoke(&handle, &text).type, SNUK_VALUE_UNKOWN);
+    SnukValue number = int_value(5);
+    ASSERT_EQ(snuk_call_handle_invoke(&handle, &number).int_value, 5);
+    snuk_call_handle_destroy(&handle);
+    snuk_value_free(fn);
+
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_call_captured_scopes) {
+    SnukInterpreter intpret;
+    SnukProgram program;
+    ASSERT_EQ(load(&intpret, &program), true);
+
+    // Every closure keeps the scope of the call that made it
+    SnukValue fn = lookup(&intpret, "adder");
+    SnukCallHandle handle;
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, NULL, 1), true);
+    snuk_value_free(fn);
+
+    SnukValue arg = int_value(1);
+    SnukValue add_one = snuk_call_handle_invoke(&handle, &arg);
+    arg = int_value(2);
+    SnukValue add_two = snuk_call_handle_invoke(&handle, &arg);
+    ASSERT_EQ(add_one.type, SNUK_VALUE_FN);
+    snuk_call_handle_destroy(&handle);
+
+    arg = int_value(10);
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, add_one, NULL, 1), true);
+    ASSERT_EQ(snuk_call_handle_invoke(&handle, &arg).int_value, 11);
+    snuk_call_handle_destroy(&handle);
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, add_two, NULL, 1), true);
+    ASSERT_EQ(snuk_call_handle_invoke(&handle, &arg).int_value, 12);
+    snuk_call_handle_destroy(&handle);
+    snuk_value_free(add_one);
+    snuk_value_free(add_two);
+
+    // Generators hold on to the parameters
+    fn = lookup(&intpret, "count");
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, NULL, 1), true);
+    snuk_value_free(fn);
+    arg = int_value(2);
+    SnukValue first = snuk_call_handle_invoke(&handle, &arg);
+    arg = int_value(5);
+    SnukValue second = snuk_call_handle_invoke(&handle, &arg);
+    ASSERT_EQ(first.type, SNUK_VALUE_GENERATOR);
+
+    int64_t items = 0;
+    SnukValue item;
+    while (snuk_generator_next(&intpret, first.generator, &item)) ++items;
+    while (snuk_generator_next(&intpret, second.generator, &item)) ++items;
+    ASSERT_EQ(items, 7);
+    snuk_value_free(first);
+    snuk_value_free(second);
+    snuk_call_handle_destroy(&handle);
+
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_call_native) {
+    SnukInterpreter intpret;
+    SnukProgram program;
+    ASSERT_EQ(load(&intpret, &program), true);
+
+    SnukValue fn = lookup(&intpret, "largest");
+    ASSERT_EQ(fn.type, SNUK_VALUE_FN_NATIVE);
+    SnukCallHandle handle;
+    const char *names[] = {"y", "x"};
+    ASSERT_EQ(snuk_call_handle_prepare(&handle, &intpret, fn, names, 2), true);
+    snuk_value_free(fn);
+
+    SnukValue args[] = {int_value(3), {.type = SNUK_VALUE_FLOAT, .float_value = 2.5}};
+    SnukValue value = snuk_call_handle_invoke(&handle, args);
+    ASSERT_EQ(value.type, SNUK_VALUE_INT);
+    ASSERT_EQ(value.int_value, 3);
+
+    snuk_call_handle_destroy(&handle);
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+
+    // Destroying a zeroed handle is fine
+    handle = (SnukCallHandle){0};
+    snuk_call_handle_destroy(&handle);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS_WITH_MEM_SIZE(MIB(64));
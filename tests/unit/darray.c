@@ -0,0 +1,106 @@
+#include "test_framework.h"
+
+#include <snuk/darray.h>
+#include <snuk/stats.h>
+
+ADD_TEST(test_darray_push_pop) {
+    int *arr = snuk_darray_create(int, NULL);
+
+    for (int i = 0; i < 100; ++i) snuk_darray_push(&arr, i);
+    ASSERT_EQ(snuk_darray_get_length(arr), 100);
+    ASSERT(snuk_darray_get_capacity(arr) >= 100);
+    for (int i = 0; i < 100; ++i) ASSERT_EQ(arr[i], i);
+
+    int last = 0;
+    snuk_darray_pop(&arr, &last);
+    ASSERT_EQ(last, 99);
+    ASSERT_EQ(snuk_darray_get_length(arr), 99);
+
+    snuk_darray_clear(&arr);
+    ASSERT_EQ(snuk_darray_get_length(arr), 0);
+    // Popping an empty array leaves the element alone
+    snuk_darray_pop(&arr, &last);
+    ASSERT_EQ(last, 99);
+
+    snuk_darray_destroy(arr);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_darray_push_at_pop_at) {
+    int *arr = snuk_darray_create_with_capacity(2, int, NULL);
+
+    snuk_darray_push(&arr, 1);
+    snuk_darray_push(&arr, 3);
+    snuk_darray_push_at(&arr, 1, 2);
+    snuk_darray_push_at(&arr, 0, 0);
+    for (int i = 0; i < 4; ++i) ASSERT_EQ(arr[i], i);
+
+    // Past the end, the gap is zeroed
+    snuk_darray_push_at(&arr, 7, 7);
+    ASSERT_EQ(snuk_darray_get_length(arr), 8);
+    for (int i = 4; i < 7; ++i) ASSERT_EQ(arr[i], 0);
+    ASSERT_EQ(arr[7], 7);
+
+    int popped = -1;
+    snuk_darray_pop_at(&arr, 1, &popped);
+    ASSERT_EQ(popped, 1);
+    ASSERT_EQ(arr[1], 2);
+    ASSERT_EQ(snuk_darray_get_length(arr), 7);
+
+    snuk_darray_destroy(arr);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_darray_alignment) {
+    typedef struct {
+        alignas(64) uint8_t bytes[64];
+    } Wide;
+
+    Wide *arr = snuk_darray_create(Wide, NULL);
+    ASSERT_EQ((uintptr_t)arr % 64, 0);
+    for (int i = 0; i < 20; ++i) snuk_darray_push(&arr, (Wide){.bytes = {(uint8_t)i}});
+    ASSERT_EQ((uintptr_t)arr % 64, 0);
+    ASSERT_EQ(arr[19].bytes[0], 19);
+
+    snuk_darray_destroy(arr);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_darray_inline) {
+    SNUK_DARRAY_INLINE_STORAGE(uint64_t, 4) storage;
+    uint64_t *arr = snuk_darray_create_inline(&storage, uint64_t, NULL);
+    ASSERT_PTR_EQ(arr, storage.elements);
+    ASSERT_EQ(snuk_darray_get_capacity(arr), 4);
+
+    // Filling the storage allocates nothing
+    uint64_t allocations = snuk_stats.allocators[SNUK_STATS_ALLOCATOR_SLAB].allocations
+                         + snuk_stats.allocators[SNUK_STATS_ALLOCATOR_GLOBAL].allocations;
+    for (uint64_t i = 0; i < 4; ++i) snuk_darray_push(&arr, i);
+    ASSERT_PTR_EQ(arr, storage.elements);
+    ASSERT_EQ(snuk_stats.allocators[SNUK_STATS_ALLOCATOR_SLAB].allocations
+                  + snuk_stats.allocators[SNUK_STATS_ALLOCATOR_GLOBAL].allocations,
+              allocations);
+
+    // Outgrowing it moves to the allocator
+    snuk_darray_push(&arr, 4);
+    ASSERT_PTR_NE(arr, storage.elements);
+    for (uint64_t i = 0; i < 5; ++i) ASSERT_EQ(arr[i], i);
+
+    snuk_darray_destroy(arr);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_darray_inline_destroy) {
+    SNUK_DARRAY_INLINE_STORAGE(int, 2) storage;
+    int *arr = snuk_darray_create_inline(&storage, int, NULL);
+    snuk_darray_push(&arr, 1);
+
+    // Shrinking keeps the storage, destroying leaves it alone
+    snuk_darray_resize(&arr, 1);
+    ASSERT_PTR_EQ(arr, storage.elements);
+    snuk_darray_destroy(arr);
+    ASSERT_EQ(storage.elements[0], 1);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();
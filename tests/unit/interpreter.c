@@ -0,0 +1,191 @@
+#include "test_framework.h"
+
+#include <snuk/arena.h>
+#include <snuk/interpreter/interpreter.h>
+#include <snuk/parser/parser.h>
+#include <snuk/thread.h>
+#include <stdio.h>
+
+#define INTERPRETERS 4
+#define RUNS 25
+
+// Functions, types, builtin methods, the math module and bignums, all of
+// which used to touch state shared between interpreters
+static const char script[] = "fn fib(n) { if n < 2 { return n }; return fib(n - 1) + fib(n - 2) }\n"
+                             "type Point { var x = 0; var y = 0 }\n"
+                             "type Point p = {x: 3; y: 4}\n"
+                             "var total = 0\n"
+                             "for var i = 0; i < 200; i += 1 { total += i.to_str().length() }\n"
+                             "var big = 1\n"
+                             "for var i = 0; i < 80; i += 1 { big *= 3 }\n"
+                             "var first = \"a,b,c\".split(\",\").next()\n"
+                             "var result = seed + fib(15) + total + p.x * p.y + big.to_str().length()\n"
+                             "result += math.floor(2.5).to_int() + first.length()\n";
+
+// seed + everything the script adds to it
+#define SCRIPT_RESULT 1154
+
+/**
+ * @brief Run the script in a fresh interpreter and return result, -1 on any
+ * error.
+ */
+static int64_t run_script(int64_t seed) {
+    char src[sizeof(script) + 32];
+    snprintf(src, sizeof(src), "var seed = %lld\n%s", (long long)seed, script);
+
+    SnukArena arena;
+    snuk_arena_init(&arena, SNUK_ARENA_DEFAULT_CHUNK_SIZE);
+    SnukAllocator allocator = snuk_arena_allocator(&arena);
+
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+    SnukParser parser;
+    snuk_parser_init(&parser, src, &allocator, SNUK_LEXER_MODE_EXECUTE);
+
+    int64_t result = 0;
+    SnukItem *item;
+    while ((item = snuk_parser_next_item(&parser))) {
+        if (item->type == SNUK_ITEM_ERROR) result = -1;
+        SnukValue value = snuk_interpreter_exec_item(&intpret, item);
+        if (value.type == SNUK_VALUE_ERROR) result = -1;
+        snuk_value_free(value);
+    }
+
+    SnukValue value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("result"));
+    if (result == 0) result = value.type == SNUK_VALUE_INT ? value.int_value : -1;
+    snuk_value_free(value);
+
+    snuk_parser_deinit(&parser);
+    snuk_interpreter_deinit(&intpret);
+    snuk_arena_deinit(&arena);
+    return result;
+}
+
+typedef struct Worker {
+    int64_t seed;
+    uint64_t failures;
+} Worker;
+
+static void run_worker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    for (int64_t i = 0; i < RUNS; ++i)
+        if (run_script(worker->seed + i) != worker->seed + i + SCRIPT_RESULT) ++worker->failures;
+}
+
+// First, so no interpreter has run before the threads start
+ADD_TEST(test_interpreters_concurrent) {
+    Worker workers[INTERPRETERS];
+    SnukThread *threads[INTERPRETERS];
+
+    snuk_memory_set_shared(true);
+    for (int i = 0; i < INTERPRETERS; ++i) {
+        workers[i] = (Worker){.seed = i * 1000, .failures = 0};
+        threads[i] = snuk_thread_create(run_worker, &workers[i]);
+    }
+    for (int i = 0; i < INTERPRETERS; ++i) snuk_thread_join(threads[i]);
+    snuk_memory_set_shared(false);
+
+    for (int i = 0; i < INTERPRETERS; ++i) {
+        ASSERT_NOT_NULL(threads[i]);
+        ASSERT_EQ(workers[i].failures, 0);
+    }
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_interpreter_script) {
+    ASSERT_EQ(run_script(0), SCRIPT_RESULT);
+    ASSERT_EQ(run_script(100), 100 + SCRIPT_RESULT);
+    TEST_PASSED;
+}
+
+static uint64_t regions_freed = 0;
+
+static void region_destroy(void *data, void *ptr) {
+    SNUK_UNUSED(data);
+    snuk_arena_deinit((SnukArena *)ptr);
+    snuk_free(ptr);
+    ++regions_freed;
+}
+
+/**
+ * @brief Parse and run one item in a region of its own, the way the runtime
+ * does, and give up the caller's reference.
+ *
+ * @return True if something still holds the region.
+ */
+static bool run_in_region(SnukInterpreter *intpret, const char *src) {
+    SnukArena *arena = (SnukArena *)snuk_alloc(sizeof(SnukArena), alignof(SnukArena));
+    snuk_arena_init(arena, KIB(4));
+    SnukAllocator allocator = snuk_arena_allocator(arena);
+    SnukRefCounter *region = snuk_ref_counter_create(arena, NULL, region_destroy);
+
+    SnukParser parser;
+    snuk_parser_init(&parser, src, &allocator, SNUK_LEXER_MODE_EXECUTE);
+    intpret->ast = region;
+    SnukValue value = snuk_interpreter_exec_item(intpret, snuk_parser_next_item(&parser));
+    snuk_value_free(value);
+    intpret->ast = NULL;
+    snuk_parser_deinit(&parser);
+
+    uint64_t freed = regions_freed;
+    snuk_ref_counter_release(&region);
+    return regions_freed == freed;
+}
+
+ADD_TEST(test_interpreter_ast_regions) {
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    // Bindings, closures and literals that outlive the item hold its region
+    ASSERT_EQ(run_in_region(&intpret, "var name = \"snuk\"\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "fn greet(s) { \"hi \" + s }\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "type Point { var x = 0 }\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "fn letters() { yield \"a\"; yield \"b\" }\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "var gen = letters()\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "name = \"lang\"\n"), true);
+
+    // Items that only use them do not
+    ASSERT_EQ(run_in_region(&intpret, "greet(name) + \"!\"\n"), false);
+    ASSERT_EQ(run_in_region(&intpret, "name == \"snuk\"\n"), false);
+    ASSERT_EQ(run_in_region(&intpret, "gen.next()\n"), false);
+    ASSERT_EQ(run_in_region(&intpret, "print \"done\"\n"), false);
+
+    SnukValue value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("name"));
+    ASSERT_EQ(value.type, SNUK_VALUE_STRING);
+    ASSERT_STR_N_EQ(value.string_value.str, "\"lang\"", 6);
+    snuk_value_free(value);
+
+    uint64_t held = regions_freed;
+    snuk_interpreter_deinit(&intpret);
+    ASSERT_EQ(regions_freed, held + 6);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_interpreter_split_outlives_item) {
+    regions_freed = 0;
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    ASSERT_EQ(run_in_region(&intpret, "var text = \"x=1;y=2\"\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "var parts = null\n"), true);
+    // Nothing but the generator refers to the literals of these
+    ASSERT_EQ(run_in_region(&intpret, "parts = \"a;b\".split(\";\")\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "var pairs = text.split(\";\")\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "var first = parts.next() + pairs.next()\n"), true);
+    ASSERT_EQ(run_in_region(&intpret, "var second = parts.next() + pairs.next()\n"), true);
+
+    SnukValue value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("first"));
+    ASSERT_EQ(value.type, SNUK_VALUE_STRING);
+    ASSERT_STR_N_EQ(value.string_value.str, "\"ax=1\"", 6);
+    snuk_value_free(value);
+    value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("second"));
+    ASSERT_STR_N_EQ(value.string_value.str, "\"by=2\"", 6);
+    snuk_value_free(value);
+
+    snuk_interpreter_deinit(&intpret);
+    ASSERT_EQ(regions_freed, 6);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS_WITH_MEM_SIZE(MIB(64));
@@ -0,0 +1,199 @@
+#include "test_framework.h"
+
+#include <snuk/lexer.h>
+
+static SnukTokenType lex_one(const char *src) {
+    SnukLexer lexer;
+    snuk_lexer_init(&lexer, src, SNUK_LEXER_MODE_COMMENTS);
+    SnukTokenType type = snuk_lexer_next_token(&lexer).type;
+    snuk_lexer_deinit(&lexer);
+    return type;
+}
+
+ADD_TEST(test_lexer_keywords) {
+    struct {
+        const char *word;
+        SnukTokenType type;
+    } words[] = {
+        {"var",       SNUK_TOKEN_VAR      },
+        {"const",     SNUK_TOKEN_CONST    },
+        {"any",       SNUK_TOKEN_ANY      },
+        {"if",        SNUK_TOKEN_IF       },
+        {"else",      SNUK_TOKEN_ELSE     },
+        {"match",     SNUK_TOKEN_MATCH    },
+        {"case",      SNUK_TOKEN_CASE     },
+        {"while",     SNUK_TOKEN_WHILE    },
+        {"do",        SNUK_TOKEN_DO       },
+        {"for",       SNUK_TOKEN_FOR      },
+        {"in",        SNUK_TOKEN_IN       },
+        {"return",    SNUK_TOKEN_RETURN   },
+        {"break",     SNUK_TOKEN_BREAK    },
+        {"continue",  SNUK_TOKEN_CONTINUE },
+        {"yield",     SNUK_TOKEN_YIELD    },
+        {"fn",        SNUK_TOKEN_FN       },
+        {"print",     SNUK_TOKEN_PRINT    },
+        {"self",      SNUK_TOKEN_SELF     },
+        {"type",      SNUK_TOKEN_TYPE     },
+        {"interface", SNUK_TOKEN_INTERFACE},
+        {"extend",    SNUK_TOKEN_EXTEND   },
+        {"or",        SNUK_TOKEN_KW_OR    },
+        {"and",       SNUK_TOKEN_KW_AND   },
+        {"not",       SNUK_TOKEN_KW_NOT   },
+        {"true",      SNUK_TOKEN_TRUE     },
+        {"false",     SNUK_TOKEN_FALSE    },
+        {"null",      SNUK_TOKEN_NULL     },
+        {"nan",       SNUK_TOKEN_NAN      },
+        {"NaN",       SNUK_TOKEN_NAN      },
+        {"inf",       SNUK_TOKEN_INF      },
+        {"Infinity",  SNUK_TOKEN_INF      },
+    };
+
+    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(words); ++i) ASSERT_EQ(lex_one(words[i].word), words[i].type);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_keyword_lookalikes) {
+    // Same hash slot or prefix as a keyword, but identifiers
+    const char *words[] = {"vars", "iff", "f", "True", "NULL", "_type", "interfaces", "fn2", "an", "nul"};
+    for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(words); ++i) ASSERT_EQ(lex_one(words[i]), SNUK_TOKEN_IDENTIFIER);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_positions) {
+    SnukLexer lexer;
+    snuk_lexer_init(&lexer, "var x_1 =\t0x1F\n  y", SNUK_LEXER_MODE_COMMENTS);
+    uint64_t line, col;
+
+    SnukToken token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_VAR);
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_IDENTIFIER);
+    ASSERT(snuk_string_view_equal_cstr(snuk_lexer_token_text(&lexer, token), "x_1"));
+    snuk_lexer_token_position(&lexer, token, &line, &col);
+    ASSERT_EQ(col, 4);
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_ASSIGN);
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_INTEGER);
+    ASSERT_EQ(snuk_lexer_token_literal(&lexer, token).int_literal, 31);
+    snuk_lexer_token_position(&lexer, token, &line, &col);
+    ASSERT_EQ(col, 10);
+    ASSERT_EQ(snuk_lexer_next_token(&lexer).type, SNUK_TOKEN_VSEMICOLON);
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_IDENTIFIER);
+    snuk_lexer_token_position(&lexer, token, &line, &col);
+    ASSERT_EQ(line, 1);
+    ASSERT_EQ(col, 2);
+
+    snuk_lexer_deinit(&lexer);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_batches) {
+    const char *src = "var a = 1.5\nprint a * 2, \"done\"";
+    SnukLexer lexer, batched;
+    snuk_lexer_init(&lexer, src, SNUK_LEXER_MODE_EXECUTE);
+    snuk_lexer_init(&batched, src, SNUK_LEXER_MODE_EXECUTE);
+
+    // Small batches that end mid-line, and one that stops at the end
+    SnukToken tokens[4];
+    uint64_t count;
+    do {
+        count = snuk_lexer_next_tokens(&batched, tokens, SNUK_ARRAY_LENGTH(tokens));
+        for (uint64_t i = 0; i < count; ++i) {
+            SnukToken expected = snuk_lexer_next_token(&lexer);
+            ASSERT_EQ(tokens[i].type, expected.type);
+            ASSERT_EQ(tokens[i].offset, expected.offset);
+            ASSERT_EQ(tokens[i].len, expected.len);
+        }
+    } while (count == SNUK_ARRAY_LENGTH(tokens));
+    ASSERT_EQ(tokens[count - 1].type, SNUK_TOKEN_EOF);
+
+    snuk_lexer_deinit(&lexer);
+    snuk_lexer_deinit(&batched);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_long_strings_and_comments) {
+    // Long enough for the vector scans, with newlines to count on the way
+    const char *src = "/* a block comment that runs past a vector\n"
+                      "   width and over\n"
+                      "   three lines */ \"a string with\n"
+                      "a newline and then some more text\" // trailing comment, long enough too\n"
+                      "x";
+    SnukLexer lexer;
+    snuk_lexer_init(&lexer, src, SNUK_LEXER_MODE_COMMENTS);
+
+    uint64_t line, col;
+    SnukStringView leading, trailing;
+
+    SnukToken token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_STRING);
+    snuk_lexer_token_position(&lexer, token, &line, &col);
+    ASSERT_EQ(line, 2);
+    ASSERT_EQ(col, 18);
+    snuk_lexer_token_comments(&lexer, token, &leading, &trailing);
+    ASSERT(snuk_string_view_equal_cstr(leading,
+                                       " a block comment that runs past a vector\n   width and over\n   three lines "));
+    ASSERT(snuk_string_view_equal_cstr(trailing, " trailing comment, long enough too"));
+
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_VSEMICOLON);
+    snuk_lexer_token_comments(&lexer, token, &leading, &trailing);
+    ASSERT_EQ(leading.len + trailing.len, 0);
+    token = snuk_lexer_next_token(&lexer);
+    ASSERT_EQ(token.type, SNUK_TOKEN_IDENTIFIER);
+    snuk_lexer_token_position(&lexer, token, &line, &col);
+    ASSERT_EQ(line, 4);
+    ASSERT_EQ(col, 0);
+
+    snuk_lexer_deinit(&lexer);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_unterminated) {
+    ASSERT_EQ(lex_one("\"no closing quote, and long enough to cross a vector"), SNUK_TOKEN_ERROR);
+    // The comment error is folded into the token it trails, nothing reads past the end
+    ASSERT_EQ(lex_one("x /* no closing, ends on a star *"), SNUK_TOKEN_IDENTIFIER);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_lexer_execute_mode) {
+    const char *src = "// leading\n"
+                      "var x = 1 // trailing\n"
+                      "/* standalone */\n"
+                      "fn f() { /* spans\n lines */ x }\n"
+                      "y /* unterminated";
+    SnukLexer full, exec;
+    snuk_lexer_init(&full, src, SNUK_LEXER_MODE_COMMENTS);
+    snuk_lexer_init(&exec, src, SNUK_LEXER_MODE_EXECUTE);
+
+    // Same tokens apart from the comments and the semicolons that ended them
+    SnukToken token;
+    do {
+        token = snuk_lexer_next_token(&exec);
+        ASSERT_NE(token.type, SNUK_TOKEN_LINE_COMMENT);
+        ASSERT_NE(token.type, SNUK_TOKEN_BLOCK_COMMENT);
+        SnukStringView leading, trailing;
+        snuk_lexer_token_comments(&exec, token, &leading, &trailing);
+        ASSERT_EQ(leading.len + trailing.len, 0);
+
+        SnukToken expected;
+        SnukTokenType previous = SNUK_TOKEN_EOF;
+        while (true) {
+            expected = snuk_lexer_next_token(&full);
+            bool comment = expected.type == SNUK_TOKEN_LINE_COMMENT || expected.type == SNUK_TOKEN_BLOCK_COMMENT;
+            if (comment) previous = expected.type;
+            else if (expected.type == SNUK_TOKEN_VSEMICOLON && previous != SNUK_TOKEN_EOF) previous = SNUK_TOKEN_EOF;
+            else break;
+        }
+        ASSERT_EQ(token.type, expected.type);
+        ASSERT_EQ(token.offset, expected.offset);
+    } while (token.type != SNUK_TOKEN_EOF);
+
+    snuk_lexer_deinit(&full);
+    snuk_lexer_deinit(&exec);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();
@@ -0,0 +1,192 @@
+#include "test_framework.h"
+
+#include <snuk/interpreter/snuk_pool.h>
+#include <snuk/io.h>
+#include <snuk/stats.h>
+#include <stdio.h>
+#include <string.h>
+
+#define THREADS 3
+#define JOBS 60
+#define IMAGE_PATH "test_pool.snukc"
+#define SOURCE_PATH "test_pool.snuk"
+
+static const char script[] = "fn fib(n) { if n < 2 { return n }; return fib(n - 1) + fib(n - 2) }\n"
+                             "var total = 0\n"
+                             "for var i = 0; i < 50; i += 1 { total += i.to_str().length() }\n"
+                             "seed + fib(12) + total + name.length()\n";
+
+// fib(12) + the digits of 0 to 49
+#define SCRIPT_RESULT (144 + 90)
+
+static SnukValue int_value(int64_t value) {
+    return (SnukValue){.type = SNUK_VALUE_INT, .int_value = value};
+}
+
+static SnukValue string_value(const char *str) {
+    return (SnukValue){.type = SNUK_VALUE_STRING, .string_value = snuk_string_view_create(str)};
+}
+
+ADD_TEST(test_pool_source) {
+    SnukStats before, after;
+    snuk_stats_get(&before);
+
+    SnukPool *pool = snuk_pool_create(THREADS);
+    ASSERT_NOT_NULL(pool);
+
+    SnukFuture *futures[JOBS];
+    for (int64_t i = 0; i < JOBS; ++i) {
+        // Quotes are part of a string value
+        char name[16];
+        snprintf(name, sizeof(name), "\"%lld\"", (long long)i);
+        SnukProgramInput inputs[] = {
+            {.name = "seed", .value = int_value(i * 1000)},
+            {.name = "name", .value = string_value(name)},
+        };
+        futures[i] = snuk_pool_submit(pool, script, inputs, 2);
+    }
+
+    uint64_t failures = 0;
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukValue value = snuk_future_wait(futures[i]);
+        int64_t digits = i < 10 ? 1 : 2;
+        if (value.type != SNUK_VALUE_INT || value.int_value != i * 1000 + SCRIPT_RESULT + digits) ++failures;
+        snuk_future_destroy(futures[i]);
+    }
+    ASSERT_EQ(failures, 0);
+
+    snuk_pool_destroy(pool);
+
+    // Workers count at once, none of it may be lost
+    snuk_stats_get(&after);
+    ASSERT_EQ(after.refcounters_created > before.refcounters_created, true);
+    ASSERT_EQ(after.refcounters_created - before.refcounters_created,
+              after.refcounters_destroyed - before.refcounters_destroyed);
+    ASSERT_EQ(after.scopes_created - before.scopes_created, after.scopes_destroyed - before.scopes_destroyed);
+    ASSERT_EQ(after.envs_created - before.envs_created, after.envs_destroyed - before.envs_destroyed);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_pool_results) {
+    SnukPool *pool = snuk_pool_create(THREADS);
+    ASSERT_NOT_NULL(pool);
+
+    SnukFuture *text = snuk_pool_submit(pool, "var s = \"ab\"\ns + \"cd\"\n", NULL, 0);
+    SnukFuture *fn = snuk_pool_submit(pool, "fn f() { return 1 }\nf\n", NULL, 0);
+    SnukFuture *failed = snuk_pool_submit(pool, "var x = 1\nx()\nx\n", NULL, 0);
+    SnukFuture *unparsed = snuk_pool_submit(pool, "var = \n", NULL, 0);
+    // Nothing from the previous job is left in the worker
+    SnukFuture *fresh = snuk_pool_submit(pool, "var x = 2\nx\n", NULL, 0);
+
+    SnukValue value = snuk_future_wait(text);
+    ASSERT_EQ(value.type, SNUK_VALUE_STRING);
+    ASSERT_EQ(value.string_value.len, 6);
+    ASSERT_STR_N_EQ(value.string_value.str, "\"abcd\"", 6);
+
+    ASSERT_EQ(snuk_future_wait(fn).type, SNUK_VALUE_NULL);
+    ASSERT_EQ(snuk_future_wait(failed).type, SNUK_VALUE_ERROR);
+    ASSERT_EQ(snuk_future_wait(unparsed).type, SNUK_VALUE_ERROR);
+
+    value = snuk_future_wait(fresh);
+    ASSERT_EQ(value.type, SNUK_VALUE_INT);
+    ASSERT_EQ(value.int_value, 2);
+
+    snuk_pool_destroy(pool);
+
+    // Futures outlive the pool
+    ASSERT_EQ(snuk_future_done(text), true);
+    snuk_future_destroy(text);
+    snuk_future_destroy(fn);
+    snuk_future_destroy(failed);
+    snuk_future_destroy(unparsed);
+    snuk_future_destroy(fresh);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_pool_image) {
+    ASSERT_EQ(snuk_image_compile(script, "", IMAGE_PATH), true);
+    SnukImage image;
+    ASSERT_EQ(snuk_image_load(&image, IMAGE_PATH), SNUK_IMAGE_OK);
+
+    SnukPool *pool = snuk_pool_create(THREADS);
+    ASSERT_NOT_NULL(pool);
+
+    SnukFuture *futures[JOBS];
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukProgramInput inputs[] = {
+            {.name = "seed", .value = int_value(i)},
+            {.name = "name", .value = string_value("\"x\"")},
+        };
+        futures[i] = snuk_pool_submit_image(pool, &image, inputs, 2);
+    }
+
+    uint64_t failures = 0;
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukValue value = snuk_future_wait(futures[i]);
+        if (value.type != SNUK_VALUE_INT || value.int_value != i + SCRIPT_RESULT + 1) ++failures;
+        snuk_future_destroy(futures[i]);
+    }
+    ASSERT_EQ(failures, 0);
+
+    snuk_pool_destroy(pool);
+    snuk_image_unload(&image);
+    remove(IMAGE_PATH);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_pool_image_source) {
+    ASSERT_EQ(snuk_write_file(SOURCE_PATH, script, sizeof(script) - 1), true);
+    ASSERT_EQ(snuk_image_compile(script, SOURCE_PATH, IMAGE_PATH), true);
+
+    // Checked against the same file whatever directory it is run from
+    SnukImage image;
+    ASSERT_EQ(snuk_image_load(&image, IMAGE_PATH), SNUK_IMAGE_OK);
+    uint64_t len = strlen(image.source_path);
+    ASSERT_EQ(len > strlen(SOURCE_PATH), true);
+    ASSERT_STR_N_EQ(image.source_path + len - strlen(SOURCE_PATH), SOURCE_PATH, strlen(SOURCE_PATH));
+    snuk_image_unload(&image);
+
+    ASSERT_EQ(snuk_write_file(SOURCE_PATH, "seed\n", 5), true);
+    ASSERT_EQ(snuk_image_load(&image, IMAGE_PATH), SNUK_IMAGE_STALE);
+    snuk_image_unload(&image);
+
+    // Runs, but is not reported as fresh
+    remove(SOURCE_PATH);
+    ASSERT_EQ(snuk_image_load(&image, IMAGE_PATH), SNUK_IMAGE_NO_SOURCE);
+    ASSERT_EQ(image.item_count, 4);
+    snuk_image_unload(&image);
+
+    remove(IMAGE_PATH);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_pool_program) {
+    SnukProgram program;
+    ASSERT_EQ(snuk_program_compile(&program, script, "script"), true);
+
+    SnukPool *pool = snuk_pool_create(THREADS);
+    ASSERT_NOT_NULL(pool);
+
+    SnukFuture *futures[JOBS];
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukProgramInput inputs[] = {
+            {.name = "seed", .value = int_value(-i)},
+            {.name = "name", .value = string_value("\"xy\"")},
+        };
+        futures[i] = snuk_pool_submit_program(pool, &program, inputs, 2);
+    }
+
+    uint64_t failures = 0;
+    for (int64_t i = 0; i < JOBS; ++i) {
+        SnukValue value = snuk_future_wait(futures[i]);
+        if (value.type != SNUK_VALUE_INT || value.int_value != -i + SCRIPT_RESULT + 2) ++failures;
+        snuk_future_destroy(futures[i]);
+    }
+    ASSERT_EQ(failures, 0);
+
+    snuk_pool_destroy(pool);
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS_WITH_MEM_SIZE(MIB(64));
@@ -0,0 +1,106 @@
+#include "test_framework.h"
+
+#include <snuk/interpreter/snuk_program.h>
+
+static const char script[] = "var calls = 0\n"
+                             "fn scale(x) { calls += 1; return x * factor }\n"
+                             "scale(base) + scale(1)\n";
+
+static SnukProgramInput inputs(const char *name, int64_t value) {
+    return (SnukProgramInput){.name = name, .value = {.type = SNUK_VALUE_INT, .int_value = value}};
+}
+
+ADD_TEST(test_program_run_many) {
+    SnukProgram program;
+    ASSERT_EQ(snuk_program_compile(&program, script, "script"), true);
+    ASSERT_EQ(program.item_count, 3);
+
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    // Same interpreter, fresh global scope every run
+    for (int64_t i = 0; i < 50; ++i) {
+        SnukProgramInput bound[] = {inputs("base", i), inputs("factor", 3)};
+        SnukValue value = snuk_program_run(&program, &intpret, bound, 2);
+        ASSERT_EQ(value.type, SNUK_VALUE_INT);
+        ASSERT_EQ(value.int_value, (i + 1) * 3);
+        snuk_value_free(value);
+        snuk_interpreter_reset(&intpret);
+    }
+
+    snuk_interpreter_deinit(&intpret);
+
+    // A fresh interpreter per run
+    for (int64_t i = 0; i < 5; ++i) {
+        snuk_interpreter_init(&intpret);
+        SnukProgramInput bound[] = {inputs("base", 10), inputs("factor", i)};
+        SnukValue value = snuk_program_run(&program, &intpret, bound, 2);
+        ASSERT_EQ(value.int_value, 11 * i);
+        snuk_value_free(value);
+
+        // Functions from the run still call into the program
+        value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("calls"));
+        ASSERT_EQ(value.int_value, 2);
+        snuk_value_free(value);
+        snuk_interpreter_deinit(&intpret);
+    }
+
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_program_rerun_inputs) {
+    SnukProgram program;
+    ASSERT_EQ(snuk_program_compile(&program, "base * factor\n", "rerun"), true);
+
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    // No reset in between, the second run sees its own inputs
+    SnukProgramInput first[] = {inputs("base", 2), inputs("factor", 3)};
+    SnukValue value = snuk_program_run(&program, &intpret, first, 2);
+    ASSERT_EQ(value.int_value, 6);
+    snuk_value_free(value);
+
+    SnukProgramInput second[] = {inputs("base", 5), inputs("factor", 7)};
+    value = snuk_program_run(&program, &intpret, second, 2);
+    ASSERT_EQ(value.type, SNUK_VALUE_INT);
+    ASSERT_EQ(value.int_value, 35);
+    snuk_value_free(value);
+
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+ADD_TEST(test_program_errors) {
+    SnukProgram program;
+    ASSERT_EQ(snuk_program_compile(&program, "var = 1\n", "broken"), false);
+    ASSERT_EQ(program.item_count, 0);
+    snuk_program_destroy(&program);
+
+    ASSERT_EQ(snuk_program_compile(&program, "var x = 1\nx()\nx = 2\n", "failing"), true);
+    SnukInterpreter intpret;
+    snuk_interpreter_init(&intpret);
+
+    // Stops at the first error
+    SnukValue value = snuk_program_run(&program, &intpret, NULL, 0);
+    ASSERT_EQ(value.type, SNUK_VALUE_ERROR);
+    snuk_interpreter_reset(&intpret);
+
+    // Runs again once reset
+    value = snuk_program_run(&program, &intpret, NULL, 0);
+    ASSERT_EQ(value.type, SNUK_VALUE_ERROR);
+    value = snuk_interpreter_get_env(&intpret, snuk_string_view_create("x"));
+    ASSERT_EQ(value.int_value, 1);
+
+    snuk_interpreter_deinit(&intpret);
+    snuk_program_destroy(&program);
+
+    // Destroying a zeroed program is fine
+    program = (SnukProgram){0};
+    snuk_program_destroy(&program);
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS_WITH_MEM_SIZE(MIB(64));
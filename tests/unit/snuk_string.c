@@ -230,4 +230,95 @@ ADD_TEST(test_string_concat) {
     TEST_PASSED;
 }
 
+ADD_TEST(test_string_find_byte) {
+    const char *s = "0123456789abcdefghijklmnopqrstuvwxyz0123456789";
+    uint64_t len = snuk_string_length(s);
+
+    ASSERT_PTR_EQ(snuk_string_find_byte(s, len, '0'), s);
+    ASSERT_PTR_EQ(snuk_string_find_byte(s, len, 'z'), s + 35);
+    ASSERT_NULL(snuk_string_find_byte(s, len, '#'));
+
+    // Bytes past len are not looked at
+    ASSERT_NULL(snuk_string_find_byte(s, 10, 'a'));
+    ASSERT_NULL(snuk_string_find_byte(s, 0, '0'));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_find_last_byte) {
+    const char *s = "0123456789abcdefghijklmnopqrstuvwxyz0123456789";
+    uint64_t len = snuk_string_length(s);
+
+    ASSERT_PTR_EQ(snuk_string_find_last_byte(s, len, '0'), s + 36);
+    ASSERT_PTR_EQ(snuk_string_find_last_byte(s, len, 'a'), s + 10);
+    ASSERT_NULL(snuk_string_find_last_byte(s, len, '#'));
+
+    // Bytes past len are not looked at
+    ASSERT_PTR_EQ(snuk_string_find_last_byte(s, 36, '0'), s);
+    ASSERT_NULL(snuk_string_find_last_byte(s, 0, '0'));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_count_byte) {
+    // Matches on both sides of the vector block boundaries
+    char s[100];
+    for (uint64_t i = 0; i < sizeof(s); ++i) s[i] = i % 3 == 0 ? '\n' : 'x';
+
+    ASSERT_EQ(snuk_string_count_byte(s, sizeof(s), '\n'), 34);
+    ASSERT_EQ(snuk_string_count_byte(s, 31, '\n'), 11);
+    ASSERT_EQ(snuk_string_count_byte(s, sizeof(s), 'y'), 0);
+    ASSERT_EQ(snuk_string_count_byte(s, 0, 'x'), 0);
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_find) {
+    const char *s = "the quick brown fox jumps over the lazy dog, the end";
+    uint64_t len = snuk_string_length(s);
+
+    ASSERT_PTR_EQ(snuk_string_find(s, len, "the", 3), s);
+    ASSERT_PTR_EQ(snuk_string_find(s, len, "lazy", 4), s + 35);
+    ASSERT_PTR_EQ(snuk_string_find(s, len, "end", 3), s + len - 3);
+    ASSERT_PTR_EQ(snuk_string_find(s, len, "", 0), s);
+    ASSERT_NULL(snuk_string_find(s, len, "cat", 3));
+    ASSERT_NULL(snuk_string_find(s, 3, "the quick", 9));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_find_matches_naive) {
+    // Every needle position and length across the vector block boundaries
+    char haystack[160];
+    for (uint64_t i = 0; i < sizeof(haystack); ++i) haystack[i] = (char)('a' + (i * 7 + i / 13) % 5);
+
+    for (uint64_t start = 0; start < 100; start += 3) {
+        for (uint64_t needle_len = 1; needle_len < 40; ++needle_len) {
+            const char *needle = haystack + start;
+            const char *expected = NULL;
+            for (uint64_t i = 0; i + needle_len <= sizeof(haystack); ++i) {
+                if (memcmp(haystack + i, needle, needle_len) == 0) {
+                    expected = haystack + i;
+                    break;
+                }
+            }
+            ASSERT_PTR_EQ(snuk_string_find(haystack, sizeof(haystack), needle, needle_len), expected);
+        }
+    }
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_count) {
+    const char *s = "abababab";
+
+    ASSERT_EQ(snuk_string_count(s, 8, "ab", 2), 4);
+    ASSERT_EQ(snuk_string_count(s, 8, "aba", 3), 2);
+    ASSERT_EQ(snuk_string_count(s, 8, "b", 1), 4);
+    ASSERT_EQ(snuk_string_count(s, 8, "c", 1), 0);
+    ASSERT_EQ(snuk_string_count(s, 8, "", 0), 0);
+
+    TEST_PASSED;
+}
+
 RUN_ALL_TESTS();
@@ -0,0 +1,61 @@
+#include "test_framework.h"
+
+#include <snuk/memory.h>
+#include <snuk/stats.h>
+
+ADD_TEST(test_stats_count_allocations) {
+    snuk_stats_reset();
+
+    void *small = snuk_alloc(24, 8);
+    void *large = snuk_alloc(4000, 8);
+    large = snuk_realloc(large, 5000, 8);
+    snuk_free(small);
+    snuk_free(large);
+
+    SnukStats stats;
+    snuk_stats_get(&stats);
+    SnukAllocatorStats *slab = &stats.allocators[SNUK_STATS_ALLOCATOR_SLAB];
+    ASSERT_EQ(slab->allocations, 1);
+    ASSERT_EQ(slab->frees, 1);
+    ASSERT_EQ(slab->bytes, 24);
+    ASSERT_EQ(slab->live, 0);
+    ASSERT_EQ(slab->live_peak, 32);
+
+    SnukAllocatorStats *global = &stats.allocators[SNUK_STATS_ALLOCATOR_GLOBAL];
+    ASSERT_EQ(global->allocations, 2);
+    ASSERT_EQ(global->frees, 1);
+    ASSERT_EQ(global->bytes, 9000);
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_stats_track_reserved_pages) {
+    snuk_stats_reset();
+
+    void *pages = snuk_allocate_pages(2);
+    snuk_free_pages(pages, 2);
+
+    SnukStats stats;
+    snuk_stats_get(&stats);
+    SnukAllocatorStats *page_stats = &stats.allocators[SNUK_STATS_ALLOCATOR_PAGES];
+    ASSERT_EQ(page_stats->allocations, 1);
+    ASSERT_EQ(page_stats->frees, 1);
+    ASSERT_EQ(page_stats->reserved, 0);
+    ASSERT_EQ(page_stats->reserved_peak, 2 * snuk_page_size());
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_stats_peak_rss) {
+    SnukStats stats;
+    snuk_stats_get(&stats);
+    ASSERT(stats.peak_rss > 0);
+
+    snuk_stats_reset();
+    snuk_stats_get(&stats);
+    ASSERT_EQ(stats.refcounters_created, 0);
+
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();
@@ -79,4 +79,29 @@ ADD_TEST(test_string_view_equal) {
     TEST_PASSED;
 }
 
+ADD_TEST(test_string_view_starts_with) {
+    SnukStringView view = snuk_string_view_create("hello world");
+
+    ASSERT(snuk_string_view_starts_with(view, snuk_string_view_create("hello")));
+    ASSERT(snuk_string_view_starts_with(view, snuk_string_view_create("")));
+    ASSERT(!snuk_string_view_starts_with(view, snuk_string_view_create("world")));
+    ASSERT(!snuk_string_view_starts_with(snuk_string_view_create("he"), snuk_string_view_create("hello")));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_string_view_trim) {
+    SnukStringView view = snuk_string_view_create(" \t hello world \r\n");
+    SnukStringView trimmed = snuk_string_view_trim(view);
+
+    ASSERT_EQ(trimmed.len, 11);
+    ASSERT_PTR_EQ(trimmed.str, view.str + 3);
+    ASSERT_STR_N_EQ(trimmed.str, "hello world", trimmed.len);
+
+    ASSERT_EQ(snuk_string_view_trim(snuk_string_view_create("   ")).len, 0);
+    ASSERT_EQ(snuk_string_view_trim(snuk_string_view_create("")).len, 0);
+
+    TEST_PASSED;
+}
+
 RUN_ALL_TESTS();
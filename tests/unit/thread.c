@@ -0,0 +1,98 @@
+#include "test_framework.h"
+
+#include <snuk/memory.h>
+#include <snuk/thread.h>
+
+#define THREADS 4
+#define INCREMENTS 100000
+
+static volatile uint64_t counter;
+static volatile uint64_t cas_counter;
+
+static void increment(void *arg) {
+    SNUK_UNUSED(arg);
+    for (uint64_t i = 0; i < INCREMENTS; ++i) snuk_atomic_fetch_add(&counter, 1);
+}
+
+static void increment_cas(void *arg) {
+    SNUK_UNUSED(arg);
+    for (uint64_t i = 0; i < INCREMENTS; ++i) {
+        uint64_t expected = snuk_atomic_load(&cas_counter);
+        while (!snuk_atomic_compare_exchange(&cas_counter, &expected, expected + 1));
+    }
+}
+
+// Blocks from the slabs and the freelist, each filled with its owner's byte
+static void allocate_shared(void *arg) {
+    uint8_t tag = (uint8_t)(uintptr_t)arg;
+    uint8_t *blocks[64];
+    for (uint64_t round = 0; round < 2000; ++round) {
+        for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(blocks); ++i) {
+            uint64_t size = 16 + (i * 37 + round) % 600;
+            blocks[i] = snuk_alloc(size, 16);
+            memset(blocks[i], tag, 16);
+        }
+        for (uint64_t i = 0; i < SNUK_ARRAY_LENGTH(blocks); ++i) {
+            for (uint64_t j = 0; j < 16; ++j)
+                if (blocks[i][j] != tag) snuk_atomic_fetch_add(&counter, 1);
+            snuk_free(blocks[i]);
+        }
+    }
+}
+
+static void set_flag(void *arg) {
+    snuk_atomic_store((volatile uint64_t *)arg, 42);
+}
+
+ADD_TEST(test_thread_join) {
+    volatile uint64_t flag = 0;
+    SnukThread *thread = snuk_thread_create(set_flag, (void *)&flag);
+    ASSERT_NOT_NULL(thread);
+    snuk_thread_join(thread);
+    ASSERT_EQ(snuk_atomic_load(&flag), 42);
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_atomic_fetch_add) {
+    counter = 0;
+    SnukThread *threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) threads[i] = snuk_thread_create(increment, NULL);
+    for (int i = 0; i < THREADS; ++i) snuk_thread_join(threads[i]);
+
+    ASSERT_EQ(snuk_atomic_load(&counter), THREADS * INCREMENTS);
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_atomic_compare_exchange) {
+    cas_counter = 0;
+    SnukThread *threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) threads[i] = snuk_thread_create(increment_cas, NULL);
+    for (int i = 0; i < THREADS; ++i) snuk_thread_join(threads[i]);
+
+    ASSERT_EQ(snuk_atomic_load(&cas_counter), THREADS * INCREMENTS);
+
+    // A stale expected value fails and is refreshed
+    uint64_t expected = 0;
+    ASSERT(!snuk_atomic_compare_exchange(&cas_counter, &expected, 1));
+    ASSERT_EQ(expected, THREADS * INCREMENTS);
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_memory_shared) {
+    counter = 0;
+    snuk_memory_set_shared(true);
+    SnukThread *threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) threads[i] = snuk_thread_create(allocate_shared, (void *)(uintptr_t)(i + 1));
+    for (int i = 0; i < THREADS; ++i) snuk_thread_join(threads[i]);
+    snuk_memory_set_shared(false);
+
+    // No block was handed to two threads at once
+    ASSERT_EQ(snuk_atomic_load(&counter), 0);
+
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();
@@ -0,0 +1,92 @@
+#include "test_framework.h"
+
+#include <snuk/writer.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+static bool int_formats_as(int64_t value, const char *expected) {
+    char buf[SNUK_FORMAT_INT_MAX_CHARS];
+    uint64_t len = snuk_format_int(value, buf);
+    return len == strlen(expected) && memcmp(buf, expected, len) == 0;
+}
+
+static bool float_formats_as(double value, const char *expected) {
+    char buf[SNUK_FORMAT_FLOAT_MAX_CHARS];
+    uint64_t len = snuk_format_float(value, buf);
+    return len == strlen(expected) && memcmp(buf, expected, len) == 0;
+}
+
+static bool float_round_trips(double value) {
+    char buf[SNUK_FORMAT_FLOAT_MAX_CHARS + 1];
+    uint64_t len = snuk_format_float(value, buf);
+    buf[len] = 0;
+    return strtod(buf, NULL) == value;
+}
+
+ADD_TEST(test_format_int) {
+    ASSERT(int_formats_as(0, "0"));
+    ASSERT(int_formats_as(7, "7"));
+    ASSERT(int_formats_as(42, "42"));
+    ASSERT(int_formats_as(-100, "-100"));
+    ASSERT(int_formats_as(1234567, "1234567"));
+    ASSERT(int_formats_as(INT64_MAX, "9223372036854775807"));
+    ASSERT(int_formats_as(INT64_MIN, "-9223372036854775808"));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_format_float) {
+    ASSERT(float_formats_as(0.0, "0.0"));
+    ASSERT(float_formats_as(-0.0, "-0.0"));
+    ASSERT(float_formats_as(1.0, "1.0"));
+    ASSERT(float_formats_as(-2.5, "-2.5"));
+    ASSERT(float_formats_as(0.1, "0.1"));
+    ASSERT(float_formats_as(0.1 + 0.2, "0.30000000000000004"));
+    ASSERT(float_formats_as(1e20, "1e+20"));
+    ASSERT(float_formats_as(1.5e-7, "1.5e-07"));
+    ASSERT(float_formats_as(INFINITY, "inf"));
+    ASSERT(float_formats_as(-INFINITY, "-inf"));
+    ASSERT(float_formats_as(NAN, "nan"));
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_format_float_round_trips) {
+    ASSERT(float_round_trips(DBL_MAX));
+    ASSERT(float_round_trips(-DBL_MIN));
+    ASSERT(float_round_trips(5e-324));
+    ASSERT(float_round_trips(9007199254740993.0));
+
+    double value = 1.0;
+    for (int i = 0; i < 1000; ++i) {
+        value = value * 1.37 + 0.001;
+        if (value > 1e300) value /= 1e290;
+        ASSERT(float_round_trips(value));
+        ASSERT(float_round_trips(1.0 / value));
+    }
+
+    TEST_PASSED;
+}
+
+ADD_TEST(test_writer_buffers) {
+    SnukWriter writer;
+    snuk_writer_init(&writer, 16, SNUK_FLUSH_ON_FULL);
+
+    snuk_writer_write_cstr(&writer, "abc");
+    snuk_writer_write_int(&writer, -12);
+    ASSERT_EQ(writer.len, 6);
+    ASSERT_STR_N_EQ(writer.buffer, "abc-12", writer.len);
+
+    // Writes that do not fit flush first
+    snuk_writer_write_cstr(&writer, "0123456789A\n");
+    ASSERT_EQ(writer.len, 12);
+
+    snuk_writer_deinit(&writer);
+    ASSERT_NULL(writer.buffer);
+
+    TEST_PASSED;
+}
+
+RUN_ALL_TESTS();